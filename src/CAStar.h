@@ -3,11 +3,32 @@
 
 #include <list>
 #include <map>
-#include <set>
+#include <unordered_map>
+#include <vector>
+#include <type_traits>
 
 #include <cassert>
 #include <iostream>
 
+// true if std::hash is specialized for T
+template<typename T, typename = void>
+struct CAStarIsHashable : std::false_type { };
+
+template<typename T>
+struct CAStarIsHashable<T, std::void_t<decltype(std::hash<T>()(std::declval<const T &>()))>> :
+  std::true_type {
+};
+
+// A* search over locations
+//
+// the open set is a binary heap of nodes ordered by total cost, each open node stores its
+// heap index so a better path to an open node is a decrease-key (sift up) rather than a
+// remove and insert. Open/closed state is stamped with a search id so nodes created by
+// previous searches are reused without being reset.
+//
+// nodes created by lookupNode are owned by the search and kept (in a hash map when
+// Location has a std::hash, otherwise a std::map) until clearNodes or destruction.
+// Caller owned start/goal nodes are only mapped for the duration of their search.
 template<typename Location>
 class CAStar {
  public:
@@ -17,6 +38,9 @@ class CAStar {
     double   costFromStart       { 0.0 };
     double   estimatedCostToGoal { 0.0 };
     double   totalCost           { 0.0 };
+    uint     searchId            { 0 };     // search which last visited node
+    int      heapInd             { -1 };    // index in open heap (-1 if not open)
+    bool     closed              { false }; // is closed in search
 
     Node(const Location &l) :
      loc(l) {
@@ -32,7 +56,10 @@ class CAStar {
  public:
   CAStar() { }
 
-  virtual ~CAStar() { }
+  virtual ~CAStar() { clearNodes(); }
+
+  CAStar(const CAStar &) = delete;
+  CAStar &operator=(const CAStar &) = delete;
 
   //--- By Location
 
@@ -71,18 +98,41 @@ class CAStar {
 
   virtual Node *createNode(const Location &loc) const;
 
+  // delete nodes created by lookupNode
+  void clearNodes();
+
+  uint numOpenNodes() const { return uint(openHeap_.size()); }
+
   //------
 
   void printNode(Node *node) const;
 
  protected:
-  using NodeMap = std::map<Location,Node *>;
-  using NodeSet = std::set<Node *>;
+  bool searchNodes(Node *startNode, Node *goalNode, NodeList &pathNodes);
+
+  void initNode(Node *node) const;
+
+  void addOpenNode   (Node *node);
+  void removeOpenNode(Node *node);
+  void updateOpenNode(Node *node);
 
-  mutable NodeMap nodeMap_; // map of location to node
+  bool isBetterNode(const Node *node1, const Node *node2) const;
 
-  NodeSet openNodes_;   // open nodes
-  NodeSet closedNodes_; // closed nodes
+  void siftUp  (int i);
+  void siftDown(int i);
+
+ protected:
+  using NodeMap = std::conditional_t<CAStarIsHashable<Location>::value,
+                                     std::unordered_map<Location,Node *>,
+                                     std::map<Location,Node *>>;
+  using NodeHeap = std::vector<Node *>;
+  using Nodes    = std::vector<Node *>;
+
+  mutable NodeMap nodeMap_;    // map of location to node
+  mutable Nodes   ownedNodes_; // nodes created by lookupNode
+
+  NodeHeap openHeap_;      // open nodes (binary heap on total cost)
+  uint     searchId_ { 0 }; // current search id
 };
 
 //---
@@ -107,25 +157,70 @@ bool
 CAStar<Location>::
 search(Node *startNode, Node *goalNode, NodeList &pathNodes)
 {
-  // clear node map
-  nodeMap_.clear();
+  // start/goal nodes replace the nodes for their locations during the search. Nodes not
+  // already in the map (caller owned) are removed (previous node restored) after it so
+  // the map never keeps nodes the caller may free
+  struct MappedNode {
+    Location loc;
+    Node*    prevNode { nullptr };
+  };
+
+  std::vector<MappedNode> mappedNodes;
+
+  auto mapNode = [&](Node *node) {
+    auto p = nodeMap_.find(node->loc);
+
+    if (p != nodeMap_.end() && (*p).second == node)
+      return;
+
+    mappedNodes.push_back(MappedNode{node->loc, (p != nodeMap_.end() ? (*p).second : nullptr)});
+
+    nodeMap_[node->loc] = node;
+  };
+
+  mapNode(startNode);
+  mapNode(goalNode);
+
+  bool rc = searchNodes(startNode, goalNode, pathNodes);
+
+  // restore in reverse order (start and goal may share location)
+  for (auto pm = mappedNodes.rbegin(); pm != mappedNodes.rend(); ++pm) {
+    if ((*pm).prevNode)
+      nodeMap_[(*pm).loc] = (*pm).prevNode;
+    else
+      nodeMap_.erase((*pm).loc);
+  }
+
+  return rc;
+}
+
+template<typename Location>
+bool
+CAStar<Location>::
+searchNodes(Node *startNode, Node *goalNode, NodeList &pathNodes)
+{
+  // new search id invalidates open and closed state of all nodes
+  if (++searchId_ == 0) {
+    for (auto &pn : nodeMap_)
+      pn.second->searchId = 0;
+
+    searchId_ = 1;
+  }
 
-  nodeMap_[startNode->loc] = startNode;
-  nodeMap_[goalNode ->loc] = goalNode;
+  openHeap_.clear();
 
-  // clear open and closed
-  openNodes_  .clear();
-  closedNodes_.clear();
+  initNode(startNode);
+  initNode(goalNode);
 
   startNode->parent              = nullptr;
   startNode->costFromStart       = 0.0;
   startNode->estimatedCostToGoal = pathCostEstimate(startNode, goalNode);
   startNode->totalCost           = startNode->estimatedCostToGoal;
 
-  openNodes_.insert(startNode);
+  addOpenNode(startNode);
 
   // process the list until we get to the goal or fail
-  while (! openNodes_.empty()) {
+  while (! openHeap_.empty()) {
     // remove node from open with lowest total cost
     Node *node = getBestOpenNode();
 
@@ -144,10 +239,10 @@ search(Node *startNode, Node *goalNode, NodeList &pathNodes)
     }
 
     // remove open node
-    openNodes_.erase(node);
+    removeOpenNode(node);
 
     // push node onto closed
-    closedNodes_.insert(node);
+    node->closed = true;
 
     // get successor nodes of this node
     NodeList nextNodes = getNextNodes(node);
@@ -157,6 +252,8 @@ search(Node *startNode, Node *goalNode, NodeList &pathNodes)
     for (pn1 = nextNodes.begin(), pn2 = nextNodes.end(); pn1 != pn2; ++pn1) {
       Node *nextNode = *pn1;
 
+      initNode(nextNode);
+
       // if closed then skip
       if (isClosedNode(nextNode))
         continue;
@@ -170,15 +267,15 @@ search(Node *startNode, Node *goalNode, NodeList &pathNodes)
       bool isBetter = (! isOpen || nextCost < nextNode->costFromStart);
 
       if (isBetter) {
-        if (isOpen)
-          openNodes_.erase(nextNode);
-
         nextNode->parent              = node;
         nextNode->costFromStart       = nextCost;
         nextNode->estimatedCostToGoal = pathCostEstimate(nextNode, goalNode);
         nextNode->totalCost           = nextNode->costFromStart + nextNode->estimatedCostToGoal;
 
-        openNodes_.insert(nextNode);
+        if (isOpen)
+          updateOpenNode(nextNode);
+        else
+          addOpenNode(nextNode);
       }
     }
   }
@@ -191,7 +288,7 @@ bool
 CAStar<Location>::
 isOpenNode(Node *node) const
 {
-  return openNodes_.find(node) != openNodes_.end();
+  return (node->searchId == searchId_ && node->heapInd >= 0);
 }
 
 template<typename Location>
@@ -199,7 +296,7 @@ bool
 CAStar<Location>::
 isClosedNode(Node *node) const
 {
-  return closedNodes_.find(node) != closedNodes_.end();
+  return (node->searchId == searchId_ && node->closed);
 }
 
 template<typename Location>
@@ -207,24 +304,148 @@ typename CAStar<Location>::Node *
 CAStar<Location>::
 getBestOpenNode()
 {
-  Node   *minNode = nullptr;
-  double  minCost = 0.0;
+  if (openHeap_.empty())
+    return nullptr;
 
-  typename NodeSet::iterator p1, p2;
+  //printNode(openHeap_[0]);
 
-  for (p1 = openNodes_.begin(), p2 = openNodes_.end(); p1 != p2; ++p1) {
-    Node   *node = *p1;
-    double  cost = node->totalCost;
+  return openHeap_[0];
+}
 
-    if (minNode == nullptr || cost < minCost) {
-      minNode = node;
-      minCost = cost;
-    }
+template<typename Location>
+void
+CAStar<Location>::
+initNode(Node *node) const
+{
+  if (node->searchId == searchId_)
+    return;
+
+  node->searchId = searchId_;
+  node->heapInd  = -1;
+  node->closed   = false;
+}
+
+template<typename Location>
+void
+CAStar<Location>::
+addOpenNode(Node *node)
+{
+  node->heapInd = int(openHeap_.size());
+
+  openHeap_.push_back(node);
+
+  siftUp(node->heapInd);
+}
+
+template<typename Location>
+void
+CAStar<Location>::
+removeOpenNode(Node *node)
+{
+  int i = node->heapInd;
+  assert(i >= 0 && openHeap_[size_t(i)] == node);
+
+  // move last node into removed slot and restore heap order
+  auto *lastNode = openHeap_.back();
+
+  openHeap_.pop_back();
+
+  node->heapInd = -1;
+
+  if (lastNode == node)
+    return;
+
+  openHeap_[size_t(i)] = lastNode;
+
+  lastNode->heapInd = i;
+
+  siftUp  (i);
+  siftDown(lastNode->heapInd);
+}
+
+template<typename Location>
+void
+CAStar<Location>::
+updateOpenNode(Node *node)
+{
+  // usually a decrease of cost so sift up, estimate could change so also sift down
+  siftUp  (node->heapInd);
+  siftDown(node->heapInd);
+}
+
+template<typename Location>
+bool
+CAStar<Location>::
+isBetterNode(const Node *node1, const Node *node2) const
+{
+  // lowest total cost, prefer furthest from start on tie
+  if (node1->totalCost != node2->totalCost)
+    return (node1->totalCost < node2->totalCost);
+
+  return (node1->costFromStart > node2->costFromStart);
+}
+
+template<typename Location>
+void
+CAStar<Location>::
+siftUp(int i)
+{
+  auto *node = openHeap_[size_t(i)];
+
+  while (i > 0) {
+    int i1 = (i - 1)/2;
+
+    auto *parentNode = openHeap_[size_t(i1)];
+
+    if (! isBetterNode(node, parentNode))
+      break;
+
+    openHeap_[size_t(i)] = parentNode;
+
+    parentNode->heapInd = i;
+
+    i = i1;
   }
 
-  //printNode(minNode);
+  openHeap_[size_t(i)] = node;
 
-  return minNode;
+  node->heapInd = i;
+}
+
+template<typename Location>
+void
+CAStar<Location>::
+siftDown(int i)
+{
+  int n = int(openHeap_.size());
+
+  auto *node = openHeap_[size_t(i)];
+
+  while (true) {
+    int i1 = 2*i + 1;
+
+    if (i1 >= n)
+      break;
+
+    // pick better child
+    if (i1 + 1 < n && isBetterNode(openHeap_[size_t(i1 + 1)], openHeap_[size_t(i1)]))
+      ++i1;
+
+    auto *childNode = openHeap_[size_t(i1)];
+
+    if (! isBetterNode(childNode, node))
+      break;
+
+    openHeap_[size_t(i)] = childNode;
+
+    childNode->heapInd = i;
+
+    i = i1;
+  }
+
+  openHeap_[size_t(i)] = node;
+
+  node->heapInd = i;
 }
 
 template<typename Location>
@@ -300,7 +521,7 @@ typename CAStar<Location>::Node *
 CAStar<Location>::
 lookupNode(const Location &loc) const
 {
-  typename NodeMap::iterator p = nodeMap_.find(loc);
+  auto p = nodeMap_.find(loc);
 
   if (p != nodeMap_.end())
     return (*p).second;
@@ -309,7 +530,7 @@ lookupNode(const Location &loc) const
 
   nodeMap_[loc] = node;
 
-  assert(nodeMap_.find(loc) != nodeMap_.end());
+  ownedNodes_.push_back(node);
 
   return node;
 }
@@ -322,6 +543,21 @@ createNode(const Location &loc) const
   return new Node(loc);
 }
 
+template<typename Location>
+void
+CAStar<Location>::
+clearNodes()
+{
+  nodeMap_.clear();
+
+  openHeap_.clear();
+
+  for (auto *node : ownedNodes_)
+    delete node;
+
+  ownedNodes_.clear();
+}
+
 template<typename Location>
 void
 CAStar<Location>::
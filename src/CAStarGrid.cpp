@@ -0,0 +1,604 @@
+#include <CAStarGrid.h>
+#include <CAStar.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <set>
+
+CAStarGrid::
+CAStarGrid(int nx, int ny)
+{
+  resize(nx, ny);
+}
+
+void
+CAStarGrid::
+resize(int nx, int ny)
+{
+  nx_ = std::max(nx, 0);
+  ny_ = std::max(ny, 0);
+
+  auto n = size_t(nx_)*size_t(ny_);
+
+  flags_.assign(n, 0);
+
+  costs_.clear();
+
+  searchIds_.assign(n, 0);
+
+  g_      .resize(n);
+  f_      .resize(n);
+  parent_ .resize(n);
+  heapInd_.resize(n);
+
+  heap_.clear();
+
+  searchId_ = 0;
+}
+
+void
+CAStarGrid::
+setBlocked(int x, int y, bool b)
+{
+  auto &flags = flags_[size_t(cellInd(x, y))];
+
+  if (b)
+    flags |= BLOCKED;
+  else
+    flags &= uint8_t(~BLOCKED);
+}
+
+double
+CAStarGrid::
+cost(int x, int y) const
+{
+  if (costs_.empty())
+    return 1.0;
+
+  return costs_[size_t(cellInd(x, y))];
+}
+
+void
+CAStarGrid::
+setCost(int x, int y, double c)
+{
+  // costs below 1 would make the distance estimate inadmissible
+  c = std::max(c, 1.0);
+
+  if (costs_.empty()) {
+    if (c == 1.0)
+      return;
+
+    costs_.assign(size_t(numCells()), 1.0f);
+  }
+
+  costs_[size_t(cellInd(x, y))] = float(c);
+}
+
+void
+CAStarGrid::
+setWall(int x, int y, Wall wall, bool b)
+{
+  auto setFlag = [&](int x1, int y1, Wall wall1) {
+    if (! isValid(x1, y1))
+      return;
+
+    auto &flags = flags_[size_t(cellInd(x1, y1))];
+
+    if (b)
+      flags |= wall1;
+    else
+      flags &= uint8_t(~wall1);
+  };
+
+  setFlag(x, y, wall);
+
+  switch (wall) {
+    case WALL_WEST : setFlag(x - 1, y, WALL_EAST ); break;
+    case WALL_EAST : setFlag(x + 1, y, WALL_WEST ); break;
+    case WALL_SOUTH: setFlag(x, y - 1, WALL_NORTH); break;
+    case WALL_NORTH: setFlag(x, y + 1, WALL_SOUTH); break;
+    default: break;
+  }
+}
+
+bool
+CAStarGrid::
+canMove(int x, int y, int dx, int dy) const
+{
+  if (! canEnter(x + dx, y + dy))
+    return false;
+
+  if (dx == 0 || dy == 0)
+    return canStep(x, y, dx, dy);
+
+  // diagonal move needs both orthogonal routes open (no corner cutting)
+  return (canEnter(x + dx, y) && canEnter(x, y + dy) &&
+          canStep(x, y, dx, 0) && canStep(x + dx, y, 0, dy) &&
+          canStep(x, y, 0, dy) && canStep(x, y + dy, dx, 0));
+}
+
+bool
+CAStarGrid::
+canStep(int x, int y, int dx, int dy) const
+{
+  auto walls = flags_[size_t(cellInd(x, y))] & WALLS;
+
+  if (! walls)
+    return true;
+
+  if      (dx < 0) return ! (walls & WALL_WEST );
+  else if (dx > 0) return ! (walls & WALL_EAST );
+  else if (dy < 0) return ! (walls & WALL_SOUTH);
+  else             return ! (walls & WALL_NORTH);
+}
+
+double
+CAStarGrid::
+estimate(int x1, int y1, int x2, int y2) const
+{
+  auto dx = std::abs(x2 - x1);
+  auto dy = std::abs(y2 - y1);
+
+  if (connect_ == Connect::FOUR)
+    return dx + dy;
+
+  // octile distance
+  return std::max(dx, dy) + (M_SQRT2 - 1.0)*std::min(dx, dy);
+}
+
+bool
+CAStarGrid::
+search(int x1, int y1, int x2, int y2, Cells &path)
+{
+  path.clear();
+
+  pathCost_    = 0.0;
+  numExpanded_ = 0;
+
+  if (! canEnter(x1, y1) || ! canEnter(x2, y2))
+    return false;
+
+  // new search id invalidates search state of all cells
+  if (++searchId_ == 0) {
+    std::fill(searchIds_.begin(), searchIds_.end(), 0);
+
+    searchId_ = 1;
+  }
+
+  heap_.clear();
+
+  int startInd = cellInd(x1, y1);
+  int goalInd  = cellInd(x2, y2);
+
+  visitCell(startInd, -1, 0.0, estimate(x1, y1, x2, y2));
+
+  static const int dirs[8][2] = {
+    { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 }, { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 } };
+
+  int numDirs = (connect_ == Connect::FOUR ? 4 : 8);
+
+  bool hasCosts = ! costs_.empty();
+
+  while (! heap_.empty()) {
+    // pop best open cell
+    int i = heap_[0];
+
+    if (i == goalInd) {
+      pathCost_ = g_[size_t(i)];
+
+      for (int i1 = i; i1 >= 0; i1 = parent_[size_t(i1)])
+        path.push_back(i1);
+
+      std::reverse(path.begin(), path.end());
+
+      return true;
+    }
+
+    heapInd_[size_t(i)] = CLOSED;
+
+    int lastInd = heap_.back();
+
+    heap_.pop_back();
+
+    if (! heap_.empty()) {
+      heap_[0] = lastInd;
+
+      heapInd_[size_t(lastInd)] = 0;
+
+      siftDown(0);
+    }
+
+    ++numExpanded_;
+
+    //---
+
+    int x = cellX(i);
+    int y = cellY(i);
+
+    double g = g_[size_t(i)];
+
+    for (int d = 0; d < numDirs; ++d) {
+      int dx = dirs[d][0];
+      int dy = dirs[d][1];
+
+      if (! canMove(x, y, dx, dy))
+        continue;
+
+      int x3 = x + dx;
+      int y3 = y + dy;
+      int i3 = cellInd(x3, y3);
+
+      bool visited = (searchIds_[size_t(i3)] == searchId_);
+
+      if (visited && heapInd_[size_t(i3)] == CLOSED)
+        continue;
+
+      double g3 = g + (d < 4 ? 1.0 : M_SQRT2)*(hasCosts ? costs_[size_t(i3)] : 1.0);
+
+      if (! visited) {
+        visitCell(i3, i, g3, estimate(x3, y3, x2, y2));
+      }
+      else if (g3 < g_[size_t(i3)]) {
+        // decrease key
+        f_[size_t(i3)] += g3 - g_[size_t(i3)];
+        g_[size_t(i3)]  = g3;
+
+        parent_[size_t(i3)] = i;
+
+        siftUp(heapInd_[size_t(i3)]);
+      }
+    }
+  }
+
+  return false;
+}
+
+void
+CAStarGrid::
+visitCell(int i, int parent, double g, double h)
+{
+  auto ii = size_t(i);
+
+  searchIds_[ii] = searchId_;
+  g_        [ii] = g;
+  f_        [ii] = g + h;
+  parent_   [ii] = parent;
+  heapInd_  [ii] = int(heap_.size());
+
+  heap_.push_back(i);
+
+  siftUp(heapInd_[ii]);
+}
+
+bool
+CAStarGrid::
+isBetterCell(int i1, int i2) const
+{
+  // lowest total cost, prefer furthest from start on tie
+  auto f1 = f_[size_t(i1)];
+  auto f2 = f_[size_t(i2)];
+
+  if (f1 != f2)
+    return (f1 < f2);
+
+  return (g_[size_t(i1)] > g_[size_t(i2)]);
+}
+
+void
+CAStarGrid::
+siftUp(int i)
+{
+  int cell = heap_[size_t(i)];
+
+  while (i > 0) {
+    int i1 = (i - 1)/2;
+
+    int parentCell = heap_[size_t(i1)];
+
+    if (! isBetterCell(cell, parentCell))
+      break;
+
+    heap_[size_t(i)] = parentCell;
+
+    heapInd_[size_t(parentCell)] = i;
+
+    i = i1;
+  }
+
+  heap_[size_t(i)] = cell;
+
+  heapInd_[size_t(cell)] = i;
+}
+
+void
+CAStarGrid::
+siftDown(int i)
+{
+  int n = int(heap_.size());
+
+  int cell = heap_[size_t(i)];
+
+  while (true) {
+    int i1 = 2*i + 1;
+
+    if (i1 >= n)
+      break;
+
+    // pick better child
+    if (i1 + 1 < n && isBetterCell(heap_[size_t(i1 + 1)], heap_[size_t(i1)]))
+      ++i1;
+
+    int childCell = heap_[size_t(i1)];
+
+    if (! isBetterCell(childCell, cell))
+      break;
+
+    heap_[size_t(i)] = childCell;
+
+    heapInd_[size_t(childCell)] = i;
+
+    i = i1;
+  }
+
+  heap_[size_t(i)] = cell;
+
+  heapInd_[size_t(cell)] = i;
+}
+
+//---
+
+namespace {
+
+// generic A* on grid using cell index as (hashed) location
+class CAStarGridSearch : public CAStar<int> {
+ public:
+  CAStarGridSearch(const CAStarGrid &grid) :
+   grid_(grid) {
+  }
+
+  double pathCostEstimate(const int &loc1, const int &loc2) override {
+    return std::abs(grid_.cellX(loc2) - grid_.cellX(loc1)) +
+           std::abs(grid_.cellY(loc2) - grid_.cellY(loc1));
+  }
+
+  double traverseCost(const int &, const int &loc2) override {
+    return grid_.cost(grid_.cellX(loc2), grid_.cellY(loc2));
+  }
+
+  LocationList getNextLocations(Node *node) const override {
+    static const int dirs[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+
+    LocationList locs;
+
+    int x = grid_.cellX(node->loc);
+    int y = grid_.cellY(node->loc);
+
+    for (int d = 0; d < 4; ++d) {
+      if (grid_.canMove(x, y, dirs[d][0], dirs[d][1]))
+        locs.push_back(grid_.cellInd(x + dirs[d][0], y + dirs[d][1]));
+    }
+
+    return locs;
+  }
+
+ private:
+  const CAStarGrid &grid_;
+};
+
+// previous generic A* (std::map node lookup, std::set open/closed sets and linear scan
+// of open set for best node) for comparison
+double
+legacySearch(const CAStarGrid &grid, int startInd, int goalInd)
+{
+  struct Node {
+    int    ind           { 0 };
+    Node*  parent        { nullptr };
+    double costFromStart { 0.0 };
+    double totalCost     { 0.0 };
+
+    Node(int i) : ind(i) { }
+  };
+
+  using NodeP = std::unique_ptr<Node>;
+
+  std::map<int, NodeP> nodeMap;
+  std::set<Node *>     openNodes, closedNodes;
+
+  auto lookupNode = [&](int ind) {
+    auto &node = nodeMap[ind];
+
+    if (! node)
+      node = std::make_unique<Node>(ind);
+
+    return node.get();
+  };
+
+  auto estimate = [&](int ind1, int ind2) {
+    return double(std::abs(grid.cellX(ind2) - grid.cellX(ind1)) +
+                  std::abs(grid.cellY(ind2) - grid.cellY(ind1)));
+  };
+
+  auto *startNode = lookupNode(startInd);
+  auto *goalNode  = lookupNode(goalInd);
+
+  startNode->totalCost = estimate(startInd, goalInd);
+
+  openNodes.insert(startNode);
+
+  static const int dirs[4][2] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+
+  while (! openNodes.empty()) {
+    Node *node = nullptr;
+
+    for (auto *node1 : openNodes) {
+      if (! node || node1->totalCost < node->totalCost)
+        node = node1;
+    }
+
+    if (node == goalNode)
+      return node->costFromStart;
+
+    openNodes.erase(node);
+
+    closedNodes.insert(node);
+
+    int x = grid.cellX(node->ind);
+    int y = grid.cellY(node->ind);
+
+    for (int d = 0; d < 4; ++d) {
+      if (! grid.canMove(x, y, dirs[d][0], dirs[d][1]))
+        continue;
+
+      int x1 = x + dirs[d][0];
+      int y1 = y + dirs[d][1];
+
+      auto *nextNode = lookupNode(grid.cellInd(x1, y1));
+
+      if (closedNodes.find(nextNode) != closedNodes.end())
+        continue;
+
+      double nextCost = node->costFromStart + grid.cost(x1, y1);
+
+      bool isOpen = (openNodes.find(nextNode) != openNodes.end());
+
+      if (! isOpen || nextCost < nextNode->costFromStart) {
+        if (isOpen)
+          openNodes.erase(nextNode);
+
+        nextNode->parent        = node;
+        nextNode->costFromStart = nextCost;
+        nextNode->totalCost     = nextCost + estimate(nextNode->ind, goalInd);
+
+        openNodes.insert(nextNode);
+      }
+    }
+  }
+
+  return -1.0;
+}
+
+}
+
+std::string
+CAStarGrid::
+benchmark(int size, int numQueries)
+{
+  using Clock = std::chrono::steady_clock;
+
+  size       = std::max(size, 2);
+  numQueries = std::max(numQueries, 1);
+
+  // legacy search is O(open set) per expansion so only run it on smaller grids
+  int legacySize = std::min(size, 256);
+
+  // random grid with 25% blocked cells (fixed seed)
+  uint64_t rand = 1;
+
+  auto randInt = [&](int n) {
+    rand = rand*6364136223846793005ULL + 1442695040888963407ULL;
+
+    return int((rand >> 33) % uint64_t(n));
+  };
+
+  auto msecs = [](const Clock::time_point &t1) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t1).count();
+  };
+
+  char buffer[256];
+
+  std::string str;
+
+  for (int n : { legacySize, size }) {
+    if (n == legacySize && ! str.empty())
+      break;
+
+    CAStarGrid grid(n, n);
+
+    for (int y = 0; y < n; ++y)
+      for (int x = 0; x < n; ++x)
+        grid.setBlocked(x, y, randInt(4) == 0);
+
+    // queries between random open cells in opposite corners
+    std::vector<int> queries;
+
+    for (int i = 0; i < numQueries; ++i) {
+      int x1 = randInt(n/4), y1 = randInt(n/4);
+      int x2 = n - 1 - randInt(n/4), y2 = n - 1 - randInt(n/4);
+
+      grid.setBlocked(x1, y1, false);
+      grid.setBlocked(x2, y2, false);
+
+      queries.push_back(grid.cellInd(x1, y1));
+      queries.push_back(grid.cellInd(x2, y2));
+    }
+
+    // grid search
+    std::vector<double> costs;
+
+    Cells path;
+
+    auto t = Clock::now();
+
+    for (int i = 0; i < numQueries; ++i) {
+      int i1 = queries[size_t(2*i)], i2 = queries[size_t(2*i + 1)];
+
+      bool found = grid.search(grid.cellX(i1), grid.cellY(i1), grid.cellX(i2), grid.cellY(i2), path);
+
+      costs.push_back(found ? grid.pathCost() : -1.0);
+    }
+
+    auto gridTime = msecs(t);
+
+    // generic search (heap open set, hashed nodes)
+    bool same = true;
+
+    auto nodeCost = [](const std::list<CAStar<int>::Node *> &nodes) {
+      return (! nodes.empty() ? nodes.back()->costFromStart : -1.0);
+    };
+
+    CAStarGridSearch heapSearch(grid);
+
+    t = Clock::now();
+
+    for (int i = 0; i < numQueries; ++i) {
+      CAStarGridSearch::NodeList nodes;
+
+      heapSearch.search(queries[size_t(2*i)], queries[size_t(2*i + 1)], nodes);
+
+      if (nodeCost(nodes) != costs[size_t(i)])
+        same = false;
+    }
+
+    auto heapTime = msecs(t);
+
+    snprintf(buffer, sizeof(buffer), "%ssize %d queries %d grid %.2fms heap %.2fms",
+             str.empty() ? "" : " ", n, numQueries, gridTime/numQueries, heapTime/numQueries);
+
+    str += buffer;
+
+    // legacy search
+    if (n == legacySize) {
+      t = Clock::now();
+
+      for (int i = 0; i < numQueries; ++i) {
+        if (legacySearch(grid, queries[size_t(2*i)], queries[size_t(2*i + 1)]) != costs[size_t(i)])
+          same = false;
+      }
+
+      auto legacyTime = msecs(t);
+
+      snprintf(buffer, sizeof(buffer), " legacy %.2fms", legacyTime/numQueries);
+
+      str += buffer;
+    }
+
+    str += (same ? " optimal 1" : " optimal 0");
+  }
+
+  return str;
+}
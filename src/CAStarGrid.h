@@ -0,0 +1,132 @@
+#ifndef CASTAR_GRID_H
+#define CASTAR_GRID_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// A* search specialized for a 2D grid of cells
+//
+// all per cell data (flags, costs, search state) is stored in flat arrays indexed by
+// cell (y*nx + x) and the open set is an indexed binary heap of cell indices, so a
+// search does no allocation once the grid has been sized.
+//
+// cells can be blocked, have a cost to enter (>= 1) and have walls on any edge (to
+// model rooms with doors). Moves are either 4 way or 8 way (diagonal moves are not
+// allowed to cut corners). y increases to the north.
+class CAStarGrid {
+ public:
+  enum class Connect {
+    FOUR,
+    EIGHT
+  };
+
+  enum Wall : uint8_t {
+    WALL_WEST  = (1<<0),
+    WALL_EAST  = (1<<1),
+    WALL_SOUTH = (1<<2),
+    WALL_NORTH = (1<<3)
+  };
+
+  using Cells = std::vector<int>;
+
+ public:
+  CAStarGrid(int nx=0, int ny=0);
+
+  // get/set size (resizing clears blocked cells, costs and walls)
+  int nx() const { return nx_; }
+  int ny() const { return ny_; }
+
+  void resize(int nx, int ny);
+
+  int numCells() const { return nx_*ny_; }
+
+  // get/set connectivity
+  const Connect &connect() const { return connect_; }
+  void setConnect(const Connect &c) { connect_ = c; }
+
+  // convert between cell coords and index
+  int cellInd(int x, int y) const { return y*nx_ + x; }
+
+  int cellX(int i) const { return i % nx_; }
+  int cellY(int i) const { return i / nx_; }
+
+  bool isValid(int x, int y) const { return (x >= 0 && x < nx_ && y >= 0 && y < ny_); }
+
+  // get/set cell blocked
+  bool isBlocked(int x, int y) const { return (flags_[size_t(cellInd(x, y))] & BLOCKED); }
+  void setBlocked(int x, int y, bool b);
+
+  // get/set cost to enter cell
+  double cost(int x, int y) const;
+  void setCost(int x, int y, double c);
+
+  // get/set cell walls (set also updates matching wall of neighbour)
+  uint walls(int x, int y) const { return flags_[size_t(cellInd(x, y))] & WALLS; }
+  void setWall(int x, int y, Wall wall, bool b);
+
+  // can move from cell in direction (dx, dy)
+  bool canMove(int x, int y, int dx, int dy) const;
+
+  // search for lowest cost path from start to goal (path is list of cell indices
+  // from start to goal inclusive)
+  bool search(int x1, int y1, int x2, int y2, Cells &path);
+
+  // cost of last path found
+  double pathCost() const { return pathCost_; }
+
+  // number of cells expanded by last search
+  uint numExpanded() const { return numExpanded_; }
+
+  // compare grid search to generic (CAStar) searches on random grids
+  static std::string benchmark(int size, int numQueries);
+
+ private:
+  enum Flags : uint8_t {
+    WALLS   = (WALL_WEST | WALL_EAST | WALL_SOUTH | WALL_NORTH),
+    BLOCKED = (1<<4)
+  };
+
+  enum { NOT_OPEN = -1, CLOSED = -2 };
+
+  bool canEnter(int x, int y) const {
+    return isValid(x, y) && ! (flags_[size_t(cellInd(x, y))] & BLOCKED);
+  }
+
+  bool canStep(int x, int y, int dx, int dy) const;
+
+  double estimate(int x1, int y1, int x2, int y2) const;
+
+  void visitCell(int i, int parent, double g, double h);
+
+  bool isBetterCell(int i1, int i2) const;
+
+  void siftUp  (int i);
+  void siftDown(int i);
+
+ private:
+  using Flags8   = std::vector<uint8_t>;
+  using Costs    = std::vector<float>;
+  using Values   = std::vector<double>;
+  using Inds     = std::vector<int>;
+  using SearchId = std::vector<uint>;
+
+  int     nx_      { 0 };
+  int     ny_      { 0 };
+  Connect connect_ { Connect::FOUR };
+  Flags8  flags_;              // blocked and wall flags per cell
+  Costs   costs_;              // cost to enter per cell (empty if all 1)
+
+  // search state per cell (valid if searchIds_ matches searchId_)
+  SearchId searchIds_;
+  Values   g_;                 // cost from start
+  Values   f_;                 // cost from start + estimate to goal
+  Inds     parent_;            // parent cell
+  Inds     heapInd_;           // index in heap, NOT_OPEN or CLOSED
+  Inds     heap_;              // open cells (binary heap on f_)
+  uint     searchId_    { 0 };
+  uint     numExpanded_ { 0 };
+  double   pathCost_    { 0.0 };
+};
+
+#endif
@@ -0,0 +1,233 @@
+#ifndef CBarnesHut3D_H
+#define CBarnesHut3D_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+// Barnes-Hut octree for approximating sums of pairwise (inverse distance) forces
+//
+// the tree is built once per step from weighted bodies. Each cell stores the total
+// weight and weighted center of its bodies. A query sums a kernel over all bodies
+// and replaces a cell by a single body at its center when the cell size divided
+// by the distance to the center is less than theta (0 gives the exact sum).
+//
+// KERNEL is called as kernel(dx, dy, dz, w, fx, fy, fz) where (dx, dy, dz) is the
+// query point minus the body (or cell center) position and w is the body (or cell)
+// weight. It should add the resulting force to (fx, fy, fz).
+class CBarnesHut3D {
+ public:
+  CBarnesHut3D() { }
+
+  double theta() const { return theta_; }
+  void setTheta(double r) { theta_ = std::max(r, 0.0); }
+
+  size_t numBodies() const { return x_.size(); }
+  size_t numCells () const { return cells_.size(); }
+
+  void clear() {
+    x_.clear(); y_.clear(); z_.clear(); w_.clear();
+
+    cells_.clear();
+    inds_ .clear();
+  }
+
+  void addBody(double x, double y, double z, double w=1.0) {
+    x_.push_back(x); y_.push_back(y); z_.push_back(z); w_.push_back(w);
+  }
+
+  // build tree from added bodies
+  void build() {
+    cells_.clear();
+
+    auto n = x_.size();
+
+    inds_.resize(n);
+
+    for (size_t i = 0; i < n; ++i)
+      inds_[i] = i;
+
+    if (n == 0)
+      return;
+
+    // cubic bounding box
+    auto xmin = *std::min_element(x_.begin(), x_.end());
+    auto ymin = *std::min_element(y_.begin(), y_.end());
+    auto zmin = *std::min_element(z_.begin(), z_.end());
+    auto xmax = *std::max_element(x_.begin(), x_.end());
+    auto ymax = *std::max_element(y_.begin(), y_.end());
+    auto zmax = *std::max_element(z_.begin(), z_.end());
+
+    auto half = std::max(std::max(xmax - xmin, ymax - ymin), zmax - zmin)/2.0;
+
+    if (half <= 0.0)
+      half = 1.0;
+
+    cells_.reserve(2*n);
+
+    (void) buildCell((xmin + xmax)/2.0, (ymin + ymax)/2.0, (zmin + zmax)/2.0,
+                     half*1.0001, 0, n, 0);
+  }
+
+  // sum kernel for point (x, y, z) over all bodies excluding body self
+  template<typename KERNEL>
+  void accumulate(double x, double y, double z, size_t self, KERNEL kernel,
+                  double &fx, double &fy, double &fz) const {
+    if (cells_.empty())
+      return;
+
+    double theta2 = theta_*theta_;
+
+    int    stack[MAX_DEPTH*8 + 8];
+    size_t ns = 0;
+
+    stack[ns++] = 0;
+
+    while (ns > 0) {
+      const auto &cell = cells_[size_t(stack[--ns])];
+
+      if (cell.leaf) {
+        for (auto i = cell.begin; i < cell.end; ++i) {
+          auto ib = inds_[i];
+
+          if (ib == self)
+            continue;
+
+          kernel(x - x_[ib], y - y_[ib], z - z_[ib], w_[ib], fx, fy, fz);
+        }
+
+        continue;
+      }
+
+      auto dx = x - cell.cx;
+      auto dy = y - cell.cy;
+      auto dz = z - cell.cz;
+
+      auto r2   = dx*dx + dy*dy + dz*dz;
+      auto size = 2.0*cell.half;
+
+      if (size*size < theta2*r2) {
+        kernel(dx, dy, dz, cell.w, fx, fy, fz);
+        continue;
+      }
+
+      for (int i = 0; i < 8; ++i) {
+        if (cell.children[i] >= 0)
+          stack[ns++] = cell.children[i];
+      }
+    }
+  }
+
+ private:
+  enum { MAX_DEPTH = 32, LEAF_SIZE = 4 };
+
+  struct Cell {
+    double cx { 0.0 }, cy { 0.0 }, cz { 0.0 }; // weighted center
+    double w  { 0.0 };                         // total weight
+    double half { 0.0 };                       // half width of cube
+    size_t begin { 0 }, end { 0 };             // body range (inds_)
+    int    children[8] { -1, -1, -1, -1, -1, -1, -1, -1 };
+    bool   leaf { true };
+  };
+
+  int buildCell(double xc, double yc, double zc, double half,
+                size_t begin, size_t end, int depth) {
+    auto ic = int(cells_.size());
+
+    cells_.emplace_back();
+
+    {
+    auto &cell = cells_.back();
+
+    cell.half  = half;
+    cell.begin = begin;
+    cell.end   = end;
+
+    double w = 0.0, cx = 0.0, cy = 0.0, cz = 0.0;
+
+    for (auto i = begin; i < end; ++i) {
+      auto ib = inds_[i];
+
+      w  += w_[ib];
+      cx += w_[ib]*x_[ib];
+      cy += w_[ib]*y_[ib];
+      cz += w_[ib]*z_[ib];
+    }
+
+    if (w != 0.0) {
+      cx /= w; cy /= w; cz /= w;
+    }
+    else {
+      cx = xc; cy = yc; cz = zc;
+    }
+
+    cell.w  = w;
+    cell.cx = cx;
+    cell.cy = cy;
+    cell.cz = cz;
+
+    if (end - begin <= LEAF_SIZE || depth >= MAX_DEPTH)
+      return ic;
+
+    cell.leaf = false;
+    }
+
+    // partition bodies into octants (counting sort on octant index)
+    auto octant = [&](size_t ib) {
+      return (x_[ib] >= xc ? 1 : 0) | (y_[ib] >= yc ? 2 : 0) | (z_[ib] >= zc ? 4 : 0);
+    };
+
+    size_t counts[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    for (auto i = begin; i < end; ++i)
+      ++counts[octant(inds_[i])];
+
+    size_t starts[9];
+
+    starts[0] = begin;
+
+    for (int i = 0; i < 8; ++i)
+      starts[i + 1] = starts[i] + counts[i];
+
+    tmpInds_.assign(inds_.begin() + long(begin), inds_.begin() + long(end));
+
+    size_t pos[8];
+
+    for (int i = 0; i < 8; ++i)
+      pos[i] = starts[i];
+
+    for (auto ib : tmpInds_)
+      inds_[pos[octant(ib)]++] = ib;
+
+    auto half1 = half/2.0;
+
+    for (int i = 0; i < 8; ++i) {
+      if (counts[i] == 0)
+        continue;
+
+      auto xc1 = xc + ((i & 1) ? half1 : -half1);
+      auto yc1 = yc + ((i & 2) ? half1 : -half1);
+      auto zc1 = zc + ((i & 4) ? half1 : -half1);
+
+      auto child = buildCell(xc1, yc1, zc1, half1, starts[i], starts[i + 1], depth + 1);
+
+      cells_[size_t(ic)].children[i] = child;
+    }
+
+    return ic;
+  }
+
+ private:
+  using Reals = std::vector<double>;
+  using Cells = std::vector<Cell>;
+  using Inds  = std::vector<size_t>;
+
+  double theta_ { 0.7 };
+  Reals  x_, y_, z_, w_;
+  Cells  cells_;
+  Inds   inds_;
+  Inds   tmpInds_;
+};
+
+#endif
@@ -2,6 +2,9 @@
 #include <CGeometry3D.h>
 #include <CGeomPyramid3D.h>
 
+#include <algorithm>
+#include <limits>
+
 #ifdef USE_CPROFILE
 #include <CProfile.h>
 #else
@@ -10,10 +13,13 @@
 
 #define VOIDP(P) static_cast<void *>(P)
 
-CBoid *CBoid::VisibleFriendsList[] = { nullptr };
+thread_local const CBoid::Entry *CBoid::VisibleFriendsList[] = { nullptr };
+
+thread_local CBoid::BoidDists CBoid::SeenList;
+thread_local CBoid::BoidDists CBoid::EnemyList;
 
 CBoid::
-CBoid(short id_v)
+CBoid(int id_v)
 {
 #ifdef BOID_DEBUG
   printf("\nCBoid constructor #1 called for boid %d.\n", id_v);
@@ -39,6 +45,8 @@ CBoid(short id_v)
 
   speed_ = vel_.length();
 
+  rand_ = uint64_t(CFlockingUtil::RAND()*double(RAND_MAX)) ^ (uint64_t(id_) << 32);
+
   imatrix_.setIdentity();
 
 #ifdef BOID_DEBUG
@@ -47,7 +55,7 @@ CBoid(short id_v)
 }
 
 CBoid::
-CBoid(short id_v, CVector3D *pos_v, CVector3D *vel_v, CVector3D *ang_v)
+CBoid(int id_v, CVector3D *pos_v, CVector3D *vel_v, CVector3D *ang_v)
 {
 #ifdef BOID_DEBUG
   printf("\nCBoid constructor #2 called for boid %d.\n", id_v);
@@ -61,6 +69,8 @@ CBoid(short id_v, CVector3D *pos_v, CVector3D *vel_v, CVector3D *ang_v)
 
   speed_ = vel_.length();
 
+  rand_ = uint64_t(id_) << 32;
+
   imatrix_.setIdentity();
 
 #ifdef BOID_DEBUG
@@ -92,6 +102,8 @@ FlockIt(CFlock *flock, double deltaTime)
 
   pos_ += vel_*deltaTime;
 
+  ScanNeighbours(flock);
+
   SeeFriends(flock);
 
   {
@@ -174,7 +186,7 @@ Cruising()
   if (urgency < CFlockingUtil::MinUrgency) urgency = CFlockingUtil::MinUrgency;
   if (urgency > CFlockingUtil::MaxUrgency) urgency = CFlockingUtil::MaxUrgency;
 
-  double jitter = CFlockingUtil::RAND();
+  double jitter = Rand();
 
   if      (jitter < 0.45)
     change.incX(CFlockingUtil::MinUrgency * CFlockingUtil::SIGN(diff));
@@ -213,7 +225,7 @@ FleeEnemies()
     printf("   too close to %p\n", VOIDP(nearest_enemy_));
 #endif
 
-    change = pos_ - nearest_enemy_->pos_;
+    change = pos_ - nearest_enemy_->pos();
   }
 
 #ifdef BOID_DEBUG
@@ -230,7 +242,7 @@ KeepDistance()
 {
   double ratio = dist_to_nearest_flockmate_/CFlockingUtil::SeparationDist;
 
-  CVector3D change = nearest_flockmate_->pos_ - pos_;
+  CVector3D change = nearest_flockmate_->pos() - pos_;
 
 #ifdef BOID_DEBUG
   printf("\nInside KeepDistance\n");
@@ -278,7 +290,7 @@ CVector3D
 CBoid::
 MatchHeading()
 {
-  CVector3D change = nearest_flockmate_->vel_;
+  CVector3D change = nearest_flockmate_->vel();
 
 #ifdef BOID_DEBUG
   printf("\nInside MatchHeading\n");
@@ -296,12 +308,10 @@ MatchHeading()
 
 int
 CBoid::
-SeeEnemies(CFlock *flock)
+SeeEnemies(CFlock *)
 {
   CPROFILE("See Enemies");
 
-  double dist;
-
 #ifdef BOID_DEBUG
   printf("\nInside SeeEnemies\n");
 #endif
@@ -310,30 +320,17 @@ SeeEnemies(CFlock *flock)
   nearest_enemy_         = nullptr;
   dist_to_nearest_enemy_ = CFlockingUtil::MY_INFINITY;
 
-  uint num_flocks = CFlock::getNumFlocks();
-
-  for (uint i = 0; i < num_flocks; i++) {
-    if (flock->getId() == i) continue;
-
-#ifdef VISIBILITY_DEBUG
-    printf("   Testing to see if %p can see anybody in flock %d\n", VOIDP(this), i);
-#endif
-
-    auto *flock1 = CFlock::getFlock(int(i));
-
-    for (auto *boid : flock1->getBoids()) {
-#ifdef VISIBILITY_DEBUG
-      printf("   looking at %p\n", VOIDP(boid));
-#endif
+  // enemies found by ScanNeighbours (ties go to lowest index so result does not
+  // depend on scan order)
+  for (const auto &seen : EnemyList) {
+    auto *boid = seen.first;
 
-      if ((dist = CanISee(boid)) != CFlockingUtil::MY_INFINITY) {
-        ++num_enemies_seen_;
+    ++num_enemies_seen_;
 
-        if (dist < dist_to_nearest_enemy_) {
-          dist_to_nearest_enemy_ = dist;
-          nearest_enemy_         = boid;
-        }
-      }
+    if (seen.second < dist_to_nearest_enemy_ ||
+        (seen.second == dist_to_nearest_enemy_ && boid->ind < nearest_enemy_->ind)) {
+      dist_to_nearest_enemy_ = seen.second;
+      nearest_enemy_         = boid;
     }
   }
 
@@ -348,12 +345,10 @@ SeeEnemies(CFlock *flock)
 
 int
 CBoid::
-SeeFriends(CFlock *flock)
+SeeFriends(CFlock *)
 {
   CPROFILE("See Friends");
 
-  double dist;
-
 #ifdef BOID_DEBUG
   printf("\nInside SeeFriends\n");
 #endif
@@ -364,18 +359,18 @@ SeeFriends(CFlock *flock)
 
   ClearVisibleList();
 
-  for (auto *boid : flock->getBoids()) {
-#ifdef VISIBILITY_DEBUG
-    printf("   looking at %p\n", boid);
-#endif
+  // process flockmates found by ScanNeighbours in flock order (visible list only
+  // keeps first Max_Friends_Visible)
+  std::sort(SeenList.begin(), SeenList.end(), [](const BoidDist &lhs, const BoidDist &rhs) {
+    return lhs.first->ind < rhs.first->ind;
+  });
 
-    if ((dist = CanISee(boid)) != CFlockingUtil::MY_INFINITY) {
-      AddToVisibleList(boid);
+  for (const auto &seen : SeenList) {
+    AddToVisibleList(seen.first);
 
-      if (dist < dist_to_nearest_flockmate_) {
-        dist_to_nearest_flockmate_ = dist;
-        nearest_flockmate_         = boid;
-      }
+    if (seen.second < dist_to_nearest_flockmate_) {
+      dist_to_nearest_flockmate_ = seen.second;
+      nearest_flockmate_         = seen.first;
     }
   }
 
@@ -388,6 +383,42 @@ SeeFriends(CFlock *flock)
   return num_flockmates_seen_;
 }
 
+// find visible friends and enemies in neighbouring grid cells (single scan
+// used by SeeFriends and SeeEnemies)
+void
+CBoid::
+ScanNeighbours(CFlock *flock)
+{
+  CPROFILE("Scan Neighbours");
+
+  SeenList .clear();
+  EnemyList.clear();
+
+  int range = (CFlockingUtil::UseTruth ? std::numeric_limits<int>::max()/2 : 1);
+
+  CFlock::getGrid().visit(pos_, range, [&](const Entry &entry) {
+    bool isFriend = (entry.flock == flock);
+
+    if (! isFriend && ! CFlockingUtil::ReactToEnemies) return;
+
+    if (! isNear(entry)) return;
+
+#ifdef VISIBILITY_DEBUG
+    printf("   looking at %p\n", VOIDP(entry.boid));
+#endif
+
+    double dist = CanISee(entry);
+
+    if (dist == CFlockingUtil::MY_INFINITY)
+      return;
+
+    if (isFriend)
+      SeenList.push_back(BoidDist(&entry, dist));
+    else
+      EnemyList.push_back(BoidDist(&entry, dist));
+  });
+}
+
 CVector3D
 CBoid::
 SteerToCenter()
@@ -400,7 +431,7 @@ SteerToCenter()
 
   for (int i = 0; i < num_flockmates_seen_; i++) {
     if (VisibleFriendsList[i])
-      center += VisibleFriendsList[i]->pos_;
+      center += VisibleFriendsList[i]->pos();
   }
 
 #ifdef BOID_DEBUG
@@ -473,7 +504,7 @@ AccumulateChanges(CVector3D &accumulator, CVector3D changes)
 
 void
 CBoid::
-AddToVisibleList(CBoid *ptr)
+AddToVisibleList(const Entry *ptr)
 {
   if (num_flockmates_seen_ < CFlockingUtil::Max_Friends_Visible) {
     VisibleFriendsList[num_flockmates_seen_] = ptr;
@@ -509,18 +540,18 @@ ClearVisibleList()
 
 double
 CBoid::
-CanISee(CBoid *ptr)
+CanISee(const Entry &entry)
 {
 #ifdef VISIBILITY_DEBUG
   printf("\n   Inside CanISee.\n");
 #endif
 
-  if (this == ptr) return CFlockingUtil::MY_INFINITY;
+  if (this == entry.boid) return CFlockingUtil::MY_INFINITY;
 
-  double dist = (pos_ - ptr->pos_).length();
+  double dist = (pos_ - entry.pos()).length();
 
 #ifdef VISIBILITY_DEBUG
-  printf("   dist between %p and %p = %lf\n", this, ptr, dist);
+  printf("   dist between %p and %p = %lf\n", VOIDP(this), VOIDP(entry.boid), dist);
 #endif
 
   if (CFlockingUtil::UseTruth) return dist;
@@ -530,6 +561,37 @@ CanISee(CBoid *ptr)
   return CFlockingUtil::MY_INFINITY;
 }
 
+// quick reject of grid entry which is outside perception range
+bool
+CBoid::
+isNear(const Entry &entry) const
+{
+  if (CFlockingUtil::UseTruth) return true;
+
+  double dx = pos_.getX() - entry.x;
+  double dy = pos_.getY() - entry.y;
+  double dz = pos_.getZ() - entry.z;
+
+  // slightly larger than range so CanISee makes final decision
+  double r = perception_range_*1.0001;
+
+  return (dx*dx + dy*dy + dz*dz < r*r);
+}
+
+// per boid random number in [0, 1] (splitmix64) so results don't depend on update order
+double
+CBoid::
+Rand()
+{
+  auto z = (rand_ += 0x9e3779b97f4a7c15ULL);
+
+  z = (z ^ (z >> 30))*0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27))*0x94d049bb133111ebULL;
+  z =  z ^ (z >> 31);
+
+  return double(z >> 11)/double((1ULL << 53) - 1);
+}
+
 void
 CBoid::
 ComputeRPY()
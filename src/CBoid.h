@@ -2,27 +2,36 @@
 #define CBOID_H
 
 #include <CFlockingUtil.h>
+#include <CFlockGrid.h>
 #include <CVector3D.h>
 #include <CMatrix3D.h>
 
+#include <vector>
+#include <cstdint>
+
 class CFlock;
 class CGeomObject3D;
 
 class CBoid {
  public:
-  CBoid(short id_v);
-  CBoid(short id_v, CVector3D *pos_v, CVector3D *vel_v, CVector3D *ang_v);
+  CBoid(int id_v);
+  CBoid(int id_v, CVector3D *pos_v, CVector3D *vel_v, CVector3D *ang_v);
 
  ~CBoid();
 
   CFlock *getFlock() const { return flock_; }
   void setFlock(CFlock *flock) { flock_ = flock; }
 
-  short getId() const { return id_; }
+  int getId() const { return id_; }
+
+  // index in flock order (set by CFlock::updateGrid)
+  int getInd() const { return ind_; }
+  void setInd(int ind) { ind_ = ind; }
 
+  // update from previous step state of other boids (CFlock::getGrid)
   void FlockIt(CFlock *flock, double deltaTime);
 
-  void AddToVisibleList(CBoid *ptr);
+  void AddToVisibleList(const CFlockGrid::Entry *ptr);
 
   void ClearVisibleList();
 
@@ -49,34 +58,49 @@ class CBoid {
 
   int SeeFriends(CFlock *flock);
 
+  void ScanNeighbours(CFlock *flock);
+
   CVector3D SteerToCenter();
 
   void WorldBound();
 
   double AccumulateChanges(CVector3D &accumulator, CVector3D changes);
 
-  double CanISee(CBoid *ptr);
+  double CanISee(const CFlockGrid::Entry &entry);
+
+  bool isNear(const CFlockGrid::Entry &entry) const;
 
   void ComputeRPY();
 
+  double Rand();
+
  private:
-  static CBoid *VisibleFriendsList[CFlockingUtil::Max_Friends_Visible];
+  using Entry     = CFlockGrid::Entry;
+  using BoidDist  = std::pair<const Entry *, double>;
+  using BoidDists = std::vector<BoidDist>;
+
+  // per thread work lists
+  static thread_local const Entry *VisibleFriendsList[CFlockingUtil::Max_Friends_Visible];
+  static thread_local BoidDists    SeenList;
+  static thread_local BoidDists    EnemyList;
 
   CFlock *  flock_ { nullptr };
-  short     id_ { 0 };
+  int       id_ { 0 };
+  int       ind_ { 0 };
   double    perception_range_ { CFlockingUtil::Default_Perception_Range };
   CVector3D pos_;
   CVector3D vel_;
   CVector3D ang_;
   double    speed_ { 0.0 };
+  uint64_t  rand_ { 0 };
 
-  short  num_flockmates_seen_       { 0 };
-  CBoid* nearest_flockmate_         { nullptr };
-  double dist_to_nearest_flockmate_ { CFlockingUtil::MY_INFINITY };
+  short        num_flockmates_seen_       { 0 };
+  const Entry* nearest_flockmate_         { nullptr };
+  double       dist_to_nearest_flockmate_ { CFlockingUtil::MY_INFINITY };
 
-  short  num_enemies_seen_      { 0 };
-  CBoid* nearest_enemy_         { nullptr };
-  double dist_to_nearest_enemy_ { CFlockingUtil::MY_INFINITY };
+  short        num_enemies_seen_      { 0 };
+  const Entry* nearest_enemy_         { nullptr };
+  double       dist_to_nearest_enemy_ { CFlockingUtil::MY_INFINITY };
 
   CVector3D oldpos_;
   CVector3D oldvel_;
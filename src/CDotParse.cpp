@@ -1,9 +1,8 @@
 #include <CDotParse.h>
+#include <CDotParseCSR.h>
 #include <CFileParse.h>
-#include <CAStarNode.h>
 #include <CStrUtil.h>
 
-#include <list>
 #include <cassert>
 
 namespace CDotParse {
@@ -838,6 +837,8 @@ addNode(NodeP node)
   assert(p == nodes_.end());
 
   nodes_[node->name()] = node;
+
+  resetCSR();
 }
 
 EdgeP
@@ -852,6 +853,8 @@ Graph::
 addEdge(EdgeP edge)
 {
   edges_.insert(edge);
+
+  resetCSR();
 }
 
 void
@@ -862,6 +865,8 @@ removeEdge(EdgeP edge)
 
   if (p != edges_.end())
     edges_.erase(p);
+
+  resetCSR();
 }
 
 void
@@ -919,61 +924,37 @@ minimumSpaningTree() const
 {
   auto newGraph = GraphP(parse_->makeGraph(""));
 
-  auto num_nodes = nodes_.size();
-  auto num_edges = edges_.size();
-
-  if (num_nodes == 0 || num_edges == 0)
+  if (nodes_.empty() || edges_.empty())
     return newGraph;
 
-  std::list<EdgeP> in_edges;
-
-  for (auto &edge : edges_)
-    in_edges.push_back(edge);
+  // kruskal (edges in cost order joining separate trees)
+  const auto &csr = this->csr();
 
-  auto num_in_edges = in_edges.size();
+  CSRGraph::Inds edgeInds;
 
-  while (num_in_edges > 0) {
-    EdgeP  min_edge;
-    double min_cost { };
+  csr.minimumSpanningForest(edgeInds);
 
-    for (auto &iedge : in_edges) {
-      auto cost = iedge->cost();
-
-      if (min_edge == nullptr || cost < min_cost) {
-        min_edge = iedge;
-        min_cost = cost;
-      }
-    }
-
-    if (! min_edge)
-      break;
+  auto getNode = [&](const Node *node) {
+    auto newNode = newGraph->getNode(node->name());
 
-    in_edges.remove(min_edge);
+    if (! newNode)
+      newNode = newGraph->addNode(node->name());
 
-    --num_in_edges;
-
-    auto *minFromNode = min_edge->fromNode();
-    auto *minToNode   = min_edge->toNode  ();
-
-    const std::string &name1 = minFromNode->name();
-    const std::string &name2 = minToNode  ->name();
-
-    minFromNode = newGraph->getNode(name1).get();
-    minToNode   = newGraph->getNode(name2).get();
-
-    if (minFromNode == nullptr)
-      minFromNode = newGraph->addNode(name1).get();
+    return newNode.get();
+  };
 
-    if (minToNode == nullptr)
-      minToNode = newGraph->addNode(name2).get();
+  // all connected nodes are in the tree
+  for (uint e = 0; e < csr.numEdges(); ++e) {
+    (void) getNode(csr.node(csr.edgeFrom(e)));
+    (void) getNode(csr.node(csr.edgeTo  (e)));
+  }
 
-    min_edge = newGraph->addEdge(minFromNode, minToNode);
+  for (auto e : edgeInds) {
+    auto *edge = csr.edge(e);
 
-    min_edge->setCost(min_cost);
+    auto newEdge = newGraph->addEdge(getNode(edge->fromNode()), getNode(edge->toNode()));
 
-    if (newGraph->isCycle(minFromNode) || newGraph->isCycle(minToNode)) {
-      newGraph->removeEdge(min_edge);
-    }
+    newEdge->setCost(edge->cost());
   }
 
   if (parse_->isDebug()) {
@@ -989,51 +970,92 @@ Graph::NodeArray
 Graph::
 shortestPath(NodeP fromNode, NodeP toNode) const
 {
-  class ShortestPath : public CAStar<Node> {
-   public:
-    ShortestPath(Graph *graph) :
-     graph_(graph) {
-    }
+  const auto &csr = this->csr();
 
-    virtual ~ShortestPath() { }
+  NodeArray pnodes;
 
-    Graph *graph() const { return graph_; }
+  CSRGraph::Inds inds;
 
-    // smallest/optimal cost to goal
-    double pathCostEstimate(Node * /*startNode*/, Node * /*goalNode*/) override {
-      return 1;
-    }
+  if (! csr.bfsPath(csr.nodeInd(fromNode.get()), csr.nodeInd(toNode.get()), inds))
+    return pnodes;
 
-    double traverseCost(Node * /*node*/, Node * /*newNode*/) override {
-      return 1;
-    }
+  for (auto i : inds)
+    pnodes.push_back(csr.node(i));
 
-    NodeList getNextNodes(Node *node) const override {
-      NodeList nodes;
+  return pnodes;
+}
 
-      for (const auto &edge : node->edges())
-        nodes.push_back(edge->toNode());
+Graph::NodeArray
+Graph::
+shortestCostPath(NodeP fromNode, NodeP toNode, double &cost) const
+{
+  const auto &csr = this->csr();
 
-      return nodes;
-    }
+  NodeArray pnodes;
 
-   private:
-    Graph *graph_ { nullptr };
-  };
+  CSRGraph::Inds inds;
 
-  ShortestPath shortestPath(const_cast<Graph *>(this));
+  if (! csr.dijkstraPath(csr.nodeInd(fromNode.get()), csr.nodeInd(toNode.get()), inds, cost))
+    return pnodes;
 
-  ShortestPath::NodeList nodes;
+  for (auto i : inds)
+    pnodes.push_back(csr.node(i));
 
-  NodeArray pnodes;
+  return pnodes;
+}
 
-  if (! shortestPath.search(fromNode.get(), toNode.get(), nodes))
-    return pnodes;
+Graph::NodeArrays
+Graph::
+connectedComponents() const
+{
+  const auto &csr = this->csr();
 
-  for (auto *node : nodes)
-    pnodes.push_back(node);
+  CSRGraph::Inds components;
 
-  return pnodes;
+  auto nc = csr.connectedComponents(components);
+
+  NodeArrays nodeArrays(nc);
+
+  for (uint n = 0; n < csr.numNodes(); ++n)
+    nodeArrays[components[n]].push_back(csr.node(n));
+
+  return nodeArrays;
+}
+
+bool
+Graph::
+topologicalSort(NodeArray &nodes) const
+{
+  const auto &csr = this->csr();
+
+  nodes.clear();
+
+  CSRGraph::Inds inds;
+
+  if (! csr.topologicalSort(inds))
+    return false;
+
+  for (auto i : inds)
+    nodes.push_back(csr.node(i));
+
+  return true;
+}
+
+const CSRGraph &
+Graph::
+csr() const
+{
+  if (! csr_)
+    csr_ = std::make_unique<CSRGraph>(*this);
+
+  return *csr_;
+}
+
+void
+Graph::
+resetCSR() const
+{
+  csr_.reset();
 }
 
 bool
@@ -1190,9 +1212,30 @@ void
 Edge::
 setAttribute(const std::string &name, const std::string &value)
 {
+  if (name == "cost" || name == "weight") {
+    bool ok;
+    auto r = Util::stringToReal(attributes_.stripQuotes(value), ok);
+
+    if (ok)
+      setCost(r);
+  }
+
   attributes_.setNameValue(name, value);
 }
 
+void
+Edge::
+setCost(double r)
+{
+  cost_ = r;
+
+  // cached costs
+  fromNode_->graph()->resetCSR();
+
+  if (toNode_->graph() != fromNode_->graph())
+    toNode_->graph()->resetCSR();
+}
+
 void
 Edge::
 print(std::ostream &os) const
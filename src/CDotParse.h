@@ -14,6 +14,7 @@ namespace CDotParse {
 class Graph;
 class Node;
 class Edge;
+class CSRGraph;
 
 using GraphP = std::shared_ptr<Graph>;
 using NodeP  = std::shared_ptr<Node>;
@@ -178,8 +179,9 @@ class Graph {
  public:
   using NodeMap   = std::map<std::string, NodeP>;
   using EdgeSet   = std::set<EdgeP>;
-  using NodeArray = std::vector<Node *>;
-  using Graphs    = std::vector<GraphP>;
+  using NodeArray  = std::vector<Node *>;
+  using NodeArrays = std::vector<NodeArray>;
+  using Graphs     = std::vector<GraphP>;
 
  public:
   Graph(Parse *parse, const std::string &name);
@@ -253,15 +255,31 @@ class Graph {
   void resetNodeVisited() const;
   void resetEdgeVisited() const;
 
+  // fewest edges path (inclusive, empty if no path)
   NodeArray shortestPath(NodeP fromNode, NodeP toNode) const;
 
+  // least cost path (inclusive, empty if no path)
+  NodeArray shortestCostPath(NodeP fromNode, NodeP toNode, double &cost) const;
+
   Graphs subGraphs() const;
 
+  // nodes of each connected component (edge direction ignored)
+  NodeArrays connectedComponents() const;
+
+  // nodes ordered so edges go from earlier to later node (false if cycle)
+  bool topologicalSort(NodeArray &nodes) const;
+
+  // compact adjacency (built on demand, reset when graph changes)
+  const CSRGraph &csr() const;
+
+  void resetCSR() const;
+
  private:
   void addNodeToSubGraph(Node *startNode, GraphP graph) const;
 
  private:
   using SubGraphs = std::set<Graph *>;
+  using CSRGraphP = std::unique_ptr<CSRGraph>;
 
   Parse*      parse_  { nullptr };
   Graph*      parent_ { nullptr };
@@ -272,6 +290,7 @@ class Graph {
   Attributes  nodeAttributes_;
   Attributes  edgeAttributes_;
   SubGraphs   graphs_;
+  mutable CSRGraphP csr_;
 };
 
 //---
@@ -359,7 +378,7 @@ class Edge {
   void setAttribute(const std::string &name, const std::string &value);
 
   double cost() const { return cost_; }
-  void setCost(double r) { cost_ = r; }
+  void setCost(double r);
 
   void print(std::ostream &os) const;
 
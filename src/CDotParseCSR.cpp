@@ -0,0 +1,517 @@
+#include <CDotParseCSR.h>
+#include <CDotParse.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+namespace CDotParse {
+
+namespace {
+
+// disjoint sets with path halving and union by size
+class UnionFind {
+ public:
+  UnionFind(uint n) :
+   parent_(n), size_(n, 1) {
+    std::iota(parent_.begin(), parent_.end(), 0);
+  }
+
+  uint find(uint i) {
+    while (parent_[i] != i) {
+      parent_[i] = parent_[parent_[i]];
+
+      i = parent_[i];
+    }
+
+    return i;
+  }
+
+  bool join(uint i, uint j) {
+    i = find(i);
+    j = find(j);
+
+    if (i == j)
+      return false;
+
+    if (size_[i] < size_[j])
+      std::swap(i, j);
+
+    parent_[j] = i;
+    size_  [i] += size_[j];
+
+    return true;
+  }
+
+ private:
+  std::vector<uint> parent_;
+  std::vector<uint> size_;
+};
+
+}
+
+//---
+
+CSRGraph::
+CSRGraph(const Graph &graph)
+{
+  for (const auto &pn : graph.nodes())
+    addNode(pn.second.get());
+
+  // edges in id order (edge set is ordered by pointer)
+  for (const auto &edge : graph.edges())
+    edges_.push_back(edge.get());
+
+  std::sort(edges_.begin(), edges_.end(), [](const Edge *e1, const Edge *e2) {
+    return e1->id() < e2->id();
+  });
+
+  auto ne = edges_.size();
+
+  edgeFrom_.resize(ne);
+  edgeTo_  .resize(ne);
+  edgeCost_.resize(ne);
+
+  for (size_t e = 0; e < ne; ++e) {
+    auto *edge = edges_[e];
+
+    // edge may connect to node in other graph
+    addNode(edge->fromNode());
+    addNode(edge->toNode  ());
+
+    edgeFrom_[e] = nodeInd(edge->fromNode());
+    edgeTo_  [e] = nodeInd(edge->toNode  ());
+    edgeCost_[e] = std::max(edge->cost(), 0.0);
+  }
+
+  //---
+
+  // count arcs per node then fill
+  auto nn = nodes_.size();
+
+  arcStart_.assign(nn + 1, 0);
+
+  for (size_t e = 0; e < ne; ++e) {
+    ++arcStart_[edgeFrom_[e] + 1];
+
+    if (! edges_[e]->isDirected())
+      ++arcStart_[edgeTo_[e] + 1];
+  }
+
+  for (size_t n = 0; n < nn; ++n)
+    arcStart_[n + 1] += arcStart_[n];
+
+  arcNode_.resize(arcStart_[nn]);
+  arcEdge_.resize(arcStart_[nn]);
+
+  Inds pos(arcStart_.begin(), arcStart_.end() - 1);
+
+  for (size_t e = 0; e < ne; ++e) {
+    auto from = edgeFrom_[e];
+    auto to   = edgeTo_  [e];
+
+    arcNode_[pos[from]] = to;
+    arcEdge_[pos[from]] = uint(e);
+
+    ++pos[from];
+
+    if (! edges_[e]->isDirected()) {
+      arcNode_[pos[to]] = from;
+      arcEdge_[pos[to]] = uint(e);
+
+      ++pos[to];
+    }
+  }
+}
+
+void
+CSRGraph::
+addNode(Node *node)
+{
+  if (nodeInds_.find(node) != nodeInds_.end())
+    return;
+
+  nodeInds_[node] = uint(nodes_.size());
+
+  nodes_.push_back(node);
+}
+
+uint
+CSRGraph::
+nodeInd(const Node *node) const
+{
+  auto p = nodeInds_.find(node);
+
+  return (p != nodeInds_.end() ? (*p).second : NO_IND);
+}
+
+//---
+
+bool
+CSRGraph::
+bfsPath(uint start, uint end, Inds &path) const
+{
+  path.clear();
+
+  if (start >= numNodes() || end >= numNodes())
+    return false;
+
+  Inds prev(numNodes(), NO_IND);
+  Inds queue;
+
+  queue.reserve(numNodes());
+
+  queue.push_back(start);
+
+  prev[start] = start;
+
+  for (size_t i = 0; i < queue.size() && prev[end] == NO_IND; ++i) {
+    auto n = queue[i];
+
+    visitArcs(n, [&](uint n1, uint) {
+      if (prev[n1] == NO_IND) {
+        prev[n1] = n;
+
+        queue.push_back(n1);
+      }
+    });
+  }
+
+  if (prev[end] == NO_IND)
+    return false;
+
+  tracePath(prev, start, end, path);
+
+  return true;
+}
+
+void
+CSRGraph::
+dijkstra(uint start, Costs &dist, Inds &prev, uint end) const
+{
+  using Item = std::pair<double, uint>;
+
+  auto inf = std::numeric_limits<double>::infinity();
+
+  dist.assign(numNodes(), inf);
+  prev.assign(numNodes(), NO_IND);
+
+  if (start >= numNodes())
+    return;
+
+  // min heap with stale entries skipped
+  std::vector<Item> heap;
+
+  auto cmp = [](const Item &i1, const Item &i2) { return i1.first > i2.first; };
+
+  dist[start] = 0.0;
+  prev[start] = start;
+
+  heap.emplace_back(0.0, start);
+
+  while (! heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), cmp);
+
+    auto item = heap.back();
+
+    heap.pop_back();
+
+    auto n = item.second;
+
+    if (item.first > dist[n])
+      continue;
+
+    if (n == end)
+      break;
+
+    visitArcs(n, [&](uint n1, uint e) {
+      auto d = item.first + edgeCost_[e];
+
+      if (d < dist[n1]) {
+        dist[n1] = d;
+        prev[n1] = n;
+
+        heap.emplace_back(d, n1);
+
+        std::push_heap(heap.begin(), heap.end(), cmp);
+      }
+    });
+  }
+}
+
+bool
+CSRGraph::
+dijkstraPath(uint start, uint end, Inds &path, double &cost) const
+{
+  path.clear();
+
+  cost = 0.0;
+
+  if (start >= numNodes() || end >= numNodes())
+    return false;
+
+  Costs dist;
+  Inds  prev;
+
+  dijkstra(start, dist, prev, end);
+
+  if (prev[end] == NO_IND)
+    return false;
+
+  tracePath(prev, start, end, path);
+
+  cost = dist[end];
+
+  return true;
+}
+
+void
+CSRGraph::
+tracePath(const Inds &prev, uint start, uint end, Inds &path) const
+{
+  for (auto n = end; n != start; n = prev[n])
+    path.push_back(n);
+
+  path.push_back(start);
+
+  std::reverse(path.begin(), path.end());
+}
+
+void
+CSRGraph::
+minimumSpanningForest(Inds &edges) const
+{
+  edges.clear();
+
+  // edges by increasing cost (ties in id order)
+  Inds order(numEdges());
+
+  std::iota(order.begin(), order.end(), 0);
+
+  std::stable_sort(order.begin(), order.end(), [&](uint e1, uint e2) {
+    return edgeCost_[e1] < edgeCost_[e2];
+  });
+
+  UnionFind sets(numNodes());
+
+  for (auto e : order) {
+    if (sets.join(edgeFrom_[e], edgeTo_[e])) {
+      edges.push_back(e);
+
+      if (edges.size() + 1 == numNodes())
+        break;
+    }
+  }
+}
+
+uint
+CSRGraph::
+connectedComponents(Inds &components) const
+{
+  UnionFind sets(numNodes());
+
+  for (uint e = 0; e < numEdges(); ++e)
+    (void) sets.join(edgeFrom_[e], edgeTo_[e]);
+
+  // number components in node order
+  components.assign(numNodes(), NO_IND);
+
+  Inds rootComponent(numNodes(), NO_IND);
+
+  uint nc = 0;
+
+  for (uint n = 0; n < numNodes(); ++n) {
+    auto root = sets.find(n);
+
+    if (rootComponent[root] == NO_IND)
+      rootComponent[root] = nc++;
+
+    components[n] = rootComponent[root];
+  }
+
+  return nc;
+}
+
+bool
+CSRGraph::
+topologicalSort(Inds &order) const
+{
+  // kahn's algorithm on edges in from -> to direction
+  order.clear();
+
+  Inds inDegree(numNodes(), 0);
+
+  for (uint e = 0; e < numEdges(); ++e)
+    ++inDegree[edgeTo_[e]];
+
+  order.reserve(numNodes());
+
+  for (uint n = 0; n < numNodes(); ++n) {
+    if (inDegree[n] == 0)
+      order.push_back(n);
+  }
+
+  for (size_t i = 0; i < order.size(); ++i) {
+    auto n = order[i];
+
+    visitArcs(n, [&](uint n1, uint e) {
+      // skip reverse arc of undirected edge
+      if (edgeFrom_[e] != n)
+        return;
+
+      if (--inDegree[n1] == 0)
+        order.push_back(n1);
+    });
+  }
+
+  return (order.size() == numNodes());
+}
+
+//---
+
+bool
+writeRandomDot(const std::string &filename, uint numNodes, uint numEdges)
+{
+  std::ofstream os(filename);
+
+  if (! os)
+    return false;
+
+  numNodes = std::max(numNodes, 2U);
+
+  // fixed seed random numbers
+  uint64_t rand = 1;
+
+  auto randInt = [&](uint n) {
+    rand = rand*6364136223846793005ULL + 1442695040888963407ULL;
+
+    return uint((rand >> 33) % n);
+  };
+
+  os << "digraph G {\n";
+
+  // edges from lower to higher node so graph is acyclic
+  for (uint i = 0; i < numEdges; ++i) {
+    auto n1 = randInt(numNodes);
+    auto n2 = randInt(numNodes);
+
+    if (n1 == n2)
+      n2 = (n1 + 1) % numNodes;
+
+    if (n1 > n2)
+      std::swap(n1, n2);
+
+    os << "  n" << n1 << " -> n" << n2 << " [cost=" << 1 + randInt(100) << "];\n";
+  }
+
+  os << "}\n";
+
+  return bool(os);
+}
+
+std::string
+benchmark(const std::string &filename)
+{
+  using Clock = std::chrono::steady_clock;
+
+  auto msecs = [](const Clock::time_point &t1) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t1).count();
+  };
+
+  char buffer[256];
+
+  std::string str;
+
+  auto addTime = [&](const char *name, double t) {
+    snprintf(buffer, sizeof(buffer), "%s%s %.1fms", str.empty() ? "" : " ", name, t);
+
+    str += buffer;
+  };
+
+  auto t = Clock::now();
+
+  Parse parse(filename);
+
+  if (! parse.parse())
+    return "parse failed";
+
+  addTime("parse", msecs(t));
+
+  // largest graph
+  const Graph *graph = nullptr;
+
+  for (const auto &pg : parse.graphs()) {
+    if (! graph || pg.second->edges().size() > graph->edges().size())
+      graph = pg.second.get();
+  }
+
+  if (! graph)
+    return str;
+
+  t = Clock::now();
+
+  CSRGraph csr(*graph);
+
+  addTime("csr", msecs(t));
+
+  snprintf(buffer, sizeof(buffer), " nodes %u edges %u", csr.numNodes(), csr.numEdges());
+
+  str += buffer;
+
+  if (csr.numNodes() == 0)
+    return str;
+
+  //---
+
+  CSRGraph::Inds inds;
+
+  t = Clock::now();
+
+  csr.minimumSpanningForest(inds);
+
+  addTime("kruskal", msecs(t));
+
+  t = Clock::now();
+
+  auto nc = csr.connectedComponents(inds);
+
+  addTime("components", msecs(t));
+
+  t = Clock::now();
+
+  bool sorted = csr.topologicalSort(inds);
+
+  addTime("topological", msecs(t));
+
+  // path from first node to last node in topological order (or last node)
+  auto start = 0U;
+  auto end   = (sorted ? inds.back() : csr.numNodes() - 1);
+
+  t = Clock::now();
+
+  bool found = csr.bfsPath(start, end, inds);
+
+  addTime("bfs", msecs(t));
+
+  auto bfsLen = inds.size();
+
+  double cost;
+
+  t = Clock::now();
+
+  (void) csr.dijkstraPath(start, end, inds, cost);
+
+  addTime("dijkstra", msecs(t));
+
+  snprintf(buffer, sizeof(buffer), " components %u acyclic %d path %d %zu/%zu",
+           nc, int(sorted), int(found), bfsLen, inds.size());
+
+  str += buffer;
+
+  return str;
+}
+
+}
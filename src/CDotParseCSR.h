@@ -0,0 +1,104 @@
+#ifndef CDotParseCSR_H
+#define CDotParseCSR_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace CDotParse {
+
+class Graph;
+class Node;
+class Edge;
+
+// compact (CSR) adjacency of a parsed graph for graph algorithms
+//
+// nodes and edges are numbered 0..n-1 (nodes in graph name order, edges in id order) and
+// the traversal arcs of each node are stored contiguously. Directed edges add an arc
+// from -> to, undirected edges add arcs in both directions.
+//
+// edge costs are assumed to be non-negative (negative costs are treated as zero).
+class CSRGraph {
+ public:
+  using Inds  = std::vector<uint>;
+  using Costs = std::vector<double>;
+  using Nodes = std::vector<Node *>;
+  using Edges = std::vector<Edge *>;
+
+  static constexpr uint NO_IND = uint(-1);
+
+ public:
+  CSRGraph(const Graph &graph);
+
+  uint numNodes() const { return uint(nodes_.size()); }
+  uint numEdges() const { return uint(edges_.size()); }
+  uint numArcs () const { return uint(arcNode_.size()); }
+
+  Node *node(uint i) const { return nodes_[i]; }
+  Edge *edge(uint i) const { return edges_[i]; }
+
+  // node index (NO_IND if not in graph)
+  uint nodeInd(const Node *node) const;
+
+  uint edgeFrom(uint e) const { return edgeFrom_[e]; }
+  uint edgeTo  (uint e) const { return edgeTo_  [e]; }
+
+  double edgeCost(uint e) const { return edgeCost_[e]; }
+
+  // visit arcs leaving node (proc(toNode, edge))
+  template<typename PROC>
+  void visitArcs(uint n, PROC proc) const {
+    for (uint i = arcStart_[n]; i < arcStart_[n + 1]; ++i)
+      proc(arcNode_[i], arcEdge_[i]);
+  }
+
+  //---
+
+  // fewest arcs path from start to end (inclusive, empty if unreachable)
+  bool bfsPath(uint start, uint end, Inds &path) const;
+
+  // cost from start to all nodes (infinity if unreachable) and previous node on path
+  void dijkstra(uint start, Costs &dist, Inds &prev, uint end=NO_IND) const;
+
+  // least cost path from start to end (inclusive, empty if unreachable)
+  bool dijkstraPath(uint start, uint end, Inds &path, double &cost) const;
+
+  // minimum spanning forest edges (kruskal, edges treated as undirected)
+  void minimumSpanningForest(Inds &edges) const;
+
+  // component number per node (edges treated as undirected), returns number of components
+  uint connectedComponents(Inds &components) const;
+
+  // nodes ordered so each edge goes from earlier to later node (false if cycle)
+  bool topologicalSort(Inds &order) const;
+
+ private:
+  void addNode(Node *node);
+
+  void tracePath(const Inds &prev, uint start, uint end, Inds &path) const;
+
+ private:
+  using NodeInds = std::unordered_map<const Node *, uint>;
+
+  Nodes    nodes_;
+  NodeInds nodeInds_;
+  Edges    edges_;
+  Inds     edgeFrom_;
+  Inds     edgeTo_;
+  Costs    edgeCost_;
+  Inds     arcStart_; // first arc per node (numNodes + 1)
+  Inds     arcNode_;  // arc destination node
+  Inds     arcEdge_;  // arc edge
+};
+
+//---
+
+// write random DOT graph (edges have random cost attribute)
+bool writeRandomDot(const std::string &filename, uint numNodes, uint numEdges);
+
+// time parse and graph algorithms on DOT file
+std::string benchmark(const std::string &filename);
+
+}
+
+#endif
@@ -0,0 +1,1184 @@
+#include <CDotParseStream.h>
+#include <CDotParse.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace CDotParse {
+
+uint
+StringPool::
+intern(std::string_view str)
+{
+  auto hash = hashStr(str);
+
+  if (! slots_.empty()) {
+    auto i = findSlot(str, hash);
+
+    if (slots_[i].id != NO_ID)
+      return slots_[i].id;
+  }
+
+  //---
+
+  // copy length and chars into chunk (large strings get own chunk)
+  auto len = uint(str.size());
+
+  auto size = (sizeof(uint) + len + 3) & ~size_t(3);
+
+  if (chunkPos_ + size > chunkSize_) {
+    chunkSize_ = std::max(size, size_t(65536));
+    chunkPos_  = 0;
+    chunkMem_ += chunkSize_;
+
+    chunks_.push_back(Chunk(new char [chunkSize_]));
+  }
+
+  auto *data = chunks_.back().get() + chunkPos_;
+
+  memcpy(data, &len, sizeof(uint));
+
+  if (len > 0)
+    memcpy(data + sizeof(uint), str.data(), len);
+
+  chunkPos_ += size;
+
+  //---
+
+  auto id = uint(strs_.size());
+
+  strs_.push_back(std::string_view(data + sizeof(uint), len));
+
+  // keep load below half
+  if (2*strs_.size() > slots_.size())
+    rehash();
+
+  auto &slot = slots_[findSlot(str, hash)];
+
+  slot.data = data;
+  slot.hash = hash;
+  slot.id   = id;
+
+  return id;
+}
+
+uint
+StringPool::
+find(std::string_view str) const
+{
+  if (slots_.empty())
+    return NO_ID;
+
+  return slots_[findSlot(str, hashStr(str))].id;
+}
+
+uint
+StringPool::
+hashStr(std::string_view str)
+{
+  // FNV-1a
+  uint hash = 2166136261U;
+
+  for (auto c : str) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 16777619U;
+  }
+
+  return hash;
+}
+
+uint
+StringPool::
+findSlot(std::string_view str, uint hash) const
+{
+  // linear probe to matching or empty slot
+  auto mask = uint(slots_.size() - 1);
+
+  auto i = hash & mask;
+
+  while (true) {
+    const auto &slot = slots_[i];
+
+    if (slot.id == NO_ID)
+      return i;
+
+    if (slot.hash == hash) {
+      uint len;
+
+      memcpy(&len, slot.data, sizeof(uint));
+
+      if (len == str.size() && memcmp(slot.data + sizeof(uint), str.data(), len) == 0)
+        return i;
+    }
+
+    i = (i + 1) & mask;
+  }
+}
+
+void
+StringPool::
+rehash()
+{
+  // power of two size
+  size_t size = 1024;
+
+  while (size < 4*strs_.size())
+    size *= 2;
+
+  Slots slots(size);
+
+  slots_.swap(slots);
+
+  auto mask = uint(slots_.size() - 1);
+
+  for (const auto &slot : slots) {
+    if (slot.id == NO_ID)
+      continue;
+
+    auto i = slot.hash & mask;
+
+    while (slots_[i].id != NO_ID)
+      i = (i + 1) & mask;
+
+    slots_[i] = slot;
+  }
+}
+
+size_t
+StringPool::
+memUsage() const
+{
+  return chunkMem_ + strs_.capacity()*sizeof(std::string_view) +
+         slots_.capacity()*sizeof(Slot);
+}
+
+//---
+
+MappedFile::
+~MappedFile()
+{
+  close();
+}
+
+bool
+MappedFile::
+open(const std::string &filename)
+{
+  close();
+
+  int fd = ::open(filename.c_str(), O_RDONLY);
+
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+
+  if (fstat(fd, &st) != 0) {
+    ::close(fd);
+    return false;
+  }
+
+  size_ = size_t(st.st_size);
+
+  if (size_ == 0) {
+    ::close(fd);
+
+    data_ = "";
+
+    return true;
+  }
+
+  auto *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  if (data != MAP_FAILED) {
+    (void) madvise(data, size_, MADV_SEQUENTIAL);
+
+    data_   = static_cast<const char *>(data);
+    mapped_ = true;
+  }
+  else {
+    // read whole file
+    buffer_.resize(size_);
+
+    size_t pos = 0;
+
+    while (pos < size_) {
+      auto n = ::read(fd, &buffer_[pos], size_ - pos);
+
+      if (n <= 0)
+        break;
+
+      pos += size_t(n);
+    }
+
+    buffer_.resize(pos);
+
+    data_ = buffer_.data();
+    size_ = pos;
+  }
+
+  ::close(fd);
+
+  return true;
+}
+
+void
+MappedFile::
+close()
+{
+  if (mapped_)
+    munmap(const_cast<char *>(data_), size_);
+
+  Buffer().swap(buffer_);
+
+  data_   = nullptr;
+  size_   = 0;
+  mapped_ = false;
+}
+
+//---
+
+StreamParse::
+StreamParse(const std::string &filename) :
+ filename_(filename)
+{
+}
+
+StreamParse::
+~StreamParse()
+{
+}
+
+bool
+StreamParse::
+parse()
+{
+  if (! file_.open(filename_))
+    return error("Failed to open '" + filename_ + "'");
+
+  fileSize_ = file_.size();
+
+  p_   = file_.data();
+  end_ = p_ + fileSize_;
+
+  peeked_ = false;
+
+  scopes_.clear();
+
+  scopes_.emplace_back();
+
+  numEnds_ = 0;
+
+  //---
+
+  bool rc = true;
+
+  while (true) {
+    if (! nextToken()) {
+      rc = false;
+      break;
+    }
+
+    if (token_ == Token::END)
+      break;
+
+    if (isKeyword("strict")) {
+      if (! nextToken()) {
+        rc = false;
+        break;
+      }
+    }
+
+    if (! isKeyword("graph") && ! isKeyword("digraph")) {
+      rc = error("expected graph or digraph");
+      break;
+    }
+
+    if (! parseGraph()) {
+      rc = false;
+      break;
+    }
+  }
+
+  // strings are copied so mapping no longer needed
+  file_.close();
+
+  p_ = end_ = nullptr;
+
+  return rc;
+}
+
+bool
+StreamParse::
+parseGraph()
+{
+  // [ID] '{' stmt_list '}'
+  if (! nextToken())
+    return false;
+
+  if (token_ == Token::ID) {
+    if (! nextToken())
+      return false;
+  }
+
+  if (token_ != Token::LBRACE)
+    return error("expected {");
+
+  return parseStatementList();
+}
+
+bool
+StreamParse::
+parseStatementList()
+{
+  // stmt [';' | ','] ... '}'
+  while (true) {
+    if (! peekToken())
+      return false;
+
+    if      (token_ == Token::RBRACE) {
+      (void) nextToken();
+      break;
+    }
+    else if (token_ == Token::END)
+      return error("expected }");
+
+    if (! parseStatement())
+      return false;
+
+    if (! peekToken())
+      return false;
+
+    if (token_ == Token::SEMI_COLON || token_ == Token::COMMA)
+      (void) nextToken();
+  }
+
+  return true;
+}
+
+bool
+StreamParse::
+parseStatement()
+{
+  if (! nextToken())
+    return false;
+
+  // anonymous subgraph or subgraph (may be start of edge)
+  if (token_ == Token::LBRACE || isKeyword("subgraph")) {
+    auto end = allocEnd();
+
+    if (! parseSubGraph(end))
+      return false;
+
+    if (! peekToken())
+      return false;
+
+    if (token_ == Token::EDGE_OP) {
+      if (! parseEdges(end))
+        return false;
+    }
+
+    --numEnds_;
+
+    return true;
+  }
+
+  if (token_ != Token::ID)
+    return error("expected identifier");
+
+  //---
+
+  // default attributes
+  bool isGraph = isKeyword("graph");
+
+  if (isGraph || isKeyword("node") || isKeyword("edge")) {
+    auto &scope = scopes_.back();
+
+    auto &defaults = (isGraph ? graphAttrs_ :
+                      (isKeyword("node") ? scope.nodeDefaults : scope.edgeDefaults));
+
+    stmtAttrs_.clear();
+
+    if (! parseAttrList(stmtAttrs_))
+      return false;
+
+    // graph attributes only kept for top level graph
+    if (isGraph && scopes_.size() > 1)
+      return true;
+
+    for (const auto &attr : stmtAttrs_) {
+      auto p = std::find_if(defaults.begin(), defaults.end(), [&](const Attr &attr1) {
+        return attr1.name == attr.name;
+      });
+
+      if (p != defaults.end())
+        (*p).value = attr.value;
+      else
+        defaults.push_back(attr);
+    }
+
+    return true;
+  }
+
+  //---
+
+  auto nameId = strings_.intern(tokenStr_);
+
+  if (! peekToken())
+    return false;
+
+  // name = value
+  if (token_ == Token::EQUALS) {
+    (void) nextToken();
+
+    if (! nextToken())
+      return false;
+
+    if (token_ != Token::ID)
+      return error("expected identifier");
+
+    auto valueId = strings_.intern(tokenStr_);
+
+    if (scopes_.size() == 1)
+      graphAttrs_.push_back(Attr{nameId, valueId});
+
+    return true;
+  }
+
+  if (! parsePort())
+    return false;
+
+  // edge
+  if (token_ == Token::EDGE_OP) {
+    auto end = allocEnd();
+
+    ends_[end].push_back(refNode(nameId));
+
+    if (! parseEdges(end))
+      return false;
+
+    --numEnds_;
+
+    return true;
+  }
+
+  // node [attributes]
+  stmtAttrs_.clear();
+
+  if (token_ == Token::LBRACKET) {
+    if (! parseAttrList(stmtAttrs_))
+      return false;
+  }
+
+  bool created;
+
+  auto node = getNode(nameId, created);
+
+  if (created) {
+    attrs_ = scopes_.back().nodeDefaults;
+
+    attrs_.insert(attrs_.end(), stmtAttrs_.begin(), stmtAttrs_.end());
+  }
+  else
+    attrs_ = stmtAttrs_;
+
+  addNodeAttrs(node, attrs_);
+
+  if (handler_)
+    handler_->node(node, created, attrs_);
+
+  addScopeNode(node);
+
+  return true;
+}
+
+bool
+StreamParse::
+parseSubGraph(uint end)
+{
+  // ['subgraph' [ID]] '{' stmt_list '}'
+  if (token_ != Token::LBRACE) {
+    if (! peekToken())
+      return false;
+
+    if (token_ == Token::ID) {
+      (void) nextToken();
+
+      if (! peekToken())
+        return false;
+    }
+
+    // subgraph reference
+    if (token_ != Token::LBRACE)
+      return true;
+
+    (void) nextToken();
+  }
+
+  // inherit defaults
+  auto scope = scopes_.back();
+
+  scope.nodesEnd = end;
+
+  scopes_.push_back(std::move(scope));
+
+  bool rc = parseStatementList();
+
+  scopes_.pop_back();
+
+  if (! rc)
+    return false;
+
+  //---
+
+  // remove duplicate nodes and add to parent subgraph
+  auto &nodes = ends_[end];
+
+  std::sort(nodes.begin(), nodes.end());
+
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+  auto parentEnd = scopes_.back().nodesEnd;
+
+  if (parentEnd != NO_IND)
+    ends_[parentEnd].insert(ends_[parentEnd].end(), nodes.begin(), nodes.end());
+
+  return true;
+}
+
+bool
+StreamParse::
+parseEdges(uint end)
+{
+  // (edgeop (node_id | subgraph))+ [attributes]
+  auto numEnds = numEnds_;
+
+  bool directed = false;
+
+  while (true) {
+    if (! peekToken())
+      return false;
+
+    if (token_ != Token::EDGE_OP)
+      break;
+
+    (void) nextToken();
+
+    directed = directedOp_;
+
+    if (! nextToken())
+      return false;
+
+    // allocated after previous end (nested edges free their ends)
+    auto end1 = allocEnd();
+
+    if      (token_ == Token::LBRACE || isKeyword("subgraph")) {
+      if (! parseSubGraph(end1))
+        return false;
+    }
+    else if (token_ == Token::ID) {
+      auto nameId = strings_.intern(tokenStr_);
+
+      ends_[end1].push_back(refNode(nameId));
+
+      if (! peekToken() || ! parsePort())
+        return false;
+    }
+    else
+      return error("expected identifier");
+  }
+
+  //---
+
+  stmtAttrs_.clear();
+
+  if (token_ == Token::LBRACKET) {
+    if (! parseAttrList(stmtAttrs_))
+      return false;
+  }
+
+  attrs_ = scopes_.back().edgeDefaults;
+
+  attrs_.insert(attrs_.end(), stmtAttrs_.begin(), stmtAttrs_.end());
+
+  // edges between each node of consecutive ends
+  for (auto i = end; i + 1 < numEnds_; ++i) {
+    for (auto fromNode : ends_[i]) {
+      for (auto toNode : ends_[i + 1])
+        addEdge(fromNode, toNode, directed, attrs_);
+    }
+  }
+
+  numEnds_ = numEnds;
+
+  return true;
+}
+
+bool
+StreamParse::
+parseAttrList(Attrs &attrs)
+{
+  // ('[' [ID ['=' ID] [';' | ',']]... ']')...
+  if (! nextToken())
+    return false;
+
+  if (token_ != Token::LBRACKET)
+    return error("expected [");
+
+  while (true) {
+    if (! nextToken())
+      return false;
+
+    if (token_ == Token::RBRACKET) {
+      if (! peekToken())
+        return false;
+
+      if (token_ != Token::LBRACKET)
+        break;
+
+      (void) nextToken();
+
+      continue;
+    }
+
+    if (token_ == Token::SEMI_COLON || token_ == Token::COMMA)
+      continue;
+
+    if (token_ != Token::ID)
+      return error("expected identifier");
+
+    auto nameId = strings_.intern(tokenStr_);
+
+    if (! peekToken())
+      return false;
+
+    uint valueId;
+
+    if (token_ == Token::EQUALS) {
+      (void) nextToken();
+
+      if (! nextToken())
+        return false;
+
+      if (token_ != Token::ID)
+        return error("expected identifier");
+
+      valueId = strings_.intern(tokenStr_);
+    }
+    else
+      valueId = strings_.intern("true");
+
+    attrs.push_back(Attr{nameId, valueId});
+  }
+
+  return true;
+}
+
+bool
+StreamParse::
+parsePort()
+{
+  // skip [':' ID [':' ID]] (token is peeked token after node id)
+  for (int i = 0; i < 2 && token_ == Token::COLON; ++i) {
+    (void) nextToken();
+
+    if (! nextToken())
+      return false;
+
+    if (token_ != Token::ID)
+      return error("expected port");
+
+    if (! peekToken())
+      return false;
+  }
+
+  return true;
+}
+
+//---
+
+uint
+StreamParse::
+nodeInd(std::string_view name) const
+{
+  auto id = strings_.find(name);
+
+  if (id == StringPool::NO_ID || id >= stringNodes_.size())
+    return NO_IND;
+
+  return stringNodes_[id];
+}
+
+uint
+StreamParse::
+getNode(uint nameId, bool &created)
+{
+  if (nameId >= stringNodes_.size())
+    stringNodes_.resize(std::max(size_t(strings_.size()), 2*stringNodes_.size()), NO_IND);
+
+  auto &node = stringNodes_[nameId];
+
+  created = (node == NO_IND);
+
+  if (created) {
+    node = uint(nodeNames_.size());
+
+    nodeNames_.push_back(nameId);
+  }
+
+  return node;
+}
+
+uint
+StreamParse::
+refNode(uint nameId)
+{
+  bool created;
+
+  auto node = getNode(nameId, created);
+
+  if (created) {
+    const auto &defaults = scopes_.back().nodeDefaults;
+
+    addNodeAttrs(node, defaults);
+
+    if (handler_)
+      handler_->node(node, true, defaults);
+  }
+
+  addScopeNode(node);
+
+  return node;
+}
+
+void
+StreamParse::
+addScopeNode(uint node)
+{
+  auto end = scopes_.back().nodesEnd;
+
+  if (end != NO_IND)
+    ends_[end].push_back(node);
+}
+
+uint
+StreamParse::
+allocEnd()
+{
+  if (numEnds_ >= ends_.size())
+    ends_.emplace_back();
+
+  ends_[numEnds_].clear();
+
+  return numEnds_++;
+}
+
+void
+StreamParse::
+addNodeAttrs(uint node, const Attrs &attrs)
+{
+  if (! store_)
+    return;
+
+  for (const auto &attr : attrs)
+    nodeAttrs_.push_back(ElementAttr{node, attr.name, attr.value});
+}
+
+void
+StreamParse::
+addEdge(uint fromNode, uint toNode, bool directed, const Attrs &attrs)
+{
+  auto edge = numEdges_++;
+
+  if (store_) {
+    edgeFrom_    .push_back(fromNode);
+    edgeTo_      .push_back(toNode);
+    edgeDirected_.push_back(directed);
+
+    for (const auto &attr : attrs)
+      edgeAttrs_.push_back(ElementAttr{edge, attr.name, attr.value});
+  }
+
+  if (handler_)
+    handler_->edge(edge, fromNode, toNode, directed, attrs);
+}
+
+size_t
+StreamParse::
+memUsage() const
+{
+  return strings_.memUsage() +
+         (nodeNames_.capacity() + stringNodes_.capacity() +
+          edgeFrom_.capacity() + edgeTo_.capacity())*sizeof(uint) +
+         edgeDirected_.capacity()/8 +
+         (nodeAttrs_.capacity() + edgeAttrs_.capacity())*sizeof(ElementAttr);
+}
+
+//---
+
+bool
+StreamParse::
+peekToken()
+{
+  if (! nextToken())
+    return false;
+
+  peeked_ = true;
+
+  return true;
+}
+
+bool
+StreamParse::
+nextToken()
+{
+  if (peeked_) {
+    peeked_ = false;
+    return true;
+  }
+
+  tokenQuoted_ = false;
+
+  skipSpace();
+
+  if (p_ >= end_) {
+    token_ = Token::END;
+    return true;
+  }
+
+  auto isIdChar = [](unsigned char c) {
+    return ((c & 0x80) || isalnum(c) || c == '_');
+  };
+
+  auto c = static_cast<unsigned char>(*p_);
+
+  switch (c) {
+    case '{': token_ = Token::LBRACE    ; ++p_; return true;
+    case '}': token_ = Token::RBRACE    ; ++p_; return true;
+    case '[': token_ = Token::LBRACKET  ; ++p_; return true;
+    case ']': token_ = Token::RBRACKET  ; ++p_; return true;
+    case ';': token_ = Token::SEMI_COLON; ++p_; return true;
+    case ',': token_ = Token::COMMA     ; ++p_; return true;
+    case '=': token_ = Token::EQUALS    ; ++p_; return true;
+    case ':': token_ = Token::COLON     ; ++p_; return true;
+    case '"': return readQuoted();
+    case '<': return readHtml();
+    default : break;
+  }
+
+  if (c == '-' && p_ + 1 < end_ && (p_[1] == '>' || p_[1] == '-')) {
+    token_      = Token::EDGE_OP;
+    directedOp_ = (p_[1] == '>');
+
+    p_ += 2;
+
+    return true;
+  }
+
+  auto *s = p_;
+
+  // numeral ([-](.[0-9]+ | [0-9]+[.[0-9]*]))
+  if (c == '-' || c == '.' || isdigit(c)) {
+    if (c == '-')
+      ++p_;
+
+    while (p_ < end_ && isdigit(static_cast<unsigned char>(*p_)))
+      ++p_;
+
+    if (p_ < end_ && *p_ == '.') {
+      ++p_;
+
+      while (p_ < end_ && isdigit(static_cast<unsigned char>(*p_)))
+        ++p_;
+    }
+  }
+  // identifier
+  else if (isIdChar(c) && ! isdigit(c)) {
+    while (p_ < end_ && isIdChar(*p_))
+      ++p_;
+  }
+  else
+    return error(std::string("unexpected character '") + char(c) + "'");
+
+  token_    = Token::ID;
+  tokenStr_ = std::string_view(s, size_t(p_ - s));
+
+  return true;
+}
+
+void
+StreamParse::
+skipSpace()
+{
+  auto *begin = file_.data();
+
+  while (p_ < end_) {
+    auto c = *p_;
+
+    if      (isspace(static_cast<unsigned char>(c)))
+      ++p_;
+    // preprocessor line
+    else if (c == '#' && (p_ == begin || p_[-1] == '\n')) {
+      while (p_ < end_ && *p_ != '\n')
+        ++p_;
+    }
+    else if (c == '/' && p_ + 1 < end_ && p_[1] == '/') {
+      while (p_ < end_ && *p_ != '\n')
+        ++p_;
+    }
+    else if (c == '/' && p_ + 1 < end_ && p_[1] == '*') {
+      p_ += 2;
+
+      while (p_ + 1 < end_ && ! (p_[0] == '*' && p_[1] == '/'))
+        ++p_;
+
+      p_ = std::min(p_ + 2, end_);
+    }
+    else
+      break;
+  }
+}
+
+bool
+StreamParse::
+readQuoted()
+{
+  // "..." (escaped quotes are kept) with optional + concatenation
+  auto readString = [&](std::string_view &str) {
+    auto *s = ++p_;
+
+    while (p_ < end_ && *p_ != '"') {
+      if (*p_ == '\\' && p_ + 1 < end_)
+        ++p_;
+
+      ++p_;
+    }
+
+    if (p_ >= end_)
+      return error("unterminated string");
+
+    str = std::string_view(s, size_t(p_ - s));
+
+    ++p_;
+
+    return true;
+  };
+
+  if (! readString(tokenStr_))
+    return false;
+
+  token_       = Token::ID;
+  tokenQuoted_ = true;
+
+  // concatenation (copy needed)
+  bool concat = false;
+
+  while (true) {
+    auto *p = p_;
+
+    skipSpace();
+
+    if (p_ < end_ && *p_ == '+') {
+      ++p_;
+
+      skipSpace();
+    }
+    else {
+      p_ = p;
+      break;
+    }
+
+    if (p_ >= end_ || *p_ != '"')
+      return error("expected string after +");
+
+    if (! concat) {
+      concat_ = std::string(tokenStr_);
+      concat  = true;
+    }
+
+    std::string_view str;
+
+    if (! readString(str))
+      return false;
+
+    concat_ += str;
+  }
+
+  if (concat)
+    tokenStr_ = concat_;
+
+  return true;
+}
+
+bool
+StreamParse::
+readHtml()
+{
+  // <...> with nested <> (angle brackets kept)
+  auto *s = p_;
+
+  int depth = 0;
+
+  while (p_ < end_) {
+    auto c = *p_++;
+
+    if      (c == '<')
+      ++depth;
+    else if (c == '>') {
+      if (--depth == 0)
+        break;
+    }
+  }
+
+  if (depth != 0)
+    return error("unterminated html string");
+
+  token_       = Token::ID;
+  tokenStr_    = std::string_view(s, size_t(p_ - s));
+  tokenQuoted_ = true;
+
+  return true;
+}
+
+bool
+StreamParse::
+isKeyword(const char *name) const
+{
+  if (token_ != Token::ID || tokenQuoted_)
+    return false;
+
+  auto len = strlen(name);
+
+  if (tokenStr_.size() != len)
+    return false;
+
+  for (size_t i = 0; i < len; ++i) {
+    if (tolower(static_cast<unsigned char>(tokenStr_[i])) != name[i])
+      return false;
+  }
+
+  return true;
+}
+
+bool
+StreamParse::
+error(const std::string &msg)
+{
+  auto *begin = file_.data();
+
+  int line = 1;
+
+  if (begin && p_) {
+    for (auto *p = begin; p < p_ && p < end_; ++p) {
+      if (*p == '\n')
+        ++line;
+    }
+  }
+
+  errorMsg_ = filename_ + "@" + std::to_string(line) + ": " + msg;
+
+  return false;
+}
+
+//---
+
+std::string
+parseBenchmark(const std::string &filename)
+{
+  using Clock = std::chrono::steady_clock;
+
+  auto secs = [](const Clock::time_point &t1) {
+    return std::chrono::duration<double>(Clock::now() - t1).count();
+  };
+
+  char buffer[256];
+
+  std::string str;
+
+  double mb = 0.0;
+
+  auto addTime = [&](const char *name, double t) {
+    snprintf(buffer, sizeof(buffer), "%s%s %.1fms (%.1fMB/s)",
+             str.empty() ? "" : " ", name, 1000.0*t, t > 0.0 ? mb/t : 0.0);
+
+    str += buffer;
+  };
+
+  // streaming into arrays
+  auto t = Clock::now();
+
+  auto parse1 = std::make_unique<StreamParse>(filename);
+
+  if (! parse1->parse())
+    return parse1->errorMsg();
+
+  mb = double(parse1->fileSize())/(1024.0*1024.0);
+
+  snprintf(buffer, sizeof(buffer), "size %.1fMB nodes %u edges %u",
+           mb, parse1->numNodes(), parse1->numEdges());
+
+  str = buffer;
+
+  addTime("stream", secs(t));
+
+  auto memUsage = parse1->memUsage();
+
+  parse1.reset();
+
+  // streaming to handler (only node names stored)
+  class CountHandler : public StreamParse::Handler {
+   public:
+    CountHandler() { }
+
+    void node(uint, bool created, const StreamParse::Attrs &) override {
+      if (created)
+        ++numNodes;
+    }
+
+    void edge(uint, uint, uint, bool, const StreamParse::Attrs &) override {
+      ++numEdges;
+    }
+
+    uint numNodes { 0 };
+    uint numEdges { 0 };
+  };
+
+  CountHandler handler;
+
+  t = Clock::now();
+
+  auto parse2 = std::make_unique<StreamParse>(filename);
+
+  parse2->setStore  (false);
+  parse2->setHandler(&handler);
+
+  if (parse2->parse())
+    addTime("handler", secs(t));
+
+  parse2.reset();
+
+  // object graph
+  t = Clock::now();
+
+  auto parse3 = std::make_unique<Parse>(filename);
+
+  if (parse3->parse())
+    addTime("parse", secs(t));
+
+  parse3.reset();
+
+  snprintf(buffer, sizeof(buffer), " stream memory %.1fMB", double(memUsage)/(1024.0*1024.0));
+
+  str += buffer;
+
+  return str;
+}
+
+}
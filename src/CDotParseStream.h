@@ -0,0 +1,281 @@
+#ifndef CDotParseStream_H
+#define CDotParseStream_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+
+namespace CDotParse {
+
+// interned strings (one copy of each unique string referenced by id)
+//
+// strings are copied (after their length) into large chunks and found with an open
+// addressing hash table of (data, hash, id) slots so a lookup only touches the slot and
+// the string data.
+class StringPool {
+ public:
+  static constexpr uint NO_ID = uint(-1);
+
+ public:
+  StringPool() { }
+
+  uint size() const { return uint(strs_.size()); }
+
+  // get id of string (added if new)
+  uint intern(std::string_view str);
+
+  // get id of string (NO_ID if not found)
+  uint find(std::string_view str) const;
+
+  std::string_view str(uint id) const { return strs_[id]; }
+
+  size_t memUsage() const;
+
+ private:
+  struct Slot {
+    const char* data { nullptr }; // length then chars
+    uint        hash { 0 };
+    uint        id   { NO_ID };
+  };
+
+  static uint hashStr(std::string_view str);
+
+  uint findSlot(std::string_view str, uint hash) const;
+
+  void rehash();
+
+ private:
+  using Chunk  = std::unique_ptr<char[]>;
+  using Chunks = std::vector<Chunk>;
+  using Strs   = std::vector<std::string_view>;
+  using Slots  = std::vector<Slot>;
+
+  Chunks chunks_;
+  size_t chunkPos_  { 0 };
+  size_t chunkSize_ { 0 };
+  size_t chunkMem_  { 0 };
+  Strs   strs_;
+  Slots  slots_;
+};
+
+//---
+
+// read only memory mapped file
+class MappedFile {
+ public:
+  MappedFile() { }
+
+ ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool open(const std::string &filename);
+
+  void close();
+
+  const char *data() const { return data_; }
+  size_t      size() const { return size_; }
+
+ private:
+  using Buffer = std::vector<char>;
+
+  const char* data_   { nullptr };
+  size_t      size_   { 0 };
+  bool        mapped_ { false };
+  Buffer      buffer_; // file contents if map fails
+};
+
+//---
+
+// streaming DOT parser
+//
+// tokens are views into the mapped file, identifiers are interned into a string pool and
+// nodes are numbered in first reference order. Nodes and edges are optionally stored in flat
+// arrays and/or passed to a handler as they are parsed (no object graph is built).
+//
+// node names are global to the file (nodes of subgraphs and multiple graphs are merged).
+class StreamParse {
+ public:
+  static constexpr uint NO_IND = uint(-1);
+
+  struct Attr {
+    uint name  { 0 };
+    uint value { 0 };
+  };
+
+  using Attrs = std::vector<Attr>;
+
+  // attribute of node or edge (element index and string ids)
+  struct ElementAttr {
+    uint element { 0 };
+    uint name    { 0 };
+    uint value   { 0 };
+  };
+
+  using ElementAttrs = std::vector<ElementAttr>;
+
+  // receives nodes and edges as they are parsed
+  class Handler {
+   public:
+    Handler() { }
+
+    virtual ~Handler() { }
+
+    // node statement or first reference (attrs include defaults if created)
+    virtual void node(uint /*node*/, bool /*created*/, const Attrs & /*attrs*/) { }
+
+    // edge (attrs include defaults)
+    virtual void edge(uint /*edge*/, uint /*fromNode*/, uint /*toNode*/,
+                      bool /*directed*/, const Attrs & /*attrs*/) { }
+  };
+
+ public:
+  StreamParse(const std::string &filename);
+
+ ~StreamParse();
+
+  Handler *handler() const { return handler_; }
+  void setHandler(Handler *handler) { handler_ = handler; }
+
+  //! get/set store edges and attributes in arrays (node names are always stored)
+  bool isStore() const { return store_; }
+  void setStore(bool b) { store_ = b; }
+
+  bool parse();
+
+  const std::string &errorMsg() const { return errorMsg_; }
+
+  size_t fileSize() const { return fileSize_; }
+
+  //---
+
+  const StringPool &strings() const { return strings_; }
+
+  std::string_view str(uint id) const { return strings_.str(id); }
+
+  uint numNodes() const { return uint(nodeNames_.size()); }
+  uint numEdges() const { return numEdges_; }
+
+  std::string_view nodeName(uint n) const { return strings_.str(nodeNames_[n]); }
+
+  // node index (NO_IND if not found)
+  uint nodeInd(std::string_view name) const;
+
+  uint edgeFrom(uint e) const { return edgeFrom_[e]; }
+  uint edgeTo  (uint e) const { return edgeTo_  [e]; }
+
+  bool isEdgeDirected(uint e) const { return edgeDirected_[e]; }
+
+  const Attrs        &graphAttrs() const { return graphAttrs_; }
+  const ElementAttrs &nodeAttrs () const { return nodeAttrs_; }
+  const ElementAttrs &edgeAttrs () const { return edgeAttrs_; }
+
+  // memory used by strings and arrays
+  size_t memUsage() const;
+
+ private:
+  enum class Token {
+    NONE,
+    ID,
+    LBRACE,
+    RBRACE,
+    LBRACKET,
+    RBRACKET,
+    SEMI_COLON,
+    COMMA,
+    EQUALS,
+    COLON,
+    EDGE_OP,
+    END
+  };
+
+  using NodeInds = std::vector<uint>;
+  using Flags    = std::vector<bool>;
+
+  struct Scope {
+    Attrs nodeDefaults;
+    Attrs edgeDefaults;
+    uint  nodesEnd { NO_IND }; // edge end collecting subgraph nodes
+  };
+
+  using Scopes    = std::vector<Scope>;
+  using NodeLists = std::vector<NodeInds>;
+
+ private:
+  bool parseGraph();
+  bool parseStatementList();
+  bool parseStatement();
+  bool parseSubGraph(uint end);
+  bool parseEdges(uint end);
+  bool parseAttrList(Attrs &attrs);
+  bool parsePort();
+
+  uint getNode(uint nameId, bool &created);
+  uint refNode(uint nameId);
+  void addScopeNode(uint node);
+
+  uint allocEnd();
+
+  void addNodeAttrs(uint node, const Attrs &attrs);
+  void addEdge(uint fromNode, uint toNode, bool directed, const Attrs &attrs);
+
+  bool nextToken();
+  bool peekToken();
+
+  void skipSpace();
+
+  bool readQuoted();
+  bool readHtml();
+
+  bool isKeyword(const char *name) const;
+
+  bool error(const std::string &msg);
+
+ private:
+  std::string  filename_;
+  MappedFile   file_;
+  size_t       fileSize_ { 0 };
+  Handler*     handler_  { nullptr };
+  bool         store_    { true };
+  std::string  errorMsg_;
+
+  // tokenizer
+  const char*      p_           { nullptr };
+  const char*      end_         { nullptr };
+  Token            token_       { Token::NONE };
+  std::string_view tokenStr_;
+  bool             tokenQuoted_ { false };
+  bool             directedOp_  { false };
+  bool             peeked_      { false };
+  std::string      concat_;
+
+  // parse state
+  Scopes    scopes_;
+  NodeLists ends_;            // edge end nodes (stack of reused lists)
+  uint      numEnds_ { 0 };
+  Attrs     stmtAttrs_;
+  Attrs     attrs_;
+
+  // data
+  StringPool   strings_;
+  NodeInds     nodeNames_;   // name string id per node
+  NodeInds     stringNodes_; // node per string id
+  uint         numEdges_ { 0 };
+  NodeInds     edgeFrom_;
+  NodeInds     edgeTo_;
+  Flags        edgeDirected_;
+  Attrs        graphAttrs_;
+  ElementAttrs nodeAttrs_;
+  ElementAttrs edgeAttrs_;
+};
+
+//---
+
+// time (and report MB/s of) original and streaming parse of DOT file
+std::string parseBenchmark(const std::string &filename);
+
+}
+
+#endif
@@ -1,9 +1,46 @@
 #include <CFlocking.h>
 
+#include <algorithm>
+
 CFlock::FlockList CFlock::flocks_;
 
 CBBox3D CFlock::world(0, 0, 0, 50, 50, 50);
 
+CFlockGrid CFlock::grid_;
+
+void
+CFlock::
+setWorldSize(double size)
+{
+  world = CBBox3D(0, 0, 0, size, size, size);
+}
+
+void
+CFlock::
+updateGrid(const FlockList &flocks)
+{
+  grid_.init(world.getXSize(), world.getYSize(), world.getZSize(),
+             CFlockingUtil::Default_Perception_Range);
+
+  // snapshot boid state (index is position in flock order and is used to order
+  // neighbours)
+  CFlockGrid::Entries entries;
+
+  int ind = 0;
+
+  for (auto *flock : flocks) {
+    for (auto *boid : flock->getBoids()) {
+      boid->setInd(ind);
+
+      entries.push_back(CFlockGrid::Entry(boid, flock, ind, boid->getPos(), boid->getVelocity()));
+
+      ++ind;
+    }
+  }
+
+  grid_.build(entries);
+}
+
 CFlock::
 CFlock()
 {
@@ -25,16 +62,18 @@ CFlock::
 
   id_ = 0;
 
-  int i = 0;
+  auto p = std::find(flocks_.begin(), flocks_.end(), this);
 
-  for (auto *flock : flocks_) {
-    if (flock == this) {
-      flocks_[i] = nullptr;
-      break;
-    }
+  if (p != flocks_.end())
+    flocks_.erase(p);
 
-    ++i;
-  }
+  // keep ids matching flock index
+  uint i = 0;
+
+  for (auto *flock : flocks_)
+    flock->id_ = i++;
+
+  grid_.clear();
 }
 
 void
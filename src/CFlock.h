@@ -1,6 +1,7 @@
 #ifndef _CFLOCK_H
 #define _CFLOCK_H
 
+#include <CFlockGrid.h>
 #include <CBBox3D.h>
 #include <CRGBA.h>
 #include <vector>
@@ -13,6 +14,11 @@ class CFlock {
 
  public:
   static const CBBox3D &getWorld() { return world; }
+  static void setWorldSize(double size);
+
+  // grid of boid state at start of step (rebuilt each step by updateGrid)
+  static const CFlockGrid &getGrid() { return grid_; }
+  static void updateGrid(const FlockList &flocks);
 
   static uint getNumFlocks() { return uint(flocks_.size()); }
 
@@ -39,8 +45,9 @@ class CFlock {
   void RemoveFrom(CBoid *boid);
 
  private:
-  static CBBox3D   world;
-  static FlockList flocks_;
+  static CBBox3D    world;
+  static FlockList  flocks_;
+  static CFlockGrid grid_;
 
   uint     id_ { 0 };
   BoidList boids_;
@@ -0,0 +1,163 @@
+#ifndef CFLOCK_GRID_H
+#define CFLOCK_GRID_H
+
+#include <CVector3D.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+class CBoid;
+class CFlock;
+
+// uniform grid of boid state over the (origin centered) flock world
+//
+// cell size is the boid perception range so all boids a boid can see are in the
+// 3x3x3 block of cells around it. Positions outside the world are clamped to the
+// edge cells which keeps this true for boids which have not yet been wrapped.
+//
+// entries are a snapshot of each boid's flock, position and velocity at the start
+// of the step. They are stored sorted by cell (and by boid index within a cell)
+// in one array and are read only while boids are updated, so boids can be updated
+// in any order (or in parallel) and only ever see the previous step's state.
+class CFlockGrid {
+ public:
+  struct Entry {
+    CBoid*        boid  { nullptr };
+    const CFlock* flock { nullptr };
+    int           ind   { 0 };
+    double        x     { 0.0 }, y  { 0.0 }, z  { 0.0 };
+    double        vx    { 0.0 }, vy { 0.0 }, vz { 0.0 };
+
+    Entry() { }
+
+    Entry(CBoid *boid, const CFlock *flock, int ind, const CVector3D &p, const CVector3D &v) :
+     boid(boid), flock(flock), ind(ind), x(p.getX()), y(p.getY()), z(p.getZ()),
+     vx(v.getX()), vy(v.getY()), vz(v.getZ()) {
+    }
+
+    CVector3D pos() const { return CVector3D(x , y , z ); }
+    CVector3D vel() const { return CVector3D(vx, vy, vz); }
+  };
+
+  using Entries = std::vector<Entry>;
+
+ public:
+  CFlockGrid() { }
+
+  uint numCells() const { return uint(cellStart_.size() > 0 ? cellStart_.size() - 1 : 0); }
+
+  uint numEntries() const { return uint(entries_.size()); }
+
+  // reset grid to cover world of specified size
+  void init(double xsize, double ysize, double zsize, double cellSize) {
+    cellSize_ = std::max(cellSize, 1E-6);
+
+    xmin_ = -xsize/2; ymin_ = -ysize/2; zmin_ = -zsize/2;
+
+    nx_ = std::max(int(std::ceil(xsize/cellSize_)), 1);
+    ny_ = std::max(int(std::ceil(ysize/cellSize_)), 1);
+    nz_ = std::max(int(std::ceil(zsize/cellSize_)), 1);
+
+    entries_.clear();
+
+    cellStart_.assign(size_t(nx_)*size_t(ny_)*size_t(nz_) + 1, 0);
+  }
+
+  void clear() {
+    entries_.clear();
+
+    std::fill(cellStart_.begin(), cellStart_.end(), 0);
+  }
+
+  int cellInd(double x, double y, double z) const {
+    int ix, iy, iz;
+
+    cellCoords(x, y, z, ix, iy, iz);
+
+    return (iz*ny_ + iy)*nx_ + ix;
+  }
+
+  // store entries sorted by cell (counting sort keeps input order within a cell)
+  void build(const Entries &entries) {
+    auto nc = cellStart_.size() - 1;
+
+    std::fill(cellStart_.begin(), cellStart_.end(), 0);
+
+    cellInds_.resize(entries.size());
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+      const auto &entry = entries[i];
+
+      cellInds_[i] = cellInd(entry.x, entry.y, entry.z);
+
+      ++cellStart_[size_t(cellInds_[i]) + 1];
+    }
+
+    for (size_t i = 0; i < nc; ++i)
+      cellStart_[i + 1] += cellStart_[i];
+
+    entries_.resize(entries.size());
+
+    pos_.assign(cellStart_.begin(), cellStart_.end() - 1);
+
+    for (size_t i = 0; i < entries.size(); ++i)
+      entries_[pos_[size_t(cellInds_[i])]++] = entries[i];
+  }
+
+  // call proc(entry) for entries in cells within range cells of p
+  template<typename PROC>
+  void visit(const CVector3D &p, int range, PROC proc) const {
+    if (entries_.empty())
+      return;
+
+    int ix, iy, iz;
+
+    cellCoords(p.getX(), p.getY(), p.getZ(), ix, iy, iz);
+
+    int ix1 = std::max(ix - range, 0), ix2 = std::min(ix + range, nx_ - 1);
+    int iy1 = std::max(iy - range, 0), iy2 = std::min(iy + range, ny_ - 1);
+    int iz1 = std::max(iz - range, 0), iz2 = std::min(iz + range, nz_ - 1);
+
+    for (int iz3 = iz1; iz3 <= iz2; ++iz3) {
+      for (int iy3 = iy1; iy3 <= iy2; ++iy3) {
+        // cells along x are contiguous
+        auto c1 = size_t((iz3*ny_ + iy3)*nx_ + ix1);
+        auto c2 = size_t((iz3*ny_ + iy3)*nx_ + ix2);
+
+        for (auto i = cellStart_[c1]; i < cellStart_[c2 + 1]; ++i)
+          proc(entries_[i]);
+      }
+    }
+  }
+
+ private:
+  void cellCoords(double x, double y, double z, int &ix, int &iy, int &iz) const {
+    auto clampInd = [](double r, int n) {
+      if (r <= 0.0) return 0;
+
+      return std::min(int(r), n - 1);
+    };
+
+    ix = clampInd((x - xmin_)/cellSize_, nx_);
+    iy = clampInd((y - ymin_)/cellSize_, ny_);
+    iz = clampInd((z - zmin_)/cellSize_, nz_);
+  }
+
+ private:
+  using Inds  = std::vector<int>;
+  using Sizes = std::vector<size_t>;
+
+  double  cellSize_ { 1.0 };
+  double  xmin_     { 0.0 };
+  double  ymin_     { 0.0 };
+  double  zmin_     { 0.0 };
+  int     nx_       { 1 };
+  int     ny_       { 1 };
+  int     nz_       { 1 };
+  Entries entries_;
+  Sizes   cellStart_;
+  Inds    cellInds_;
+  Sizes   pos_;
+};
+
+#endif
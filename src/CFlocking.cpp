@@ -1,10 +1,19 @@
 #include <CFlocking.h>
 #include <COSRand.h>
 #include <CFuncs.h>
+#include <CThreadPool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 
 CFlocking::
-CFlocking()
+CFlocking(uint numBoids, uint seed) :
+ numBoids_(numBoids), seed_(seed)
 {
+  pool_ = new CThreadPool(1);
+
   createBoids();
 }
 
@@ -16,45 +25,73 @@ CFlocking::
 
   for (auto *boid : boids_)
     delete boid;
+
+  delete pool_;
+}
+
+size_t
+CFlocking::
+numThreads() const
+{
+  return pool_->numThreads();
+}
+
+void
+CFlocking::
+setNumThreads(size_t n)
+{
+  pool_->setNumThreads(n);
 }
 
 void
 CFlocking::
 createBoids()
 {
-  COSRand::srand();
+  if (seed_)
+    srand(seed_);
+  else
+    COSRand::srand();
+
+  for (auto *flock : flocks_)
+    delete flock;
 
-  boids_.resize(numBoids());
+  for (auto *boid : boids_)
+    delete boid;
 
-  for (uint i = 0; i < numBoids(); ++i)
-    boids_[i] = new CBoid(short(i));
+  // scale world to keep default boid density
+  auto n = numBoids();
+
+  CFlock::setWorldSize(50.0*std::cbrt(std::max(n, 200U)/200.0));
+
+  boids_.resize(n);
+
+  for (uint i = 0; i < n; ++i)
+    boids_[i] = new CBoid(int(i));
 
   flocks_.resize(numFlocks());
 
   for (uint i = 0; i < numFlocks(); i++)
     flocks_[i] = new CFlock();
 
-  uint count1 = 0;
-
-  for (uint count = 0; count < 50; ++count, ++count1)
-    flocks_[0]->AddTo(boids_[count1]);
-
-  flocks_[0]->setColor(CRGBA(1, 0, 0));
+  // split boids between flocks in ratio 50:120:20:10
+  static uint  weights[] = { 50, 120, 20, 10 };
+  static CRGBA colors [] = { CRGBA(1, 0, 0), CRGBA(0, 1, 0), CRGBA(0, 0, 1), CRGBA(1, 0, 1) };
 
-  for (uint count = 0; count < 120; ++count, ++count1)
-    flocks_[1]->AddTo(boids_[count1]);
+  uint totalWeight = 0;
 
-  flocks_[1]->setColor(CRGBA(0, 1, 0));
+  for (uint i = 0; i < numFlocks(); i++)
+    totalWeight += weights[i % 4];
 
-  for (uint count = 0; count < 20; ++count, ++count1)
-    flocks_[2]->AddTo(boids_[count1]);
+  uint count1 = 0;
 
-  flocks_[2]->setColor(CRGBA(0,0,1));
+  for (uint i = 0; i < numFlocks(); i++) {
+    auto count2 = (i < numFlocks() - 1 ? count1 + n*weights[i % 4]/totalWeight : n);
 
-  for (uint count = 0; count < 10; ++count, ++count1)
-    flocks_[3]->AddTo(boids_[count1]);
+    for ( ; count1 < count2; ++count1)
+      flocks_[i]->AddTo(boids_[count1]);
 
-  flocks_[3]->setColor(CRGBA(1,0,1));
+    flocks_[i]->setColor(colors[i % 4]);
+  }
 
 #ifdef FLOCK_DEBUG
   for (uint i = 0; i < numFlocks(); ++i)
@@ -112,27 +149,30 @@ getObject()
   return object_;
 }
 
+// boids read other boids state from the grid snapshot and only write their own
+// state so they can be updated in parallel with results independent of thread count
 void
 CFlocking::
 update(double dt)
 {
-  auto num_flocks = CFlock::getNumFlocks();
+  auto t1 = std::chrono::steady_clock::now();
 
-  for (uint i = 0; i < num_flocks; ++i) {
-    auto *flock = CFlock::getFlock(int(i));
+  CFlock::updateGrid(flocks_);
 
-    updateFlock(flock, dt);
-  }
-}
+  pool_->parallelFor(boids_.size(), [&](size_t, size_t i1, size_t i2) {
+    for (auto i = i1; i < i2; ++i) {
+      auto *boid = boids_[i];
 
-void
-CFlocking::
-updateFlock(CFlock *flock, double dt)
-{
-  flock->Update(dt);
+      boid->FlockIt(boid->getFlock(), dt);
+    }
+  }, /*minChunk*/256);
 
-  for (auto *boid : flock->getBoids())
+  for (auto *boid : boids_)
     boid->updateObject();
+
+  auto t2 = std::chrono::steady_clock::now();
+
+  lastTime_ = std::chrono::duration<double, std::milli>(t2 - t1).count();
 }
 
 void
@@ -162,3 +202,73 @@ addFlockObjects(CFlock *flock, std::vector<CGeomObject3D *> &objects)
     objects.push_back(object);
   }
 }
+
+std::string
+CFlocking::
+benchmark(uint numBoids, uint numSteps)
+{
+  // benchmark changes (static) world size so restore after
+  auto worldSize = CFlock::getWorld().getXSize();
+
+  numSteps = std::max(numSteps, 1U);
+
+  auto runFlocking = [&](size_t numThreads, double &t, std::vector<double> &coords) {
+    CFlocking flocking(numBoids, /*seed*/1);
+
+    flocking.setNumThreads(numThreads);
+
+    t = 0.0;
+
+    for (uint i = 0; i < numSteps; ++i) {
+      flocking.update(0.1);
+
+      t += flocking.lastTime();
+    }
+
+    coords.clear();
+
+    for (auto *boid : flocking.getBoids()) {
+      const auto &p = boid->getPos();
+
+      coords.push_back(p.getX());
+      coords.push_back(p.getY());
+      coords.push_back(p.getZ());
+    }
+  };
+
+  // always use at least 2 threads so determinism is checked
+  auto maxThreads = std::max(CThreadPool::hardwareThreads(), size_t(2));
+
+  char buffer[256];
+
+  snprintf(buffer, sizeof(buffer), "boids %u steps %u", numBoids, numSteps);
+
+  std::string str = buffer;
+
+  std::vector<double> coords1, coords;
+
+  bool same = true;
+
+  for (size_t n = 1; ; n = std::min(2*n, maxThreads)) {
+    double t;
+
+    runFlocking(n, t, (n == 1 ? coords1 : coords));
+
+    if (n > 1 && coords != coords1)
+      same = false;
+
+    snprintf(buffer, sizeof(buffer), " threads %zu %.0f boids/s",
+             n, t > 0.0 ? 1000.0*numBoids*numSteps/t : 0.0);
+
+    str += buffer;
+
+    if (n >= maxThreads)
+      break;
+  }
+
+  str += (same ? " deterministic 1" : " deterministic 0");
+
+  CFlock::setWorldSize(worldSize);
+
+  return str;
+}
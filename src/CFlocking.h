@@ -12,15 +12,27 @@
 #include <CMatrix3D.h>
 #include <CRGBA.h>
 
+#include <string>
+
+class CThreadPool;
+
 class CFlocking {
  public:
   using FlockList = std::vector<CFlock *>;
   using BoidList  = std::vector<CBoid *>;
 
  public:
-  CFlocking();
+  // seed 0 uses random seed
+  explicit CFlocking(uint numBoids=200, uint seed=0);
  ~CFlocking();
 
+  //! get/set number of update threads (0 is hardware concurrency)
+  size_t numThreads() const;
+  void setNumThreads(size_t n);
+
+  //! time (ms) of last update
+  double lastTime() const { return lastTime_; }
+
   const uint &numBoids() const { return numBoids_; }
   void setNumBoids(const uint &n) { numBoids_ = n; createBoids(); }
 
@@ -37,19 +49,23 @@ class CFlocking {
 
   void getObjects(std::vector<CGeomObject3D *> &objects);
 
+  //! boids/second for 1 to hardware threads and check results match
+  static std::string benchmark(uint numBoids, uint numSteps);
+
  private:
   void createBoids();
 
-  void updateFlock(CFlock *flock, double dt);
-
   void addFlockObjects(CFlock *flock, std::vector<CGeomObject3D *> &objects);
 
  private:
-  uint           numBoids_ { 200 };
+  uint           numBoids_  { 200 };
   uint           numFlocks_ { 4 };
+  uint           seed_      { 0 };
   FlockList      flocks_;
   BoidList       boids_;
-  CGeomObject3D *object_ { nullptr };
+  CGeomObject3D *object_    { nullptr };
+  CThreadPool*   pool_      { nullptr };
+  double         lastTime_  { 0.0 };
 };
 
 #endif
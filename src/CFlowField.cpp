@@ -0,0 +1,475 @@
+#include <CFlowField.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+CFlowField::
+CFlowField(int nx, int ny)
+{
+  resize(nx, ny);
+}
+
+void
+CFlowField::
+resize(int nx, int ny)
+{
+  nx_ = std::max(nx, 0);
+  ny_ = std::max(ny, 0);
+
+  auto n = size_t(nx_)*size_t(ny_);
+
+  flags_.assign(n, 0);
+
+  costs_.clear();
+  goals_.clear();
+
+  dist_.assign(n, INF);
+  next_.assign(n, -1);
+
+  goalsValid_ = false;
+}
+
+void
+CFlowField::
+setBlocked(int x, int y, bool b)
+{
+  if (isBlocked(x, y) == b)
+    return;
+
+  int i = cellInd(x, y);
+
+  numUpdated_ = 0;
+
+  if (b) {
+    flags_[size_t(i)] |= BLOCKED;
+
+    if (goalsValid_)
+      invalidateCell(i);
+  }
+  else {
+    flags_[size_t(i)] &= uint8_t(~BLOCKED);
+
+    if (goalsValid_)
+      improveCell(i);
+  }
+}
+
+double
+CFlowField::
+cost(int x, int y) const
+{
+  return cellCost(cellInd(x, y));
+}
+
+void
+CFlowField::
+setCost(int x, int y, double c)
+{
+  c = std::max(c, 0.0);
+
+  int i = cellInd(x, y);
+
+  auto oldCost = cellCost(i);
+
+  if (c == oldCost)
+    return;
+
+  if (costs_.empty())
+    costs_.assign(size_t(numCells()), 1.0f);
+
+  costs_[size_t(i)] = float(c);
+
+  numUpdated_ = 0;
+
+  if (! goalsValid_ || ! isOpen(i) || dist_[size_t(i)] >= INF)
+    return;
+
+  // cost is paid entering cell so only affects cells which step into it
+  if (c > oldCost) {
+    // invalidate cells whose path enters cell (cell is reseeded unchanged)
+    invalidateCell(i);
+  }
+  else {
+    heap_.clear();
+
+    heap_.emplace_back(dist_[size_t(i)], i);
+
+    propagate();
+  }
+}
+
+void
+CFlowField::
+clearGoals()
+{
+  for (auto i : goals_)
+    flags_[size_t(i)] &= uint8_t(~GOAL);
+
+  goals_.clear();
+
+  goalsValid_ = false;
+}
+
+void
+CFlowField::
+addGoal(int x, int y)
+{
+  int i = cellInd(x, y);
+
+  if (flags_[size_t(i)] & GOAL)
+    return;
+
+  flags_[size_t(i)] |= GOAL;
+
+  goals_.push_back(i);
+
+  goalsValid_ = false;
+}
+
+void
+CFlowField::
+update()
+{
+  if (goalsValid_)
+    return;
+
+  calcField(dist_, next_);
+
+  numUpdated_ = uint(numCells());
+
+  goalsValid_ = true;
+}
+
+double
+CFlowField::
+distance(int x, int y) const
+{
+  if (! goalsValid_ || ! isValid(x, y))
+    return -1.0;
+
+  auto d = dist_[size_t(cellInd(x, y))];
+
+  return (d < INF ? d : -1.0);
+}
+
+bool
+CFlowField::
+nextCell(int x, int y, int &x1, int &y1) const
+{
+  if (! goalsValid_ || ! isValid(x, y))
+    return false;
+
+  int i = next_[size_t(cellInd(x, y))];
+
+  if (i < 0)
+    return false;
+
+  x1 = cellX(i);
+  y1 = cellY(i);
+
+  return true;
+}
+
+//---
+
+void
+CFlowField::
+calcField(Values &dist, Inds &next) const
+{
+  dist.assign(size_t(numCells()), INF);
+  next.assign(size_t(numCells()), -1);
+
+  Heap heap;
+
+  for (auto i : goals_) {
+    if (! isOpen(i))
+      continue;
+
+    dist[size_t(i)] = 0.0;
+
+    heap.emplace_back(0.0, i);
+  }
+
+  std::make_heap(heap.begin(), heap.end());
+
+  while (! heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end());
+
+    auto item = heap.back();
+
+    heap.pop_back();
+
+    if (item.dist > dist[size_t(item.ind)])
+      continue;
+
+    auto d = item.dist + cellCost(item.ind);
+
+    visitNeighbours(item.ind, [&](int i1) {
+      if (isOpen(i1) && d < dist[size_t(i1)]) {
+        dist[size_t(i1)] = d;
+        next[size_t(i1)] = item.ind;
+
+        heap.emplace_back(d, i1);
+
+        std::push_heap(heap.begin(), heap.end());
+      }
+    });
+  }
+}
+
+void
+CFlowField::
+invalidateCell(int i)
+{
+  // collect cell and all cells whose path passes through it
+  work_.clear();
+
+  work_.push_back(i);
+
+  flags_[size_t(i)] |= MARKED;
+
+  for (size_t j = 0; j < work_.size(); ++j) {
+    int i1 = work_[j];
+
+    visitNeighbours(i1, [&](int i2) {
+      if (next_[size_t(i2)] == i1 && ! (flags_[size_t(i2)] & MARKED)) {
+        flags_[size_t(i2)] |= MARKED;
+
+        work_.push_back(i2);
+      }
+    });
+  }
+
+  for (auto i1 : work_) {
+    dist_[size_t(i1)] = INF;
+    next_[size_t(i1)] = -1;
+  }
+
+  // reseed invalidated cells from best unaffected neighbour
+  heap_.clear();
+
+  for (auto i1 : work_) {
+    if (! isOpen(i1))
+      continue;
+
+    if (flags_[size_t(i1)] & GOAL) {
+      pushCell(i1, 0.0, -1);
+      continue;
+    }
+
+    visitNeighbours(i1, [&](int i2) {
+      if (! isOpen(i2) || (flags_[size_t(i2)] & MARKED) || dist_[size_t(i2)] >= INF)
+        return;
+
+      auto d = dist_[size_t(i2)] + cellCost(i2);
+
+      if (d < dist_[size_t(i1)])
+        pushCell(i1, d, i2);
+    });
+  }
+
+  for (auto i1 : work_)
+    flags_[size_t(i1)] &= uint8_t(~MARKED);
+
+  numUpdated_ += uint(work_.size());
+
+  propagate();
+}
+
+void
+CFlowField::
+improveCell(int i)
+{
+  heap_.clear();
+
+  if (flags_[size_t(i)] & GOAL)
+    pushCell(i, 0.0, -1);
+  else {
+    visitNeighbours(i, [&](int i1) {
+      if (! isOpen(i1) || dist_[size_t(i1)] >= INF)
+        return;
+
+      auto d = dist_[size_t(i1)] + cellCost(i1);
+
+      if (d < dist_[size_t(i)])
+        pushCell(i, d, i1);
+    });
+  }
+
+  propagate();
+}
+
+void
+CFlowField::
+pushCell(int i, double d, int next)
+{
+  dist_[size_t(i)] = d;
+  next_[size_t(i)] = next;
+
+  heap_.emplace_back(d, i);
+}
+
+void
+CFlowField::
+propagate()
+{
+  // dijkstra from queued cells, only decreasing distances
+  std::make_heap(heap_.begin(), heap_.end());
+
+  while (! heap_.empty()) {
+    std::pop_heap(heap_.begin(), heap_.end());
+
+    auto item = heap_.back();
+
+    heap_.pop_back();
+
+    if (item.dist > dist_[size_t(item.ind)])
+      continue;
+
+    ++numUpdated_;
+
+    auto d = item.dist + cellCost(item.ind);
+
+    visitNeighbours(item.ind, [&](int i1) {
+      if (isOpen(i1) && d < dist_[size_t(i1)]) {
+        dist_[size_t(i1)] = d;
+        next_[size_t(i1)] = item.ind;
+
+        heap_.emplace_back(d, i1);
+
+        std::push_heap(heap_.begin(), heap_.end());
+      }
+    });
+  }
+}
+
+//---
+
+bool
+CFlowField::
+verify() const
+{
+  if (! goalsValid_)
+    return true;
+
+  Values dist;
+  Inds   next;
+
+  calcField(dist, next);
+
+  auto isSame = [](double d1, double d2) {
+    if (d1 >= INF || d2 >= INF)
+      return (d1 >= INF && d2 >= INF);
+
+    return std::abs(d1 - d2) <= 1E-9*(1.0 + std::abs(d1));
+  };
+
+  for (int i = 0; i < numCells(); ++i) {
+    auto d = dist_[size_t(i)];
+
+    if (! isSame(d, dist[size_t(i)]))
+      return false;
+
+    // next cell must be an open neighbour on a shortest path
+    int i1 = next_[size_t(i)];
+
+    if (i1 < 0) {
+      if (d < INF && ! (flags_[size_t(i)] & GOAL))
+        return false;
+
+      continue;
+    }
+
+    if (! isOpen(i1) || std::abs(cellX(i1) - cellX(i)) + std::abs(cellY(i1) - cellY(i)) != 1)
+      return false;
+
+    if (! isSame(d, dist_[size_t(i1)] + cellCost(i1)))
+      return false;
+  }
+
+  return true;
+}
+
+std::string
+CFlowField::
+benchmark(int maxSize, int numChanges)
+{
+  using Clock = std::chrono::steady_clock;
+
+  maxSize    = std::max(maxSize, 16);
+  numChanges = std::max(numChanges, 1);
+
+  // fixed seed random numbers
+  uint64_t rand = 1;
+
+  auto randInt = [&](int n) {
+    rand = rand*6364136223846793005ULL + 1442695040888963407ULL;
+
+    return int((rand >> 33) % uint64_t(n));
+  };
+
+  auto msecs = [](const Clock::time_point &t1) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t1).count();
+  };
+
+  char buffer[256];
+
+  std::string str;
+
+  bool consistent = true;
+
+  for (int n = 16; n <= maxSize; n *= 2) {
+    // 15% blocked cells, goal is right column
+    CFlowField field(n, n);
+
+    for (int y = 0; y < n; ++y) {
+      for (int x = 0; x < n - 1; ++x)
+        field.setBlocked(x, y, randInt(100) < 15);
+
+      field.addGoal(n - 1, y);
+    }
+
+    auto t = Clock::now();
+
+    field.update();
+
+    auto fullTime = msecs(t);
+
+    // block then unblock random cells
+    double changeTime  = 0.0;
+    size_t changeCells = 0;
+
+    for (int i = 0; i < numChanges; ++i) {
+      int x = randInt(n - 1), y = randInt(n);
+
+      bool blocked = field.isBlocked(x, y);
+
+      for (int j = 0; j < 2; ++j) {
+        blocked = ! blocked;
+
+        t = Clock::now();
+
+        field.setBlocked(x, y, blocked);
+
+        changeTime += msecs(t);
+
+        changeCells += field.numUpdated();
+      }
+    }
+
+    if (! field.verify())
+      consistent = false;
+
+    snprintf(buffer, sizeof(buffer), "%ssize %d full %.3fms change %.4fms (%zu cells)",
+             str.empty() ? "" : " ", n, fullTime, changeTime/(2*numChanges),
+             changeCells/size_t(2*numChanges));
+
+    str += buffer;
+  }
+
+  str += (consistent ? " consistent 1" : " consistent 0");
+
+  return str;
+}
@@ -0,0 +1,139 @@
+#ifndef CFLOW_FIELD_H
+#define CFLOW_FIELD_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// shared distance field to a set of goal cells on a 2D grid (4 way moves)
+//
+// every reachable cell stores its cost to the nearest goal and the neighbour cell
+// on that path, so any number of agents can get their next step in O(1).
+//
+// blocking, unblocking or changing the cost of a cell only updates the cells whose
+// distance changes: blocking (or increasing cost) invalidates the cells whose path
+// went through the cell and re-runs Dijkstra from the valid cells bordering them,
+// unblocking (or decreasing cost) runs Dijkstra outward from the cell while distances
+// improve.
+class CFlowField {
+ public:
+  using Cells = std::vector<int>;
+
+ public:
+  CFlowField(int nx=0, int ny=0);
+
+  // get/set size (resizing clears blocked cells, costs and goals)
+  int nx() const { return nx_; }
+  int ny() const { return ny_; }
+
+  void resize(int nx, int ny);
+
+  int numCells() const { return nx_*ny_; }
+
+  // convert between cell coords and index
+  int cellInd(int x, int y) const { return y*nx_ + x; }
+
+  int cellX(int i) const { return i % nx_; }
+  int cellY(int i) const { return i / nx_; }
+
+  bool isValid(int x, int y) const { return (x >= 0 && x < nx_ && y >= 0 && y < ny_); }
+
+  // get/set cell blocked (updates field)
+  bool isBlocked(int x, int y) const { return (flags_[size_t(cellInd(x, y))] & BLOCKED); }
+  void setBlocked(int x, int y, bool b);
+
+  // get/set cost to enter cell (updates field)
+  double cost(int x, int y) const;
+  void setCost(int x, int y, double c);
+
+  // set goal cells (field is recalculated on next update)
+  void clearGoals();
+  void addGoal(int x, int y);
+
+  const Cells &goals() const { return goals_; }
+
+  // recalculate whole field if goals changed
+  void update();
+
+  // cost from cell to nearest goal (-1 if unreachable)
+  double distance(int x, int y) const;
+
+  bool isReachable(int x, int y) const { return distance(x, y) >= 0.0; }
+
+  // next cell on path to nearest goal (false if at goal or unreachable)
+  bool nextCell(int x, int y, int &x1, int &y1) const;
+
+  // number of cells updated by last change
+  uint numUpdated() const { return numUpdated_; }
+
+  // check field matches full recalculation
+  bool verify() const;
+
+  // time incremental updates against full recalculation for range of grid sizes
+  static std::string benchmark(int maxSize, int numChanges);
+
+ private:
+  enum Flags : uint8_t {
+    BLOCKED = (1<<0),
+    GOAL    = (1<<1),
+    MARKED  = (1<<2)
+  };
+
+  struct HeapItem {
+    double dist { 0.0 };
+    int    ind  { 0 };
+
+    HeapItem(double dist, int ind) : dist(dist), ind(ind) { }
+
+    friend bool operator<(const HeapItem &lhs, const HeapItem &rhs) {
+      // reversed for min heap
+      return (lhs.dist != rhs.dist ? lhs.dist > rhs.dist : lhs.ind > rhs.ind);
+    }
+  };
+
+  using Flags8   = std::vector<uint8_t>;
+  using Costs    = std::vector<float>;
+  using Values   = std::vector<double>;
+  using Inds     = std::vector<int>;
+  using Heap     = std::vector<HeapItem>;
+
+  double cellCost(int i) const { return (costs_.empty() ? 1.0 : double(costs_[size_t(i)])); }
+
+  bool isOpen(int i) const { return ! (flags_[size_t(i)] & BLOCKED); }
+
+  template<typename PROC>
+  void visitNeighbours(int i, PROC proc) const {
+    int x = cellX(i), y = cellY(i);
+
+    if (x > 0      ) proc(i - 1  );
+    if (x < nx_ - 1) proc(i + 1  );
+    if (y > 0      ) proc(i - nx_);
+    if (y < ny_ - 1) proc(i + nx_);
+  }
+
+  void calcField(Values &dist, Inds &next) const;
+
+  void invalidateCell(int i);
+  void improveCell(int i);
+
+  void pushCell(int i, double d, int next);
+
+  void propagate();
+
+ private:
+  static constexpr double INF = 1E300;
+
+  int    nx_         { 0 };
+  int    ny_         { 0 };
+  Flags8 flags_;            // blocked, goal and work flags per cell
+  Costs  costs_;            // cost to enter per cell (empty if all 1)
+  Cells  goals_;            // goal cells
+  bool   goalsValid_ { false };
+  Values dist_;             // cost to nearest goal
+  Inds   next_;             // next cell to nearest goal (-1 for goal/unreachable)
+  Heap   heap_;             // dijkstra work queue (stale items skipped)
+  Inds   work_;             // invalidated cells
+  uint   numUpdated_ { 0 };
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define CForceDirected3D_H
 
 #include <Springy3D.h>
+#include <CMultilevelLayout3D.h>
 
 /*!
  * \brief Force directed graph data
@@ -35,6 +36,19 @@ class CForceDirected3D {
   void setCenterAttract(double r) {
     centerAttract_ = r; if (layout_) layout_->setCenterAttract(centerAttract_); }
 
+  bool isBarnesHut() const { return barnesHut_; }
+  void setBarnesHut(bool b) { barnesHut_ = b; if (layout_) layout_->setBarnesHut(barnesHut_); }
+
+  double theta() const { return theta_; }
+  void setTheta(double r) { theta_ = r; if (layout_) layout_->setTheta(theta_); }
+
+  // relative error of Barnes-Hut repulsion compared to exact calculation
+  double barnesHutError() {
+    init();
+
+    return layout_->barnesHutError();
+  }
+
   void resetPlacement() {
     layout_->resetNodes();
   }
@@ -134,6 +148,51 @@ class CForceDirected3D {
     layout_->calcRange(xmin, ymin, zmin, xmax, ymax, zmax);
   }
 
+  // place nodes using multilevel layout
+  void multilevelLayout(CMultilevelLayout3D &multilevel) {
+    init();
+
+    Springy3D::Nodes            nodes;
+    CMultilevelLayout3D::Inds   fromNodes, toNodes;
+    CMultilevelLayout3D::Points points;
+
+    layoutGraph(nodes, fromNodes, toNodes);
+
+    multilevel.setGraph(uint(nodes.size()), fromNodes, toNodes);
+
+    multilevel.layout(points);
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      const auto &p = points[i];
+
+      auto point = layout_->nodePoint(nodes[i]);
+
+      point->setP(Springy3D::Vector(p.x, p.y, p.z));
+      point->setV(Springy3D::Vector());
+    }
+  }
+
+  // normalized stress of current node positions
+  double stress() const {
+    init();
+
+    Springy3D::Nodes            nodes;
+    CMultilevelLayout3D::Inds   fromNodes, toNodes;
+    CMultilevelLayout3D::Points points;
+
+    layoutGraph(nodes, fromNodes, toNodes);
+
+    points.resize(nodes.size());
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      const auto &p = layout_->nodePoint(nodes[i])->p();
+
+      points[i] = CMultilevelLayout3D::Point{p.x(), p.y(), p.z()};
+    }
+
+    return CMultilevelLayout3D::stress(uint(nodes.size()), fromNodes, toNodes, points);
+  }
+
 #if 0
   void adjustRange(double &xmin, double &ymin, double &zmin,
                    double &xmax, double &ymax, double &zmax) {
@@ -144,6 +203,22 @@ class CForceDirected3D {
 #endif
 
  protected:
+  // nodes and edges (as node indices) for multilevel layout
+  void layoutGraph(Springy3D::Nodes &nodes, CMultilevelLayout3D::Inds &fromNodes,
+                   CMultilevelLayout3D::Inds &toNodes) const {
+    nodes = graph_->nodes();
+
+    std::map<int, uint> nodeInd;
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+      nodeInd[nodes[i]->id()] = uint(i);
+
+    for (const auto &edge : graph_->edges()) {
+      fromNodes.push_back(nodeInd[edge->source()->id()]);
+      toNodes  .push_back(nodeInd[edge->target()->id()]);
+    }
+  }
+
   void init() const {
     if (! initialized_) {
       auto *th = const_cast<CForceDirected3D *>(this);
@@ -163,6 +238,8 @@ class CForceDirected3D {
     auto *layout = new Springy3D::Layout(graph_.get(), stiffness_, repulsion_, damping_);
 
     layout->setCenterAttract(centerAttract_);
+    layout->setBarnesHut    (barnesHut_);
+    layout->setTheta        (theta_);
 
     return LayoutP(layout);
   }
@@ -172,6 +249,8 @@ class CForceDirected3D {
   double  repulsion_     { 400.0 };
   double  damping_       { 0.5 };
   double  centerAttract_ { 50.0 };
+  bool    barnesHut_     { false };
+  double  theta_         { 0.7 };
   bool    initialized_   { false };
   GraphP  graph_;
   LayoutP layout_;
@@ -0,0 +1,257 @@
+#include <CForceDirectedThread3D.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+CForceDirectedThread3D::
+CForceDirectedThread3D(CForceDirected3D *forceDirected) :
+ forceDirected_(forceDirected)
+{
+}
+
+CForceDirectedThread3D::
+~CForceDirectedThread3D()
+{
+  stop();
+}
+
+void
+CForceDirectedThread3D::
+setForceDirected(CForceDirected3D *forceDirected)
+{
+  Pause pause(this);
+
+  forceDirected_ = forceDirected;
+  pointsValid_   = false;
+}
+
+void
+CForceDirectedThread3D::
+start()
+{
+  if (isRunning() || ! forceDirected_)
+    return;
+
+  initPoints();
+
+  stop_ = false;
+
+  converged_.store(false, std::memory_order_relaxed);
+
+  thread_ = std::thread([this]() { run(); });
+}
+
+void
+CForceDirectedThread3D::
+stop()
+{
+  if (! isRunning())
+    return;
+
+  {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  stop_ = true;
+  }
+
+  cond_.notify_all();
+
+  thread_.join();
+
+  stepsPerSecond_.store(0.0, std::memory_order_relaxed);
+}
+
+double
+CForceDirectedThread3D::
+step()
+{
+  if (! forceDirected_)
+    return 0.0;
+
+  initPoints();
+
+  auto delta = forceDirected_->step(stepSize_);
+
+  numSteps_.fetch_add(1, std::memory_order_relaxed);
+
+  publish();
+
+  return delta;
+}
+
+void
+CForceDirectedThread3D::
+update()
+{
+  if (! forceDirected_)
+    return;
+
+  initPoints();
+
+  publish();
+}
+
+void
+CForceDirectedThread3D::
+initPoints()
+{
+  if (pointsValid_)
+    return;
+
+  // cache point of each node and node indices of each edge
+  auto nodes = forceDirected_->nodes();
+
+  std::map<int, uint> nodeInd;
+
+  points_.resize(nodes.size());
+
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    nodeInd[nodes[i]->id()] = uint(i);
+
+    points_[i] = forceDirected_->point(nodes[i]);
+  }
+
+  auto edges = forceDirected_->edges();
+
+  edgeNodes_.resize(2*edges.size());
+
+  for (size_t i = 0; i < edges.size(); ++i) {
+    edgeNodes_[2*i    ] = nodeInd[edges[i]->source()->id()];
+    edgeNodes_[2*i + 1] = nodeInd[edges[i]->target()->id()];
+  }
+
+  pointsValid_ = true;
+}
+
+void
+CForceDirectedThread3D::
+publish()
+{
+  auto &snapshot = snapshots_.writeBuffer();
+
+  auto nn = points_.size();
+  auto nl = edgeNodes_.size();
+
+  snapshot.points    .resize(3*nn);
+  snapshot.linePoints.resize(3*nl);
+
+  snapshot.step = numSteps();
+
+  if (nn == 0) {
+    snapshots_.publish();
+    return;
+  }
+
+  // map range to -0.45 to 0.45 (each axis)
+  double min[3], max[3];
+
+  for (int j = 0; j < 3; ++j) {
+    min[j] =  1e100;
+    max[j] = -1e100;
+  }
+
+  for (size_t i = 0; i < nn; ++i) {
+    const auto &p = points_[i]->p();
+
+    double xyz[3] = { p.x(), p.y(), p.z() };
+
+    for (int j = 0; j < 3; ++j) {
+      min[j] = std::min(min[j], xyz[j]);
+      max[j] = std::max(max[j], xyz[j]);
+    }
+  }
+
+  double scale[3];
+
+  for (int j = 0; j < 3; ++j) {
+    if (max[j] == min[j])
+      max[j] = min[j] + 0.01;
+
+    scale[j] = 0.9/(max[j] - min[j]);
+  }
+
+  auto *points = snapshot.points.data();
+
+  for (size_t i = 0; i < nn; ++i) {
+    const auto &p = points_[i]->p();
+
+    points[3*i    ] = float((p.x() - min[0])*scale[0] - 0.45);
+    points[3*i + 1] = float((p.y() - min[1])*scale[1] - 0.45);
+    points[3*i + 2] = float((p.z() - min[2])*scale[2] - 0.45);
+  }
+
+  auto *linePoints = snapshot.linePoints.data();
+
+  for (size_t i = 0; i < nl; ++i) {
+    const auto *p = &points[3*edgeNodes_[i]];
+
+    linePoints[3*i    ] = p[0];
+    linePoints[3*i + 1] = p[1];
+    linePoints[3*i + 2] = p[2];
+  }
+
+  snapshots_.publish();
+}
+
+void
+CForceDirectedThread3D::
+run()
+{
+  using Clock = std::chrono::steady_clock;
+
+  auto msecs = [](const Clock::time_point &t1, const Clock::time_point &t2) {
+    return std::chrono::duration<double, std::milli>(t2 - t1).count();
+  };
+
+  auto nn = std::max(points_.size(), size_t(1));
+
+  auto rateTime    = Clock::now();
+  auto rateSteps   = numSteps();
+  auto publishTime = rateTime;
+
+  for (;;) {
+    {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (stop_)
+      return;
+    }
+
+    auto delta = forceDirected_->step(stepSize_);
+
+    numSteps_.fetch_add(1, std::memory_order_relaxed);
+
+    bool converged = (delta/double(nn) < tolerance_);
+
+    // limit snapshot rate (always publish final positions)
+    auto t = Clock::now();
+
+    if (converged || msecs(publishTime, t) >= publishInterval_) {
+      publish();
+
+      publishTime = t;
+    }
+
+    auto dt = msecs(rateTime, t);
+
+    if (dt >= 500.0) {
+      stepsPerSecond_.store(1000.0*double(numSteps() - rateSteps)/dt, std::memory_order_relaxed);
+
+      rateTime  = t;
+      rateSteps = numSteps();
+    }
+
+    // idle until stopped
+    if (converged) {
+      converged_     .store(true, std::memory_order_relaxed);
+      stepsPerSecond_.store(0.0 , std::memory_order_relaxed);
+
+      std::unique_lock<std::mutex> lock(mutex_);
+
+      cond_.wait(lock, [&]() { return stop_; });
+
+      return;
+    }
+  }
+}
@@ -0,0 +1,142 @@
+#ifndef CForceDirectedThread3D_H
+#define CForceDirectedThread3D_H
+
+#include <CForceDirected3D.h>
+#include <CTripleBuffer.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+// runs force directed layout steps on a worker thread
+//
+// after each step the node positions (mapped into the -0.45 to 0.45 cube) and the edge line
+// end points are written to a snapshot which is published through a triple buffer, so the
+// render thread only picks up the newest snapshot and never waits for the layout.
+//
+// the graph and layout must not be accessed by other threads while the worker is running
+// (use Pause to stop it while the graph is changed). Layout stops (idles) when the average
+// node move of a step is below the tolerance.
+class CForceDirectedThread3D {
+ public:
+  using Coords = std::vector<float>; // x, y, z triples
+
+  struct Snapshot {
+    Coords   points;     // node positions
+    Coords   linePoints; // edge end positions (two per edge)
+    uint64_t step { 0 }; // layout step of snapshot
+  };
+
+  // stops thread for scope (restarting if it was running)
+  class Pause {
+   public:
+    Pause(CForceDirectedThread3D *thread) :
+     thread_(thread), running_(thread && thread->isRunning()) {
+      if (running_)
+        thread_->stop();
+    }
+
+   ~Pause() {
+      if (running_)
+        thread_->start();
+    }
+
+    Pause(const Pause &) = delete;
+    Pause &operator=(const Pause &) = delete;
+
+   private:
+    CForceDirectedThread3D* thread_  { nullptr };
+    bool                    running_ { false };
+  };
+
+ public:
+  CForceDirectedThread3D(CForceDirected3D *forceDirected=nullptr);
+
+ ~CForceDirectedThread3D();
+
+  CForceDirectedThread3D(const CForceDirectedThread3D &) = delete;
+  CForceDirectedThread3D &operator=(const CForceDirectedThread3D &) = delete;
+
+  CForceDirected3D *forceDirected() const { return forceDirected_; }
+  void setForceDirected(CForceDirected3D *forceDirected);
+
+  //! get/set step size
+  double stepSize() const { return stepSize_; }
+  void setStepSize(double r) { stepSize_ = r; }
+
+  //! get/set average node move below which layout is converged
+  double tolerance() const { return tolerance_; }
+  void setTolerance(double r) { tolerance_ = r; }
+
+  //! get/set min time between published snapshots (ms)
+  double publishInterval() const { return publishInterval_; }
+  void setPublishInterval(double r) { publishInterval_ = r; }
+
+  //---
+
+  bool isRunning() const { return thread_.joinable(); }
+
+  // start/stop worker thread
+  void start();
+  void stop();
+
+  // step and publish on calling thread (thread must not be running)
+  double step();
+
+  // publish current positions (thread must not be running)
+  void update();
+
+  //---
+
+  // reader: get newest snapshot (false if unchanged since last acquire)
+  bool acquire() { return snapshots_.acquire(); }
+
+  const Snapshot &snapshot() const { return snapshots_.readBuffer(); }
+
+  //---
+
+  uint64_t numSteps() const { return numSteps_.load(std::memory_order_relaxed); }
+
+  // steps per second (over last half second of running)
+  double stepsPerSecond() const { return stepsPerSecond_.load(std::memory_order_relaxed); }
+
+  bool isConverged() const { return converged_.load(std::memory_order_relaxed); }
+
+ private:
+  using PointP  = CForceDirected3D::PointP;
+  using PointPs = std::vector<PointP>;
+  using Inds    = std::vector<uint>;
+
+  void initPoints();
+
+  void publish();
+
+  void run();
+
+ private:
+  CForceDirected3D* forceDirected_   { nullptr };
+  double            stepSize_        { 0.01 };
+  double            tolerance_       { 1e-5 };
+  double            publishInterval_ { 5.0 };
+
+  // cached layout points and edge node indices (graph is fixed while running)
+  PointPs points_;
+  Inds    edgeNodes_;
+  bool    pointsValid_ { false };
+
+  CTripleBuffer<Snapshot> snapshots_;
+
+  std::thread             thread_;
+  std::mutex              mutex_;
+  std::condition_variable cond_;
+  bool                    stop_ { false };
+
+  std::atomic<uint64_t> numSteps_       { 0 };
+  std::atomic<double>   stepsPerSecond_ { 0.0 };
+  std::atomic<bool>     converged_      { false };
+};
+
+#endif
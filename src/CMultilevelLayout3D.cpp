@@ -0,0 +1,509 @@
+#include <CMultilevelLayout3D.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+// spring electrical model constants (natural edge length and relative repulsion)
+const double K = 1.0;
+const double C = 0.2;
+
+// step length cooling factor
+const double COOL = 0.9;
+
+// use exact repulsion below this many nodes
+const uint EXACT_NODES = 256;
+
+}
+
+//---
+
+void
+CMultilevelLayout3D::
+setGraph(uint numNodes, const Inds &fromNodes, const Inds &toNodes)
+{
+  levels_.clear();
+
+  levels_.emplace_back();
+
+  Edges edges;
+
+  auto ne = std::min(fromNodes.size(), toNodes.size());
+
+  edges.reserve(ne);
+
+  for (size_t i = 0; i < ne; ++i) {
+    auto from = fromNodes[i];
+    auto to   = toNodes  [i];
+
+    if (from == to || from >= numNodes || to >= numNodes)
+      continue;
+
+    if (from > to)
+      std::swap(from, to);
+
+    edges.push_back(Edge{from, to, 1.0});
+  }
+
+  // duplicates count once
+  std::sort(edges.begin(), edges.end(), [](const Edge &e1, const Edge &e2) {
+    return (e1.from != e2.from ? e1.from < e2.from : e1.to < e2.to);
+  });
+
+  edges.erase(std::unique(edges.begin(), edges.end(), [](const Edge &e1, const Edge &e2) {
+    return (e1.from == e2.from && e1.to == e2.to);
+  }), edges.end());
+
+  auto &level = levels_.back();
+
+  buildLevel(numNodes, edges, level);
+
+  level.nodeWeight.assign(numNodes, 1.0);
+}
+
+void
+CMultilevelLayout3D::
+buildLevel(uint numNodes, Edges &edges, Level &level)
+{
+  // edges are unique (from < to), add arc for each direction
+  level.numNodes = numNodes;
+
+  level.arcStart.assign(numNodes + 1, 0);
+
+  for (const auto &edge : edges) {
+    ++level.arcStart[edge.from + 1];
+    ++level.arcStart[edge.to   + 1];
+  }
+
+  for (uint i = 0; i < numNodes; ++i)
+    level.arcStart[i + 1] += level.arcStart[i];
+
+  level.arcNode  .resize(level.arcStart[numNodes]);
+  level.arcWeight.resize(level.arcStart[numNodes]);
+
+  Inds pos(level.arcStart.begin(), level.arcStart.end() - 1);
+
+  for (const auto &edge : edges) {
+    level.arcNode  [pos[edge.from]] = edge.to;
+    level.arcWeight[pos[edge.from]] = edge.weight;
+
+    ++pos[edge.from];
+
+    level.arcNode  [pos[edge.to]] = edge.from;
+    level.arcWeight[pos[edge.to]] = edge.weight;
+
+    ++pos[edge.to];
+  }
+}
+
+bool
+CMultilevelLayout3D::
+coarsen(Level &fine, Level &coarse)
+{
+  static const uint NO_IND = uint(-1);
+
+  auto n = fine.numNodes;
+
+  // visit nodes in random order
+  Inds order(n);
+
+  std::iota(order.begin(), order.end(), 0);
+
+  for (uint i = n; i > 1; --i)
+    std::swap(order[i - 1], order[uint(randReal()*i) % i]);
+
+  // match with unmatched neighbor of heaviest edge (prefer light nodes to keep balanced)
+  Inds match(n, NO_IND);
+
+  for (auto u : order) {
+    if (match[u] != NO_IND)
+      continue;
+
+    auto   best      = NO_IND;
+    double bestScore = 0.0;
+
+    for (auto i = fine.arcStart[u]; i < fine.arcStart[u + 1]; ++i) {
+      auto v = fine.arcNode[i];
+
+      if (match[v] != NO_IND)
+        continue;
+
+      auto score = fine.arcWeight[i]/(fine.nodeWeight[u] + fine.nodeWeight[v]);
+
+      if (best == NO_IND || score > bestScore) {
+        best      = v;
+        bestScore = score;
+      }
+    }
+
+    if (best != NO_IND) {
+      match[u   ] = best;
+      match[best] = u;
+    }
+    else
+      match[u] = u;
+  }
+
+  //---
+
+  // number coarse nodes
+  fine.parent.assign(n, NO_IND);
+
+  uint nc = 0;
+
+  for (uint u = 0; u < n; ++u) {
+    if (fine.parent[u] != NO_IND)
+      continue;
+
+    fine.parent[u       ] = nc;
+    fine.parent[match[u]] = nc;
+
+    ++nc;
+  }
+
+  // stop if matching no longer shrinks graph (e.g. star)
+  if (nc > n - n/10)
+    return false;
+
+  coarse.nodeWeight.assign(nc, 0.0);
+
+  for (uint u = 0; u < n; ++u)
+    coarse.nodeWeight[fine.parent[u]] += fine.nodeWeight[u];
+
+  // merge edges between coarse nodes
+  Edges edges;
+
+  for (uint u = 0; u < n; ++u) {
+    auto cu = fine.parent[u];
+
+    for (auto i = fine.arcStart[u]; i < fine.arcStart[u + 1]; ++i) {
+      auto v = fine.arcNode[i];
+
+      if (v < u)
+        continue;
+
+      auto cv = fine.parent[v];
+
+      if (cu == cv)
+        continue;
+
+      edges.push_back(Edge{std::min(cu, cv), std::max(cu, cv), fine.arcWeight[i]});
+    }
+  }
+
+  std::sort(edges.begin(), edges.end(), [](const Edge &e1, const Edge &e2) {
+    return (e1.from != e2.from ? e1.from < e2.from : e1.to < e2.to);
+  });
+
+  size_t ne = 0;
+
+  for (const auto &edge : edges) {
+    if (ne > 0 && edges[ne - 1].from == edge.from && edges[ne - 1].to == edge.to)
+      edges[ne - 1].weight += edge.weight;
+    else
+      edges[ne++] = edge;
+  }
+
+  edges.resize(ne);
+
+  buildLevel(nc, edges, coarse);
+
+  return true;
+}
+
+void
+CMultilevelLayout3D::
+layout(Points &points)
+{
+  using Clock = std::chrono::steady_clock;
+
+  auto t = Clock::now();
+
+  numLevels_     = 0;
+  numIterations_ = 0;
+
+  points.clear();
+
+  if (levels_.empty() || levels_[0].numNodes == 0) {
+    time_ = 0.0;
+    return;
+  }
+
+  rand_ = 1;
+
+  // coarsen (keep finest level)
+  levels_.resize(1);
+
+  while (levels_.back().numNodes > minNodes_) {
+    Level coarse;
+
+    if (! coarsen(levels_.back(), coarse))
+      break;
+
+    levels_.push_back(std::move(coarse));
+  }
+
+  levels_.back().parent.clear();
+
+  numLevels_ = int(levels_.size());
+
+  //---
+
+  // coarsest level from random positions in cube with room for nodes
+  const auto &coarsest = levels_.back();
+
+  auto size = K*std::cbrt(double(coarsest.numNodes));
+
+  points.resize(coarsest.numNodes);
+
+  for (auto &p : points) {
+    p.x = size*(randReal() - 0.5);
+    p.y = size*(randReal() - 0.5);
+    p.z = size*(randReal() - 0.5);
+  }
+
+  numIterations_ += refine(coarsest, points, size/5.0, coarseIterations_);
+
+  // prolong to each finer level and refine
+  Points finePoints;
+
+  for (auto l = int(levels_.size()) - 2; l >= 0; --l) {
+    const auto &fine = levels_[size_t(l)];
+
+    auto scale = std::cbrt(double(fine.numNodes)/double(points.size()));
+
+    finePoints.resize(fine.numNodes);
+
+    // jitter so merged nodes separate
+    for (uint u = 0; u < fine.numNodes; ++u) {
+      const auto &p = points[fine.parent[u]];
+
+      auto &p1 = finePoints[u];
+
+      p1.x = scale*p.x + 0.1*K*(randReal() - 0.5);
+      p1.y = scale*p.y + 0.1*K*(randReal() - 0.5);
+      p1.z = scale*p.z + 0.1*K*(randReal() - 0.5);
+    }
+
+    points.swap(finePoints);
+
+    numIterations_ += refine(fine, points, K, refineIterations_);
+  }
+
+  // only finest level needed for next layout
+  levels_.resize(1);
+
+  time_ = std::chrono::duration<double, std::milli>(Clock::now() - t).count();
+}
+
+int
+CMultilevelLayout3D::
+refine(const Level &level, Points &points, double step, int maxIterations)
+{
+  // spring electrical model with adaptive step (Hu)
+  auto n = level.numNodes;
+
+  if (n < 2)
+    return 0;
+
+  auto cK2 = C*K*K;
+
+  auto kernel = [&](double dx, double dy, double dz, double w,
+                    double &fx, double &fy, double &fz) {
+    auto r2 = dx*dx + dy*dy + dz*dz;
+    if (r2 == 0.0) return;
+
+    auto f = cK2*w/r2;
+
+    fx += dx*f; fy += dy*f; fz += dz*f;
+  };
+
+  bool exact = (n <= EXACT_NODES);
+
+  double energy   = 1e100;
+  int    progress = 0;
+  int    iter     = 0;
+
+  for ( ; iter < maxIterations; ++iter) {
+    if (! exact) {
+      barnesHut_.clear();
+
+      for (const auto &p : points)
+        barnesHut_.addBody(p.x, p.y, p.z);
+
+      barnesHut_.build();
+    }
+
+    auto energy0 = energy;
+
+    energy = 0.0;
+
+    double moved = 0.0;
+
+    for (uint i = 0; i < n; ++i) {
+      auto &p = points[i];
+
+      double fx = 0.0, fy = 0.0, fz = 0.0;
+
+      // repulsion
+      if (exact) {
+        for (uint j = 0; j < n; ++j) {
+          if (j == i) continue;
+
+          const auto &p1 = points[j];
+
+          kernel(p.x - p1.x, p.y - p1.y, p.z - p1.z, 1.0, fx, fy, fz);
+        }
+      }
+      else
+        barnesHut_.accumulate(p.x, p.y, p.z, i, kernel, fx, fy, fz);
+
+      // attraction along edges (|d|^2/K)
+      for (auto a = level.arcStart[i]; a < level.arcStart[i + 1]; ++a) {
+        const auto &p1 = points[level.arcNode[a]];
+
+        auto dx = p1.x - p.x;
+        auto dy = p1.y - p.y;
+        auto dz = p1.z - p.z;
+
+        auto f = std::sqrt(dx*dx + dy*dy + dz*dz)/K;
+
+        fx += dx*f; fy += dy*f; fz += dz*f;
+      }
+
+      // move step along force direction
+      auto f2 = fx*fx + fy*fy + fz*fz;
+
+      if (f2 == 0.0)
+        continue;
+
+      auto f = std::sqrt(f2);
+
+      p.x += step*fx/f;
+      p.y += step*fy/f;
+      p.z += step*fz/f;
+
+      energy += f2;
+      moved  += step;
+    }
+
+    // grow step after consistent progress, otherwise cool
+    if (energy < energy0) {
+      if (++progress >= 5) {
+        progress = 0;
+        step    /= COOL;
+      }
+    }
+    else {
+      progress = 0;
+      step    *= COOL;
+    }
+
+    if (moved/n < tolerance_*K) {
+      ++iter;
+      break;
+    }
+  }
+
+  return iter;
+}
+
+double
+CMultilevelLayout3D::
+randReal()
+{
+  // fixed seed so layouts are repeatable
+  rand_ = rand_*6364136223846793005ULL + 1442695040888963407ULL;
+
+  return double(rand_ >> 11)/double(1ULL << 53);
+}
+
+//---
+
+double
+CMultilevelLayout3D::
+stress(uint numNodes, const Inds &fromNodes, const Inds &toNodes,
+       const Points &points, uint maxSources)
+{
+  if (numNodes < 2 || points.size() < numNodes || maxSources == 0)
+    return 0.0;
+
+  // undirected adjacency
+  Edges edges;
+
+  auto ne = std::min(fromNodes.size(), toNodes.size());
+
+  for (size_t i = 0; i < ne; ++i) {
+    if (fromNodes[i] != toNodes[i] && fromNodes[i] < numNodes && toNodes[i] < numNodes)
+      edges.push_back(Edge{fromNodes[i], toNodes[i], 1.0});
+  }
+
+  Level level;
+
+  buildLevel(numNodes, edges, level);
+
+  //---
+
+  // with e = |pi - pj| and d graph distance: stress(s) = sum((s*e - d)/d)^2
+  // = s^2*B - 2*s*A + N for A = sum(e/d), B = sum(e^2/d^2), so best s = A/B
+  double A = 0.0, B = 0.0, N = 0.0;
+
+  auto numSources = std::min(maxSources, numNodes);
+
+  Inds dist(numNodes), queue;
+
+  queue.reserve(numNodes);
+
+  for (uint s = 0; s < numSources; ++s) {
+    auto source = uint(uint64_t(s)*numNodes/numSources);
+
+    std::fill(dist.begin(), dist.end(), 0U);
+
+    queue.clear();
+
+    queue.push_back(source);
+
+    dist[source] = 1; // distance + 1 (0 is unvisited)
+
+    for (size_t i = 0; i < queue.size(); ++i) {
+      auto u = queue[i];
+
+      for (auto a = level.arcStart[u]; a < level.arcStart[u + 1]; ++a) {
+        auto v = level.arcNode[a];
+
+        if (dist[v] == 0) {
+          dist[v] = dist[u] + 1;
+
+          queue.push_back(v);
+        }
+      }
+    }
+
+    const auto &ps = points[source];
+
+    for (size_t i = 1; i < queue.size(); ++i) {
+      auto v = queue[i];
+
+      const auto &pv = points[v];
+
+      auto dx = pv.x - ps.x;
+      auto dy = pv.y - ps.y;
+      auto dz = pv.z - ps.z;
+
+      auto e = std::sqrt(dx*dx + dy*dy + dz*dz);
+      auto d = double(dist[v] - 1);
+
+      A += e/d;
+      B += e*e/(d*d);
+      N += 1.0;
+    }
+  }
+
+  if (N == 0.0 || B == 0.0)
+    return 0.0;
+
+  return (N - A*A/B)/N;
+}
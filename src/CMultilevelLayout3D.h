@@ -0,0 +1,113 @@
+#ifndef CMultilevelLayout3D_H
+#define CMultilevelLayout3D_H
+
+#include <CBarnesHut3D.h>
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// multilevel force directed 3D graph layout (Walshaw, Hu)
+//
+// the graph is repeatedly coarsened by matching each node with an unmatched neighbor
+// (heaviest edge to lightest node first) until it is small or stops shrinking. The
+// coarsest graph is laid out from random positions, then each finer level starts from
+// the positions of its coarse nodes (scaled for the extra nodes) and is refined with a
+// few iterations of a spring electrical model (Barnes-Hut repulsion) with an adaptive
+// step length. Edges are undirected with natural length one.
+class CMultilevelLayout3D {
+ public:
+  struct Point {
+    double x { 0.0 };
+    double y { 0.0 };
+    double z { 0.0 };
+  };
+
+  using Points = std::vector<Point>;
+  using Inds   = std::vector<uint>;
+
+ public:
+  CMultilevelLayout3D() { }
+
+  //! get/set node count to stop coarsening at
+  uint minNodes() const { return minNodes_; }
+  void setMinNodes(uint n) { minNodes_ = std::max(n, 2U); }
+
+  //! get/set max iterations for coarsest level
+  int coarseIterations() const { return coarseIterations_; }
+  void setCoarseIterations(int i) { coarseIterations_ = i; }
+
+  //! get/set max iterations for each refined level
+  int refineIterations() const { return refineIterations_; }
+  void setRefineIterations(int i) { refineIterations_ = i; }
+
+  //! get/set convergence tolerance (average move relative to edge length)
+  double tolerance() const { return tolerance_; }
+  void setTolerance(double r) { tolerance_ = r; }
+
+  //! get/set Barnes-Hut accuracy
+  double theta() const { return barnesHut_.theta(); }
+  void setTheta(double r) { barnesHut_.setTheta(r); }
+
+  // set graph (nodes 0..numNodes-1, self loops and duplicate edges ignored)
+  void setGraph(uint numNodes, const Inds &fromNodes, const Inds &toNodes);
+
+  // calculate positions for graph nodes
+  void layout(Points &points);
+
+  // stats of last layout
+  int    numLevels    () const { return numLevels_; }
+  int    numIterations() const { return numIterations_; }
+  double time         () const { return time_; } // ms
+
+  // normalized stress of positions (mean of ((s*|pi - pj| - dij)/dij)^2 over node pairs
+  // with graph distance dij and best fit scale s). Pairs are from at most maxSources
+  // (evenly spaced) source nodes.
+  static double stress(uint numNodes, const Inds &fromNodes, const Inds &toNodes,
+                       const Points &points, uint maxSources=100);
+
+ private:
+  using Reals = std::vector<double>;
+
+  // graph (symmetric compact adjacency) of each level
+  struct Level {
+    uint  numNodes { 0 };
+    Inds  arcStart;   // first arc per node (numNodes + 1)
+    Inds  arcNode;    // arc destination
+    Reals arcWeight;  // number of fine edges merged into arc
+    Reals nodeWeight; // number of fine nodes merged into node
+    Inds  parent;     // node in next coarser level
+  };
+
+  using Levels = std::vector<Level>;
+
+  struct Edge {
+    uint   from   { 0 };
+    uint   to     { 0 };
+    double weight { 1.0 };
+  };
+
+  using Edges = std::vector<Edge>;
+
+  static void buildLevel(uint numNodes, Edges &edges, Level &level);
+
+  bool coarsen(Level &fine, Level &coarse);
+
+  int refine(const Level &level, Points &points, double step, int maxIterations);
+
+  double randReal();
+
+ private:
+  uint         minNodes_         { 16 };
+  int          coarseIterations_ { 300 };
+  int          refineIterations_ { 60 };
+  double       tolerance_        { 0.01 };
+  Levels       levels_;
+  CBarnesHut3D barnesHut_;
+  uint64_t     rand_             { 1 };
+  int          numLevels_        { 0 };
+  int          numIterations_    { 0 };
+  double       time_             { 0.0 };
+};
+
+#endif
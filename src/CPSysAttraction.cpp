@@ -56,10 +56,24 @@ apply()
 {
   if (! b_) return;
 
+  apply(a_->store()->force);
+}
+
+void
+CPSysAttraction::
+apply(CPSysVectorArray &forces) const
+{
+  if (! b_) return;
+
   if (on_ && (a_->isFree() || b_->isFree())) {
-    double a2bX = a_->position()->x() - b_->position()->x();
-    double a2bY = a_->position()->y() - b_->position()->y();
-    double a2bZ = a_->position()->z() - b_->position()->z();
+    const auto &position = a_->store()->position;
+
+    auto ia = a_->ind();
+    auto ib = b_->ind();
+
+    double a2bX = position.x[ia] - position.x[ib];
+    double a2bY = position.y[ia] - position.y[ib];
+    double a2bZ = position.z[ia] - position.z[ib];
 
     double a2bDistanceSquared = a2bX*a2bX + a2bY*a2bY + a2bZ*a2bZ;
 
@@ -84,7 +98,12 @@ apply()
 
     // apply
 
-    if (a_->isFree()) a_->force()->add(-a2bX, -a2bY, -a2bZ);
-    if (b_->isFree()) b_->force()->add( a2bX,  a2bY,  a2bZ);
+    if (a_->isFree()) {
+      forces.x[ia] -= a2bX; forces.y[ia] -= a2bY; forces.z[ia] -= a2bZ;
+    }
+
+    if (b_->isFree()) {
+      forces.x[ib] += a2bX; forces.y[ib] += a2bY; forces.z[ib] += a2bZ;
+    }
   }
 }
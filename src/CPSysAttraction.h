@@ -36,6 +36,9 @@ class CPSysAttraction : public CPSysForce {
 
   void apply() override;
 
+  // add force to specified (per thread) force array
+  void apply(CPSysVectorArray &forces) const;
+
  private:
   uint           ind_                { 0 };
   CPSysParticle *a_                  { nullptr };
@@ -14,19 +14,26 @@ step(double t)
   s_->clearForces();
   s_->applyForces();
 
-  uint numParticles = s_->numberOfParticles();
+  auto &store = s_->store();
+
+  auto &position = store.position;
+  auto &velocity = store.velocity;
+  auto &force    = store.force;
+
+  uint numParticles = store.size();
 
   for (uint i = 0; i < numParticles; i++) {
-    auto *p = s_->getParticle(i);
+    if (! store.free[i])
+      continue;
+
+    double mt = store.mass[i]*t;
 
-    if (p->isFree()) {
-      p->velocity()->add(p->force()->x()/(p->mass()*t),
-                         p->force()->y()/(p->mass()*t),
-                         p->force()->z()/(p->mass()*t));
+    velocity.x[i] += force.x[i]/mt;
+    velocity.y[i] += force.y[i]/mt;
+    velocity.z[i] += force.z[i]/mt;
 
-      p->position()->add(p->velocity()->x()/t,
-                         p->velocity()->y()/t,
-                         p->velocity()->z()/t);
-    }
+    position.x[i] += velocity.x[i]/t;
+    position.y[i] += velocity.y[i]/t;
+    position.z[i] += velocity.z[i]/t;
   }
 }
@@ -16,19 +16,34 @@ step(double t)
 
   double halftt = 0.5*t*t;
 
-  uint numParticles = s_->numberOfParticles();
+  auto &store = s_->store();
+
+  auto &position = store.position;
+  auto &velocity = store.velocity;
+  auto &force    = store.force;
+
+  uint numParticles = store.size();
 
   for (uint i = 0; i < numParticles; i++) {
-    auto *p = s_->getParticle(i);
+    if (! store.free[i])
+      continue;
+
+    double m = store.mass[i];
+
+    double ax = force.x[i]/m;
+    double ay = force.y[i]/m;
+    double az = force.z[i]/m;
+
+    position.x[i] += velocity.x[i]/t;
+    position.y[i] += velocity.y[i]/t;
+    position.z[i] += velocity.z[i]/t;
 
-    if (p->isFree()) {
-      double ax = p->force()->x()/p->mass();
-      double ay = p->force()->y()/p->mass();
-      double az = p->force()->z()/p->mass();
+    position.x[i] += ax*halftt;
+    position.y[i] += ay*halftt;
+    position.z[i] += az*halftt;
 
-      p->position()->add(p->velocity()->x()/t, p->velocity()->y()/t, p->velocity()->z()/t);
-      p->position()->add(ax*halftt, ay*halftt, az*halftt);
-      p->velocity()->add(ax/t, ay/t, az/t);
-    }
+    velocity.x[i] += ax/t;
+    velocity.y[i] += ay/t;
+    velocity.z[i] += az/t;
   }
 }
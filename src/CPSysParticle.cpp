@@ -1,80 +1,136 @@
 #include <CPSysParticle.h>
 
 CPSysParticle::
-CPSysParticle(double m) :
- mass_(m)
+CPSysParticle(double m)
 {
-  position_ = new CPSysVector3D();
-  velocity_ = new CPSysVector3D();
-  force_    = new CPSysVector3D();
+  localStore_ = new CPSysParticleStore;
+  store_      = localStore_;
+
+  ind_ = store_->add(m);
 }
 
 CPSysParticle::
 CPSysParticle(const CPSysParticle &p)
 {
-  position_ = new CPSysVector3D();
-  velocity_ = new CPSysVector3D();
-  force_    = new CPSysVector3D();
-
-  *position_ = *p.position_;
-  *velocity_ = *p.velocity_;
-  *force_    = *p.force_;
-
-  mass_  = p.mass_;
-  age_   = p.age_;
-  dead_  = p.dead_;
-  fixed_ = p.fixed_;
+  localStore_ = new CPSysParticleStore;
+  store_      = localStore_;
+
+  ind_ = store_->add();
+
+  copyData(p);
 }
 
-double
+CPSysParticle &
 CPSysParticle::
-distanceTo(CPSysParticle *p) const
+operator=(const CPSysParticle &p)
 {
-  return position()->distanceTo(p->position());
+  if (&p != this)
+    copyData(p);
+
+  return *this;
+}
+
+CPSysParticle::
+~CPSysParticle()
+{
+  delete localStore_;
 }
 
 void
 CPSysParticle::
-makeFixed()
+copyData(const CPSysParticle &p)
 {
-  fixed_ = true;
+  auto pos = p.position();
+  auto vel = p.velocity();
+  auto f   = p.force();
+
+  setPosition(pos.x(), pos.y(), pos.z());
+  setVelocity(vel.x(), vel.y(), vel.z());
+  setForce   (f  .x(), f  .y(), f  .z());
+
+  setMass(p.mass());
 
-  velocity_->clear();
+  store_->free[ind_] = p.store_->free[p.ind_];
+
+  age_  = p.age_;
+  dead_ = p.dead_;
 }
 
 void
 CPSysParticle::
-makeFree()
+attach(CPSysParticleStore *store)
 {
-  fixed_ = false;
+  if (store == store_)
+    return;
+
+  auto pos    = position();
+  auto vel    = velocity();
+  auto f      = force();
+  auto m      = mass();
+  auto isFree = this->isFree();
+
+  store_ = store;
+  ind_   = store_->add(m);
+
+  setPosition(pos.x(), pos.y(), pos.z());
+  setVelocity(vel.x(), vel.y(), vel.z());
+  setForce   (f  .x(), f  .y(), f  .z());
+
+  store_->free[ind_] = isFree;
+
+  delete localStore_;
+
+  localStore_ = nullptr;
 }
 
 void
 CPSysParticle::
-setPosition(double x, double y, double z)
+detach()
 {
-  position_->set(x, y, z);
+  if (localStore_)
+    return;
+
+  auto pos    = position();
+  auto vel    = velocity();
+  auto f      = force();
+  auto m      = mass();
+  auto isFree = this->isFree();
+
+  localStore_ = new CPSysParticleStore;
+  store_      = localStore_;
+
+  ind_ = store_->add(m);
+
+  setPosition(pos.x(), pos.y(), pos.z());
+  setVelocity(vel.x(), vel.y(), vel.z());
+  setForce   (f  .x(), f  .y(), f  .z());
+
+  store_->free[ind_] = isFree;
 }
 
-void
+double
 CPSysParticle::
-setVelocity(double x, double y, double z)
+distanceTo(CPSysParticle *p) const
 {
-  velocity_->set(x, y, z);
+  auto p1 = p->position();
+
+  return position().distanceTo(p1.x(), p1.y(), p1.z());
 }
 
 void
 CPSysParticle::
-setForce(double x, double y, double z)
+makeFixed()
 {
-  force_->set(x, y, z);
+  store_->free[ind_] = 0;
+
+  setVelocity(0, 0, 0);
 }
 
 void
 CPSysParticle::
-setMass(double m)
+makeFree()
 {
-  mass_ = m;
+  store_->free[ind_] = 1;
 }
 
 void
@@ -84,9 +140,9 @@ reset()
   age_  = 0;
   dead_ = false;
 
-  position_->clear();
-  velocity_->clear();
-  force_   ->clear();
+  setPosition(0, 0, 0);
+  setVelocity(0, 0, 0);
+  setForce   (0, 0, 0);
 
-  mass_ = 1.0;
+  setMass(1.0);
 }
@@ -2,7 +2,11 @@
 #define CPSysParticle_H
 
 #include <CPSysVector3D.h>
+#include <CPSysParticleStore.h>
 
+// particle position, velocity, force, mass and free state live in a structure of
+// arrays store. A particle owns a single entry store until it is attached to a
+// system, it then references its entry in the system store.
 class CPSysParticle {
  public:
   CPSysParticle(double m=1.0);
@@ -11,22 +15,60 @@ class CPSysParticle {
 
   CPSysParticle &operator=(const CPSysParticle &p);
 
-  virtual ~CPSysParticle() { }
+  virtual ~CPSysParticle();
 
   const uint &ind() const { return ind_; }
   void setInd(const uint &v) { ind_ = v; }
 
-  CPSysVector3D *position() const { return position_; }
-  void setPosition(double x, double y, double z);
+  //---
+
+  CPSysParticleStore *store() const { return store_; }
+
+  // move particle data into (system) store
+  void attach(CPSysParticleStore *store);
+
+  // move particle data back into local store
+  void detach();
+
+  //---
+
+  CPSysVector3D position() const {
+    const auto &a = store_->position;
+    return CPSysVector3D(a.x[ind_], a.y[ind_], a.z[ind_]);
+  }
 
-  CPSysVector3D *velocity() const { return velocity_; }
-  void setVelocity(double x, double y, double z);
+  void setPosition(double x, double y, double z) {
+    auto &a = store_->position;
+    a.x[ind_] = x; a.y[ind_] = y; a.z[ind_] = z;
+  }
 
-  double mass() const { return mass_; }
-  void setMass(double m);
+  CPSysVector3D velocity() const {
+    const auto &a = store_->velocity;
+    return CPSysVector3D(a.x[ind_], a.y[ind_], a.z[ind_]);
+  }
 
-  CPSysVector3D *force() const { return force_; }
-  void setForce(double x, double y, double z);
+  void setVelocity(double x, double y, double z) {
+    auto &a = store_->velocity;
+    a.x[ind_] = x; a.y[ind_] = y; a.z[ind_] = z;
+  }
+
+  double mass() const { return store_->mass[ind_]; }
+  void setMass(double m) { store_->mass[ind_] = m; }
+
+  CPSysVector3D force() const {
+    const auto &a = store_->force;
+    return CPSysVector3D(a.x[ind_], a.y[ind_], a.z[ind_]);
+  }
+
+  void setForce(double x, double y, double z) {
+    auto &a = store_->force;
+    a.x[ind_] = x; a.y[ind_] = y; a.z[ind_] = z;
+  }
+
+  void addForce(double x, double y, double z) {
+    auto &a = store_->force;
+    a.x[ind_] += x; a.y[ind_] += y; a.z[ind_] += z;
+  }
 
   double age() const { return age_; }
   void setAge(double a) { age_ = a; }
@@ -38,8 +80,8 @@ class CPSysParticle {
 
   void makeFixed();
 
-  bool isFixed() const { return   fixed_; }
-  bool isFree () const { return ! fixed_; };
+  bool isFixed() const { return ! store_->free[ind_]; }
+  bool isFree () const { return   store_->free[ind_]; };
 
   void makeFree();
 
@@ -54,14 +96,14 @@ class CPSysParticle {
   virtual void updateParticle() { }
 
  private:
-  uint           ind_      { 0 };
-  CPSysVector3D *position_ { nullptr };
-  CPSysVector3D *velocity_ { nullptr };
-  CPSysVector3D *force_    { nullptr };
-  double         mass_     { 1.0 };
-  double         age_      { 0.0 };
-  bool           dead_     { false };
-  bool           fixed_    { false };
+  void copyData(const CPSysParticle &p);
+
+ private:
+  uint                ind_        { 0 };
+  CPSysParticleStore* store_      { nullptr };
+  CPSysParticleStore* localStore_ { nullptr };
+  double              age_        { 0.0 };
+  bool                dead_       { false };
 };
 
 #endif
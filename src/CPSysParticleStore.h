@@ -0,0 +1,102 @@
+#ifndef CPSysParticleStore_H
+#define CPSysParticleStore_H
+
+#include <vector>
+#include <algorithm>
+#include <sys/types.h>
+
+// structure of arrays vector data (one contiguous array per component)
+class CPSysVectorArray {
+ public:
+  using Reals = std::vector<double>;
+
+ public:
+  CPSysVectorArray() { }
+
+  uint size() const { return uint(x.size()); }
+
+  void resize(uint n) {
+    x.resize(n, 0.0);
+    y.resize(n, 0.0);
+    z.resize(n, 0.0);
+  }
+
+  void clear() {
+    std::fill(x.begin(), x.end(), 0.0);
+    std::fill(y.begin(), y.end(), 0.0);
+    std::fill(z.begin(), z.end(), 0.0);
+  }
+
+  void erase(uint i) {
+    x.erase(x.begin() + i);
+    y.erase(y.begin() + i);
+    z.erase(z.begin() + i);
+  }
+
+ public:
+  Reals x;
+  Reals y;
+  Reals z;
+};
+
+//---
+
+// structure of arrays storage for particle integration state
+//
+// particles added to a system store their position, velocity, force, mass and
+// free flag in contiguous arrays indexed by the particle index so integrators
+// can stream over them without chasing per particle heap pointers
+class CPSysParticleStore {
+ public:
+  using Reals = std::vector<double>;
+  using Flags = std::vector<unsigned char>;
+
+ public:
+  CPSysParticleStore() { }
+
+  uint size() const { return uint(mass.size()); }
+
+  uint add(double m=1.0) {
+    auto n = size();
+
+    position.resize(n + 1);
+    velocity.resize(n + 1);
+    force   .resize(n + 1);
+
+    mass.push_back(m);
+    free.push_back(1);
+
+    return n;
+  }
+
+  void remove(uint i) {
+    position.erase(i);
+    velocity.erase(i);
+    force   .erase(i);
+
+    mass.erase(mass.begin() + i);
+    free.erase(free.begin() + i);
+  }
+
+  void clear() {
+    position.resize(0);
+    velocity.resize(0);
+    force   .resize(0);
+
+    mass.clear();
+    free.clear();
+  }
+
+  void clearForces() {
+    force.clear();
+  }
+
+ public:
+  CPSysVectorArray position;
+  CPSysVectorArray velocity;
+  CPSysVectorArray force;
+  Reals            mass;
+  Flags            free;
+};
+
+#endif
@@ -13,207 +13,171 @@ allocateParticles()
 {
   uint numParticles = s_->numberOfParticles();
 
-  while (numParticles > originalPositions_.size()) {
-    originalPositions_ .add(new CPSysVector3D());
-    originalVelocities_.add(new CPSysVector3D());
-    k1Forces_          .add(new CPSysVector3D());
-    k1Velocities_      .add(new CPSysVector3D());
-    k2Forces_          .add(new CPSysVector3D());
-    k2Velocities_      .add(new CPSysVector3D());
-    k3Forces_          .add(new CPSysVector3D());
-    k3Velocities_      .add(new CPSysVector3D());
-    k4Forces_          .add(new CPSysVector3D());
-    k4Velocities_      .add(new CPSysVector3D());
-  }
+  if (numParticles <= originalPositions_.size())
+    return;
+
+  originalPositions_ .resize(numParticles);
+  originalVelocities_.resize(numParticles);
+  k1Forces_          .resize(numParticles);
+  k1Velocities_      .resize(numParticles);
+  k2Forces_          .resize(numParticles);
+  k2Velocities_      .resize(numParticles);
+  k3Forces_          .resize(numParticles);
+  k3Velocities_      .resize(numParticles);
+  k4Forces_          .resize(numParticles);
+  k4Velocities_      .resize(numParticles);
 }
 
 void
 CPSysRungeKuttaIntegrator::
-step(double deltaT)
+saveK(CPSysVectorArray &kForces, CPSysVectorArray &kVelocities)
 {
-  allocateParticles();
+  const auto &store = s_->store();
 
-  /////////////////////////////////////////////////////////
-  // save original position and velocities
+  const auto &velocity = store.velocity;
+  const auto &force    = store.force;
 
-  uint numParticles = s_->numberOfParticles();
+  uint numParticles = store.size();
 
   for (uint i = 0; i < numParticles; ++i) {
-    auto p = s_->getParticle(i);
+    if (! store.free[i])
+      continue;
 
-    if (p->isFree()) {
-      originalPositions_ .get(int(i))->set(p->position());
-      originalVelocities_.get(int(i))->set(p->velocity());
-    }
+    kForces.x[i] = force.x[i];
+    kForces.y[i] = force.y[i];
+    kForces.z[i] = force.z[i];
 
-    p->force()->clear();  // and clear the forces
+    kVelocities.x[i] = velocity.x[i];
+    kVelocities.y[i] = velocity.y[i];
+    kVelocities.z[i] = velocity.z[i];
   }
+}
 
-  ////////////////////////////////////////////////////////
-  // get all the k1 values
+void
+CPSysRungeKuttaIntegrator::
+setFromK(const CPSysVectorArray &kForces, const CPSysVectorArray &kVelocities, double dt)
+{
+  auto &store = s_->store();
 
-  s_->applyForces();
+  auto &position = store.position;
+  auto &velocity = store.velocity;
 
-  // save the intermediate forces
-  for (uint i = 0; i < numParticles; ++i) {
-    auto *p = s_->getParticle(i);
+  uint numParticles = store.size();
 
-    if (p->isFree()) {
-      k1Forces_    .get(int(i))->set(p->force   ());
-      k1Velocities_.get(int(i))->set(p->velocity());
-    }
+  for (uint i = 0; i < numParticles; ++i) {
+    if (! store.free[i])
+      continue;
 
-    p->force()->clear();
-  }
+    position.x[i] = originalPositions_.x[i] + kVelocities.x[i]*dt;
+    position.y[i] = originalPositions_.y[i] + kVelocities.y[i]*dt;
+    position.z[i] = originalPositions_.z[i] + kVelocities.z[i]*dt;
 
-  ////////////////////////////////////////////////////////////////
-  // get k2 values
+    double m = store.mass[i];
 
-  for (uint i = 0; i < numParticles; ++i) {
-    auto *p = s_->getParticle(i);
+    velocity.x[i] = originalVelocities_.x[i] + kForces.x[i]*dt/m;
+    velocity.y[i] = originalVelocities_.y[i] + kForces.y[i]*dt/m;
+    velocity.z[i] = originalVelocities_.z[i] + kForces.z[i]*dt/m;
+  }
+}
 
-    if (p->isFree()) {
-      auto *originalPosition = originalPositions_.get(int(i));
-      auto *k1Velocity       = k1Velocities_     .get(int(i));
+void
+CPSysRungeKuttaIntegrator::
+step(double deltaT)
+{
+  allocateParticles();
 
-      p->setPosition(originalPosition->x() + k1Velocity->x()*0.5*deltaT,
-                     originalPosition->y() + k1Velocity->y()*0.5*deltaT,
-                     originalPosition->z() + k1Velocity->z()*0.5*deltaT);
+  auto &store = s_->store();
 
-      auto *originalVelocity = originalVelocities_.get(int(i));
-      auto *k1Force          = k1Forces_          .get(int(i));
+  auto &position = store.position;
+  auto &velocity = store.velocity;
 
-      p->setVelocity(originalVelocity->x() + k1Force->x()*0.5*deltaT/p->mass(),
-                     originalVelocity->y() + k1Force->y()*0.5*deltaT/p->mass(),
-                     originalVelocity->z() + k1Force->z()*0.5*deltaT/p->mass());
-    }
-  }
+  uint numParticles = store.size();
 
-  s_->applyForces();
+  /////////////////////////////////////////////////////////
+  // save original position and velocities
 
-  // save the intermediate forces
   for (uint i = 0; i < numParticles; ++i) {
-    auto *p = s_->getParticle(i);
+    if (! store.free[i])
+      continue;
 
-    if ( p->isFree()) {
-      k2Forces_    .get(int(i))->set(p->force   ());
-      k2Velocities_.get(int(i))->set(p->velocity());
-    }
+    originalPositions_.x[i] = position.x[i];
+    originalPositions_.y[i] = position.y[i];
+    originalPositions_.z[i] = position.z[i];
 
-    p->force()->clear();  // and clear the forces now that we are done with them
+    originalVelocities_.x[i] = velocity.x[i];
+    originalVelocities_.y[i] = velocity.y[i];
+    originalVelocities_.z[i] = velocity.z[i];
   }
 
+  store.clearForces();
 
-  /////////////////////////////////////////////////////
-  // get k3 values
+  ////////////////////////////////////////////////////////
+  // get all the k1 values
 
-  for (uint i = 0; i < numParticles; ++i) {
-    auto *p = s_->getParticle(i);
+  s_->applyForces();
 
-    if (p->isFree()) {
-      auto *originalPosition = originalPositions_.get(int(i));
-      auto *k2Velocity       = k2Velocities_     .get(int(i));
+  saveK(k1Forces_, k1Velocities_);
 
-      p->setPosition(originalPosition->x() + k2Velocity->x()*0.5*deltaT,
-                     originalPosition->y() + k2Velocity->y()*0.5*deltaT,
-                     originalPosition->z() + k2Velocity->z()*0.5*deltaT);
+  store.clearForces();
 
-      auto *originalVelocity = originalVelocities_.get(int(i));
-      auto *k2Force          = k2Forces_          .get(int(i));
+  ////////////////////////////////////////////////////////////////
+  // get k2 values
 
-      p->setVelocity(originalVelocity->x() + k2Force->x()*0.5*deltaT/p->mass(),
-                     originalVelocity->y() + k2Force->y()*0.5*deltaT/p->mass(),
-                     originalVelocity->z() + k2Force->z()*0.5*deltaT/p->mass());
-    }
-  }
+  setFromK(k1Forces_, k1Velocities_, 0.5*deltaT);
 
   s_->applyForces();
 
-  // save the intermediate forces
-  for (uint i = 0; i < numParticles; ++i) {
-    auto *p = s_->getParticle(i);
+  saveK(k2Forces_, k2Velocities_);
 
-    if (p->isFree()) {
-      k3Forces_    .get(int(i))->set(p->force   ());
-      k3Velocities_.get(int(i))->set(p->velocity());
-    }
+  store.clearForces();
 
-    p->force()->clear();  // and clear the forces now that we are done with them
-  }
+  /////////////////////////////////////////////////////
+  // get k3 values
 
-  //////////////////////////////////////////////////
-  // get k4 values
+  setFromK(k2Forces_, k2Velocities_, 0.5*deltaT);
 
-  for (uint i = 0; i < numParticles; ++i) {
-    auto *p = s_->getParticle(i);
+  s_->applyForces();
 
-    if (p->isFree()) {
-      auto *originalPosition = originalPositions_.get(int(i));
-      auto *k3Velocity       = k3Velocities_     .get(int(i));
+  saveK(k3Forces_, k3Velocities_);
 
-      p->setPosition(originalPosition->x() + k3Velocity->x()*deltaT,
-                     originalPosition->y() + k3Velocity->y()*deltaT,
-                     originalPosition->z() + k3Velocity->z()*deltaT);
+  store.clearForces();
 
-      auto *originalVelocity = originalVelocities_.get(int(i));
-      auto *k3Force          = k3Forces_          .get(int(i));
+  //////////////////////////////////////////////////
+  // get k4 values
 
-      p->setVelocity(originalVelocity->x() + k3Force->x()*deltaT/p->mass(),
-                     originalVelocity->y() + k3Force->y()*deltaT/p->mass(),
-                     originalVelocity->z() + k3Force->z()*deltaT/p->mass());
-    }
-  }
+  setFromK(k3Forces_, k3Velocities_, deltaT);
 
   s_->applyForces();
 
-  // save the intermediate forces
-  for (uint i = 0; i < numParticles; ++i) {
-    auto *p = s_->getParticle(i);
-
-    if (p->isFree()) {
-      k4Forces_    .get(int(i))->set(p->force   ());
-      k4Velocities_.get(int(i))->set(p->velocity());
-    }
-  }
+  saveK(k4Forces_, k4Velocities_);
 
   /////////////////////////////////////////////////////////////
   // put them all together and what do you get?
 
+  double dt6 = deltaT/6.0;
+
   for (uint i = 0; i < numParticles; ++i) {
-    auto *p = s_->getParticle(i);
-
-    //p->setStepAge(p->stepAge() + deltaT);
-
-    if (p->isFree()) {
-      // update position
-
-      auto *originalPosition = originalPositions_.get(int(i));
-      auto *k1Velocity       = k1Velocities_     .get(int(i));
-      auto *k2Velocity       = k2Velocities_     .get(int(i));
-      auto *k3Velocity       = k3Velocities_     .get(int(i));
-      auto *k4Velocity       = k4Velocities_     .get(int(i));
-
-      p->setPosition(originalPosition->x() + deltaT/6.0*(k1Velocity->x() + 2.0*k2Velocity->x() +
-                       2.0*k3Velocity->x() + k4Velocity->x()),
-                     originalPosition->y() + deltaT/6.0*(k1Velocity->y() + 2.0*k2Velocity->y() +
-                       2.0*k3Velocity->y() + k4Velocity->y()),
-                     originalPosition->z() + deltaT/6.0*(k1Velocity->z() + 2.0*k2Velocity->z() +
-                       2.0*k3Velocity->z() + k4Velocity->z()));
-
-      // update velocity
-
-      auto *originalVelocity = originalVelocities_.get(int(i));
-      auto *k1Force          = k1Forces_          .get(int(i));
-      auto *k2Force          = k2Forces_          .get(int(i));
-      auto *k3Force          = k3Forces_          .get(int(i));
-      auto *k4Force          = k4Forces_          .get(int(i));
-
-      p->setVelocity(originalVelocity->x() + deltaT/(6.0*p->mass())*(k1Force->x() +
-                       2.0*k2Force->x() + 2.0*k3Force->x() + k4Force->x()),
-                     originalVelocity->y() + deltaT/(6.0*p->mass())*(k1Force->y() +
-                       2.0*k2Force->y() + 2.0*k3Force->y() + k4Force->y()),
-                     originalVelocity->z() + deltaT/(6.0*p->mass())*(k1Force->z() +
-                       2.0*k2Force->z() + 2.0*k3Force->z() + k4Force->z()));
-    }
+    if (! store.free[i])
+      continue;
+
+    // update position
+
+    position.x[i] = originalPositions_.x[i] + dt6*(k1Velocities_.x[i] +
+      2.0*k2Velocities_.x[i] + 2.0*k3Velocities_.x[i] + k4Velocities_.x[i]);
+    position.y[i] = originalPositions_.y[i] + dt6*(k1Velocities_.y[i] +
+      2.0*k2Velocities_.y[i] + 2.0*k3Velocities_.y[i] + k4Velocities_.y[i]);
+    position.z[i] = originalPositions_.z[i] + dt6*(k1Velocities_.z[i] +
+      2.0*k2Velocities_.z[i] + 2.0*k3Velocities_.z[i] + k4Velocities_.z[i]);
+
+    // update velocity
+
+    double dtm6 = deltaT/(6.0*store.mass[i]);
+
+    velocity.x[i] = originalVelocities_.x[i] + dtm6*(k1Forces_.x[i] +
+      2.0*k2Forces_.x[i] + 2.0*k3Forces_.x[i] + k4Forces_.x[i]);
+    velocity.y[i] = originalVelocities_.y[i] + dtm6*(k1Forces_.y[i] +
+      2.0*k2Forces_.y[i] + 2.0*k3Forces_.y[i] + k4Forces_.y[i]);
+    velocity.z[i] = originalVelocities_.z[i] + dtm6*(k1Forces_.z[i] +
+      2.0*k2Forces_.z[i] + 2.0*k3Forces_.z[i] + k4Forces_.z[i]);
   }
 }
@@ -2,11 +2,14 @@
 #define CPSysRungeKuttaIntegrator_H
 
 #include <CPSysIntegrator.h>
-#include <CArrayList.h>
+#include <CPSysParticleStore.h>
 
 class CPSysSystem;
-class CPSysVector3D;
 
+// fourth order Runge Kutta integrator streaming over the system particle store
+//
+// intermediate values are held in structure of arrays buffers which are only
+// reallocated when the number of particles grows
 class CPSysRungeKuttaIntegrator : public CPSysIntegrator {
  public:
   CPSysRungeKuttaIntegrator(CPSysSystem *s);
@@ -16,18 +19,24 @@ class CPSysRungeKuttaIntegrator : public CPSysIntegrator {
   void step(double deltaT) override;
 
  private:
-  using Vector3DArray = CArrayList<CPSysVector3D *>;
-
-  Vector3DArray originalPositions_;
-  Vector3DArray originalVelocities_;
-  Vector3DArray k1Forces_;
-  Vector3DArray k1Velocities_;
-  Vector3DArray k2Forces_;
-  Vector3DArray k2Velocities_;
-  Vector3DArray k3Forces_;
-  Vector3DArray k3Velocities_;
-  Vector3DArray k4Forces_;
-  Vector3DArray k4Velocities_;
+  // save current forces and velocities of free particles
+  void saveK(CPSysVectorArray &kForces, CPSysVectorArray &kVelocities);
+
+  // set free particle positions and velocities to original plus scaled k values
+  void setFromK(const CPSysVectorArray &kForces, const CPSysVectorArray &kVelocities,
+                double dt);
+
+ private:
+  CPSysVectorArray originalPositions_;
+  CPSysVectorArray originalVelocities_;
+  CPSysVectorArray k1Forces_;
+  CPSysVectorArray k1Velocities_;
+  CPSysVectorArray k2Forces_;
+  CPSysVectorArray k2Velocities_;
+  CPSysVectorArray k3Forces_;
+  CPSysVectorArray k3Velocities_;
+  CPSysVectorArray k4Forces_;
+  CPSysVectorArray k4Velocities_;
 
   CPSysSystem *s_ { nullptr };
 };
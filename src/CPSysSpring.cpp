@@ -25,7 +25,7 @@ double
 CPSysSpring::
 currentLength() const
 {
-  return a_->position()->distanceTo(b_->position());
+  return a_->distanceTo(b_);
 }
 
 void
@@ -69,10 +69,25 @@ apply()
 {
   if (! b_) return;
 
+  apply(a_->store()->force);
+}
+
+void
+CPSysSpring::
+apply(CPSysVectorArray &forces) const
+{
+  if (! b_) return;
+
   if (on_ && (a_->isFree() || b_->isFree())) {
-    double a2bX = a_->position()->x() - b_->position()->x();
-    double a2bY = a_->position()->y() - b_->position()->y();
-    double a2bZ = a_->position()->z() - b_->position()->z();
+    const auto &position = a_->store()->position;
+    const auto &velocity = a_->store()->velocity;
+
+    auto ia = a_->ind();
+    auto ib = b_->ind();
+
+    double a2bX = position.x[ia] - position.x[ib];
+    double a2bY = position.y[ia] - position.y[ib];
+    double a2bZ = position.z[ia] - position.z[ib];
 
     double a2bDistance = sqrt(a2bX*a2bX + a2bY*a2bY + a2bZ*a2bZ);
 
@@ -93,9 +108,9 @@ apply()
 
     // want velocity along line b/w a & b, damping force is proportional to this
 
-    double Va2bX = a_->velocity()->x() - b_->velocity()->x();
-    double Va2bY = a_->velocity()->y() - b_->velocity()->y();
-    double Va2bZ = a_->velocity()->z() - b_->velocity()->z();
+    double Va2bX = velocity.x[ia] - velocity.x[ib];
+    double Va2bY = velocity.y[ia] - velocity.y[ib];
+    double Va2bZ = velocity.z[ia] - velocity.z[ib];
 
     double dampingForce = -damping_*(a2bX*Va2bX + a2bY*Va2bY + a2bZ*Va2bZ);
 
@@ -107,7 +122,12 @@ apply()
     a2bY *= r;
     a2bZ *= r;
 
-    if (a_->isFree()) a_->force()->add( a2bX,  a2bY,  a2bZ);
-    if (b_->isFree()) b_->force()->add(-a2bX, -a2bY, -a2bZ);
+    if (a_->isFree()) {
+      forces.x[ia] += a2bX; forces.y[ia] += a2bY; forces.z[ia] += a2bZ;
+    }
+
+    if (b_->isFree()) {
+      forces.x[ib] -= a2bX; forces.y[ib] -= a2bY; forces.z[ib] -= a2bZ;
+    }
   }
 }
@@ -6,6 +6,7 @@
 #include <sys/types.h>
 
 class CPSysParticle;
+class CPSysVectorArray;
 
 class CPSysSpring : public CPSysForce {
  public:
@@ -41,6 +42,9 @@ class CPSysSpring : public CPSysForce {
 
   void apply() override;
 
+  // add force to specified (per thread) force array
+  void apply(CPSysVectorArray &forces) const;
+
  private:
   uint           ind_            { 0 };
   CPSysParticle *a_              { nullptr };
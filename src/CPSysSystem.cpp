@@ -3,6 +3,9 @@
 #include <CPSysModifiedEulerIntegrator.h>
 
 #include <cassert>
+#include <utility>
+#include <algorithm>
+#include <cmath>
 
 CPSysSystem::
 CPSysSystem(double g, double somedrag)
@@ -25,6 +28,7 @@ CPSysSystem(double gx, double gy, double gz, double somedrag)
 CPSysSystem::
 ~CPSysSystem()
 {
+  delete pool_;
 }
 
 void
@@ -89,7 +93,7 @@ makeParticle(double mass, double x, double y, double z)
 {
   auto *p = new CPSysParticle(mass);
 
-  p->position()->set(x, y, z);
+  p->setPosition(x, y, z);
 
   addParticle(p);
 
@@ -100,7 +104,9 @@ void
 CPSysSystem::
 addParticle(CPSysParticle *p)
 {
-  p->setInd(particles_.size());
+  p->attach(&store_);
+
+  assert(p->ind() == particles_.size());
 
   particles_.add(p);
 }
@@ -149,61 +155,257 @@ void
 CPSysSystem::
 clear()
 {
+  for (uint i = 0; i < particles_.size(); ++i)
+    particles_.get(int(i))->detach();
+
   particles_  .clear();
   springs_    .clear();
   attractions_.clear();
+
+  store_.clear();
 }
 
 void
 CPSysSystem::
 applyForces()
 {
-  if (! gravity_->isZero()) {
-    for (uint i = 0; i < particles_.size(); ++i) {
-      auto *p = particles_.get(int(i));
+  auto n = store_.size();
+
+  auto &force    = store_.force;
+  auto &velocity = store_.velocity;
+
+  // particle local forces (gravity and drag)
+  auto gx = gravity_->x();
+  auto gy = gravity_->y();
+  auto gz = gravity_->z();
+
+  bool hasGravity = ! gravity_->isZero();
 
-      p->force()->add(gravity_);
+  parallelFor(n, [&](size_t, size_t i1, size_t i2) {
+    if (hasGravity) {
+      for (auto i = i1; i < i2; ++i) {
+        force.x[i] += gx;
+        force.y[i] += gy;
+        force.z[i] += gz;
+      }
     }
-  }
 
-  for (uint i = 0; i < particles_.size(); ++i) {
-    auto *p = particles_.get(int(i));
+    for (auto i = i1; i < i2; ++i) {
+      force.x[i] += velocity.x[i] * -drag_;
+      force.y[i] += velocity.y[i] * -drag_;
+      force.z[i] += velocity.z[i] * -drag_;
+    }
+  }, /*minChunk*/4096);
+
+  // pairwise forces
+  if (numThreads() <= 1) {
+    for (uint i = 0; i < springs_.size(); i++) {
+      auto *f = springs_.get(int(i));
+
+      f->apply();
+    }
+
+    for (uint i = 0; i < attractions_.size(); i++) {
+      auto *f = attractions_.get(int(i));
 
-    p->force()->add(p->velocity()->x() * -drag_,
-                    p->velocity()->y() * -drag_,
-                    p->velocity()->z() * -drag_);
+      f->apply();
+    }
+  }
+  else {
+    // accumulate each chunk of springs/attractions into its own buffer and then
+    // sum buffers in chunk order (chunks only depend on counts and thread count
+    // so results are repeatable)
+    auto ns = springs_.size();
+    auto nf = ns + attractions_.size();
+
+    auto nc = pool_->numChunks(nf, /*minChunk*/1024);
+
+    if (threadForces_.size() < nc)
+      threadForces_.resize(nc);
+
+    pool_->parallelFor(nf, [&](size_t chunk, size_t j1, size_t j2) {
+      auto &forces = threadForces_[chunk];
+
+      forces.resize(n);
+      forces.clear();
+
+      for (auto j = j1; j < j2; ++j) {
+        if (j < ns)
+          springs_.get(int(j))->apply(forces);
+        else
+          attractions_.get(int(j - ns))->apply(forces);
+      }
+    }, /*minChunk*/1024);
+
+    parallelFor(n, [&](size_t, size_t i1, size_t i2) {
+      for (size_t c = 0; c < nc; ++c) {
+        const auto &forces = threadForces_[c];
+
+        for (auto i = i1; i < i2; ++i) {
+          force.x[i] += forces.x[i];
+          force.y[i] += forces.y[i];
+          force.z[i] += forces.z[i];
+        }
+      }
+    }, /*minChunk*/4096);
   }
 
-  for (uint i = 0; i < springs_.size(); i++) {
-    auto *f = springs_.get(int(i));
+  for (uint i = 0; i < customForces_.size(); i++) {
+    auto *f = customForces_.get(int(i));
 
     f->apply();
   }
 
-  for (uint i = 0; i < attractions_.size(); i++) {
-    auto *f = attractions_.get(int(i));
+  if (allAttraction_ != 0.0) {
+    calcAllAttraction(barnesHut_, allAttractionForces_);
 
-    f->apply();
+    for (uint i = 0; i < n; ++i) {
+      if (! store_.free[i]) continue;
+
+      force.x[i] += allAttractionForces_.x[i];
+      force.y[i] += allAttractionForces_.y[i];
+      force.z[i] += allAttractionForces_.z[i];
+    }
   }
+}
 
-  for (uint i = 0; i < customForces_.size(); i++) {
-    auto *f = customForces_.get(int(i));
+size_t
+CPSysSystem::
+numThreads() const
+{
+  return (pool_ ? pool_->numThreads() : 1);
+}
 
-    f->apply();
+void
+CPSysSystem::
+setNumThreads(size_t n)
+{
+  if (n == 0)
+    n = CThreadPool::hardwareThreads();
+
+  if (n <= 1) {
+    delete pool_;
+
+    pool_ = nullptr;
+  }
+  else {
+    if (! pool_)
+      pool_ = new CThreadPool(n);
+    else
+      pool_->setNumThreads(n);
   }
 }
 
 void
 CPSysSystem::
-clearForces()
+parallelFor(size_t n, const CThreadPool::RangeProc &proc, size_t minChunk)
 {
-  auto i = particles_.iterator();
+  if (pool_)
+    pool_->parallelFor(n, proc, minChunk);
+  else if (n > 0)
+    proc(0, 0, n);
+}
 
-  while (i.hasNext()) {
-    auto *p = i.next();
+void
+CPSysSystem::
+setAllAttraction(double k, double minDistance)
+{
+  allAttraction_            = k;
+  allAttractionMinDistance_ = minDistance;
+}
+
+// calc attraction force on each particle from all other particles
+// (same force as CPSysAttraction: k*ma*mb/d^2 with d clamped to min distance)
+void
+CPSysSystem::
+calcAllAttraction(bool barnesHut, CPSysVectorArray &forces)
+{
+  auto n = store_.size();
+
+  forces.resize(n);
+  forces.clear();
+
+  const auto &position = store_.position;
+  const auto &mass     = store_.mass;
+
+  auto minD2 = allAttractionMinDistance_*allAttractionMinDistance_;
+
+  auto kernel = [&](double dx, double dy, double dz, double w,
+                    double &fx, double &fy, double &fz) {
+    auto d2 = std::max(dx*dx + dy*dy + dz*dz, minD2);
+    if (d2 == 0.0) return;
+
+    auto s = -w/(d2*std::sqrt(d2));
+
+    fx += dx*s; fy += dy*s; fz += dz*s;
+  };
+
+  if (barnesHut) {
+    barnesHutTree_.clear();
+
+    for (uint i = 0; i < n; ++i)
+      barnesHutTree_.addBody(position.x[i], position.y[i], position.z[i], mass[i]);
+
+    barnesHutTree_.build();
+  }
+
+  // each particle sum is independent (tree is read only during queries)
+  parallelFor(n, [&](size_t, size_t i1, size_t i2) {
+    for (auto i = i1; i < i2; ++i) {
+      double fx = 0.0, fy = 0.0, fz = 0.0;
+
+      auto x = position.x[i];
+      auto y = position.y[i];
+      auto z = position.z[i];
+
+      if (barnesHut)
+        barnesHutTree_.accumulate(x, y, z, i, kernel, fx, fy, fz);
+      else {
+        for (uint j = 0; j < n; ++j) {
+          if (j == i) continue;
+
+          kernel(x - position.x[j], y - position.y[j], z - position.z[j], mass[j], fx, fy, fz);
+        }
+      }
+
+      auto s = allAttraction_*mass[i];
+
+      forces.x[i] = fx*s;
+      forces.y[i] = fy*s;
+      forces.z[i] = fz*s;
+    }
+  }, /*minChunk*/64);
+}
+
+double
+CPSysSystem::
+attractionError()
+{
+  CPSysVectorArray exactForces, approxForces;
+
+  calcAllAttraction(/*barnesHut*/false, exactForces);
+  calcAllAttraction(/*barnesHut*/true , approxForces);
+
+  double e2 = 0.0, f2 = 0.0;
 
-    p->force()->clear();
+  for (uint i = 0; i < exactForces.size(); ++i) {
+    auto dx = approxForces.x[i] - exactForces.x[i];
+    auto dy = approxForces.y[i] - exactForces.y[i];
+    auto dz = approxForces.z[i] - exactForces.z[i];
+
+    e2 += dx*dx + dy*dy + dz*dz;
+    f2 += exactForces.x[i]*exactForces.x[i] + exactForces.y[i]*exactForces.y[i] +
+          exactForces.z[i]*exactForces.z[i];
   }
+
+  return (f2 > 0.0 ? std::sqrt(e2/f2) : 0.0);
+}
+
+void
+CPSysSystem::
+clearForces()
+{
+  store_.clearForces();
 }
 
 uint
@@ -280,7 +482,29 @@ void
 CPSysSystem::
 removeParticle(CPSysParticle * p)
 {
-  particles_.remove(p);
+  if (p->store() != &store_)
+    return;
+
+  auto ind = p->ind();
+
+  p->detach();
+
+  store_.remove(ind);
+
+  ParticleArray particles;
+
+  for (uint i = 0; i < particles_.size(); ++i) {
+    auto *p1 = particles_.get(int(i));
+
+    if (p1 == p)
+      continue;
+
+    p1->setInd(particles.size());
+
+    particles.add(p1);
+  }
+
+  std::swap(particles, particles_);
 }
 
 CPSysSpring *
@@ -2,12 +2,15 @@
 #define CPSysSystem_H
 
 #include <CPSysParticle.h>
+#include <CPSysParticleStore.h>
 #include <CPSysSpring.h>
 #include <CPSysAttraction.h>
 #include <CPSysForce.h>
 #include <CPSysIntegrator.h>
 
 #include <CArrayList.h>
+#include <CBarnesHut3D.h>
+#include <CThreadPool.h>
 
 class CPSysSystem {
  public:
@@ -52,6 +55,25 @@ class CPSysSystem {
 
   void clear();
 
+  // mutual attraction between all particle pairs (0 strength is off)
+  double allAttraction() const { return allAttraction_; }
+  double allAttractionMinDistance() const { return allAttractionMinDistance_; }
+  void setAllAttraction(double k, double minDistance=0.0);
+
+  // use Barnes-Hut approximation for all pairs attraction
+  bool isBarnesHut() const { return barnesHut_; }
+  void setBarnesHut(bool b) { barnesHut_ = b; }
+
+  double theta() const { return barnesHutTree_.theta(); }
+  void setTheta(double r) { barnesHutTree_.setTheta(r); }
+
+  // relative error of Barnes-Hut all pairs attraction compared to exact calculation
+  double attractionError();
+
+  // number of threads used to apply forces (0 is hardware concurrency, 1 is serial)
+  size_t numThreads() const;
+  void setNumThreads(size_t n);
+
   void applyForces();
 
   void clearForces();
@@ -65,6 +87,10 @@ class CPSysSystem {
   CPSysParticle *getParticle(uint i);
   const ParticleArray &getParticles() const { return particles_; }
 
+  // structure of arrays particle data (indexed by particle ind)
+  CPSysParticleStore &store() { return store_; }
+  const CPSysParticleStore &store() const { return store_; }
+
   CPSysSpring *getSpring(uint i);
 
   CPSysAttraction *getAttraction(uint i);
@@ -89,17 +115,34 @@ class CPSysSystem {
   void removeCustomForce(CPSysForce *f);
 
  public:
-  ParticleArray   particles_;
-  SpringArray     springs_;
-  AttractionArray attractions_;
-  ForceArray      customForces_;
+  ParticleArray      particles_;
+  CPSysParticleStore store_;
+  SpringArray        springs_;
+  AttractionArray    attractions_;
+  ForceArray         customForces_;
 
   CPSysVector3D *gravity_ { nullptr };
   double         drag_    { 0.0 };
 
   bool hasDeadParticles_ { false };
 
+  double       allAttraction_            { 0.0 };
+  double       allAttractionMinDistance_ { 0.0 };
+  bool         barnesHut_                { false };
+  CBarnesHut3D barnesHutTree_;
+
   CPSysIntegrator *integrator_ { nullptr };
+
+ private:
+  using VectorArrays = std::vector<CPSysVectorArray>;
+
+  void calcAllAttraction(bool barnesHut, CPSysVectorArray &forces);
+
+  void parallelFor(size_t n, const CThreadPool::RangeProc &proc, size_t minChunk);
+
+  CPSysVectorArray allAttractionForces_;
+  CThreadPool*     pool_ { nullptr };
+  VectorArrays     threadForces_;
 };
 
 #endif
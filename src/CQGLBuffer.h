@@ -150,6 +150,7 @@ class CQGLBuffer {
   bool hasBonesPart  () const { return (data_.types & static_cast<unsigned int>(Parts::BONE   )); }
 
   void disableTexturePart() { data_.types &= ~static_cast<unsigned int>(Parts::TEXTURE); }
+  void disableBonesPart  () { data_.types &= ~static_cast<unsigned int>(Parts::BONE   ); }
 
   //---
 
@@ -295,6 +296,40 @@ class CQGLBuffer {
     data_.dataValid = false;
   }
 
+  //---
+
+  // allocate n vertices for parts so vertex values can be set by index
+  // (set calls for different indices can be made from multiple threads)
+  void resizeVertices(unsigned int types, uint n) {
+    clearBuffers();
+
+    if (n == 0)
+      return;
+
+    data_.types |= types;
+
+    if (types & static_cast<unsigned int>(Parts::IND    )) data_.inds         .resize(n);
+    if (types & static_cast<unsigned int>(Parts::POINT  )) data_.points       .resize(n);
+    if (types & static_cast<unsigned int>(Parts::NORMAL )) data_.normals      .resize(n);
+    if (types & static_cast<unsigned int>(Parts::COLOR  )) data_.colors       .resize(n);
+    if (types & static_cast<unsigned int>(Parts::TEXTURE)) data_.texturePoints.resize(n);
+
+    if (types & static_cast<unsigned int>(Parts::BONE)) {
+      data_.boneIds    .resize(n);
+      data_.boneWeights.resize(n);
+    }
+  }
+
+  void setInd         (uint i, int ind)                { data_.inds         [i] = ind; }
+  void setPoint       (uint i, const Point &p)         { data_.points       [i] = p; }
+  void setNormal      (uint i, const Point &p)         { data_.normals      [i] = p; }
+  void setColor       (uint i, const Color &c)         { data_.colors       [i] = c; }
+  void setTexturePoint(uint i, const TexturePoint &p)  { data_.texturePoints[i] = p; }
+  void setBoneIds     (uint i, const IVector &ids)     { data_.boneIds      [i] = ids; }
+  void setBoneWeights (uint i, const Vector &weights)  { data_.boneWeights  [i] = weights; }
+
+  //---
+
   void addIndex(int i) {
     data_.indices.push_back(i);
 
@@ -303,6 +338,47 @@ class CQGLBuffer {
 
   //---
 
+  // parts and interleaved vertex data (in parts order) as sent to GPU
+  unsigned int types() const { return data_.types; }
+
+  // floats per vertex for parts
+  static unsigned int typesSpan(unsigned int types) {
+    unsigned int span = 0;
+
+    if (types & static_cast<unsigned int>(Parts::POINT  )) span += 3;
+    if (types & static_cast<unsigned int>(Parts::NORMAL )) span += 3;
+    if (types & static_cast<unsigned int>(Parts::COLOR  )) span += 3;
+    if (types & static_cast<unsigned int>(Parts::TEXTURE)) span += 2;
+    if (types & static_cast<unsigned int>(Parts::BONE   )) span += 8;
+
+    return span;
+  }
+
+  const float *interleavedData() { initData(); return data_.data; }
+
+  unsigned int numInterleavedData() { initData(); return data_.numData; }
+
+  // set interleaved vertex data directly (e.g. from saved buffer), replaces parts
+  void setInterleavedData(unsigned int types, const float *data, unsigned int numData) {
+    clearAll();
+
+    // no vertex inds (only used for picking)
+    data_.types = types & ~static_cast<unsigned int>(Parts::IND);
+    data_.span  = typesSpan(types);
+
+    data_.numData = numData;
+    data_.data    = new float [numData];
+
+    memcpy(data_.data, data, numData*sizeof(float));
+
+    data_.indData    = new int [0];
+    data_.numIndData = 0;
+
+    data_.dataValid = true;
+  }
+
+  //---
+
   struct PointData {
     std::optional<int>          ind;
     std::optional<Point>        point;
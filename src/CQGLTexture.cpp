@@ -1,10 +1,13 @@
 #include <CQGLTexture.h>
 #include <CQImage.h>
-#include <CMathGen.h>
 
 #include <QFileInfo>
 #include <QImageReader>
+#include <QOpenGLContext>
+
 #include <iostream>
+#include <vector>
+#include <cstring>
 
 #if 0
 #include <glad/glad.h>
@@ -185,44 +188,46 @@ init(const QImage &image, bool flip)
     return false;
   }
 
+  // upload format matches image byte order (no swizzle). convert is a no-op (shared
+  // data) if already in format
   if (useAlpha())
     image_ = image.convertToFormat(QImage::Format_RGBA8888);
   else
     image_ = image.convertToFormat(QImage::Format_RGB888);
 
-//if (flip)
-//  image_ = image_.flippedH();
+  width_  = image_.width ();
+  height_ = image_.height();
 
   //------
 
-  // convert to GL compatible data
-  width_  = image_.width ();
-  height_ = image_.height();
+  // image rows are 32 bit aligned (matches GL unpack alignment of 4). Flip copies rows
+  // (bottom to top) to a staging buffer which is freed on return, otherwise the image
+  // data is uploaded directly
+  auto bytesPerLine = size_t(image_.bytesPerLine());
 
-  imageData_ = new unsigned char [4*width_*height_];
+  const uchar *data = image_.constBits();
 
-  int i = 0;
+  std::vector<uchar> flipData;
 
-  for (int y = 0; y < height_; ++y) {
-    int y1 = (flip ? height_ - 1 - y : y);
+  if (flip) {
+    flipData.resize(bytesPerLine*size_t(height_));
 
-    for (int x = 0; x < width_; ++x) {
-      auto rgba = image_.pixel(x, y1);
+    for (int y = 0; y < height_; ++y)
+      memcpy(&flipData[size_t(y)*bytesPerLine], image_.constScanLine(height_ - 1 - y),
+             bytesPerLine);
 
-      imageData_[i++] = qBlue (rgba);
-      imageData_[i++] = qGreen(rgba);
-      imageData_[i++] = qRed  (rgba);
-      imageData_[i++] = qAlpha(rgba);
-    }
+    data = &flipData[0];
   }
 
   //------
 
-  //glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
   // allocate texture id
-  glGenTextures(1, &id_);
-  if (! checkError("glGenTextures")) return false;
+  if (id_ == 0) {
+    glGenTextures(1, &id_);
+    if (! checkError("glGenTextures")) return false;
+  }
 
   valid_ = true;
 
@@ -249,32 +254,32 @@ init(const QImage &image, bool flip)
   //if (! checkError("glTexEnvf")) return false;
 
   // build our texture mipmaps
-  GLint internalFormat = (useAlpha() ? GL_RGBA : GL_RGB);
+  GLint  internalFormat = (useAlpha() ? GL_RGBA : GL_RGB);
+  GLenum format         = (useAlpha() ? GL_RGBA : GL_RGB);
 
-  if (CMathGen::isPowerOf(2, width_) && CMathGen::isPowerOf(2, height_)) {
-#if 1
-    // Hardware mipmap generation
-    glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP_SGIS, GL_TRUE);
-    if (! checkError("glTexParameteri")) return false;
+  // GPU mipmap generation (any size) if GL 3 functions available
+  auto *functions = functions_;
 
-    glHint(GL_GENERATE_MIPMAP_HINT_SGIS, GL_NICEST);
-    if (! checkError("glHint")) return false;
-#endif
+  if (! functions) {
+    auto *context = QOpenGLContext::currentContext();
+
+    if (context)
+      functions = context->extraFunctions();
+  }
 
+  if (functions) {
     glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width_, height_, 0,
-                 GL_BGRA, GL_UNSIGNED_BYTE, &imageData_[0]);
+                 format, GL_UNSIGNED_BYTE, data);
     if (! checkError("glTexImage2D")) return false;
 
-#if 0
-    glGenerateMipmap(GL_TEXTURE_2D);
+    functions->glGenerateMipmap(GL_TEXTURE_2D);
     if (! checkError("glGenerateMipmap")) return false;
-#endif
   }
   else {
     // No hardware mipmap generation support, fall back to the
     // good old gluBuild2DMipmaps function
     gluBuild2DMipmaps(GL_TEXTURE_2D, internalFormat, width_, height_,
-                      GL_BGRA, GL_UNSIGNED_BYTE, &imageData_[0]);
+                      format, GL_UNSIGNED_BYTE, data);
     if (! checkError("gluBuild2DMipmaps")) return false;
   }
 
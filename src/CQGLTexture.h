@@ -69,8 +69,7 @@ class CQGLTexture {
   bool init(const QImage &image, bool flip);
 
  private:
-  QImage         image_;
-  unsigned char *imageData_ { nullptr };
+  QImage image_;
 
   int width_  { 0 };
   int height_ { 0 };
@@ -54,6 +54,11 @@ CQSandboxToolbar3D.cpp \
 CQSandboxOverview3D.cpp \
 CQSandboxStatus.cpp \
 CQSandboxCamera.cpp \
+CQSandboxCompositor.cpp \
+CQSandboxObjectIndex.cpp \
+CQSandboxMeshCache.cpp \
+CQSandboxAnimClipCache.cpp \
+CQSandboxTextureCache.cpp \
 \
 CCircleFactor.cpp \
 CQGLTexture.cpp \
@@ -72,13 +77,20 @@ CTclUtil.cpp \
 CQRubberBand.cpp \
 \
 CForceDirected3D.cpp \
+CForceDirectedThread3D.cpp \
 CFlag.cpp \
 CDotParse.cpp \
+CDotParseCSR.cpp \
+CDotParseStream.cpp \
+CMultilevelLayout3D.cpp \
+CAStarGrid.cpp \
+CFlowField.cpp \
 CFireworks.cpp \
 CFlocking.cpp \
 CFlock.cpp \
 CBoid.cpp \
 CWaterSurface.cpp \
+CSkinning3D.cpp \
 CProfile.cpp \
 \
 CPSysAttraction.cpp \
@@ -128,6 +140,13 @@ CQSandboxToolbar3D.h \
 CQSandboxOverview3D.h \
 CQSandboxStatus.h \
 CQSandboxCamera.h \
+CQSandboxCompositor.h \
+CQSandboxObjectIndex.h \
+CQSandboxMeshCache.h \
+CQSandboxAnimClipCache.h \
+CQSandboxTextureCache.h \
+CQSandboxTclCallback.h \
+CQSandboxProperty.h \
 CQSandboxUtil.h \
 \
 CQTclUtil.h \
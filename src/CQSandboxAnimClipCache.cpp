@@ -0,0 +1,206 @@
+#include <CQSandboxAnimClipCache.h>
+
+#include <CGeomObject3D.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace CQSandbox {
+
+namespace {
+
+// limits on samples per clip
+const int MIN_SAMPLES = 2;
+const int MAX_SAMPLES = 10000;
+
+}
+
+//---
+
+void
+AnimClipCache::Clip::
+interp(double t, float *m) const
+{
+  auto nn = nodeIds.size()*MATRIX_SIZE;
+
+  if (numSamples <= 0 || nn == 0)
+    return;
+
+  // sample index and fraction for time (clamped to clip range)
+  int    i = 0;
+  double f = 0.0;
+
+  if (dt > 0.0 && numSamples > 1) {
+    auto s = (std::min(std::max(t, tmin), tmax) - tmin)/dt;
+
+    i = std::min(int(s), numSamples - 2);
+    f = std::min(s - i, 1.0);
+  }
+
+  const auto *m1 = &matrices[size_t(i)*nn];
+
+  if (f <= 0.0) {
+    std::copy(m1, m1 + nn, m);
+    return;
+  }
+
+  const auto *m2 = m1 + nn;
+
+  auto f1 = float(f);
+
+  for (size_t j = 0; j < nn; ++j)
+    m[j] = m1[j] + f1*(m2[j] - m1[j]);
+}
+
+//---
+
+AnimClipCache *
+AnimClipCache::
+instance()
+{
+  static AnimClipCache *cache;
+
+  if (! cache)
+    cache = new AnimClipCache;
+
+  return cache;
+}
+
+void
+AnimClipCache::
+setSampleRate(double r)
+{
+  if (r <= 0.0 || r == sampleRate_)
+    return;
+
+  sampleRate_ = r;
+
+  clear();
+}
+
+const AnimClipCache::Clip *
+AnimClipCache::
+getClip(const std::string &key, CGeomObject3D *animObject, const std::string &animName)
+{
+  auto clipKey = key + "/" + animName;
+
+  auto pc = clips_.find(clipKey);
+
+  if (pc != clips_.end())
+    return (*pc).second.get();
+
+  //---
+
+  auto clip = std::make_unique<Clip>();
+
+  // clip with no time range is not cached (null clip)
+  if (! animObject->getAnimationTranslationRange(animName, clip->tmin, clip->tmax) ||
+      clip->tmax <= clip->tmin) {
+    clips_[clipKey] = ClipP();
+    return nullptr;
+  }
+
+  auto n = int(std::ceil((clip->tmax - clip->tmin)*sampleRate_)) + 1;
+
+  clip->numSamples = std::min(std::max(n, MIN_SAMPLES), MAX_SAMPLES);
+  clip->dt         = (clip->tmax - clip->tmin)/(clip->numSamples - 1);
+
+  //---
+
+  // animated nodes by index (last node wins for duplicate index as in node matrices map)
+  std::map<int, CGeomNodeData *> indexNodes;
+
+  for (const auto &pn : animObject->getNodes()) {
+    auto &node = const_cast<CGeomNodeData &>(pn.second);
+
+    if (node.index() >= 0)
+      indexNodes[node.index()] = &node;
+  }
+
+  for (const auto &pn : indexNodes)
+    clip->nodeIds.push_back(pn.first);
+
+  auto nn = clip->nodeIds.size()*MATRIX_SIZE;
+
+  clip->matrices.resize(size_t(clip->numSamples)*nn);
+
+  //---
+
+  auto inverseMeshMatrix = animObject->getMeshGlobalTransform().inverse();
+
+  for (int i = 0; i < clip->numSamples; ++i) {
+    auto t = clip->tmin + i*clip->dt;
+
+    animObject->updateNodesAnimationData(animName, t);
+
+    auto *m = &clip->matrices[size_t(i)*nn];
+
+    for (const auto &pn : indexNodes) {
+      auto nodeMatrix = pn.second->calcNodeAnimMatrix(inverseMeshMatrix);
+
+      const auto *data = nodeMatrix.getData(); // row major
+
+      for (int j = 0; j < MATRIX_SIZE; ++j)
+        m[j] = float(data[j]);
+
+      m += MATRIX_SIZE;
+    }
+  }
+
+  auto *clip1 = clip.get();
+
+  clips_[clipKey] = std::move(clip);
+
+  return clip1;
+}
+
+const AnimClipCache::MeshFrames &
+AnimClipCache::
+getMeshFrames(const std::string &key, CGeomObject3D *object, int meshNodeId,
+              const std::string &animName, int nt)
+{
+  auto framesKey = key + "/" + animName + "/" + std::to_string(meshNodeId) + "/" +
+                   std::to_string(nt);
+
+  auto pf = meshFrames_.find(framesKey);
+
+  if (pf != meshFrames_.end())
+    return *(*pf).second;
+
+  //---
+
+  auto frames = std::make_unique<MeshFrames>();
+
+  auto *animObject = object->getAnimObject();
+
+  auto &node = const_cast<CGeomNodeData &>(animObject->getNode(meshNodeId));
+
+  (void) animObject->getAnimationTranslationRange(animName, frames->tmin, frames->tmax);
+
+  if (nt > 1)
+    frames->dt = (frames->tmax - frames->tmin)/(nt - 1);
+  else
+    frames->dt = (frames->tmax - frames->tmin);
+
+  for (int i = 0; i < nt; ++i) {
+    auto t = frames->tmin + i*frames->dt;
+
+    frames->matrices.push_back(CMatrix3DH(object->getNodeAnimHierTransform(node, animName, t)));
+  }
+
+  auto &frames1 = *frames;
+
+  meshFrames_[framesKey] = std::move(frames);
+
+  return frames1;
+}
+
+void
+AnimClipCache::
+clear()
+{
+  clips_     .clear();
+  meshFrames_.clear();
+}
+
+}
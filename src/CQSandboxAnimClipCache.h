@@ -0,0 +1,85 @@
+#ifndef CQSandboxAnimClipCache_H
+#define CQSandboxAnimClipCache_H
+
+#include <CMatrix3DH.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class CGeomObject3D;
+
+namespace CQSandbox {
+
+// cache of pre-sampled animation clips
+//
+// each (model key, clip name) is sampled once at a fixed rate into a contiguous array of
+// node animation matrices (sample major, 3x4 row major floats) and the node matrices for
+// any time are a lerp between the two nearest samples. Keys identify the model source
+// (e.g. file name) so all instances of the same model share the samples.
+//
+// mesh frame matrices of non-jointed animated meshes are cached the same way.
+class AnimClipCache {
+ public:
+  static constexpr int MATRIX_SIZE = 12;
+
+  // sampled node matrices of clip
+  struct Clip {
+    double             tmin       { 0.0 };
+    double             tmax       { 0.0 };
+    double             dt         { 0.0 };
+    int                numSamples { 0 };
+    std::vector<int>   nodeIds;  // animated node indices (ascending)
+    std::vector<float> matrices; // numSamples*nodeIds.size()*MATRIX_SIZE
+
+    // interpolate node matrices at time into m (nodeIds.size()*MATRIX_SIZE values)
+    void interp(double t, float *m) const;
+  };
+
+  // sampled mesh matrices of non-jointed mesh
+  struct MeshFrames {
+    double                  tmin { 0.0 };
+    double                  tmax { 0.0 };
+    double                  dt   { 0.0 };
+    std::vector<CMatrix3DH> matrices;
+  };
+
+ public:
+  static AnimClipCache *instance();
+
+  AnimClipCache() { }
+
+  AnimClipCache(const AnimClipCache &) = delete;
+  AnimClipCache &operator=(const AnimClipCache &) = delete;
+
+  //! get/set samples per unit of animation time (clears cache)
+  double sampleRate() const { return sampleRate_; }
+  void setSampleRate(double r);
+
+  size_t numClips() const { return clips_.size(); }
+
+  // get clip for model key (sampled on first use), null if clip has no time range
+  const Clip *getClip(const std::string &key, CGeomObject3D *animObject,
+                      const std::string &animName);
+
+  // get nt mesh matrices of non-jointed object mesh node for model key
+  const MeshFrames &getMeshFrames(const std::string &key, CGeomObject3D *object,
+                                  int meshNodeId, const std::string &animName, int nt);
+
+  void clear();
+
+ private:
+  using ClipP       = std::unique_ptr<Clip>;
+  using Clips       = std::map<std::string, ClipP>;
+  using MeshFramesP = std::unique_ptr<MeshFrames>;
+  using MeshFramesM = std::map<std::string, MeshFramesP>;
+
+  double      sampleRate_ { 60.0 };
+  Clips       clips_;
+  MeshFramesM meshFrames_;
+};
+
+}
+
+#endif
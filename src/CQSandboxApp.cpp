@@ -7,6 +7,8 @@
 #include <CQSandboxToolbar3D.h>
 #include <CQSandboxStatus.h>
 #include <CQSandboxOverview3D.h>
+#include <CQSandboxTclCallback.h>
+#include <CQSandboxProperty.h>
 
 #include <CQTclUtil.h>
 #include <CQTabSplit.h>
@@ -19,8 +21,11 @@
 #endif
 
 #include <QVBoxLayout>
+#include <QElapsedTimer>
 #include <QFile>
 
+#include <cstring>
+
 #include <svg/play_svg.h>
 #include <svg/pause_svg.h>
 #include <svg/play_one_svg.h>
@@ -253,6 +258,75 @@ runTclCmd(const QString &cmd)
   return rc;
 }
 
+bool
+App::
+runTclCallback(TclCallback &callback)
+{
+  auto *interp = tcl_->interp();
+
+  // new or redefined proc so check for empty body (commands which are not procs are run).
+  // Command trace clears checked on delete, rename or redefine
+  if (! callback.checked_) {
+    // not defined
+    Tcl_CmdInfo info;
+
+    if (! Tcl_GetCommandInfo(interp, callback.name_, &info))
+      return true;
+
+    callback.checked_ = true;
+    callback.enabled_ = true;
+
+    if (! callback.traced_)
+      callback.trace(interp);
+
+    // no trace so recheck every call
+    if (! callback.traced_)
+      callback.checked_ = false;
+
+    Tcl_Obj *objv[3] = {
+      Tcl_NewStringObj("info", -1), Tcl_NewStringObj("body", -1),
+      Tcl_NewStringObj(callback.name_, -1) };
+
+    for (auto *obj : objv)
+      Tcl_IncrRefCount(obj);
+
+    if (Tcl_EvalObjv(interp, 3, objv, TCL_EVAL_GLOBAL) == TCL_OK)
+      callback.enabled_ = (QString(Tcl_GetStringResult(interp)).trimmed() != "");
+
+    for (auto *obj : objv)
+      Tcl_DecrRefCount(obj);
+
+    Tcl_ResetResult(interp);
+  }
+
+  if (! callback.enabled_)
+    return true;
+
+  //---
+
+  if (! callback.cmdObj_) {
+    callback.cmdObj_ = Tcl_NewStringObj(callback.name_, -1);
+
+    Tcl_IncrRefCount(callback.cmdObj_);
+  }
+
+  QElapsedTimer timer;
+
+  timer.start();
+
+  auto rc = Tcl_EvalObjv(interp, 1, &callback.cmdObj_, TCL_EVAL_GLOBAL);
+
+  scriptTime_ += timer.nsecsElapsed()/1e6;
+
+  if (rc != TCL_OK) {
+    errorMsg(QString("Command '%1' failed: %2").
+               arg(callback.name_).arg(CTclUtil::errorInfo(interp, rc).c_str()));
+    return false;
+  }
+
+  return true;
+}
+
 QStringList
 App::
 getArgs(int objc, const Tcl_Obj **objv) const
@@ -268,6 +342,167 @@ getArgs(int objc, const Tcl_Obj **objv) const
   return args;
 }
 
+namespace {
+
+// Tcl object type caching interned property id of name (string rep is never changed)
+void propertyDupIntRep(Tcl_Obj *srcPtr, Tcl_Obj *dupPtr);
+int  propertySetFromAny(Tcl_Interp *, Tcl_Obj *objPtr);
+
+Tcl_ObjType propertyObjType = {
+  "sb_property", nullptr, propertyDupIntRep, nullptr, propertySetFromAny
+};
+
+void
+propertyDupIntRep(Tcl_Obj *srcPtr, Tcl_Obj *dupPtr)
+{
+  dupPtr->internalRep.longValue = srcPtr->internalRep.longValue;
+  dupPtr->typePtr               = &propertyObjType;
+}
+
+int
+propertySetFromAny(Tcl_Interp *, Tcl_Obj *objPtr)
+{
+  auto id = PropertyId::find(QString(Tcl_GetString(objPtr)));
+  if (id < 0) return TCL_ERROR;
+
+  if (objPtr->typePtr && objPtr->typePtr->freeIntRepProc)
+    objPtr->typePtr->freeIntRepProc(objPtr);
+
+  objPtr->internalRep.longValue = id;
+  objPtr->typePtr               = &propertyObjType;
+
+  return TCL_OK;
+}
+
+}
+
+QString
+App::
+getPropertyName(const Tcl_Obj *obj) const
+{
+  auto *obj1 = const_cast<Tcl_Obj *>(obj);
+
+  if (obj1->typePtr == &propertyObjType ||
+      propertySetFromAny(nullptr, obj1) == TCL_OK)
+    return PropertyId::name(int(obj1->internalRep.longValue));
+
+  return QString(Tcl_GetString(obj1));
+}
+
+bool
+App::
+getDataArgs(Tcl_Interp *interp, int objc, const Tcl_Obj **objv,
+            bool hasValues, DataArgs &dataArgs) const
+{
+  // objv: <obj> <op> <name> [<values>] [options]
+  int i = 2;
+
+  if (i >= objc)
+    return errorMsg("Missing data name");
+
+  dataArgs.name = QString(Tcl_GetString(const_cast<Tcl_Obj *>(objv[i++])));
+
+  Tcl_Obj *valuesObj = nullptr;
+
+  if (hasValues) {
+    if (i >= objc)
+      return errorMsg("Missing data values");
+
+    valuesObj = const_cast<Tcl_Obj *>(objv[i++]);
+  }
+
+  for ( ; i < objc; ++i) {
+    std::string opt = Tcl_GetString(const_cast<Tcl_Obj *>(objv[i]));
+
+    if      (opt == "-binary")
+      dataArgs.binary = true;
+    else if (opt == "-start" || opt == "-stride") {
+      if (i + 1 >= objc)
+        return errorMsg(QString("Missing value for '%1'").arg(opt.c_str()));
+
+      int n;
+      if (Tcl_GetIntFromObj(interp, const_cast<Tcl_Obj *>(objv[++i]), &n) != TCL_OK)
+        return errorMsg(QString("Invalid value for '%1'").arg(opt.c_str()));
+
+      if (opt == "-start")
+        dataArgs.start = n;
+      else
+        dataArgs.stride = n;
+    }
+    else
+      return errorMsg(QString("Invalid data option '%1'").arg(opt.c_str()));
+  }
+
+  if (dataArgs.start < 0 || dataArgs.stride < 1)
+    return errorMsg("Invalid data range");
+
+  if (! valuesObj)
+    return true;
+
+  //---
+
+  // convert values directly from byte array or list elements (no string round trip)
+  auto &values = dataArgs.values;
+
+  if (dataArgs.binary) {
+    int len = 0;
+    auto *bytes = Tcl_GetByteArrayFromObj(valuesObj, &len);
+
+    if (len % int(sizeof(float)) != 0)
+      return errorMsg("Invalid binary data size");
+
+    values.resize(size_t(len)/sizeof(float));
+
+    if (len > 0)
+      std::memcpy(&values[0], bytes, size_t(len));
+  }
+  else {
+    int       n     = 0;
+    Tcl_Obj **elems = nullptr;
+
+    if (Tcl_ListObjGetElements(interp, valuesObj, &n, &elems) != TCL_OK)
+      return errorMsg("Invalid data list");
+
+    values.resize(size_t(n));
+
+    for (int j = 0; j < n; ++j) {
+      double r;
+      if (Tcl_GetDoubleFromObj(interp, elems[j], &r) != TCL_OK)
+        return errorMsg("Invalid data value");
+
+      values[size_t(j)] = float(r);
+    }
+  }
+
+  return true;
+}
+
+void
+App::
+setDataResult(Tcl_Interp *interp, const std::vector<float> &values, bool binary) const
+{
+  Tcl_Obj *resObj = nullptr;
+
+  if (binary) {
+    auto len = int(values.size()*sizeof(float));
+
+    resObj = Tcl_NewByteArrayObj(
+      reinterpret_cast<const unsigned char *>(values.empty() ? nullptr : &values[0]), len);
+  }
+  else {
+    std::vector<Tcl_Obj *> elems;
+
+    elems.reserve(values.size());
+
+    for (const auto &v : values)
+      elems.push_back(Tcl_NewDoubleObj(v));
+
+    resObj = Tcl_NewListObj(int(elems.size()), elems.empty() ? nullptr : &elems[0]);
+  }
+
+  Tcl_SetObjResult(interp, resObj);
+}
+
 bool
 App::
 errorMsg(const QString &msg) const
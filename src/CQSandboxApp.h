@@ -5,6 +5,8 @@
 
 #include <QFrame>
 
+#include <vector>
+
 class CQTcl;
 class CQTabSplit;
 
@@ -14,6 +16,7 @@ class QLabel;
 
 namespace CQSandbox {
 
+class TclCallback;
 class Canvas;
 class Toolbar2D;
 class Canvas3D;
@@ -65,8 +68,37 @@ class App : public QFrame {
 
   bool runTclCmd(const QString &cmd);
 
+  // run per frame callback proc (skipped if not defined or empty)
+  bool runTclCallback(TclCallback &callback);
+
+  // total time (ms) spent in callback procs
+  double scriptTime() const { return scriptTime_; }
+
   QStringList getArgs(int objc, const Tcl_Obj **objv) const;
 
+  // property name of get/set arg. Known (interned) names are cached in the Tcl object
+  // so repeated calls skip the string conversion and name hash
+  QString getPropertyName(const Tcl_Obj *obj) const;
+
+  //---
+
+  // bulk data command args: <name> [<values>] [-binary] [-start <i>] [-stride <n>]
+  //
+  // values are a list of numbers or, with -binary, a byte array of native floats
+  // (binary format f*). Elements start at element start and step by stride elements
+  struct DataArgs {
+    QString            name;
+    std::vector<float> values;
+    bool               binary { false };
+    int                start  { 0 };
+    int                stride { 1 };
+  };
+
+  bool getDataArgs(Tcl_Interp *interp, int objc, const Tcl_Obj **objv,
+                   bool hasValues, DataArgs &dataArgs) const;
+
+  void setDataResult(Tcl_Interp *interp, const std::vector<float> &values, bool binary) const;
+
   bool errorMsg(const QString &msg) const;
 
   //---
@@ -82,6 +114,8 @@ class App : public QFrame {
 
   bool initialized_ { false };
 
+  double scriptTime_ { 0.0 };
+
   Canvas*            canvas_            { nullptr };
   Toolbar2D*         toolbar2D_         { nullptr };
   Canvas3D*          canvas3D_          { nullptr };
@@ -44,10 +44,102 @@ init()
   Object3D::init();
 }
 
+const PropertyTable<Object3D> &
+Axis3DObj::
+properties()
+{
+  using Table = PropertyTable<Object3D>;
+
+  static Table table({
+    { "start", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *axis = static_cast<Axis3DObj *>(obj);
+
+        axis->start_ = Util::stringToVector3D(axis->canvas()->app()->tcl(), value);
+
+        axis->setNeedsUpdate();
+
+        return true;
+      } },
+    { "end", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *axis = static_cast<Axis3DObj *>(obj);
+
+        axis->end_ = Util::stringToVector3D(axis->canvas()->app()->tcl(), value);
+
+        axis->setNeedsUpdate();
+
+        return true;
+      } },
+    { "min", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *axis = static_cast<Axis3DObj *>(obj);
+
+        axis->min_ = Util::stringToReal(value);
+
+        axis->setNeedsUpdate();
+
+        return true;
+      } },
+    { "max", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *axis = static_cast<Axis3DObj *>(obj);
+
+        axis->max_ = Util::stringToReal(value);
+
+        axis->setNeedsUpdate();
+
+        return true;
+      } },
+    { "auto_range", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *axis = static_cast<Axis3DObj *>(obj);
+
+        auto *canvas = axis->canvas();
+
+        if      (value == "x") {
+          const auto &xrange = canvas->xrange();
+
+          axis->start_ = CVector3D(-1, -0.5, -0.5);
+          axis->end_   = CVector3D( 1, -0.5, -0.5);
+          axis->min_   = xrange.min();
+          axis->max_   = xrange.max();
+        }
+        else if (value == "y") {
+          const auto &yrange = canvas->yrange();
+
+          axis->start_ = CVector3D(-0.5, -1, -0.5);
+          axis->end_   = CVector3D(-0.5,  1, -0.5);
+          axis->min_   = yrange.min();
+          axis->max_   = yrange.max();
+        }
+        else if (value == "z") {
+          const auto &zrange = canvas->zrange();
+
+          axis->start_ = CVector3D(-0.5, -0.5,  1);
+          axis->end_   = CVector3D(-0.5, -0.5, -1);
+          axis->min_   = zrange.min();
+          axis->max_   = zrange.max();
+        }
+
+        axis->setNeedsUpdate();
+
+        return true;
+      } },
+  }, &Object3D::properties());
+
+  return table;
+}
+
 bool
 Axis3DObj::
 getValue(const QString &name, const QStringList &args, QVariant &value)
 {
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
+
   return Object3D::getValue(name, args, value);
 }
 
@@ -55,61 +147,12 @@ bool
 Axis3DObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  auto *app = canvas_->app();
-  auto *tcl = app->tcl();
+  auto *property = properties().find(name);
 
-  if      (name == "start") {
-    start_ = Util::stringToVector3D(tcl, value);
-
-    setNeedsUpdate();
-  }
-  else if (name == "end") {
-    end_ = Util::stringToVector3D(tcl, value);
-
-    setNeedsUpdate();
-  }
-  else if (name == "min") {
-    min_ = Util::stringToReal(value);
-
-    setNeedsUpdate();
-  }
-  else if (name == "max") {
-    max_ = Util::stringToReal(value);
-
-    setNeedsUpdate();
-  }
-  else if (name == "auto_range") {
-    if      (value == "x") {
-      const auto &xrange = canvas_->xrange();
-
-      start_ = CVector3D(-1, -0.5, -0.5);
-      end_   = CVector3D( 1, -0.5, -0.5);
-      min_   = xrange.min();
-      max_   = xrange.max();
-    }
-    else if (value == "y") {
-      const auto &yrange = canvas_->yrange();
-
-      start_ = CVector3D(-0.5, -1, -0.5);
-      end_   = CVector3D(-0.5,  1, -0.5);
-      min_   = yrange.min();
-      max_   = yrange.max();
-    }
-    else if (value == "z") {
-      const auto &zrange = canvas_->zrange();
-
-      start_ = CVector3D(-0.5, -0.5,  1);
-      end_   = CVector3D(-0.5, -0.5, -1);
-      min_   = zrange.min();
-      max_   = zrange.max();
-    }
-
-    setNeedsUpdate();
-  }
-  else
-    return Object3D::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object3D::setValue(name, value, args);
 }
 
 void
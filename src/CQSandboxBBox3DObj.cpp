@@ -203,6 +203,9 @@ render()
 
   //---
 
+  // vertex array is bound directly so clear canvas current buffer
+  canvas_->bindBuffer(nullptr);
+
   canvas_->glBindVertexArray(vertexArrayId_);
 
   int np = points_.size();
@@ -4,6 +4,9 @@
 #include <CQSandboxControl2D.h>
 #include <CQSandboxViewport.h>
 #include <CQSandboxToolbar2D.h>
+#include <CQSandboxCompositor.h>
+#include <CQSandboxObjectIndex.h>
+#include <CThreadPool.h>
 
 #include <CQSVGUtil.h>
 #include <CQTclUtil.h>
@@ -16,11 +19,14 @@
 #include <CCircleFactor.h>
 #include <CFile.h>
 
+#include <QElapsedTimer>
 #include <QFile>
 #include <QPainter>
 #include <QTimer>
 #include <QMouseEvent>
 
+#include <set>
+
 namespace CQSandbox {
 
 template<typename T>
@@ -293,6 +299,108 @@ CRGBA QColorToRGBA(const QColor &c) {
   return CRGBA(c.redF(), c.greenF(), c.blueF(), c.alphaF());
 }
 
+// time (ms/tick) of particle system with square mesh of (at least) numSprings
+// springs for 1, 2, 4 ... hardware threads and check repeated runs are identical
+QString springMeshBenchmark(int numSprings, int numTicks) {
+  // w x w mesh has 2*w*(w - 1) springs
+  int w = 2;
+
+  while (2*w*(w - 1) < numSprings)
+    ++w;
+
+  using Particles = std::vector<CPSysParticle *>;
+  using Springs   = std::vector<CPSysSpring *>;
+
+  // system does not own particles and springs (deleted by caller)
+  auto buildMesh = [&](CPSysSystem &psys, Particles &particles, Springs &springs) {
+    for (int y = 0; y < w; ++y)
+      for (int x = 0; x < w; ++x)
+        particles.push_back(psys.makeParticle(1.0, x, y, 0.01*((x*7 + y*13) % 17)));
+
+    for (int x = 0; x < w; ++x)
+      particles[size_t(x)]->makeFixed();
+
+    for (int y = 0; y < w; ++y) {
+      for (int x = 0; x < w; ++x) {
+        auto *p = particles[size_t(y*w + x)];
+
+        if (x < w - 1)
+          springs.push_back(psys.makeSpring(p, particles[size_t(y*w + x + 1)], 5.0, 0.1, 1.0));
+        if (y < w - 1)
+          springs.push_back(psys.makeSpring(p, particles[size_t(y*w + x + w)], 5.0, 0.1, 1.0));
+      }
+    }
+  };
+
+  auto runMesh = [&](size_t numThreads, double &t, std::vector<double> &coords) {
+    CPSysSystem psys(-1.0, 0.1);
+
+    Particles particles;
+    Springs   springs;
+
+    buildMesh(psys, particles, springs);
+
+    psys.setNumThreads(numThreads);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < numTicks; ++i)
+      psys.tick(0.01);
+
+    t = timer.nsecsElapsed()/1e6/numTicks;
+
+    const auto &position = psys.store().position;
+
+    coords = position.x;
+
+    coords.insert(coords.end(), position.y.begin(), position.y.end());
+    coords.insert(coords.end(), position.z.begin(), position.z.end());
+
+    // detach particles from system then free mesh
+    psys.clear();
+
+    for (auto *spring : springs)
+      delete spring;
+
+    for (auto *particle : particles)
+      delete particle;
+  };
+
+  auto hwThreads = CThreadPool::hardwareThreads();
+
+  QString str = QString("springs %1").arg(2*w*(w - 1));
+
+  double t1 = 0.0;
+
+  std::vector<double> coords;
+
+  for (size_t n = 1; ; n = std::min(2*n, hwThreads)) {
+    double t;
+
+    runMesh(n, t, coords);
+
+    if (n == 1)
+      t1 = t;
+
+    str += QString(" threads %1 %2ms x%3").arg(n).arg(t).arg(t > 0.0 ? t1/t : 0.0);
+
+    if (n >= hwThreads)
+      break;
+  }
+
+  // same thread count must give bit identical positions
+  double t;
+
+  std::vector<double> coords1;
+
+  runMesh(hwThreads, t, coords1);
+
+  str += QString(" repeatable %1").arg(coords == coords1 ? 1 : 0);
+
+  return str;
+}
+
 }
 
 //---
@@ -308,6 +416,10 @@ Canvas(App *app) :
   setMouseTracking(true);
 
   psys_ = new ParticleSystem;
+
+  compositor_ = new Compositor;
+
+  objectIndex_ = new ObjectIndex(this);
 }
 
 void
@@ -512,21 +624,33 @@ Rect
 Canvas::
 rectToPixel(const Rect &rect) const
 {
-  auto p1 = pointToPixel(rect.ll);
-  auto p2 = pointToPixel(rect.ur);
+  return rectToPixel(currentViewport(), rect);
+}
+
+Point
+Canvas::
+pointToPixel(const Point &p) const
+{
+  return pointToPixel(currentViewport(), p);
+}
+
+Rect
+Canvas::
+rectToPixel(Viewport *viewport, const Rect &rect) const
+{
+  auto p1 = pointToPixel(viewport, rect.ll);
+  auto p2 = pointToPixel(viewport, rect.ur);
 
   return Rect(p1, p2);
 }
 
 Point
 Canvas::
-pointToPixel(const Point &p) const
+pointToPixel(Viewport *viewport, const Point &p) const
 {
   if (p.x.units == Units::PIXEL)
     return p;
 
-  auto *viewport = currentViewport();
-
   double px, py;
   if (viewport->hasRange)
     viewport->displayRange.windowToPixel(p.x.value, p.y.value, &px, &py);
@@ -599,6 +723,12 @@ void
 Canvas::
 step()
 {
+  QElapsedTimer timer;
+
+  timer.start();
+
+  auto scriptTime = app_->scriptTime();
+
   ++ticks_;
 
   //---
@@ -610,16 +740,32 @@ step()
 
   psys_->tick(0.01);
 
+  // particle objects move with particle
+  const auto &particles = psys_->getParticles();
+
+  for (uint i = 0; i < particles.size(); ++i) {
+    auto *particle = static_cast<Particle *>(particles.get(int(i)));
+
+    if (particle->obj())
+      objectChanged(particle->obj());
+  }
+
   for (auto *viewport : viewports_) {
     for (auto *obj : viewport->objects) {
       if (obj->isAnimating()) {
         if (! obj->step())
           obj->setAnimating(false);
+
+        // also clears raster cache and marks groups changed
+        objectChanged(obj);
       }
     }
   }
 
-  app_->runTclCmd("update");
+  app_->runTclCallback(updateProc_);
+
+  stepTime_       = timer.nsecsElapsed()/1e6;
+  stepScriptTime_ = app_->scriptTime() - scriptTime;
 
   //---
 
@@ -629,6 +775,8 @@ step()
 
     drawBufferedNeeded_ = true;
   }
+  else if (retained_)
+    requestRedraw();
 }
 
 void
@@ -658,6 +806,18 @@ void
 Canvas::
 drawBuffered()
 {
+  // retained mode redraws damaged region of previous image (blend needs full draw)
+  redrawPartial_ = false;
+
+  if (retained_ && ! blend_) {
+    bool full;
+
+    if (! takeRedrawRegion(redrawRegion_, full))
+      return;
+
+    redrawPartial_ = ! full;
+  }
+
   if (blend_)
     painter_ = new QPainter(&bufferImage2_);
   else
@@ -665,6 +825,8 @@ drawBuffered()
 
   drawStep();
 
+  redrawPartial_ = false;
+
   delete painter_;
 
   painter_ = nullptr;
@@ -704,48 +866,8 @@ void
 Canvas::
 fadeImage(QImage &image1, QImage &image2, double f)
 {
-#if 1
   // blend image2 into faded image1
-  for (int y = 0; y < pixelHeight_; ++y) {
-    for (int x = 0; x < pixelWidth_; ++x) {
-      QRgb pixel1 = image1.pixel(x, y);
-      QRgb pixel2 = image2.pixel(x, y);
-
-      auto a1 = qAlpha(pixel1)/255.0;
-
-      QRgb pixel3;
-
-      if (a1 > 0) {
-        auto r1 = qRed  (pixel1)/255.0;
-        auto g1 = qGreen(pixel1)/255.0;
-        auto b1 = qBlue (pixel1)/255.0;
-
-        auto r2 = qRed  (pixel2)/255.0;
-        auto g2 = qGreen(pixel2)/255.0;
-        auto b2 = qBlue (pixel2)/255.0;
-
-        pixel3 = qRgb(int(255*std::min(r1*f + r2, 1.0)),
-                      int(255*std::min(g1*f + g2, 1.0)),
-                      int(255*std::min(b1*f + b2, 1.0)));
-      }
-      else
-        pixel3 = pixel2;
-
-      if (pixel3 != pixel1)
-        image1.setPixel(x, y, pixel3);
-    }
-  }
-#else
-  if (f < 0) return;
-
-  for (int y = 0; y < pixelHeight_; ++y) {
-    for (int x = 0; x < pixelWidth_; ++x) {
-      QRgb pixel2 = image2.pixel(x, y);
-
-      image1.setPixel(x, y, pixel2);
-    }
-  }
-#endif
+  compositor_->fadeImage(image1, image2, f);
 }
 
 void
@@ -795,11 +917,13 @@ updatePixelRanges()
 
     viewport->displayRange.setPixelRange(x1, y1, x2, y2);
   }
+
+  invalidateObjects();
 }
 
 void
 Canvas::
-paintEvent(QPaintEvent *)
+paintEvent(QPaintEvent *e)
 {
   if (buffered_) {
     QPainter painter(this);
@@ -810,6 +934,12 @@ paintEvent(QPaintEvent *)
     if (drawing_)
       return;
 
+    // retained mode only draws the region Qt needs (rest of widget is kept)
+    redrawPartial_ = retained_ && e;
+
+    if (redrawPartial_)
+      redrawRegion_ = e->region();
+
     painter_ = new QPainter(this);
 
     drawStep();
@@ -817,6 +947,8 @@ paintEvent(QPaintEvent *)
     delete painter_;
 
     painter_ = nullptr;
+
+    redrawPartial_ = false;
   }
 }
 
@@ -835,6 +967,16 @@ drawStep()
     return;
   }
 
+  QElapsedTimer timer;
+
+  timer.start();
+
+  auto scriptTime = app_->scriptTime();
+
+  redrawObjects_ = 0;
+  redrawCached_  = 0;
+  redrawFull_    = ! redrawPartial_;
+
   for (auto *viewport : viewports_) {
     currentViewport_ = viewport;
 
@@ -845,15 +987,40 @@ drawStep()
 
     auto rect = QRectF(x1, y1, x2 - x1, y2 - y1);
 
-    painter_->setClipRect(rect);
+    QRegion region;
+
+    if (redrawPartial_) {
+      region = redrawRegion_.intersected(rect.toAlignedRect());
+
+      if (region.isEmpty()) {
+        currentViewport_ = nullptr;
+        continue;
+      }
+
+      painter_->setClipRegion(region);
+    }
+    else
+      painter_->setClipRect(rect);
 
     painter_->fillRect(rect, viewport->brush.value().color());
 
-    app_->runTclCmd("drawBg");
+    app_->runTclCallback(drawBgProc_);
 
-    for (auto *obj : viewport->objects) {
-      if (obj->isVisible())
-        obj->draw(painter_);
+    if (redrawPartial_) {
+      Objects objs;
+
+      objectIndex_->objectsTouchingRegion(region, viewport, objs);
+
+      for (auto *obj : objs) {
+        if (obj->isVisible())
+          drawObject(obj);
+      }
+    }
+    else {
+      for (auto *obj : viewport->objects) {
+        if (obj->isVisible())
+          drawObject(obj);
+      }
     }
 
     auto np = psys_->numberOfParticles();
@@ -870,14 +1037,123 @@ drawStep()
       drawParticle(painter_, particle1);
     }
 
-    app_->runTclCmd("drawFg");
+    app_->runTclCallback(drawFgProc_);
 
     currentViewport_ = nullptr;
   }
 
+  drawTime_       = timer.nsecsElapsed()/1e6;
+  drawScriptTime_ = app_->scriptTime() - scriptTime;
+
   drawing_ = false;
 }
 
+void
+Canvas::
+drawObject(Object *obj)
+{
+  ++redrawObjects_;
+
+  if (retained_ && obj->isRasterCached() && drawCachedObject(obj)) {
+    ++redrawCached_;
+    return;
+  }
+
+  obj->draw(painter_);
+}
+
+bool
+Canvas::
+drawCachedObject(Object *obj)
+{
+  // first draw after change is direct, second unchanged draw creates image
+  auto &data = rasterCache_[obj];
+
+  if (! data.valid) {
+    QRectF prect;
+
+    if (! objectIndex_->objectRect(obj, prect))
+      return false;
+
+    auto m = ObjectIndex::drawMargin(obj);
+
+    auto irect = prect.adjusted(-m, -m, m, m).toAlignedRect();
+
+    if (irect.isEmpty() || irect.width()*irect.height() > 1024*1024)
+      return false;
+
+    if (! data.drawn) {
+      data.drawn = true;
+
+      return false;
+    }
+
+    data.image = QImage(irect.size(), QImage::Format_ARGB32_Premultiplied);
+    data.pos   = irect.topLeft();
+
+    data.image.fill(Qt::transparent);
+
+    QPainter painter(&data.image);
+
+    painter.setRenderHints(painter_->renderHints());
+    painter.translate(-data.pos);
+
+    obj->draw(&painter);
+
+    data.valid = true;
+  }
+
+  painter_->drawImage(data.pos, data.image);
+
+  return true;
+}
+
+void
+Canvas::
+setRetained(bool b)
+{
+  retained_ = b;
+
+  rasterCache_.clear();
+
+  fullRedraw_ = true;
+}
+
+bool
+Canvas::
+takeRedrawRegion(QRegion &region, bool &full)
+{
+  // moving particles are not in damage so need full redraw
+  bool all;
+  objectIndex_->takeDamage(region, all);
+
+  full = all || fullRedraw_ || psys_->numberOfParticles() > 0;
+
+  fullRedraw_ = false;
+
+  return (full || ! region.isEmpty());
+}
+
+void
+Canvas::
+requestRedraw()
+{
+  if (retained_ && ! buffered_) {
+    QRegion region;
+    bool    full;
+
+    if (! takeRedrawRegion(region, full))
+      return;
+
+    if (full)
+      update();
+    else
+      update(region);
+  }
+  else
+    update();
+}
+
 void
 Canvas::
 drawParticle(QPainter *painter, Particle *particle)
@@ -886,9 +1162,9 @@ drawParticle(QPainter *painter, Particle *particle)
 
   painter->setPen(obj->pen());
 
-  auto *position = particle->position();
+  auto position = particle->position();
 
-  auto p = Point(position->x(), position->y());
+  auto p = Point(position.x(), position.y());
 
   auto p1 = pointToPixel(p).qpoint();
 
@@ -952,7 +1228,7 @@ mousePressEvent(QMouseEvent *e)
 
   app_->runTclCmd(QString("mousePress %1 %2").arg(p.x()).arg(p.y()));
 
-  update();
+  requestRedraw();
 }
 
 void
@@ -995,7 +1271,7 @@ mouseMoveEvent(QMouseEvent *e)
   if (pressed_)
     app_->runTclCmd(QString("mouseMove %1 %2").arg(p.x()).arg(p.y()));
 
-  update();
+  requestRedraw();
 }
 
 void
@@ -1017,7 +1293,7 @@ mouseReleaseEvent(QMouseEvent *e)
 
   app_->runTclCmd(QString("mouseRelease %1 %2").arg(p.x()).arg(p.y()));
 
-  update();
+  requestRedraw();
 }
 
 void
@@ -1035,7 +1311,7 @@ keyPressEvent(QKeyEvent *e)
 
   app_->runTclCmd(QString("keyPress {%1}").arg(keyStr));
 
-  update();
+  requestRedraw();
 
   return;
 }
@@ -1084,34 +1360,49 @@ Object *
 Canvas::
 getObjectAtPos(const QPoint &pos) const
 {
-  for (auto *viewport : viewports_) {
-    for (auto *obj : viewport->objects) {
-      auto rect  = obj->calcRect();
-      auto prect = rectToPixel(rect).qrect();
-
-      if (prect.contains(pos))
-        return obj;
-    }
-  }
-
-  return nullptr;
+  return objectIndex_->objectAtPos(pos);
 }
 
 Object *
 Canvas::
 getObjectByName(const QString &name) const
 {
-  for (auto *obj : allObjects_) {
-    if (name == obj->getCommandName())
-      return obj;
-  }
+  return objectIndex_->objectByName(name);
+}
 
-  for (auto *obj : allObjects_) {
-    if (name == obj->calcId())
-      return obj;
-  }
+void
+Canvas::
+getObjectsAtPos(const QPointF &pos, Objects &objs) const
+{
+  objectIndex_->objectsAtPos(pos, objs);
+}
 
-  return nullptr;
+void
+Canvas::
+getObjectsInRect(const QRectF &rect, Objects &objs) const
+{
+  objectIndex_->objectsTouchingRect(rect, objs);
+}
+
+void
+Canvas::
+getObjectOverlaps(const Object *obj, Objects &objs) const
+{
+  objs.clear();
+
+  QRectF rect;
+
+  if (! objectIndex_->objectRect(obj, rect))
+    return;
+
+  Objects objs1;
+
+  objectIndex_->objectsTouchingRect(rect, objs1);
+
+  for (auto *obj1 : objs1) {
+    if (obj1 != obj)
+      objs.push_back(obj1);
+  }
 }
 
 QString
@@ -1124,6 +1415,8 @@ addNewObject(Object *obj)
 
   obj->setInd(++lastInd_);
 
+  objectIndex_->addName(obj);
+
   createObjCommand(obj);
 
   return obj->calcId();
@@ -1139,6 +1432,10 @@ addObject(Object *obj)
 
   obj->setGroup(nullptr);
 
+  auto pv = std::find(viewports_.begin(), viewports_.end(), viewport);
+
+  objectIndex_->addObject(obj, viewport, int(pv - viewports_.begin()));
+
   Q_EMIT objectsChanged();
 }
 
@@ -1155,58 +1452,142 @@ removeObject(Object *obj)
       objects.push_back(obj1);
   }
 
+  if (objects.size() != viewport->objects.size()) {
+    objectIndex_->removeObject(obj);
+
+    rasterCache_.erase(obj);
+  }
+
   std::swap(objects, viewport->objects);
 
   Q_EMIT objectsChanged();
 }
 
-int
+void
 Canvas::
-canvasProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv)
+deleteObject(Object *obj)
 {
-  auto *th = static_cast<Canvas *>(clientData);
-  assert(th);
-
-  auto args = th->app()->getArgs(objc, objv);
-  if (args.size() < 1) return TCL_ERROR;
+  removeObject(obj);
 
-  auto *tcl = th->app_->tcl();
+  deleteObjects(Objects({obj}));
+}
 
-  if      (args[0] == "get") {
-    if (args.size() < 2) {
-      th->app_->errorMsg("Missing args for get");
-      return TCL_ERROR;
-    }
+void
+Canvas::
+deleteObjects(const Objects &objs)
+{
+  // objects must already be removed from viewport
+  std::set<const Object *> objSet;
 
-    QStringList args1;
-    for (int i = 2; i < args.size(); ++i)
-      args1.push_back(args[i]);
+  for (auto *obj : objs) {
+    objectIndex_->removeObject(obj);
 
-    auto res = th->getValue(args[1], args1);
+    rasterCache_.erase(obj);
 
-    tcl->setResult(res);
+    objSet.insert(obj);
   }
-  else if (args[0] == "set") {
-    if (args.size() < 3) {
-      th->app_->errorMsg("Missing args for set");
-      return TCL_ERROR;
-    }
 
-    QStringList args1;
-    for (int i = 3; i < args.size(); ++i)
-      args1.push_back(args[i]);
+  // remove from all objects before updating names (id lookup rescans all objects)
+  Objects allObjects;
 
-    th->setValue(args[1], args[2], args1);
+  for (auto *obj : allObjects_) {
+    if (objSet.find(obj) == objSet.end())
+      allObjects.push_back(obj);
   }
-  else if (args[0] == "exec") {
-    if (args.size() <= 1) {
-      th->app_->errorMsg("Missing args for exec");
-      return TCL_ERROR;
-    }
 
-    QString op = args[1];
+  std::swap(allObjects, allObjects_);
 
-    QStringList args1;
+  for (auto *obj : objs)
+    objectIndex_->removeName(obj);
+
+  if (pressObj_ && objSet.find(pressObj_) != objSet.end())
+    pressObj_ = nullptr;
+
+  for (auto *obj : objs)
+    delete obj;
+}
+
+void
+Canvas::
+objectChanged(const Object *obj)
+{
+  // group rect may depend on child objects
+  while (obj) {
+    objectIndex_->objectChanged(obj, ! drawing_);
+
+    rasterCache_.erase(obj);
+
+    obj = obj->group();
+  }
+}
+
+void
+Canvas::
+invalidateObjects()
+{
+  objectIndex_->invalidate();
+
+  rasterCache_.clear();
+
+  fullRedraw_ = true;
+}
+
+void
+Canvas::
+objectIdChanged(Object *obj, const QString &oldId)
+{
+  objectIndex_->idChanged(obj, oldId);
+}
+
+int
+Canvas::
+canvasProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv)
+{
+  auto *th = static_cast<Canvas *>(clientData);
+  assert(th);
+
+  auto args = th->app()->getArgs(objc, objv);
+  if (args.size() < 1) return TCL_ERROR;
+
+  auto *tcl = th->app_->tcl();
+
+  if      (args[0] == "get") {
+    if (args.size() < 2) {
+      th->app_->errorMsg("Missing args for get");
+      return TCL_ERROR;
+    }
+
+    QStringList args1;
+    for (int i = 2; i < args.size(); ++i)
+      args1.push_back(args[i]);
+
+    auto res = th->getValue(args[1], args1);
+
+    tcl->setResult(res);
+  }
+  else if (args[0] == "set") {
+    if (args.size() < 3) {
+      th->app_->errorMsg("Missing args for set");
+      return TCL_ERROR;
+    }
+
+    QStringList args1;
+    for (int i = 3; i < args.size(); ++i)
+      args1.push_back(args[i]);
+
+    th->setValue(args[1], args[2], args1);
+
+    th->fullRedraw_ = true;
+  }
+  else if (args[0] == "exec") {
+    if (args.size() <= 1) {
+      th->app_->errorMsg("Missing args for exec");
+      return TCL_ERROR;
+    }
+
+    QString op = args[1];
+
+    QStringList args1;
     for (int i = 2; i < args.length(); ++i)
       args1.push_back(args[i]);
 
@@ -1226,8 +1607,9 @@ canvasProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv)
 
         std::swap(objects, viewport->objects);
 
-        for (auto *obj : objects)
-          delete obj;
+        th->deleteObjects(objects);
+
+        Q_EMIT th->objectsChanged();
       }
     }
     else
@@ -1331,222 +1713,519 @@ styleProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv)
   return TCL_OK;
 }
 
-QVariant
+const PropertyTable<Canvas> &
 Canvas::
-getValue(const QString &name, const QStringList &args)
+properties()
 {
-  auto *tcl = app_->tcl();
+  using Table = PropertyTable<Canvas>;
 
-  auto *viewport = currentViewport();
+  static Table table({
+    { "brush.color",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        auto *viewport = canvas->currentViewport();
 
-  if      (name == "brush.color") {
-    return Util::colorToString(viewport->brush.value().color());
-  }
-  else if (name == "brush.color.target") {
-    return Util::colorToString(viewport->brush.target().color());
-  }
-  else if (name == "brush.steps") {
-    return Util::colorToString(viewport->brush.steps());
-  }
-  else if (name == "pen.color") {
-    return Util::colorToString(viewport->pen.color());
-  }
-  else if (name == "pen.width") {
-    return Util::realToString(viewport->pen.widthF());
-  }
-  else if (name == "range") {
-    return rangeToString(tcl, viewport->displayRange);
-  }
-  else if (name == "range.xmin") {
-    double x1, y1, x2, y2;
-    viewport->displayRange.getWindowRange(&x1, &y1, &x2, &y2);
-    return x1;
-  }
-  else if (name == "range.ymin") {
-    double x1, y1, x2, y2;
-    viewport->displayRange.getWindowRange(&x1, &y1, &x2, &y2);
-    return y1;
-  }
-  else if (name == "range.xmax") {
-    double x1, y1, x2, y2;
-    viewport->displayRange.getWindowRange(&x1, &y1, &x2, &y2);
-    return x2;
-  }
-  else if (name == "range.ymax") {
-    double x1, y1, x2, y2;
-    viewport->displayRange.getWindowRange(&x1, &y1, &x2, &y2);
-    return y2;
-  }
-  else if (name == "equal_scale") {
-    auto b = viewport->displayRange.getEqualScale();
+        value = Util::colorToString(viewport->brush.value().color());
 
-    return Util::boolToString(b);
-  }
-  else if (name == "particles") {
-    QStringList ids;
+        return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        auto *tcl = canvas->app()->tcl();
 
-    const auto &particles = psys_->getParticles();
+        auto *viewport = canvas->currentViewport();
 
-    for (uint i = 0; i < particles.size(); ++i) {
-      auto *particle = particles.get(int(i));
+        auto b = viewport->brush.value();
 
-      auto *particle1 = dynamic_cast<Particle *>(particle);
+        b.setColor(Util::stringToColor(tcl, value));
 
-      ids.push_back(particle1->obj()->getCommandName());
-    }
+        viewport->brush = b;
 
-    return ids;
-  }
-  else if (name == "ticks") {
-    return Util::intToString(ticks_);
-  }
-  else if (name == "key") {
-    if (args.size() < 1) {
-      app_->errorMsg(QString("Invalid value name '%1'").arg(name));
-      return QVariant();
-    }
+        return true;
+      } },
+    { "brush.color.target",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        auto *viewport = canvas->currentViewport();
 
-    return getKeyPressed(args[0]);
-  }
-  else if (name == "play") {
-    return running_;
-  }
-  else if (name == "buffered") {
-    return buffered_;
-  }
-  else if (name == "pixel_width") {
-    return pixelWidth_;
-  }
-  else if (name == "pixel_height") {
-    return pixelHeight_;
-  }
-  else if (name == "font.height") {
-    QFontMetrics fm(font());
+        value = Util::colorToString(viewport->brush.target().color());
 
-    return fm.height();
-  }
-  else {
-    app_->errorMsg(QString("Invalid value name '%1'").arg(name));
-    return QVariant();
-  }
-}
+        return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        auto *tcl = canvas->app()->tcl();
 
-bool
-Canvas::
-setValue(const QString &name, const QString &value, const QStringList &)
-{
-  auto *tcl = app_->tcl();
+        auto *viewport = canvas->currentViewport();
 
-  auto *viewport = currentViewport();
+        auto b = viewport->brush.target();
 
-  if      (name == "brush.color") {
-    auto b = viewport->brush.value();
+        b.setColor(Util::stringToColor(tcl, value));
 
-    b.setColor(Util::stringToColor(tcl, value));
+        viewport->brush.setTarget(b);
 
-    viewport->brush = b;
-  }
-  else if (name == "brush.color.target") {
-    auto b = viewport->brush.target();
+        return true;
+      } },
+    { "brush.steps",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        auto *viewport = canvas->currentViewport();
 
-    b.setColor(Util::stringToColor(tcl, value));
+        value = Util::colorToString(viewport->brush.steps());
 
-    viewport->brush.setTarget(b);
-  }
-  else if (name == "brush.steps")
-    viewport->brush.setSteps(Util::stringToInt(value));
-  else if (name == "pen.color")
-    viewport->pen.setColor(Util::stringToColor(tcl, value));
-  else if (name == "pen.width")
-    viewport->pen.setWidthF(Util::stringToReal(value));
-  else if (name == "range") {
-    stringToRange(tcl, viewport->displayRange, value);
+        return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        auto *viewport = canvas->currentViewport();
 
-    viewport->hasRange = true;
-  }
-  else if (name == "equal_scale") {
-    auto *viewport = currentViewport();
+        viewport->brush.setSteps(Util::stringToInt(value));
 
-    viewport->displayRange.setEqualScale(Util::stringToBool(value));
+        return true;
+      } },
+    { "pen.color",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        auto *viewport = canvas->currentViewport();
 
-    viewport->hasRange = true;
-  }
-  else if (name == "view") {
-    currentViewportName_ = value;
-  }
-  else if (name == "view.rect") {
-    viewport->rect = stringToRect(tcl, value);
+        value = Util::colorToString(viewport->pen.color());
 
-    updatePixelRanges();
-  }
-  else if (name == "play") {
-    if (Util::stringToBool(value))
-      play();
-    else
-      pause();
-  }
-  else if (name == "gravity") {
-    psys_->setGravity(Util::stringToReal(value));
-  }
-  else if (name == "buffered") {
-    buffered_ = Util::stringToBool(value);
+        return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        auto *tcl = canvas->app()->tcl();
 
-    resizeEvent(nullptr);
-  }
-  else if (name == "blend.enabled") {
-    blend_ = Util::stringToBool(value);
+        auto *viewport = canvas->currentViewport();
 
-    resizeEvent(nullptr);
-  }
-  else if (name == "blend.factor") {
-    blendFactor_ = Util::stringToReal(value);
-  }
-  else if (name == "window.size") {
-    auto size = stringToPoint(tcl, value);
+        viewport->pen.setColor(Util::stringToColor(tcl, value));
 
-    int w = size.x.value;
-    int h = size.y.value;
+        return true;
+      } },
+    { "pen.width",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        auto *viewport = canvas->currentViewport();
 
-    h += app_->toolbar2D()->height();
+        value = Util::realToString(viewport->pen.widthF());
 
-    app_->resize(w, h);
-  }
-  else if (name == "font.size") {
-    double s = Util::stringToReal(value);
+        return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        auto *viewport = canvas->currentViewport();
 
-    auto font = this->font();
+        viewport->pen.setWidthF(Util::stringToReal(value));
 
-    double scale = 1;
+        return true;
+      } },
+    { "range",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        auto *tcl = canvas->app()->tcl();
 
-    for (int i = 0; i < 8; ++i) {
-      font.setPointSizeF(scale*s);
+        auto *viewport = canvas->currentViewport();
 
-      QFontMetricsF fm(font);
+        value = rangeToString(tcl, viewport->displayRange);
 
-      double s1 = fm.height();
+        return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        auto *tcl = canvas->app()->tcl();
 
-      scale *= s/s1;
-    }
+        auto *viewport = canvas->currentViewport();
 
-    setFont(font);
-  }
-  else if (name == "controls.show") {
-    auto b = Util::stringToBool(value);
+        stringToRange(tcl, viewport->displayRange, value);
+
+        viewport->hasRange = true;
+
+        canvas->invalidateObjects();
+
+        return true;
+      } },
+    { "range.xmin",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        auto *viewport = canvas->currentViewport();
+
+        double x1, y1, x2, y2;
+        viewport->displayRange.getWindowRange(&x1, &y1, &x2, &y2);
+
+        value = x1;
+
+        return true;
+      }, nullptr },
+    { "range.ymin",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        auto *viewport = canvas->currentViewport();
+
+        double x1, y1, x2, y2;
+        viewport->displayRange.getWindowRange(&x1, &y1, &x2, &y2);
+
+        value = y1;
+
+        return true;
+      }, nullptr },
+    { "range.xmax",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        auto *viewport = canvas->currentViewport();
+
+        double x1, y1, x2, y2;
+        viewport->displayRange.getWindowRange(&x1, &y1, &x2, &y2);
+
+        value = x2;
+
+        return true;
+      }, nullptr },
+    { "range.ymax",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        auto *viewport = canvas->currentViewport();
+
+        double x1, y1, x2, y2;
+        viewport->displayRange.getWindowRange(&x1, &y1, &x2, &y2);
+
+        value = y2;
+
+        return true;
+      }, nullptr },
+    { "equal_scale",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        auto *viewport = canvas->currentViewport();
+
+        value = Util::boolToString(viewport->displayRange.getEqualScale());
+
+        return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        auto *viewport = canvas->currentViewport();
+
+        viewport->displayRange.setEqualScale(Util::stringToBool(value));
+
+        viewport->hasRange = true;
+
+        canvas->invalidateObjects();
+
+        return true;
+      } },
+    { "view", nullptr,
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        canvas->currentViewportName_ = value; return true;
+      } },
+    { "view.rect", nullptr,
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        auto *tcl = canvas->app()->tcl();
+
+        auto *viewport = canvas->currentViewport();
+
+        viewport->rect = stringToRect(tcl, value);
+
+        canvas->updatePixelRanges();
+
+        return true;
+      } },
+    { "particles",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        QStringList ids;
+
+        const auto &particles = canvas->psys_->getParticles();
+
+        for (uint i = 0; i < particles.size(); ++i) {
+          auto *particle = particles.get(int(i));
+
+          auto *particle1 = dynamic_cast<Particle *>(particle);
+
+          ids.push_back(particle1->obj()->getCommandName());
+        }
+
+        value = ids;
+
+        return true;
+      }, nullptr },
+    { "gravity", nullptr,
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        canvas->psys_->setGravity(Util::stringToReal(value)); return true;
+      } },
+    { "attraction.all",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        auto *psys = canvas->psys_;
+
+        value = QString("%1 %2").arg(psys->allAttraction()).arg(psys->allAttractionMinDistance());
+
+        return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        auto *tcl = canvas->app()->tcl();
+
+        QStringList strs;
+        (void) tcl->splitList(value, strs);
+
+        auto k           = (strs.length() > 0 ? Util::stringToReal(strs[0]) : 0.0);
+        auto minDistance = (strs.length() > 1 ? Util::stringToReal(strs[1]) : 0.0);
+
+        canvas->psys_->setAllAttraction(k, minDistance);
+
+        return true;
+      } },
+    { "barnes_hut",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = Util::boolToString(canvas->psys_->isBarnesHut()); return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        canvas->psys_->setBarnesHut(Util::stringToBool(value)); return true;
+      } },
+    { "barnes_hut.theta",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = canvas->psys_->theta(); return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        canvas->psys_->setTheta(Util::stringToReal(value)); return true;
+      } },
+    { "barnes_hut.error",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = canvas->psys_->attractionError(); return true;
+      }, nullptr },
+    { "particle.threads",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = int(canvas->psys_->numThreads()); return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        canvas->psys_->setNumThreads(size_t(std::max(Util::stringToInt(value), 0))); return true;
+      } },
+    { "ticks",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = Util::intToString(canvas->ticks_); return true;
+      }, nullptr },
+    { "key",
+      [](Canvas *canvas, const QStringList &args, QVariant &value) {
+        if (args.size() < 1)
+          return canvas->app()->errorMsg("Invalid value name 'key'");
+
+        value = canvas->getKeyPressed(args[0]);
+
+        return true;
+      }, nullptr },
+    { "play",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = canvas->running_; return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        if (Util::stringToBool(value))
+          canvas->play();
+        else
+          canvas->pause();
+
+        return true;
+      } },
+    { "buffered",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = canvas->buffered_; return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        canvas->buffered_ = Util::stringToBool(value);
+
+        canvas->resizeEvent(nullptr);
+
+        return true;
+      } },
+    { "retained",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = canvas->retained_; return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        canvas->setRetained(Util::stringToBool(value)); return true;
+      } },
+    { "blend.enabled", nullptr,
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        canvas->blend_ = Util::stringToBool(value);
+
+        canvas->resizeEvent(nullptr);
+
+        return true;
+      } },
+    { "blend.factor", nullptr,
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        canvas->blendFactor_ = Util::stringToReal(value); return true;
+      } },
+    { "blend.threads",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = int(canvas->compositor_->numThreads()); return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        canvas->compositor_->setNumThreads(std::max(Util::stringToInt(value), 0)); return true;
+      } },
+    { "blend.simd",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = canvas->compositor_->isSimd(); return true;
+      },
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        canvas->compositor_->setSimd(Util::stringToBool(value)); return true;
+      } },
+    { "blend.time",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = canvas->compositor_->lastTime(); return true;
+      }, nullptr },
+    { "pixel_width",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = canvas->pixelWidth_; return true;
+      }, nullptr },
+    { "pixel_height",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = canvas->pixelHeight_; return true;
+      }, nullptr },
+    { "window.size", nullptr,
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        auto *app = canvas->app();
+
+        auto size = stringToPoint(app->tcl(), value);
+
+        int w = size.x.value;
+        int h = size.y.value;
+
+        h += app->toolbar2D()->height();
+
+        app->resize(w, h);
+
+        return true;
+      } },
+    { "font.height",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        QFontMetrics fm(canvas->font());
+
+        value = fm.height();
+
+        return true;
+      }, nullptr },
+    { "font.size", nullptr,
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        double s = Util::stringToReal(value);
+
+        auto font = canvas->font();
+
+        double scale = 1;
+
+        for (int i = 0; i < 8; ++i) {
+          font.setPointSizeF(scale*s);
+
+          QFontMetricsF fm(font);
+
+          double s1 = fm.height();
+
+          scale *= s/s1;
+        }
+
+        canvas->setFont(font);
+
+        return true;
+      } },
+    { "controls.show", nullptr,
+      [](Canvas *canvas, const QString &value, const QStringList &) {
+        auto b = Util::stringToBool(value);
+
+        canvas->app()->toolbar2D()->showControls(b);
+
+        return true;
+      } },
+    { "redraw.objects",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = int(canvas->redrawObjects_); return true;
+      }, nullptr },
+    { "redraw.cached",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = int(canvas->redrawCached_); return true;
+      }, nullptr },
+    { "redraw.full",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = canvas->redrawFull_; return true;
+      }, nullptr },
+    { "stats.script_time",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = canvas->stepScriptTime_ + canvas->drawScriptTime_; return true;
+      }, nullptr },
+    { "stats.native_time",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = (canvas->stepTime_ - canvas->stepScriptTime_) +
+                (canvas->drawTime_ - canvas->drawScriptTime_);
+
+        return true;
+      }, nullptr },
+    { "objects.at_point",
+      [](Canvas *canvas, const QStringList &args, QVariant &value) {
+        auto *tcl = canvas->app()->tcl();
+
+        if (args.size() < 1)
+          return canvas->app()->errorMsg(QString("Missing args for 'objects.at_point'"));
 
-    app_->toolbar2D()->showControls(b);
+        Objects objs;
+
+        auto p = canvas->pointToPixel(stringToPoint(tcl, args[0]));
+
+        canvas->getObjectsAtPos(p.qpoint(), objs);
+
+        QStringList names;
+
+        for (auto *obj : objs)
+          names.push_back(obj->getCommandName());
+
+        value = names;
+
+        return true;
+      }, nullptr },
+    { "objects.in_rect",
+      [](Canvas *canvas, const QStringList &args, QVariant &value) {
+        auto *tcl = canvas->app()->tcl();
+
+        if (args.size() < 1)
+          return canvas->app()->errorMsg(QString("Missing args for 'objects.in_rect'"));
+
+        Objects objs;
+
+        auto r = canvas->rectToPixel(stringToRect(tcl, args[0]));
+
+        canvas->getObjectsInRect(r.qrect(), objs);
+
+        QStringList names;
+
+        for (auto *obj : objs)
+          names.push_back(obj->getCommandName());
+
+        value = names;
+
+        return true;
+      }, nullptr },
+    { "objects.count",
+      [](Canvas *canvas, const QStringList &, QVariant &value) {
+        value = int(canvas->objectIndex_->numObjects()); return true;
+      }, nullptr },
+  });
+
+  return table;
+}
+
+QVariant
+Canvas::
+getValue(const QString &name, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
   }
-  else
-    return app_->errorMsg(QString("Invalid value name '%1'").arg(name));
 
-  return true;
+  app_->errorMsg(QString("Invalid value name '%1'").arg(name));
+  return QVariant();
+}
+
+bool
+Canvas::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return app_->errorMsg(QString("Invalid value name '%1'").arg(name));
 }
 
 bool
 Canvas::
-exec(const QString &op, const QStringList &, QVariant &)
+exec(const QString &op, const QStringList &args, QVariant &res)
 {
   if      (op == "update") {
-    this->update();
+    requestRedraw();
   }
   else if (op == "step") {
     stepTimer_->start(10);
@@ -1555,7 +2234,31 @@ exec(const QString &op, const QStringList &, QVariant &)
     if (buffered_)
       drawBufferedNeeded_ = true;
     else
-      this->update();
+      requestRedraw();
+  }
+  else if (op == "benchmark.fade") {
+    // args: width height [count]
+    if (args.size() < 2)
+      return app_->errorMsg("Missing size for benchmark.fade");
+
+    auto w = Util::stringToInt(args[0]);
+    auto h = Util::stringToInt(args[1]);
+    auto n = (args.size() > 2 ? Util::stringToInt(args[2]) : 10);
+
+    if (w <= 0 || h <= 0)
+      return app_->errorMsg("Invalid size for benchmark.fade");
+
+    res = compositor_->benchmark(w, h, n);
+  }
+  else if (op == "benchmark.springs") {
+    // args: [numSprings] [numTicks]
+    auto numSprings = (args.size() > 0 ? Util::stringToInt(args[0]) : 100000);
+    auto numTicks   = (args.size() > 1 ? Util::stringToInt(args[1]) : 10);
+
+    if (numSprings <= 0 || numTicks <= 0)
+      return app_->errorMsg("Invalid count for benchmark.springs");
+
+    res = springMeshBenchmark(numSprings, numTicks);
   }
   else
     return false;
@@ -1678,7 +2381,7 @@ drawPointProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv)
 
 int
 Canvas::
-objectCommandProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv)
+objectCommandProc(void *clientData, Tcl_Interp *interp, int objc, const Tcl_Obj **objv)
 {
   auto *obj = static_cast<Object *>(clientData);
   assert(obj);
@@ -1688,38 +2391,68 @@ objectCommandProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv
 
   auto *tcl = app->tcl();
 
-  auto args = app->getArgs(objc, objv);
+  // bulk data values are converted directly from/to Tcl objects
+  if (objc > 1) {
+    std::string op = Tcl_GetString(const_cast<Tcl_Obj *>(objv[1]));
 
-  if      (args[0] == "get") {
-    if (args.size() > 1) {
-      auto name = args[1];
+    if      (op == "get_data") {
+      App::DataArgs dataArgs;
+      if (! app->getDataArgs(interp, objc, objv, /*hasValues*/false, dataArgs))
+        return TCL_ERROR;
 
-      QStringList args1;
-      for (int i = 2; i < args.length(); ++i)
-        args1.push_back(args[i]);
+      std::vector<float> values;
+      if (! obj->getData(dataArgs.name, dataArgs.start, dataArgs.stride, values))
+        return TCL_ERROR;
+
+      app->setDataResult(interp, values, dataArgs.binary);
+
+      return TCL_OK;
+    }
+    else if (op == "set_data") {
+      App::DataArgs dataArgs;
+      if (! app->getDataArgs(interp, objc, objv, /*hasValues*/true, dataArgs))
+        return TCL_ERROR;
+
+      if (! obj->setData(dataArgs.name, dataArgs.values, dataArgs.start, dataArgs.stride))
+        return TCL_ERROR;
+
+      canvas->objectChanged(obj);
+
+      return TCL_OK;
+    }
+    // property name is not converted to a string (interned property id is cached in
+    // Tcl object) and only the args after it are converted
+    else if (op == "get" && objc > 2) {
+      auto name  = app->getPropertyName(objv[2]);
+      auto args1 = app->getArgs(objc - 2, objv + 2);
 
       auto res = obj->getValue(name, args1);
 
       tcl->setResult(res);
+
+      return TCL_OK;
     }
-    else {
-      app->errorMsg("Missing args for get");
+    else if (op == "set" && objc > 3) {
+      auto name  = app->getPropertyName(objv[2]);
+      auto args1 = app->getArgs(objc - 2, objv + 2);
+      auto value = args1.takeFirst();
+
+      obj->setValue(name, value, args1);
+
+      canvas->objectChanged(obj);
+
+      return TCL_OK;
     }
   }
-  else if (args[0] == "set") {
-    if (args.size() > 2) {
-      auto name  = args[1];
-      auto value = args[2];
 
-      QStringList args1;
-      for (int i = 3; i < args.length(); ++i)
-        args1.push_back(args[i]);
+  auto args = app->getArgs(objc, objv);
 
-      obj->setValue(args[1], args[2], args1);
-    }
-    else {
-      app->errorMsg("Missing args for set");
-    }
+  // get/set with name (and value) handled above
+  if      (args[0] == "get") {
+    app->errorMsg("Missing args for get");
+  }
+  else if (args[0] == "set") {
+    app->errorMsg("Missing args for set");
   }
   else if (args[0] == "exec") {
     if (args.size() > 1) {
@@ -1734,6 +2467,8 @@ objectCommandProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv
       if (! obj->exec(op, args1, res))
         return TCL_ERROR;
 
+      canvas->objectChanged(obj);
+
       tcl->setResult(res);
     }
     else {
@@ -1741,9 +2476,7 @@ objectCommandProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv
     }
   }
   else if (args[0] == "delete") {
-    canvas->removeObject(obj);
-
-    delete obj;
+    canvas->deleteObject(obj);
   }
   else {
     app->errorMsg(QString("Bad object command '%1'").arg(args[0]));
@@ -1792,12 +2525,16 @@ viewportCommandProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **ob
         stringToRange(tcl, viewport->displayRange, value);
 
         viewport->hasRange = true;
+
+        canvas->invalidateObjects();
       }
       else if (name == "clip") {
         viewport->clip = stringToRect(tcl, value);
       }
       else
         app->errorMsg("Invalid set name '" + name + "' for viewport");
+
+      canvas->fullRedraw_ = true;
     }
     else {
       app->errorMsg("Missing args for viewport set");
@@ -1931,34 +2668,82 @@ GroupObj(Canvas *canvas, const Rect &rect) :
 {
 }
 
-QVariant
+const PropertyTable<Object> &
 GroupObj::
-getValue(const QString &name, const QStringList &args)
+properties()
 {
-  auto *tcl = canvas()->app()->tcl();
+  using Table = PropertyTable<Object>;
 
-  if      (name == "rect")
-    return rectToString(calcRect());
-  else if (name == "range")
-    return rangeToString(tcl, displayRange_);
-  else
-    return Object::getValue(name, args);
-}
+  static Table table({
+    { "rect",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *group = static_cast<GroupObj *>(obj);
 
-bool
-GroupObj::
-setValue(const QString &name, const QString &value, const QStringList &args)
-{
-  auto *tcl = canvas()->app()->tcl();
+        value = rectToString(group->calcRect());
 
-  if      (name == "rect")
-    rect_ = stringToRect(tcl, value);
-  else if (name == "range")
-    stringToRange(tcl, displayRange_, value);
-  else
-    return Object::setValue(name, value, args);
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *group = static_cast<GroupObj *>(obj);
 
-  return true;
+        auto *tcl = group->canvas()->app()->tcl();
+
+        group->rect_ = stringToRect(tcl, value);
+
+        return true;
+      } },
+    { "range",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *group = static_cast<GroupObj *>(obj);
+
+        auto *tcl = group->canvas()->app()->tcl();
+
+        value = rangeToString(tcl, group->displayRange_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *group = static_cast<GroupObj *>(obj);
+
+        auto *tcl = group->canvas()->app()->tcl();
+
+        stringToRange(tcl, group->displayRange_, value);
+
+        return true;
+      } },
+  }, &Object::properties());
+
+  return table;
+}
+
+QVariant
+GroupObj::
+getValue(const QString &name, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  return Object::getValue(name, args);
+}
+
+bool
+GroupObj::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object::setValue(name, value, args);
 }
 
 Rect
@@ -1981,7 +2766,7 @@ draw(QPainter *painter)
   painter->drawRect(prect);
 
   painter->save();
-  painter->setClipRect(prect);
+  painter->setClipRect(prect, Qt::IntersectClip);
 
   auto qrect = rect.qrect();
 
@@ -2077,61 +2862,114 @@ RendererObj(Canvas *canvas) :
   font_ = canvas->font();
 }
 
-QVariant
+const PropertyTable<Object> &
 RendererObj::
-getValue(const QString &name, const QStringList &args)
+properties()
 {
-  //auto *tcl = canvas()->app()->tcl();
+  using Table = PropertyTable<Object>;
 
-  if      (name == "brush.color") {
-    return Util::colorToString(brush_.color());
-  }
-  else if (name == "pen.color") {
-    return Util::colorToString(pen_.color());
-  }
-  else if (name == "font.height") {
-    QFontMetrics fm(font_);
+  static Table table({
+    { "brush.color",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *renderer = static_cast<RendererObj *>(obj);
 
-    return fm.height();
-  }
-  else
-    return Object::getValue(name, args);
-}
+        value = Util::colorToString(renderer->brush_.color());
 
-bool
-RendererObj::
-setValue(const QString &name, const QString &value, const QStringList &args)
-{
-  auto *app = canvas()->app();
-  auto *tcl = app->tcl();
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *renderer = static_cast<RendererObj *>(obj);
 
-  if      (name == "brush.color")
-    brush_.setColor(Util::stringToColor(tcl, value));
-  else if (name == "pen.color")
-    pen_.setColor(Util::stringToColor(tcl, value));
-  else if (name == "font.size") {
-    double s = Util::stringToReal(value);
+        auto *tcl = renderer->canvas()->app()->tcl();
 
-    auto font = font_;
+        renderer->brush_.setColor(Util::stringToColor(tcl, value));
 
-    double scale = 1;
+        return true;
+      } },
+    { "pen.color",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *renderer = static_cast<RendererObj *>(obj);
 
-    for (int i = 0; i < 8; ++i) {
-      font.setPointSizeF(scale*s);
+        value = Util::colorToString(renderer->pen_.color());
 
-      QFontMetricsF fm(font);
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *renderer = static_cast<RendererObj *>(obj);
 
-      double s1 = fm.height();
+        auto *tcl = renderer->canvas()->app()->tcl();
 
-      scale *= s/s1;
-    }
+        renderer->pen_.setColor(Util::stringToColor(tcl, value));
+
+        return true;
+      } },
+    { "font.height",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *renderer = static_cast<RendererObj *>(obj);
+
+        QFontMetrics fm(renderer->font_);
+
+        value = fm.height();
+
+        return true;
+      }, nullptr },
+    { "font.size", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *renderer = static_cast<RendererObj *>(obj);
+
+        double s = Util::stringToReal(value);
+
+        auto font = renderer->font_;
+
+        double scale = 1;
+
+        for (int i = 0; i < 8; ++i) {
+          font.setPointSizeF(scale*s);
+
+          QFontMetricsF fm(font);
+
+          double s1 = fm.height();
+
+          scale *= s/s1;
+        }
+
+        renderer->font_ = font;
+
+        return true;
+      } },
+  }, &Object::properties());
+
+  return table;
+}
+
+QVariant
+RendererObj::
+getValue(const QString &name, const QStringList &args)
+{
+  auto *property = properties().find(name);
 
-    font_ = font;
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
   }
-  else
-    return Object::setValue(name, value, args);
 
-  return true;
+  return Object::getValue(name, args);
+}
+
+bool
+RendererObj::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object::setValue(name, value, args);
 }
 
 bool
@@ -2313,29 +3151,63 @@ CirclesGroupObj(Canvas *canvas, const Rect &rect) :
   mgr_->place();
 }
 
+const PropertyTable<Object> &
+CirclesGroupObj::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "n",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *group = static_cast<CirclesGroupObj *>(obj);
+
+        value = group->mgr_->factor();
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *group = static_cast<CirclesGroupObj *>(obj);
+
+        group->mgr_->setFactor(Util::stringToInt(value));
+
+        group->mgr_->place();
+
+        return true;
+      } },
+  }, &GroupObj::properties());
+
+  return table;
+}
+
 QVariant
 CirclesGroupObj::
 getValue(const QString &name, const QStringList &args)
 {
-  if (name == "n")
-    return mgr_->factor();
-  else
-    return GroupObj::getValue(name, args);
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  return GroupObj::getValue(name, args);
 }
 
 bool
 CirclesGroupObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  if (name == "n") {
-    mgr_->setFactor(Util::stringToInt(value));
+  auto *property = properties().find(name);
 
-    mgr_->place();
-  }
-  else
-    return GroupObj::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return GroupObj::setValue(name, value, args);
 }
 
 #if 0
@@ -2379,79 +3251,136 @@ QuadTreeObj(Canvas *canvas) :
 {
 }
 
-QVariant
+const PropertyTable<Object> &
 QuadTreeObj::
-getValue(const QString &name, const QStringList &args)
+properties()
 {
-  auto *tcl = canvas()->app()->tcl();
+  using Table = PropertyTable<Object>;
 
-  if      (name == "object.in_rect") {
-    if (args.size() < 1)
-      return false;
+  static Table table({
+    { "object.in_rect",
+      [](Object *obj, const QStringList &args, QVariant &value) {
+        auto *quadTree = static_cast<QuadTreeObj *>(obj);
 
-    auto rect = stringToRect(tcl, args[0]);
+        auto *tcl = quadTree->canvas()->app()->tcl();
 
-    QuadTree::DataList dataList;
-    quadTree_.getDataInsideBBox(rect, dataList);
+        if (args.size() < 1) {
+          value = false;
+          return true;
+        }
 
-    QStringList names;
+        auto rect = stringToRect(tcl, args[0]);
 
-    for (auto *obj : dataList)
-      names.push_back(obj->getCommandName());
+        QuadTree::DataList dataList;
+        quadTree->quadTree_.getDataInsideBBox(rect, dataList);
 
-    return names;
-  }
-  else if (name == "object.at_point") {
-    if (args.size() < 1)
-      return false;
+        QStringList names;
 
-    auto p = stringToPoint(tcl, args[0]);
+        for (auto *obj1 : dataList)
+          names.push_back(obj1->getCommandName());
 
-    QuadTree::DataList dataList;
-    quadTree_.getDataAtPoint(p.x.value, p.y.value, dataList);
+        value = names;
 
-    QStringList names;
+        return true;
+      }, nullptr },
+    { "object.at_point",
+      [](Object *obj, const QStringList &args, QVariant &value) {
+        auto *quadTree = static_cast<QuadTreeObj *>(obj);
 
-    for (auto *obj : dataList)
-      names.push_back(obj->getCommandName());
+        auto *tcl = quadTree->canvas()->app()->tcl();
 
-    return names;
-  }
-  else
-    return GroupObj::getValue(name, args);
+        if (args.size() < 1) {
+          value = false;
+          return true;
+        }
+
+        auto p = stringToPoint(tcl, args[0]);
+
+        QuadTree::DataList dataList;
+        quadTree->quadTree_.getDataAtPoint(p.x.value, p.y.value, dataList);
+
+        QStringList names;
+
+        for (auto *obj1 : dataList)
+          names.push_back(obj1->getCommandName());
+
+        value = names;
+
+        return true;
+      }, nullptr },
+    { "reset", nullptr,
+      [](Object *obj, const QString &, const QStringList &) {
+        auto *quadTree = static_cast<QuadTreeObj *>(obj);
+
+        quadTree->quadTree_.reset();
+
+        return true;
+      } },
+    { "object.add", nullptr,
+      [](Object *obj, const QString &value, const QStringList &args) {
+        auto *quadTree = static_cast<QuadTreeObj *>(obj);
+
+        auto *app = quadTree->canvas()->app();
+
+        if (args.size() != 0)
+          return app->errorMsg("Invalid number of args");
+
+        auto *obj1 = quadTree->canvas()->getObjectByName(value);
+        if (! obj1) return app->errorMsg(QString("Failed to find object '%1'").arg(value));
+
+        quadTree->quadTree_.add(obj1);
+
+        return true;
+      } },
+    { "object.remove", nullptr,
+      [](Object *obj, const QString &value, const QStringList &args) {
+        auto *quadTree = static_cast<QuadTreeObj *>(obj);
+
+        auto *app = quadTree->canvas()->app();
+
+        if (args.size() != 0)
+          return app->errorMsg("Invalid number of args");
+
+        auto *obj1 = quadTree->canvas()->getObjectByName(value);
+        if (! obj1) return app->errorMsg(QString("Failed to find object '%1'").arg(value));
+
+        quadTree->quadTree_.remove(obj1);
+
+        return true;
+      } },
+  }, &GroupObj::properties());
+
+  return table;
 }
 
-bool
+QVariant
 QuadTreeObj::
-setValue(const QString &name, const QString &value, const QStringList &args)
+getValue(const QString &name, const QStringList &args)
 {
-  auto *app = canvas()->app();
+  auto *property = properties().find(name);
 
-  if      (name == "reset") {
-    quadTree_.reset();
-  }
-  else if (name == "object.add") {
-    if (args.size() != 0)
-      return app->errorMsg("Invalid number of args");
+  if (property && property->get) {
+    QVariant value;
 
-    auto *obj = canvas()->getObjectByName(value);
-    if (! obj) return app->errorMsg(QString("Failed to find object '%1'").arg(value));
+    if (! property->get(this, args, value))
+      return QVariant();
 
-    quadTree_.add(obj);
+    return value;
   }
-  else if (name == "object.remove") {
-    if (args.size() != 0)
-      return app->errorMsg("Invalid number of args");
 
-    auto *obj = canvas()->getObjectByName(value);
-    if (! obj) return app->errorMsg(QString("Failed to find object '%1'").arg(value));
+  return GroupObj::getValue(name, args);
+}
 
-    quadTree_.remove(obj);
-  }
-  else
-    return GroupObj::setValue(name, value, args);
+bool
+QuadTreeObj::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
 
-  return true;
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return GroupObj::setValue(name, value, args);
 }
 
 //---
@@ -2482,56 +3411,148 @@ CircleObj(Canvas *canvas, const Point &center, const Coord &radius) :
 {
 }
 
+const PropertyTable<Object> &
+CircleObj::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "rect",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *circle = static_cast<CircleObj *>(obj);
+
+        value = rectToString(circle->calcRect());
+
+        return true;
+      }, nullptr },
+    { "center",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *circle = static_cast<CircleObj *>(obj);
+
+        value = pointToString(circle->center_.value());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *circle = static_cast<CircleObj *>(obj);
+
+        auto *tcl = circle->canvas()->app()->tcl();
+
+        circle->center_.setValue(stringToPoint(tcl, value));
+
+        return true;
+      } },
+    { "center.target",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *circle = static_cast<CircleObj *>(obj);
+
+        value = pointToString(circle->center_.target());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *circle = static_cast<CircleObj *>(obj);
+
+        auto *tcl = circle->canvas()->app()->tcl();
+
+        circle->center_.setTarget(stringToPoint(tcl, value));
+
+        return true;
+      } },
+    { "center.steps",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *circle = static_cast<CircleObj *>(obj);
+
+        value = int(circle->center_.steps());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *circle = static_cast<CircleObj *>(obj);
+
+        circle->center_.setSteps(Util::stringToInt(value));
+
+        return true;
+      } },
+    { "radius",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *circle = static_cast<CircleObj *>(obj);
+
+        value = coordToString(circle->radius_.value());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *circle = static_cast<CircleObj *>(obj);
+
+        circle->radius_.setValue(stringToCoord(value));
+
+        return true;
+      } },
+    { "radius.target",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *circle = static_cast<CircleObj *>(obj);
+
+        value = coordToString(circle->radius_.target());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *circle = static_cast<CircleObj *>(obj);
+
+        circle->radius_.setTarget(stringToCoord(value));
+
+        return true;
+      } },
+    { "radius.steps",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *circle = static_cast<CircleObj *>(obj);
+
+        value = int(circle->radius_.steps());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *circle = static_cast<CircleObj *>(obj);
+
+        circle->radius_.setSteps(Util::stringToInt(value));
+
+        return true;
+      } },
+  }, &Object::properties());
+
+  return table;
+}
+
 QVariant
 CircleObj::
 getValue(const QString &name, const QStringList &args)
 {
-  if      (name == "rect")
-    return rectToString(calcRect());
-  else if (name == "center")
-    return pointToString(center_.value());
-  else if (name == "center.target")
-    return pointToString(center_.target());
-  else if (name == "center.steps")
-    return int(center_.steps());
-  else if (name == "radius")
-    return coordToString(radius_.value());
-  else if (name == "radius.target")
-    return coordToString(radius_.target());
-  else if (name == "radius.steps")
-    return int(radius_.steps());
-  else
-    return Object::getValue(name, args);
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  return Object::getValue(name, args);
 }
 
 bool
 CircleObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  auto *tcl = canvas()->app()->tcl();
+  auto *property = properties().find(name);
 
-  if      (name == "center") {
-    center_.setValue(stringToPoint(tcl, value));
-  }
-  else if (name == "center.target") {
-    center_.setTarget(stringToPoint(tcl, value));
-  }
-  else if (name == "center.steps") {
-    center_.setSteps(Util::stringToInt(value));
-  }
-  else if (name == "radius") {
-    radius_.setValue(stringToCoord(value));
-  }
-  else if (name == "radius.target") {
-    radius_.setTarget(stringToCoord(value));
-  }
-  else if (name == "radius.steps") {
-    radius_.setSteps(Util::stringToInt(value));
-  }
-  else
-    return Object::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object::setValue(name, value, args);
 }
 
 Rect
@@ -2611,29 +3632,63 @@ RectObj(Canvas *canvas, const Rect &rect) :
 {
 }
 
+const PropertyTable<Object> &
+RectObj::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "rect",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *rect = static_cast<RectObj *>(obj);
+
+        value = rectToString(rect->calcRect());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *rect = static_cast<RectObj *>(obj);
+
+        auto *tcl = rect->canvas()->app()->tcl();
+
+        rect->rect_ = stringToRect(tcl, value);
+
+        return true;
+      } },
+  }, &Object::properties());
+
+  return table;
+}
+
 QVariant
 RectObj::
 getValue(const QString &name, const QStringList &args)
 {
-  if (name == "rect")
-    return rectToString(calcRect());
-  else
-    return Object::getValue(name, args);
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  return Object::getValue(name, args);
 }
 
 bool
 RectObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  auto *tcl = canvas()->app()->tcl();
+  auto *property = properties().find(name);
 
-  if (name == "rect") {
-    rect_ = stringToRect(tcl, value);
-  }
-  else
-    return Object::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object::setValue(name, value, args);
 }
 
 Rect
@@ -2684,32 +3739,80 @@ LineObj(Canvas *canvas, const Point &p1, const Point &p2) :
 {
 }
 
+const PropertyTable<Object> &
+LineObj::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "p1",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *line = static_cast<LineObj *>(obj);
+
+        value = pointToString(line->p1_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *line = static_cast<LineObj *>(obj);
+
+        auto *tcl = line->canvas()->app()->tcl();
+
+        line->p1_ = stringToPoint(tcl, value);
+
+        return true;
+      } },
+    { "p2",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *line = static_cast<LineObj *>(obj);
+
+        value = pointToString(line->p2_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *line = static_cast<LineObj *>(obj);
+
+        auto *tcl = line->canvas()->app()->tcl();
+
+        line->p2_ = stringToPoint(tcl, value);
+
+        return true;
+      } },
+  }, &Object::properties());
+
+  return table;
+}
+
 QVariant
 LineObj::
 getValue(const QString &name, const QStringList &args)
 {
-  if      (name == "p1")
-    return pointToString(p1_);
-  else if (name == "p2")
-    return pointToString(p2_);
-  else
-    return Object::getValue(name, args);
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  return Object::getValue(name, args);
 }
 
 bool
 LineObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  auto *tcl = canvas()->app()->tcl();
+  auto *property = properties().find(name);
 
-  if      (name == "p1")
-    p1_ = stringToPoint(tcl, value);
-  else if (name == "p2")
-    p2_ = stringToPoint(tcl, value);
-  else
-    return Object::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object::setValue(name, value, args);
 }
 
 Rect
@@ -2743,32 +3846,77 @@ EditObj(Canvas *canvas, const QString &name) :
 {
 }
 
-QVariant
+const PropertyTable<Object> &
 EditObj::
-getValue(const QString &name, const QStringList &args)
+properties()
 {
-  if      (name == "name")
-    return name_;
-  else if (name == "proc")
-    return proc_;
-  else
-    return Object::getValue(name, args);
-}
+  using Table = PropertyTable<Object>;
 
-bool
-EditObj::
-setValue(const QString &name, const QString &value, const QStringList &args)
-{
-  if      (name == "name")
-    name_ = value;
-  else if (name == "proc") {
-    proc_ = value;
-  }
-  else
-    return Object::setValue(name, value, args);
+  static Table table({
+    { "name",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *edit = static_cast<EditObj *>(obj);
 
-  return true;
-}
+        value = edit->name_;
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *edit = static_cast<EditObj *>(obj);
+
+        edit->name_ = value;
+
+        return true;
+      } },
+    { "proc",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *edit = static_cast<EditObj *>(obj);
+
+        value = edit->proc_;
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *edit = static_cast<EditObj *>(obj);
+
+        edit->proc_ = value;
+
+        return true;
+      } },
+  }, &Object::properties());
+
+  return table;
+}
+
+QVariant
+EditObj::
+getValue(const QString &name, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  return Object::getValue(name, args);
+}
+
+bool
+EditObj::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object::setValue(name, value, args);
+}
 
 //---
 
@@ -2797,39 +3945,93 @@ RealEdit(Canvas *canvas, const Point &p, const QString &name) :
 {
 }
 
+const PropertyTable<Object> &
+RealEdit::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "position",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *edit = static_cast<RealEdit *>(obj);
+
+        value = pointToString(edit->p_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *edit = static_cast<RealEdit *>(obj);
+
+        auto *tcl = edit->canvas()->app()->tcl();
+
+        edit->p_ = stringToPoint(tcl, value);
+
+        return true;
+      } },
+    { "min_value",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *edit = static_cast<RealEdit *>(obj);
+
+        value = edit->minValue_;
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *edit = static_cast<RealEdit *>(obj);
+
+        edit->minValue_ = Util::stringToReal(value);
+
+        return true;
+      } },
+    { "max_value",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *edit = static_cast<RealEdit *>(obj);
+
+        value = edit->maxValue_;
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *edit = static_cast<RealEdit *>(obj);
+
+        edit->maxValue_ = Util::stringToReal(value);
+
+        return true;
+      } },
+  }, &EditObj::properties());
+
+  return table;
+}
+
 QVariant
 RealEdit::
 getValue(const QString &name, const QStringList &args)
 {
-  if      (name == "position")
-    return pointToString(p_);
-  else if (name == "min_value")
-    return minValue_;
-  else if (name == "max_value")
-    return maxValue_;
-  else
-    return EditObj::getValue(name, args);
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  return EditObj::getValue(name, args);
 }
 
 bool
 RealEdit::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  if      (name == "position") {
-    auto *tcl = canvas()->app()->tcl();
+  auto *property = properties().find(name);
 
-    p_ = stringToPoint(tcl, value);
-  }
-  else if (name == "min_value") {
-    minValue_ = Util::stringToReal(value);
-  }
-  else if (name == "max_value") {
-    maxValue_ = Util::stringToReal(value);
-  }
-  else
-    return EditObj::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return EditObj::setValue(name, value, args);
 }
 
 Rect
@@ -2924,39 +4126,93 @@ IntegerEdit(Canvas *canvas, const Point &p, const QString &name) :
 {
 }
 
+const PropertyTable<Object> &
+IntegerEdit::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "position",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *edit = static_cast<IntegerEdit *>(obj);
+
+        value = pointToString(edit->p_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *edit = static_cast<IntegerEdit *>(obj);
+
+        auto *tcl = edit->canvas()->app()->tcl();
+
+        edit->p_ = stringToPoint(tcl, value);
+
+        return true;
+      } },
+    { "min_value",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *edit = static_cast<IntegerEdit *>(obj);
+
+        value = edit->minValue_;
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *edit = static_cast<IntegerEdit *>(obj);
+
+        edit->minValue_ = Util::stringToInt(value);
+
+        return true;
+      } },
+    { "max_value",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *edit = static_cast<IntegerEdit *>(obj);
+
+        value = edit->maxValue_;
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *edit = static_cast<IntegerEdit *>(obj);
+
+        edit->maxValue_ = Util::stringToInt(value);
+
+        return true;
+      } },
+  }, &EditObj::properties());
+
+  return table;
+}
+
 QVariant
 IntegerEdit::
 getValue(const QString &name, const QStringList &args)
 {
-  if      (name == "position")
-    return pointToString(p_);
-  else if (name == "min_value")
-    return minValue_;
-  else if (name == "max_value")
-    return maxValue_;
-  else
-    return EditObj::getValue(name, args);
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  return EditObj::getValue(name, args);
 }
 
 bool
 IntegerEdit::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  if      (name == "position") {
-    auto *tcl = canvas()->app()->tcl();
+  auto *property = properties().find(name);
 
-    p_ = stringToPoint(tcl, value);
-  }
-  else if (name == "min_value") {
-    minValue_ = Util::stringToInt(value);
-  }
-  else if (name == "max_value") {
-    maxValue_ = Util::stringToInt(value);
-  }
-  else
-    return EditObj::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return EditObj::setValue(name, value, args);
 }
 
 Rect
@@ -3110,37 +4366,93 @@ ButtonObj(Canvas *canvas, const Point &p, const QString &name) :
 {
 }
 
+const PropertyTable<Object> &
+ButtonObj::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "position",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *button = static_cast<ButtonObj *>(obj);
+
+        value = pointToString(button->p_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *button = static_cast<ButtonObj *>(obj);
+
+        auto *tcl = button->canvas()->app()->tcl();
+
+        button->p_ = stringToPoint(tcl, value);
+
+        return true;
+      } },
+    { "name",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *button = static_cast<ButtonObj *>(obj);
+
+        value = button->name_;
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *button = static_cast<ButtonObj *>(obj);
+
+        button->name_ = value;
+
+        return true;
+      } },
+    { "proc",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *button = static_cast<ButtonObj *>(obj);
+
+        value = button->proc_;
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *button = static_cast<ButtonObj *>(obj);
+
+        button->proc_ = value;
+
+        return true;
+      } },
+  }, &Object::properties());
+
+  return table;
+}
+
 QVariant
 ButtonObj::
 getValue(const QString &name, const QStringList &args)
 {
-  if      (name == "position")
-    return pointToString(p_);
-  else if (name == "name")
-    return name_;
-  else if (name == "proc")
-    return proc_;
-  else
-    return Object::getValue(name, args);
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  return Object::getValue(name, args);
 }
 
 bool
 ButtonObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  if      (name == "position") {
-    auto *tcl = canvas()->app()->tcl();
+  auto *property = properties().find(name);
 
-    p_ = stringToPoint(tcl, value);
-  }
-  else if (name == "name")
-    name_ = value;
-  else if (name == "proc")
-    proc_ = value;
-  else
-    return Object::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object::setValue(name, value, args);
 }
 
 Rect
@@ -3223,42 +4535,118 @@ TextObj(Canvas *canvas, const Point &pos, const QString &text) :
   font_ = canvas->font();
 }
 
+const PropertyTable<Object> &
+TextObj::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "position",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *text = static_cast<TextObj *>(obj);
+
+        value = pointToString(text->pos_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *text = static_cast<TextObj *>(obj);
+
+        auto *tcl = text->canvas()->app()->tcl();
+
+        text->pos_ = stringToPoint(tcl, value);
+
+        return true;
+      } },
+    { "text",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *text = static_cast<TextObj *>(obj);
+
+        value = text->text_;
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *text = static_cast<TextObj *>(obj);
+
+        text->text_ = value;
+
+        return true;
+      } },
+    { "align",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *text = static_cast<TextObj *>(obj);
+
+        value = alignToString(text->align_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *text = static_cast<TextObj *>(obj);
+
+        text->align_ = stringToAlign(value);
+
+        return true;
+      } },
+    { "html",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *text = static_cast<TextObj *>(obj);
+
+        value = text->html_;
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *text = static_cast<TextObj *>(obj);
+
+        text->html_ = Util::stringToBool(value);
+
+        return true;
+      } },
+    { "border.color", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *text = static_cast<TextObj *>(obj);
+
+        auto *tcl = text->canvas()->app()->tcl();
+
+        text->border_.setColor(Util::stringToColor(tcl, value));
+
+        return true;
+      } },
+  }, &Object::properties());
+
+  return table;
+}
+
 QVariant
 TextObj::
 getValue(const QString &name, const QStringList &args)
 {
-  if      (name == "position")
-    return pointToString(pos_);
-  else if (name == "text")
-    return text_;
-  else if (name == "align")
-    return alignToString(align_);
-  else if (name == "html")
-    return html_;
-  else
-    return Object::getValue(name, args);
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  return Object::getValue(name, args);
 }
 
 bool
 TextObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  auto *tcl = canvas()->app()->tcl();
+  auto *property = properties().find(name);
 
-  if      (name == "position")
-    pos_ = stringToPoint(tcl, value);
-  else if (name == "text")
-    text_ = value;
-  else if (name == "align")
-    align_ = stringToAlign(value);
-  else if (name == "html")
-    html_ = Util::stringToBool(value);
-  else if (name == "border.color")
-    border_.setColor(Util::stringToColor(tcl, value));
-  else
-    return Object::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object::setValue(name, value, args);
 }
 
 Rect
@@ -3378,75 +4766,156 @@ ImageObj(Canvas *canvas, const Point &pos, const QImage &image) :
 {
 }
 
+const PropertyTable<Object> &
+ImageObj::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "position",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *image = static_cast<ImageObj *>(obj);
+
+        value = pointToString(image->pos_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *image = static_cast<ImageObj *>(obj);
+
+        auto *tcl = image->canvas()->app()->tcl();
+
+        image->pos_     = stringToPoint(tcl, value);
+        image->posType_ = Position::TOP_LEFT;
+
+        return true;
+      } },
+    { "center",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *image = static_cast<ImageObj *>(obj);
+
+        auto ppos = image->pointToPixel(image->pos_);
+
+        ppos.x.value += image->image_.width ()/2;
+        ppos.y.value += image->image_.height()/2;
+
+        value = pointToString(ppos);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *image = static_cast<ImageObj *>(obj);
+
+        auto *tcl = image->canvas()->app()->tcl();
+
+        image->pos_     = stringToPoint(tcl, value);
+        image->posType_ = Position::CENTER;
+
+        return true;
+      } },
+    { "rect", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *image = static_cast<ImageObj *>(obj);
+
+        auto *tcl = image->canvas()->app()->tcl();
+
+        image->rect_    = stringToRect(tcl, value);
+        image->posType_ = Position::RECT;
+
+        return true;
+      } },
+    { "image",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *image = static_cast<ImageObj *>(obj);
+
+        value = imageToString(image->image_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *image = static_cast<ImageObj *>(obj);
+
+        auto *app = image->canvas()->app();
+
+        if (value != "") {
+          if (! stringToImage(value, image->image_)) {
+            auto *obj1 = image->canvas()->getObjectByName(value);
+            if (! obj1) return app->errorMsg(QString("Failed to find object '%1'").arg(value));
+
+            auto *imageObj = dynamic_cast<ImageObj *>(obj1);
+            if (! imageObj) return false;
+
+            image->image_ = imageObj->image();
+          }
+        }
+        else
+          image->image_ = QImage();
+
+        return true;
+      } },
+    { "flip_x", nullptr,
+      [](Object *obj, const QString &, const QStringList &) {
+        auto *image = static_cast<ImageObj *>(obj);
+
+        image->image_ = image->image_.mirrored(true, false);
+
+        return true;
+      } },
+    { "flip_y", nullptr,
+      [](Object *obj, const QString &, const QStringList &) {
+        auto *image = static_cast<ImageObj *>(obj);
+
+        image->image_ = image->image_.mirrored(false, true);
+
+        return true;
+      } },
+    { "scale", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *image = static_cast<ImageObj *>(obj);
+
+        auto *tcl = image->canvas()->app()->tcl();
+
+        auto size = stringToPoint(tcl, value);
+
+        image->image_ = image->image_.scaled(image->image_.width ()*size.x.value,
+                                         image->image_.height()*size.y.value);
+
+        return true;
+      } },
+  }, &Object::properties());
+
+  return table;
+}
+
 QVariant
 ImageObj::
 getValue(const QString &name, const QStringList &args)
 {
-  if      (name == "position")
-    return pointToString(pos_);
-  else if (name == "center") {
-    auto ppos = pointToPixel(pos_);
+  auto *property = properties().find(name);
 
-    ppos.x.value += image_.width ()/2;
-    ppos.y.value += image_.height()/2;
+  if (property && property->get) {
+    QVariant value;
 
-    return pointToString(ppos);
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
   }
-  else if (name == "image")
-    return imageToString(image_);
-  else
-    return Object::getValue(name, args);
+
+  return Object::getValue(name, args);
 }
 
 bool
 ImageObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  auto *app = canvas()->app();
-  auto *tcl = app->tcl();
-
-  if      (name == "position") {
-    pos_     = stringToPoint(tcl, value);
-    posType_ = Position::TOP_LEFT;
-  }
-  else if (name == "center") {
-    pos_     = stringToPoint(tcl, value);
-    posType_ = Position::CENTER;
-  }
-  else if (name == "rect") {
-    rect_    = stringToRect(tcl, value);
-    posType_ = Position::RECT;
-  }
-  else if (name == "image") {
-    if (value != "") {
-      if (! stringToImage(value, image_)) {
-        auto *obj = canvas()->getObjectByName(value);
-        if (! obj) return app->errorMsg(QString("Failed to find object '%1'").arg(value));
-
-        auto *imageObj = dynamic_cast<ImageObj *>(obj);
-        if (! obj) return false;
-
-        image_ = imageObj->image();
-      }
-    }
-    else
-      image_ = QImage();
-  }
-  else if (name == "flip_x") {
-    image_ = image_.mirrored(true, false);
-  }
-  else if (name == "flip_y") {
-    image_ = image_.mirrored(false, true);
-  }
-  else if (name == "scale") {
-    auto size = stringToPoint(tcl, value);
+  auto *property = properties().find(name);
 
-    image_ = image_.scaled(image_.width()*size.x.value, image_.height()*size.y.value);
-  }
-  else
-    return Object::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object::setValue(name, value, args);
 }
 
 Rect
@@ -3526,27 +4995,61 @@ PathObj(Canvas *canvas, const QPainterPath &path) :
 {
 }
 
+const PropertyTable<Object> &
+PathObj::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "path",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *path = static_cast<PathObj *>(obj);
+
+        value = pathToString(path->path_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *path = static_cast<PathObj *>(obj);
+
+        path->path_ = stringToPath(value);
+
+        return true;
+      } },
+  }, &Object::properties());
+
+  return table;
+}
+
 QVariant
 PathObj::
 getValue(const QString &name, const QStringList &args)
 {
-  if (name == "path")
-    return pathToString(path_);
-  else
-    return Object::getValue(name, args);
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  return Object::getValue(name, args);
 }
 
 bool
 PathObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  if (name == "path") {
-    path_ = stringToPath(value);
-  }
-  else
-    return Object::setValue(name, value, args);
+  auto *property = properties().find(name);
 
-  return true;
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object::setValue(name, value, args);
 }
 
 Rect
@@ -3599,136 +5102,336 @@ PointListObj(Canvas *canvas, const Coord &radius) :
 {
 }
 
-QVariant
+const PropertyTable<Object> &
 PointListObj::
-getValue(const QString &name, const QStringList &args)
+properties()
 {
-  auto *app = canvas()->app();
-  auto *tcl = app->tcl();
+  static PropertyTable<Object> table({
+    { "size",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<PointListObj *>(obj);
 
-  if      (name == "radius")
-    return coordToString(radius_.value());
-  else if (name == "radius.target")
-    return coordToString(radius_.target());
-  else if (name == "radius.steps")
-    return int(radius_.steps());
-  else if (name == "size")
-    return Util::intToString(int(points_.size()));
-  else if (name == "connected")
-    return Util::boolToString(isConnected());
-  else if (name == "show_points")
-    return Util::boolToString(isShowPoints());
-  else if (name == "angle")
-    return angle();
-  else if (name == "scale")
-    return scale();
-  else if (name == "offset")
-    return pointToString(offset());
-  else if (name == "fill_under")
-    return Util::boolToString(isFillUnder());
-  else if (name == "fill_under.y") {
-    if (fillUnderY())
-      return coordToString(*fillUnderY());
-    else
-      return QVariant();
-  }
-  else if (name == "position") {
-    if (args.size() > 0) {
-      auto i = Util::stringToInt(args[0]);
+        value = Util::intToString(int(pobj->points_.size()));
 
-      if (i < 0 || i >= int(points_.size()))
-        return QVariant();
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<PointListObj *>(obj);
 
-      return pointToString(points_[i]);
-    }
-    else
-      return QVariant();
-  }
-  else if (name == "intersect") {
-    if (args.size() < 0)
-      return QVariant();
+        auto n = Util::stringToInt(value);
+        if (n < 0) return false;
 
-    auto pos = stringToPoint(tcl, args[0]);
+        pobj->points_.resize(size_t(n));
 
-    auto pos1 = canvas()->pointToPixel(pos).qpoint();
+        return true;
+      } },
+    { "position",
+      // get index from args
+      [](Object *obj, const QStringList &args, QVariant &value) {
+        auto *pobj = static_cast<PointListObj *>(obj);
 
-    return path_.contains(pos1);
-  }
-  else if (name == "intersect_obj") {
-    if (args.size() < 0)
-      return QVariant();
+        if (args.size() == 0)
+          return false;
 
-    auto *obj = canvas()->getObjectByName(args[0]);
-    if (! obj) {
-     app->errorMsg(QString("Failed to find object '%1'").arg(args[0]));
-     return QVariant();
-    }
+        auto i = Util::stringToInt(args[0]);
 
-    auto path1 = calcPath();
-    auto path2 = obj->calcPath();
+        if (i < 0 || i >= int(pobj->points_.size()))
+          return false;
 
-    return path1.intersects(path2);
-  }
-  else
-    return Object::getValue(name, args);
-}
+        value = pointToString(pobj->points_[i]);
 
-bool
-PointListObj::
-setValue(const QString &name, const QString &value, const QStringList &args)
-{
-  auto *app = canvas()->app();
-  auto *tcl = app->tcl();
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &args) {
+        auto *pobj = static_cast<PointListObj *>(obj);
 
-  if      (name == "radius")
-    radius_.setValue(stringToCoord(value));
-  else if (name == "radius.target")
-    radius_.setTarget(stringToCoord(value));
-  else if (name == "radius.steps")
-    radius_.setSteps(Util::stringToInt(value));
-  else if (name == "size") {
-    auto n = Util::stringToInt(value);
+        if (args.size() == 0)
+          return pobj->canvas()->app()->errorMsg("Missing index for position");
 
-    auto n1 = int(points_.size());
+        auto i = Util::stringToInt(args[0]);
 
-    if      (n > n1) {
-      for (int i = 0; i < n - n1; ++i)
-        points_.emplace_back();
-    }
-    else if (n < n1) {
-      for (int i = 0; i < n1 - n; ++i)
-        points_.pop_back();
-    }
+        if (i < 0 || i >= int(pobj->points_.size()))
+          return false;
+
+        pobj->points_[i] = stringToPoint(pobj->canvas()->app()->tcl(), value);
+
+        return true;
+      } },
+    { "radius",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        value = coordToString(pobj->radius_.value());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        pobj->radius_.setValue(stringToCoord(value));
+
+        return true;
+      } },
+    { "radius.target",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        value = coordToString(pobj->radius_.target());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        pobj->radius_.setTarget(stringToCoord(value));
+
+        return true;
+      } },
+    { "radius.steps",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        value = int(pobj->radius_.steps());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        pobj->radius_.setSteps(Util::stringToInt(value));
+
+        return true;
+      } },
+    { "connected",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        value = Util::boolToString(pobj->isConnected());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        pobj->setConnected(Util::stringToBool(value));
+
+        return true;
+      } },
+    { "show_points",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        value = Util::boolToString(pobj->isShowPoints());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        pobj->setShowPoints(Util::stringToBool(value));
+
+        return true;
+      } },
+    { "angle",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        value = pobj->angle();
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        pobj->setAngle(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "scale",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        value = pobj->scale();
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        pobj->setScale(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "offset",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        value = pointToString(pobj->offset());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        auto *tcl = pobj->canvas()->app()->tcl();
+
+        pobj->setOffset(stringToPoint(tcl, value));
+
+        return true;
+      } },
+    { "fill_under",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        value = Util::boolToString(pobj->isFillUnder());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        pobj->setFillUnder(Util::stringToBool(value));
+
+        return true;
+      } },
+    { "fill_under.y",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        if (! pobj->fillUnderY())
+          return false;
+
+        value = coordToString(*pobj->fillUnderY());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        pobj->setFillUnderY(stringToCoord(value));
+
+        return true;
+      } },
+    { "intersect",
+      [](Object *obj, const QStringList &args, QVariant &value) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        auto *tcl = pobj->canvas()->app()->tcl();
+
+        if (args.size() < 1)
+          return false;
+
+        auto pos = stringToPoint(tcl, args[0]);
+
+        auto pos1 = pobj->canvas()->pointToPixel(pos).qpoint();
+
+        value = pobj->path_.contains(pos1);
+
+        return true;
+      }, nullptr },
+    { "intersect_obj",
+      [](Object *obj, const QStringList &args, QVariant &value) {
+        auto *pobj = static_cast<PointListObj *>(obj);
+
+        auto *app = pobj->canvas()->app();
+
+        if (args.size() < 1)
+          return false;
+
+        auto *obj1 = pobj->canvas()->getObjectByName(args[0]);
+        if (! obj1)
+          return app->errorMsg(QString("Failed to find object '%1'").arg(args[0]));
+
+        auto path1 = pobj->calcPath();
+        auto path2 = obj1->calcPath();
+
+        value = path1.intersects(path2);
+
+        return true;
+      }, nullptr },
+  }, &Object::properties());
+
+  return table;
+}
+
+QVariant
+PointListObj::
+getValue(const QString &name, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
   }
-  else if (name == "connected")
-    setConnected(Util::stringToBool(value));
-  else if (name == "show_points")
-    setFillUnder(Util::stringToBool(value));
-  else if (name == "fill_under")
-    setFillUnder(Util::stringToBool(value));
-  else if (name == "fill_under.y")
-    setFillUnderY(stringToCoord(value));
-  else if (name == "angle")
-    setAngle(Util::stringToReal(value));
-  else if (name == "scale")
-    setScale(Util::stringToReal(value));
-  else if (name == "offset")
-    setOffset(stringToPoint(tcl, value));
-  else if (name == "position") {
-    // get index from args
-    if (args.size() > 0) {
-      auto i = Util::stringToInt(args[0]);
-
-      if (i < 0 || i >= int(points_.size()))
-        return false;
 
-      points_[i] = stringToPoint(tcl, value);
-    }
-    else
-      return app->errorMsg("Missing index for position");
+  return Object::getValue(name, args);
+}
+
+bool
+PointListObj::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object::setValue(name, value, args);
+}
+
+bool
+PointListObj::
+getData(const QString &name, int start, int stride, std::vector<float> &values)
+{
+  if (name != "position")
+    return Object::getData(name, start, stride, values);
+
+  auto n = Util::dataRangeCount(int(points_.size()), start, stride);
+
+  values.resize(size_t(2*n));
+
+  auto *v = values.data();
+
+  for (int i = 0, j = start; i < n; ++i, j += stride) {
+    const auto &p = points_[size_t(j)];
+
+    *v++ = float(p.x.value); *v++ = float(p.y.value);
   }
-  else
-    return Object::setValue(name, value, args);
+
+  return true;
+}
+
+bool
+PointListObj::
+setData(const QString &name, const std::vector<float> &values, int start, int stride)
+{
+  auto *app = canvas()->app();
+
+  if (name != "position")
+    return Object::setData(name, values, start, stride);
+
+  // x y per element
+  if (values.size() % 2 != 0)
+    return app->errorMsg("Invalid number of values for 'position' data");
+
+  auto n = int(values.size()/2);
+
+  // all positions (resize)
+  if (start == 0 && stride == 1)
+    points_.resize(size_t(n));
+
+  if (! Util::isDataRangeValid(int(points_.size()), n, start, stride))
+    return app->errorMsg("Invalid range for 'position' data");
+
+  const auto *v = values.data();
+
+  for (int i = 0, j = start; i < n; ++i, j += stride, v += 2)
+    points_[size_t(j)] = Point::makeWindow(v[0], v[1]);
 
   return true;
 }
@@ -3736,6 +5439,45 @@ setValue(const QString &name, const QString &value, const QStringList &args)
 Rect
 PointListObj::
 calcRect() const
+{
+  auto rect = calcPointsRect();
+
+  if (angle() == 0.0 && scale() == 1.0 && offset().x.value == 0.0 && offset().y.value == 0.0)
+    return rect;
+
+  // bounds of drawn (transformed) points
+  auto t = calcTransform();
+
+  QRectF r;
+  bool   rset { false };
+
+  for (const auto &point : points_) {
+    auto p = t.map(canvas()->pointToPixel(pointToWindow(point)).qpoint());
+
+    if (! rset) {
+      r = QRectF(p.x(), p.y(), 0, 0);
+
+      rset = true;
+    }
+    else {
+      auto x1 = std::min(r.left  (), p.x());
+      auto y1 = std::min(r.top   (), p.y());
+      auto x2 = std::max(r.right (), p.x());
+      auto y2 = std::max(r.bottom(), p.y());
+
+      r = QRectF(x1, y1, x2 - x1, y2 - y1);
+    }
+  }
+
+  auto p1 = canvas()->pointToWindow(Point::makePixel(r.left (), r.top   ()));
+  auto p2 = canvas()->pointToWindow(Point::makePixel(r.right(), r.bottom()));
+
+  return Rect(p1, p2);
+}
+
+Rect
+PointListObj::
+calcPointsRect() const
 {
   QRectF r;
   bool   rset { false };
@@ -3771,22 +5513,16 @@ step()
   return (b1 || b2);
 }
 
-void
+QTransform
 PointListObj::
-draw(QPainter *painter)
+calcTransform() const
 {
-  auto rect  = this->calcRect();
-  auto prect = canvas()->rectToPixel(rect).qrect();
-
   auto c  = center();
   auto pc = canvas()->pointToPixel(c).qpoint();
 
   auto po = canvas()->pointToPixel(Point()).qpoint();
   auto pf = canvas()->pointToPixel(offset()).qpoint() - po;
 
-  painter->setPen(pen_);
-  painter->setBrush(brush_.value());
-
   QTransform t;
 
   t.translate(pc.x() + pf.x(), pc.y() + pf.y());
@@ -3794,6 +5530,21 @@ draw(QPainter *painter)
   t.scale(scale(), scale());
   t.translate(-pc.x(), -pc.y());
 
+  return t;
+}
+
+void
+PointListObj::
+draw(QPainter *painter)
+{
+  auto rect  = this->calcPointsRect();
+  auto prect = canvas()->rectToPixel(rect).qrect();
+
+  painter->setPen(pen_);
+  painter->setBrush(brush_.value());
+
+  auto t = calcTransform();
+
 #if 0
   painter->setTransform(t);
 #endif
@@ -3924,58 +5675,184 @@ ArrowObj(Canvas *canvas, const Point &p1, const Point &p2) :
   arrow_ = new CQArrow;
 }
 
+const PropertyTable<Object> &
+ArrowObj::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "p1",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        value = pointToString(arrow->p1_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        auto *tcl = arrow->canvas()->app()->tcl();
+
+        arrow->p1_ = stringToPoint(tcl, value);
+
+        return true;
+      } },
+    { "p2",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        value = pointToString(arrow->p2_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        auto *tcl = arrow->canvas()->app()->tcl();
+
+        arrow->p2_ = stringToPoint(tcl, value);
+
+        return true;
+      } },
+    { "lineWidth", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        arrow->arrow_->setLineWidth(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "front.visible", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        arrow->arrow_->setFHead(Util::stringToBool(value));
+
+        return true;
+      } },
+    { "front.angle", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        arrow->arrow_->setFrontAngle(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "front.backAngle", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        arrow->arrow_->setFrontBackAngle(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "front.length", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        arrow->arrow_->setFrontLength(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "front.lineEnds", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        arrow->arrow_->setFrontLineEnds(Util::stringToBool(value));
+
+        return true;
+      } },
+    { "tail.visible", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        arrow->arrow_->setTHead(Util::stringToBool(value));
+
+        return true;
+      } },
+    { "tail.angle", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        arrow->arrow_->setTailAngle(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "tail.backAngle", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        arrow->arrow_->setTailBackAngle(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "tail.length", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        arrow->arrow_->setTailLength(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "tail.lineEnds", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        arrow->arrow_->setTailLineEnds(Util::stringToBool(value));
+
+        return true;
+      } },
+    { "filled", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        arrow->arrow_->setFilled(Util::stringToBool(value));
+
+        return true;
+      } },
+    { "stroked", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *arrow = static_cast<ArrowObj *>(obj);
+
+        arrow->arrow_->setStroked(Util::stringToBool(value));
+
+        return true;
+      } },
+  }, &Object::properties());
+
+  return table;
+}
+
 QVariant
 ArrowObj::
 getValue(const QString &name, const QStringList &args)
 {
-  if      (name == "p1")
-    return pointToString(p1_);
-  else if (name == "p2")
-    return pointToString(p2_);
-  else
-    return Object::getValue(name, args);
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  return Object::getValue(name, args);
 }
 
 bool
 ArrowObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  auto *tcl = canvas()->app()->tcl();
+  auto *property = properties().find(name);
 
-  if      (name == "p1")
-    p1_ = stringToPoint(tcl, value);
-  else if (name == "p2")
-    p2_ = stringToPoint(tcl, value);
-  else if (name == "lineWidth")
-    arrow_->setLineWidth(Util::stringToReal(value));
-  else if (name == "front.visible")
-    arrow_->setFHead(Util::stringToBool(value));
-  else if (name == "front.angle")
-    arrow_->setFrontAngle(Util::stringToReal(value));
-  else if (name == "front.backAngle")
-    arrow_->setFrontBackAngle(Util::stringToReal(value));
-  else if (name == "front.length")
-    arrow_->setFrontLength(Util::stringToReal(value));
-  else if (name == "front.lineEnds")
-    arrow_->setFrontLineEnds(Util::stringToBool(value));
-  else if (name == "tail.visible")
-    arrow_->setTHead(Util::stringToBool(value));
-  else if (name == "tail.angle")
-    arrow_->setTailAngle(Util::stringToReal(value));
-  else if (name == "tail.backAngle")
-    arrow_->setTailBackAngle(Util::stringToReal(value));
-  else if (name == "tail.length")
-    arrow_->setTailLength(Util::stringToReal(value));
-  else if (name == "tail.lineEnds")
-    arrow_->setTailLineEnds(Util::stringToBool(value));
-  else if (name == "filled")
-    arrow_->setFilled(Util::stringToBool(value));
-  else if (name == "stroked")
-    arrow_->setStroked(Util::stringToBool(value));
-  else
-    return Object::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object::setValue(name, value, args);
 }
 
 Rect
@@ -4050,40 +5927,91 @@ AxisObj(Canvas *canvas, const Point &pos, const Coord &len) :
   axis_ = new CQAxis;
 }
 
+const PropertyTable<Object> &
+AxisObj::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "pos",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *axis = static_cast<AxisObj *>(obj);
+
+        value = pointToString(axis->pos_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *axis = static_cast<AxisObj *>(obj);
+
+        auto *tcl = axis->canvas()->app()->tcl();
+
+        axis->pos_ = stringToPoint(tcl, value);
+
+        return true;
+      } },
+    { "p2",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *axis = static_cast<AxisObj *>(obj);
+
+        value = coordToString(axis->len_);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *axis = static_cast<AxisObj *>(obj);
+
+        axis->len_ = stringToCoord(value);
+
+        return true;
+      } },
+    { "direction", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *axis = static_cast<AxisObj *>(obj);
+
+        auto lstr = value.toLower();
+
+        if      (lstr == "horizontal")
+          axis->axis_->setDirection(CQAxis::DIR_HORIZONTAL);
+        else if (lstr == "vertical")
+          axis->axis_->setDirection(CQAxis::DIR_VERTICAL);
+
+        return true;
+      } },
+  }, &Object::properties());
+
+  return table;
+}
+
 QVariant
 AxisObj::
 getValue(const QString &name, const QStringList &args)
 {
-  if      (name == "pos")
-    return pointToString(pos_);
-  else if (name == "p2")
-    return coordToString(len_);
-  else
-    return Object::getValue(name, args);
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  return Object::getValue(name, args);
 }
 
 bool
 AxisObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  auto *tcl = canvas()->app()->tcl();
+  auto *property = properties().find(name);
 
-  if      (name == "pos")
-    pos_ = stringToPoint(tcl, value);
-  else if (name == "p2")
-    len_ = stringToCoord(value);
-  else if (name == "direction") {
-    auto lstr = value.toLower();
-
-    if      (lstr == "horizontal")
-      axis_->setDirection(CQAxis::DIR_HORIZONTAL);
-    else if (lstr == "vertical")
-      axis_->setDirection(CQAxis::DIR_VERTICAL);
-  }
-  else
-    return Object::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object::setValue(name, value, args);
 }
 
 Rect
@@ -4176,101 +6104,205 @@ setParticle(Particle *p)
   particle_->setPosition(pos_.x.value, pos_.y.value, 0);
 }
 
-QVariant
+const PropertyTable<Object> &
 ParticleObj::
-getValue(const QString &name, const QStringList &args)
+properties()
 {
-  if      (name == "position") {
-    auto *position = particle_->position();
+  using Table = PropertyTable<Object>;
 
-    return pointToString(Point(position->x(), position->y()));
-  }
-  else if (name == "velocity") {
-    auto *velocity = particle_->velocity();
+  static Table table({
+    { "position",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
 
-    return pointToString(Point(velocity->x(), velocity->y()));
-  }
-  else if (name == "dead") {
-    return Util::boolToString(particle_->isDead());
-  }
-  else if (name == "age") {
-    return particle_->age();
-  }
-  else
-    return Object::getValue(name, args);
+        auto position = pobj->particle_->position();
+
+        value = pointToString(Point(position.x(), position.y()));
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
+
+        auto *tcl = pobj->canvas()->app()->tcl();
+
+        auto p = stringToPoint(tcl, value);
+
+        pobj->particle_->setPosition(p.x.value, p.y.value, 0);
+
+        return true;
+      } },
+    { "velocity",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
+
+        auto velocity = pobj->particle_->velocity();
+
+        value = pointToString(Point(velocity.x(), velocity.y()));
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
+
+        auto *tcl = pobj->canvas()->app()->tcl();
+
+        auto p = stringToPoint(tcl, value);
+
+        pobj->particle_->setVelocity(p.x.value, p.y.value, 0);
+
+        return true;
+      } },
+    { "dead",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
+
+        value = Util::boolToString(pobj->particle_->isDead());
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
+
+        pobj->particle_->setDead(Util::stringToBool(value));
+
+        return true;
+      } },
+    { "age",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
+
+        value = pobj->particle_->age();
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
+
+        pobj->particle_->setAge(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "size", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
+
+        pobj->particle_->setSize(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "tpos", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
+
+        auto *tcl = pobj->canvas()->app()->tcl();
+
+        auto p = stringToPoint(tcl, value);
+
+        pobj->particle_->setTPos(CPoint2D(p.x.value, p.y.value));
+
+        return true;
+      } },
+    { "tsize", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
+
+        auto *tcl = pobj->canvas()->app()->tcl();
+
+        auto p = stringToPoint(tcl, value);
+
+        pobj->particle_->setTSize(CSize2D(p.x.value, p.y.value));
+
+        return true;
+      } },
+    { "angle", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
+
+        pobj->particle_->setAngle(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "color", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
+
+        auto *tcl = pobj->canvas()->app()->tcl();
+
+        pobj->particle_->setColor(QColorToRGBA(Util::stringToColor(tcl, value)));
+
+        return true;
+      } },
+    { "alpha", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
+
+        pobj->particle_->setAlpha(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "image", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *pobj = static_cast<ParticleObj *>(obj);
+
+        auto *app = pobj->canvas()->app();
+
+        QImage image;
+
+        if (! stringToImage(value, image)) {
+          auto *obj1 = pobj->canvas()->getObjectByName(value);
+          if (! obj1) return app->errorMsg(QString("Failed to find object '%1'").arg(value));
+
+          auto *imageObj = dynamic_cast<ImageObj *>(obj1);
+          if (! imageObj) return false;
+
+          pobj->particle_->setImage(imageObj->image());
+        }
+
+        return true;
+      } },
+  }, &Object::properties());
+
+  return table;
 }
 
-bool
+QVariant
 ParticleObj::
-setValue(const QString &name, const QString &value, const QStringList &args)
+getValue(const QString &name, const QStringList &args)
 {
-  auto *app = canvas()->app();
-  auto *tcl = app->tcl();
+  auto *property = properties().find(name);
 
-  if      (name == "position") {
-    auto p = stringToPoint(tcl, value);
+  if (property && property->get) {
+    QVariant value;
 
-    particle_->setPosition(p.x.value, p.y.value, 0);
-  }
-  else if (name == "velocity") {
-    auto p = stringToPoint(tcl, value);
-
-    particle_->setVelocity(p.x.value, p.y.value, 0);
-  }
-  else if (name == "dead") {
-    particle_->setDead(Util::stringToBool(value));
-  }
-  else if (name == "age") {
-    particle_->setAge(Util::stringToReal(value));
-  }
-  else if (name == "size") {
-    particle_->setSize(Util::stringToReal(value));
-  }
-  else if (name == "tpos") {
-    auto p = stringToPoint(tcl, value);
+    if (! property->get(this, args, value))
+      return QVariant();
 
-    particle_->setTPos(CPoint2D(p.x.value, p.y.value));
+    return value;
   }
-  else if (name == "tsize") {
-    auto p = stringToPoint(tcl, value);
 
-    particle_->setTSize(CSize2D(p.x.value, p.y.value));
-  }
-  else if (name == "angle") {
-    particle_->setAngle(Util::stringToReal(value));
-  }
-  else if (name == "color") {
-    particle_->setColor(QColorToRGBA(Util::stringToColor(tcl, value)));
-  }
-  else if (name == "alpha") {
-    particle_->setAlpha(Util::stringToReal(value));
-  }
-  else if (name == "image") {
-    QImage image;
-
-    if (! stringToImage(value, image)) {
-      auto *obj = canvas()->getObjectByName(value);
-      if (! obj) return app->errorMsg(QString("Failed to find object '%1'").arg(value));
+  return Object::getValue(name, args);
+}
 
-      auto *imageObj = dynamic_cast<ImageObj *>(obj);
-      if (! obj) return false;
+bool
+ParticleObj::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
 
-      particle_->setImage(imageObj->image());
-    }
-  }
-  else
-    return Object::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object::setValue(name, value, args);
 }
 
 Rect
 ParticleObj::
 calcRect() const
 {
-  auto *position = particle_->position();
+  auto position = particle_->position();
 
-  auto p = Point(position->x(), position->y());
+  auto p = Point(position.x(), position.y());
 
   return Rect(p, p);
 }
@@ -4307,30 +6339,76 @@ VectorObj(Canvas *canvas) :
 {
 }
 
+const PropertyTable<Object> &
+VectorObj::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "x",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *vobj = static_cast<VectorObj *>(obj);
+
+        value = vobj->v_.x();
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *vobj = static_cast<VectorObj *>(obj);
+
+        vobj->v_.setX(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "y",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *vobj = static_cast<VectorObj *>(obj);
+
+        value = vobj->v_.y();
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *vobj = static_cast<VectorObj *>(obj);
+
+        vobj->v_.setY(Util::stringToReal(value));
+
+        return true;
+      } },
+  }, &Object::properties());
+
+  return table;
+}
+
 QVariant
 VectorObj::
 getValue(const QString &name, const QStringList &args)
 {
-  if      (name == "x")
-    return v_.x();
-  else if (name == "y")
-    return v_.y();
-  else
-    return Object::getValue(name, args);
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  return Object::getValue(name, args);
 }
 
 bool
 VectorObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  if      (name == "x")
-    v_.setX(Util::stringToReal(value));
-  else if (name == "y")
-    v_.setY(Util::stringToReal(value));
-  else
-    return Object::setValue(name, value, args);
+  auto *property = properties().find(name);
 
-  return true;
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object::setValue(name, value, args);
 }
 
 //---
@@ -4368,89 +6446,133 @@ ArrayObj(Canvas *canvas, const CArray2D<double> &a) :
 {
 }
 
-QVariant
+const PropertyTable<Object> &
 ArrayObj::
-getValue(const QString &name, const QStringList &args)
+properties()
 {
-  auto *app = canvas()->app();
-  auto *tcl = app->tcl();
+  using Table = PropertyTable<Object>;
 
-  if      (name == "value") {
-    uint dim0, dim1;
+  static Table table({
+    { "value",
+      [](Object *obj, const QStringList &args, QVariant &value) {
+        auto *array = static_cast<ArrayObj *>(obj);
 
-    if      (args.size() == 2) {
-      dim0 = Util::stringToInt(args[0]);
-      dim1 = Util::stringToInt(args[1]);
-    }
-    else if (args.size() == 1) {
-      std::vector<int> a;
-      if (! stringToIntArray(tcl, args[0], a) || a.size() != 2)
-        return false;
+        auto *tcl = array->canvas()->app()->tcl();
 
-      dim0 = a[0];
-      dim1 = a[1];
-    }
-    else
-      return QVariant();
+        uint dim0, dim1;
 
-    if (! a_.validIndex(dim0, dim1))
-      return QVariant();
+        if      (args.size() == 2) {
+          dim0 = Util::stringToInt(args[0]);
+          dim1 = Util::stringToInt(args[1]);
+        }
+        else if (args.size() == 1) {
+          std::vector<int> a;
+          if (! stringToIntArray(tcl, args[0], a) || a.size() != 2)
+            return false;
 
-    return a_.get(dim0, dim1);
-  }
-  else if (name == "dim0") {
-    return int(a_.dim(0));
-  }
-  else if (name == "dim1") {
-    return int(a_.dim(1));
-  }
-  else if (name == "dup") {
-    auto *obj = new ArrayObj(canvas(), a_);
+          dim0 = a[0];
+          dim1 = a[1];
+        }
+        else
+          return false;
 
-    auto name = canvas()->addNewObject(obj);
+        if (! array->a_.validIndex(dim0, dim1))
+          return false;
 
-    return name;
-  }
-  else
-    return Object::getValue(name, args);
+        value = array->a_.get(dim0, dim1);
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &args) {
+        auto *array = static_cast<ArrayObj *>(obj);
+
+        auto *tcl = array->canvas()->app()->tcl();
+
+        uint dim0, dim1;
+
+        if      (args.size() == 2) {
+          dim0 = Util::stringToInt(args[0]);
+          dim1 = Util::stringToInt(args[1]);
+        }
+        else if (args.size() == 1) {
+          std::vector<int> a;
+          if (! stringToIntArray(tcl, args[0], a) || a.size() != 2)
+            return false;
+
+          dim0 = a[0];
+          dim1 = a[1];
+        }
+        else
+          return false;
+
+        if (! array->a_.validIndex(dim0, dim1))
+          return false;
+
+        auto r = Util::stringToReal(value);
+
+        array->a_.set(dim0, dim1, r);
+
+        return true;
+      } },
+    { "dim0",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *array = static_cast<ArrayObj *>(obj);
+
+        value = int(array->a_.dim(0));
+
+        return true;
+      }, nullptr },
+    { "dim1",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *array = static_cast<ArrayObj *>(obj);
+
+        value = int(array->a_.dim(1));
+
+        return true;
+      }, nullptr },
+    { "dup",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *array = static_cast<ArrayObj *>(obj);
+
+        auto *obj1 = new ArrayObj(array->canvas(), array->a_);
+
+        value = array->canvas()->addNewObject(obj1);
+
+        return true;
+      }, nullptr },
+  }, &Object::properties());
+
+  return table;
 }
 
-bool
+QVariant
 ArrayObj::
-setValue(const QString &name, const QString &value, const QStringList &args)
+getValue(const QString &name, const QStringList &args)
 {
-  auto *app = canvas()->app();
-  auto *tcl = app->tcl();
+  auto *property = properties().find(name);
 
-  if (name == "value") {
-    uint dim0, dim1;
+  if (property && property->get) {
+    QVariant value;
 
-    if      (args.size() == 2) {
-      dim0 = Util::stringToInt(args[0]);
-      dim1 = Util::stringToInt(args[1]);
-    }
-    else if (args.size() == 1) {
-      std::vector<int> a;
-      if (! stringToIntArray(tcl, args[0], a) || a.size() != 2)
-        return false;
+    if (! property->get(this, args, value))
+      return QVariant();
 
-      dim0 = a[0];
-      dim1 = a[1];
-    }
-    else
-      return false;
+    return value;
+  }
 
-    if (! a_.validIndex(dim0, dim1))
-      return false;
+  return Object::getValue(name, args);
+}
 
-    auto r = Util::stringToReal(value);
+bool
+ArrayObj::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
 
-    a_.set(dim0, dim1, r);
-  }
-  else
-    return Object::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object::setValue(name, value, args);
 }
 
 //---
@@ -4482,58 +6604,146 @@ CsvObj(Canvas *canvas, const QString &filename) :
   csv_ = new CQCsvModel;
 }
 
+const PropertyTable<Object> &
+CsvObj::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "filename",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *csv = static_cast<CsvObj *>(obj);
+
+        value = csv->filename_;
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *csv = static_cast<CsvObj *>(obj);
+
+        csv->filename_ = value;
+
+        return true;
+      } },
+    { "comment_header",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *csv = static_cast<CsvObj *>(obj);
+
+        value = csv->csv_->isCommentHeader();
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *csv = static_cast<CsvObj *>(obj);
+
+        csv->csv_->setCommentHeader(Util::stringToBool(value));
+
+        return true;
+      } },
+    { "first_line_header",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *csv = static_cast<CsvObj *>(obj);
+
+        value = csv->csv_->isFirstLineHeader();
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *csv = static_cast<CsvObj *>(obj);
+
+        csv->csv_->setFirstLineHeader(Util::stringToBool(value));
+
+        return true;
+      } },
+    { "first_column_header",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *csv = static_cast<CsvObj *>(obj);
+
+        value = csv->csv_->isFirstColumnHeader();
+
+        return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *csv = static_cast<CsvObj *>(obj);
+
+        csv->csv_->setFirstColumnHeader(Util::stringToBool(value));
+
+        return true;
+      } },
+    { "num_rows",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *csv = static_cast<CsvObj *>(obj);
+
+        value = csv->csv_->rowCount();
+
+        return true;
+      }, nullptr },
+    { "num_columns",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *csv = static_cast<CsvObj *>(obj);
+
+        value = csv->csv_->columnCount();
+
+        return true;
+      }, nullptr },
+    { "num_cols",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        auto *csv = static_cast<CsvObj *>(obj);
+
+        value = csv->csv_->columnCount();
+
+        return true;
+      }, nullptr },
+    { "data",
+      [](Object *obj, const QStringList &args, QVariant &value) {
+        auto *csv = static_cast<CsvObj *>(obj);
+
+        if (args.size() != 2)
+          return csv->canvas()->app()->errorMsg("missing row/col for data");
+
+        auto row = Util::stringToInt(args[0]);
+        auto col = Util::stringToInt(args[1]);
+
+        auto ind = csv->csv_->index(row, col, QModelIndex());
+
+        value = csv->csv_->data(ind);
+
+        return true;
+      }, nullptr },
+  }, &Object::properties());
+
+  return table;
+}
+
 QVariant
 CsvObj::
 getValue(const QString &name, const QStringList &args)
 {
-  auto *app = canvas()->app();
+  auto *property = properties().find(name);
 
-  if      (name == "filename")
-    return filename_;
-  else if (name == "comment_header")
-    return csv_->isCommentHeader();
-  else if (name == "first_line_header")
-    return csv_->isFirstLineHeader();
-  else if (name == "first_column_header")
-    return csv_->isFirstColumnHeader();
-  else if (name == "num_rows")
-    return csv_->rowCount();
-  else if (name == "num_columns" || name == "num_cols")
-    return csv_->columnCount();
-  else if (name == "data") {
-    if (args.size() == 2) {
-      auto row = Util::stringToInt(args[0]);
-      auto col = Util::stringToInt(args[1]);
-
-      auto ind = csv_->index(row, col, QModelIndex());
-
-      return csv_->data(ind);
-    }
-    else {
-      app->errorMsg("missing row/col for data");
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
       return QVariant();
-    }
+
+    return value;
   }
-  else
-    return Object::getValue(name, args);
+
+  return Object::getValue(name, args);
 }
 
 bool
 CsvObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  if      (name == "filename")
-    filename_ = value;
-  else if (name == "comment_header")
-    csv_->setCommentHeader(Util::stringToBool(value));
-  else if (name == "first_line_header")
-    csv_->setFirstLineHeader(Util::stringToBool(value));
-  else if (name == "first_column_header")
-    csv_->setFirstColumnHeader(Util::stringToBool(value));
-  else
-    return Object::setValue(name, value, args);
+  auto *property = properties().find(name);
 
-  return true;
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object::setValue(name, value, args);
 }
 
 bool
@@ -4643,31 +6853,206 @@ calcId() const
   return id;
 }
 
+const PropertyTable<Object> &
+Object::
+properties()
+{
+  using Table = PropertyTable<Object>;
+
+  static Table table({
+    { "id",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        value = obj->id(); return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto oldId = obj->id();
+
+        obj->setId(value);
+
+        obj->canvas()->objectIdChanged(obj, oldId);
+
+        return true;
+      } },
+    { "visible",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        value = obj->isVisible(); return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        obj->setVisible(Util::stringToBool(value)); return true;
+      } },
+    { "stroked", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        obj->setStroked(Util::stringToBool(value)); return true;
+      } },
+    { "filled", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        obj->setFilled(Util::stringToBool(value)); return true;
+      } },
+    { "brush.color",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        value = Util::colorToString(obj->brush_.value().color()); return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto b = obj->brush_.value();
+
+        b.setColor(Util::stringToColor(obj->canvas()->app()->tcl(), value));
+
+        obj->brush_ = b;
+
+        return true;
+      } },
+    { "brush.color.target",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        value = Util::colorToString(obj->brush_.target().color()); return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto b = obj->brush_.target();
+
+        b.setColor(Util::stringToColor(obj->canvas()->app()->tcl(), value));
+
+        obj->brush_.setTarget(b);
+
+        return true;
+      } },
+    { "brush.alpha",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        value = Util::realToString(obj->brush_.value().color().alphaF()); return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto b = obj->brush_.value();
+        auto c = b.color();
+
+        c.setAlphaF(Util::stringToReal(value));
+        b.setColor(c);
+
+        obj->brush_ = b;
+
+        return true;
+      } },
+    { "brush.steps",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        value = Util::colorToString(obj->brush_.steps()); return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        obj->brush_.setSteps(Util::stringToInt(value)); return true;
+      } },
+    { "brush.linear_gradient", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *tcl = obj->canvas()->app()->tcl();
+
+        QStringList strs;
+        (void) tcl->splitList(value, strs);
+        if (strs.size() != 4) return false;
+
+        auto x1 = Util::stringToReal(strs[0]);
+        auto y1 = Util::stringToReal(strs[1]);
+        auto x2 = Util::stringToReal(strs[2]);
+        auto y2 = Util::stringToReal(strs[3]);
+
+        QLinearGradient lg(x1, y1, x2, y2);
+
+        QGradientStops stops;
+
+        stops.push_back(QGradientStop(0.0, Qt::red));
+        stops.push_back(QGradientStop(1.0, Qt::green));
+
+        lg.setStops(stops);
+
+        lg.setCoordinateMode(QGradient::ObjectMode);
+
+        obj->brush_ = QBrush(lg);
+
+        return true;
+      } },
+    { "pen.color",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        value = Util::colorToString(obj->pen_.color()); return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        obj->pen_.setColor(Util::stringToColor(obj->canvas()->app()->tcl(), value));
+        return true;
+      } },
+    { "pen.width",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        value = Util::realToString(obj->pen_.widthF()); return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        obj->pen_.setWidthF(Util::stringToReal(value)); return true;
+      } },
+    { "pen.dash", nullptr,
+      [](Object *obj, const QString &value, const QStringList &) {
+        obj->pen_.setDashPattern(stringToDashes(obj->canvas()->app()->tcl(), value));
+        return true;
+      } },
+    { "group",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        value = (obj->group() ? obj->group()->calcId() : ""); return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        auto *canvas = obj->canvas();
+
+        auto *group = dynamic_cast<GroupObj *>(canvas->getObjectByName(value));
+        if (! group)
+          return canvas->app()->errorMsg(QString("Failed to find group '%1'").arg(value));
+
+        if (group != obj->group_) {
+          if (obj->group_)
+            obj->group_->removeObject(obj);
+          else
+            canvas->removeObject(obj);
+
+          if (group)
+            group->addObject(obj);
+          else
+            canvas->addObject(obj);
+        }
+
+        return true;
+      } },
+    { "overlaps",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        Objects objs;
+        obj->canvas()->getObjectOverlaps(obj, objs);
+
+        QStringList names;
+
+        for (auto *obj1 : objs)
+          names.push_back(obj1->getCommandName());
+
+        value = names;
+
+        return true;
+      }, nullptr },
+    { "meta",
+      [](Object *obj, const QStringList &, QVariant &value) {
+        value = obj->meta_; return true;
+      },
+      [](Object *obj, const QString &value, const QStringList &) {
+        obj->meta_ = value; return true;
+      } },
+  });
+
+  return table;
+}
+
 QVariant
 Object::
-getValue(const QString &name, const QStringList &)
+getValue(const QString &name, const QStringList &args)
 {
   auto *app = canvas()->app();
 
-  if      (name == "id")
-    return id();
-  else if (name == "visible")
-    return isVisible();
-  else if (name == "brush.color")
-    return Util::colorToString(brush_.value().color());
-  else if (name == "brush.color.target")
-    return Util::colorToString(brush_.target().color());
-  else if (name == "brush.alpha")
-    return Util::realToString(brush_.value().color().alphaF());
-  else if (name == "brush.steps")
-    return Util::colorToString(brush_.steps());
-  else if (name == "pen.color")
-    return Util::colorToString(pen_.color());
-  else if (name == "pen.width")
-    return Util::realToString(pen_.widthF());
-  else if (name == "group")
-    return (group() ? group()->calcId() : "");
-  else if (name.left(5) == "user.")
+  auto *property = properties().find(name);
+
+  if (property && property->get) {
+    QVariant value;
+
+    if (! property->get(this, args, value))
+      return QVariant();
+
+    return value;
+  }
+
+  if      (name.left(5) == "user.")
     return nameValue(name.mid(5));
   else if (name.left(8) == "animate.") {
     auto name1 = name.mid(8);
@@ -4679,9 +7064,6 @@ getValue(const QString &name, const QStringList &)
       return QVariant();
     }
   }
-  else if (name == "meta") {
-    return meta_;
-  }
   else {
     app->errorMsg(QString("Invalid get name '%1' for '%2'").arg(name).arg(getCommandName()));
     return QVariant();
@@ -4690,90 +7072,16 @@ getValue(const QString &name, const QStringList &)
 
 bool
 Object::
-setValue(const QString &name, const QString &value, const QStringList &)
+setValue(const QString &name, const QString &value, const QStringList &args)
 {
   auto *app = canvas()->app();
-  auto *tcl = app->tcl();
 
-  if      (name == "id")
-    setId(value);
-  else if (name == "visible")
-    setVisible(Util::stringToBool(value));
-  else if (name == "stroked")
-    setStroked(Util::stringToBool(value));
-  else if (name == "filled")
-    setFilled(Util::stringToBool(value));
-  else if (name == "brush.color") {
-    auto b = brush_.value();
+  auto *property = properties().find(name);
 
-    b.setColor(Util::stringToColor(tcl, value));
+  if (property && property->set)
+    return property->set(this, value, args);
 
-    brush_ = b;
-  }
-  else if (name == "brush.color.target") {
-    auto b = brush_.target();
-
-    b.setColor(Util::stringToColor(tcl, value));
-
-    brush_.setTarget(b);
-  }
-  else if (name == "brush.steps")
-    brush_.setSteps(Util::stringToInt(value));
-  else if (name == "brush.alpha") {
-    auto b = brush_.value();
-    auto c = b.color();
-
-    c.setAlphaF(Util::stringToReal(value));
-    b.setColor(c);
-
-    brush_ = b;
-  }
-  else if (name == "brush.linear_gradient") {
-    QStringList strs;
-    (void) tcl->splitList(value, strs);
-    if (strs.size() != 4) return false;
-
-    auto x1 = Util::stringToReal(strs[0]);
-    auto y1 = Util::stringToReal(strs[1]);
-    auto x2 = Util::stringToReal(strs[2]);
-    auto y2 = Util::stringToReal(strs[3]);
-
-    QLinearGradient lg(x1, y1, x2, y2);
-
-    QGradientStops stops;
-
-    stops.push_back(QGradientStop(0.0, Qt::red));
-    stops.push_back(QGradientStop(1.0, Qt::green));
-
-    lg.setStops(stops);
-
-    lg.setCoordinateMode(QGradient::ObjectMode);
-
-    brush_ = QBrush(lg);
-  }
-  else if (name == "pen.color")
-    pen_.setColor(Util::stringToColor(tcl, value));
-  else if (name == "pen.width")
-    pen_.setWidthF(Util::stringToReal(value));
-  else if (name == "pen.dash")
-    pen_.setDashPattern(stringToDashes(tcl, value));
-  else if (name == "group") {
-    auto *group = dynamic_cast<GroupObj *>(canvas()->getObjectByName(value));
-    if (! group) return app->errorMsg(QString("Failed to find group '%1'").arg(value));
-
-    if (group != group_) {
-      if (group_)
-        group_->removeObject(this);
-      else
-        canvas()->removeObject(this);
-
-      if (group)
-        group->addObject(this);
-      else
-        canvas()->addObject(this);
-    }
-  }
-  else if (name.left(5) == "user.") {
+  if      (name.left(5) == "user.") {
     setNameValue(name.mid(5), value);
   }
   else if (name.left(8) == "animate.") {
@@ -4785,9 +7093,6 @@ setValue(const QString &name, const QString &value, const QStringList &)
       return app->errorMsg(QString("Invalid set name '%1' for '%2'").
                arg(name).arg(getCommandName()));
   }
-  else if (name == "meta") {
-    meta_ = value;
-  }
   else
     return app->errorMsg(QString("Invalid set name '%1' for '%2'").
                arg(name).arg(getCommandName()));
@@ -4795,6 +7100,26 @@ setValue(const QString &name, const QString &value, const QStringList &)
   return true;
 }
 
+bool
+Object::
+getData(const QString &name, int, int, std::vector<float> &)
+{
+  auto *app = canvas()->app();
+
+  return app->errorMsg(QString("Invalid data name '%1' for '%2'").
+           arg(name).arg(getCommandName()));
+}
+
+bool
+Object::
+setData(const QString &name, const std::vector<float> &, int, int)
+{
+  auto *app = canvas()->app();
+
+  return app->errorMsg(QString("Invalid data name '%1' for '%2'").
+           arg(name).arg(getCommandName()));
+}
+
 bool
 Object::
 step()
@@ -4840,7 +7165,7 @@ makeParticle(double mass, double x, double y, double z)
 
   particle->setMass(mass);
 
-  particle->position()->set(x, y, z);
+  particle->setPosition(x, y, z);
 
   addParticle(particle);
 
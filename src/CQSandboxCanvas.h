@@ -1,6 +1,9 @@
 #ifndef CQSandbox_H
 #define CQSandbox_H
 
+#include <CQSandboxProperty.h>
+#include <CQSandboxTclCallback.h>
+
 #include <CTclUtil.h>
 //#include <CDisplayRange2D.h>
 #include <CWindowRange2D.h>
@@ -17,8 +20,12 @@
 #include <QPen>
 #include <QBrush>
 #include <QPainterPath>
+#include <QTransform>
+#include <QRegion>
+#include <QImage>
 
 #include <optional>
+#include <unordered_map>
 
 class CQArrow;
 class CQAxis;
@@ -30,6 +37,8 @@ namespace CQSandbox {
 
 class App;
 class Canvas;
+class Compositor;
+class ObjectIndex;
 class Particle;
 class Viewport;
 
@@ -363,11 +372,19 @@ class Object : public QObject {
 
   //---
 
+  // properties handled by getValue/setValue (derived classes extend)
+  static const PropertyTable<Object> &properties();
+
   virtual QVariant getValue(const QString &name,  const QStringList &args);
   virtual bool setValue(const QString &name, const QString &value, const QStringList &args);
 
   virtual bool exec(const QString &, const QStringList &, QVariant &) { return false; }
 
+  // bulk float data (e.g. all positions) for elements start, start + stride, ...
+  virtual bool getData(const QString &name, int start, int stride, std::vector<float> &values);
+  virtual bool setData(const QString &name, const std::vector<float> &values,
+                       int start, int stride);
+
   //---
 
   bool isStroked() const { return stroked_; }
@@ -403,6 +420,9 @@ class Object : public QObject {
 
   Rect getBBox() const { return calcRect(); }
 
+  // draw can be cached as image in retained mode (drawing is inside rect and costly)
+  virtual bool isRasterCached() const { return false; }
+
   //---
 
   virtual void draw(QPainter *) { }
@@ -460,6 +480,8 @@ class GroupObj : public Object {
 
   const char *typeName() const override { return "group"; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -469,6 +491,8 @@ class GroupObj : public Object {
 
   Rect calcRect() const override;
 
+  bool isRasterCached() const override { return true; }
+
   void draw(QPainter *) override;
 
   void addObject(Object *obj);
@@ -501,6 +525,8 @@ class RendererObj : public Object {
 
   const char *typeName() const override { return "renderer"; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -524,6 +550,8 @@ class CirclesGroupObj : public GroupObj {
 
   CirclesGroupObj(Canvas *canvas, const Rect &rect);
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -541,6 +569,8 @@ class QuadTreeObj : public GroupObj {
 
   QuadTreeObj(Canvas *canvas);
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -562,6 +592,8 @@ class RectObj : public Object {
 
   const char *typeName() const override { return "rect"; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -593,6 +625,8 @@ class CircleObj : public Object {
   void setRadius(const AnimateCoord &r) { radius_ = r; }
   void setTargetRadius(const Coord &r) { radius_.setTarget(r); }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -619,6 +653,8 @@ class LineObj : public Object {
 
   const char *typeName() const override { return "line"; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -658,11 +694,15 @@ class TextObj : public Object {
   const Qt::Alignment &align() const { return align_; }
   void setAlign(const Qt::Alignment &v) { align_ = v; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
   Rect calcRect() const override;
 
+  bool isRasterCached() const override { return true; }
+
   void draw(QPainter *) override;
 
  protected:
@@ -694,6 +734,8 @@ class ImageObj : public Object {
 
   const QImage &image() const { return image_; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -720,6 +762,8 @@ class PathObj : public Object {
 
   const char *typeName() const override { return "path"; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -771,17 +815,30 @@ class PointListObj : public Object {
   const Point &offset() const { return offset_; }
   void setOffset(const Point &o) { offset_ = o; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
+  bool getData(const QString &name, int start, int stride, std::vector<float> &values) override;
+  bool setData(const QString &name, const std::vector<float> &values,
+               int start, int stride) override;
+
   Rect calcRect() const override;
 
+  // rect of untransformed points
+  Rect calcPointsRect() const;
+
   QPainterPath calcPath() const override { return path_; }
 
   bool step() override;
 
   void draw(QPainter *) override;
 
+ protected:
+  // pixel transform for offset, angle and scale
+  QTransform calcTransform() const;
+
  protected:
   using Points = std::vector<Point>;
 
@@ -810,6 +867,8 @@ class ArrowObj : public Object {
 
   const char *typeName() const override { return "arrow"; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -836,6 +895,8 @@ class AxisObj : public Object {
 
   const char *typeName() const override { return "axis"; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -865,6 +926,8 @@ class ParticleObj : public Object {
   const Particle *particle() const { return particle_; }
   void setParticle(Particle *p);
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -889,6 +952,8 @@ class VectorObj : public Object {
 
   const char *typeName() const override { return "vector"; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -909,6 +974,8 @@ class ArrayObj : public Object {
 
   const char *typeName() const override { return "array"; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -928,6 +995,8 @@ class CsvObj : public Object {
 
   const char *typeName() const override { return "csv"; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -949,6 +1018,8 @@ class EditObj : public Object {
 
   const char *typeName() const override { return "edit"; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -967,6 +1038,8 @@ class RealEdit : public EditObj {
 
   RealEdit(Canvas *canvas, const Point &p, const QString &name);
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -992,6 +1065,8 @@ class IntegerEdit : public EditObj {
 
   IntegerEdit(Canvas *canvas, const Point &p, const QString &name);
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -1027,6 +1102,8 @@ class ButtonObj : public Object {
 
   const char *typeName() const override { return "button"; }
 
+  static const PropertyTable<Object> &properties();
+
   QVariant getValue(const QString &name, const QStringList &args) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -1127,6 +1204,8 @@ class Canvas : public QFrame {
 
   void drawStep();
 
+  void drawObject(Object *obj);
+
   void drawParticle(QPainter *, Particle *);
 
   void fadeImage(QImage &image1, QImage &image2, double f);
@@ -1151,6 +1230,14 @@ class Canvas : public QFrame {
   Object *getObjectAtPos(const QPoint &pos) const;
   Object *getObjectByName(const QString &name) const;
 
+  void getObjectsAtPos (const QPointF &pos, Objects &objs) const;
+  void getObjectsInRect(const QRectF &rect, Objects &objs) const;
+
+  // objects whose pixel rect touches object's pixel rect
+  void getObjectOverlaps(const Object *obj, Objects &objs) const;
+
+  const Objects &allObjects() const { return allObjects_; }
+
   void init();
 
   void addCommands();
@@ -1167,6 +1254,25 @@ class Canvas : public QFrame {
   void addObject(Object *obj);
   void removeObject(Object *obj);
 
+  void deleteObject(Object *obj);
+  void deleteObjects(const Objects &objs);
+
+  // notify object rect or id changed (updates object index)
+  void objectChanged(const Object *obj);
+  void objectIdChanged(Object *obj, const QString &oldId);
+
+  // all object pixel rects changed (resize, range change)
+  void invalidateObjects();
+
+  //---
+
+  // retained mode only redraws damaged regions
+  bool isRetained() const { return retained_; }
+  void setRetained(bool b);
+
+  // redraw changed objects (full update if not retained)
+  void requestRedraw();
+
   void createObjCommand(Object *obj);
 
   Point pointToWindow(const Point &p) const;
@@ -1174,6 +1280,9 @@ class Canvas : public QFrame {
   Rect rectToPixel(const Rect &rect) const;
   Point pointToPixel(const Point &p) const;
 
+  Rect rectToPixel(Viewport *viewport, const Rect &rect) const;
+  Point pointToPixel(Viewport *viewport, const Point &p) const;
+
   QSizeF pixelSizeToWindow(const QSizeF &psize) const;
 
   Viewport *currentViewport() const;
@@ -1212,12 +1321,18 @@ class Canvas : public QFrame {
 
   static int uiProc(void *, Tcl_Interp *interp, int objc, const Tcl_Obj **objv);
 
+  static const PropertyTable<Canvas> &properties();
+
   QVariant getValue(const QString &, const QStringList &);
   bool setValue(const QString &, const QString &, const QStringList &);
   bool exec(const QString &, const QStringList &, QVariant &);
 
   void updatePixelRanges();
 
+  bool takeRedrawRegion(QRegion &region, bool &full);
+
+  bool drawCachedObject(Object *obj);
+
  Q_SIGNALS:
   void objectsChanged();
 
@@ -1256,13 +1371,14 @@ class Canvas : public QFrame {
   bool      drawing_            { false };
   bool      drawBufferedNeeded_ { false };
 
-  bool   buffered_    { false };
-  bool   blend_       { false };
-  double blendFactor_ { 0.95 };
-  QImage bufferImage1_;
-  QImage bufferImage2_;
-  int    pixelWidth_  { 1 };
-  int    pixelHeight_ { 1 };
+  bool        buffered_    { false };
+  bool        blend_       { false };
+  double      blendFactor_ { 0.95 };
+  QImage      bufferImage1_;
+  QImage      bufferImage2_;
+  Compositor* compositor_  { nullptr };
+  int         pixelWidth_  { 1 };
+  int         pixelHeight_ { 1 };
 
   //--
 
@@ -1272,6 +1388,40 @@ class Canvas : public QFrame {
 
   Objects allObjects_;
 
+  ObjectIndex *objectIndex_ { nullptr };
+
+  //---
+
+  struct RasterData {
+    QImage image;
+    QPoint pos;
+    bool   drawn { false }; // drawn once since change
+    bool   valid { false }; // image valid (set on second unchanged draw)
+  };
+
+  using RasterCache = std::unordered_map<const Object *, RasterData>;
+
+  bool        retained_       { false };
+  bool        fullRedraw_     { true };  // next redraw must be full
+  bool        redrawPartial_  { false }; // current draw is limited to redrawRegion_
+  QRegion     redrawRegion_;
+  uint        redrawObjects_  { 0 };     // objects drawn by last draw
+  uint        redrawCached_   { 0 };     // objects drawn from raster cache by last draw
+  bool        redrawFull_     { false }; // last draw was full
+  RasterCache rasterCache_;
+
+  //---
+
+  // per frame script procs and time (ms) of last step/draw
+  TclCallback updateProc_ { "update" };
+  TclCallback drawBgProc_ { "drawBg" };
+  TclCallback drawFgProc_ { "drawFg" };
+
+  double stepTime_       { 0.0 };
+  double stepScriptTime_ { 0.0 };
+  double drawTime_       { 0.0 };
+  double drawScriptTime_ { 0.0 };
+
   //---
 
   using KeyPressed = std::map<QString, bool>;
@@ -27,9 +27,12 @@
 #include <CQSandboxTexture.h>
 #include <CQSandboxUtil.h>
 #include <CQSandboxShaderToyProgram.h>
+#include <CQSandboxAnimClipCache.h>
+#include <CQSandboxTextureCache.h>
 
 #include <CQGLUtil.h>
 #include <CQGLBuffer.h>
+#include <CQGLTexture.h>
 #include <CGeometry3D.h>
 
 #ifdef CQ_PERF_GRAPH
@@ -40,9 +43,14 @@ struct CQPerfTrace {
 };
 #endif
 
+#include <QElapsedTimer>
 #include <QMouseEvent>
 #include <QTimer>
 
+#include <algorithm>
+#include <chrono>
+#include <random>
+
 //---
 
 namespace CQSandbox {
@@ -222,6 +230,8 @@ Canvas3D(App *app) :
   CGeometry3DInst->setFactory(new GeomFactory(this));
 
   scene_ = CGeometry3DInst->createScene3D();
+
+  textureCache_ = new TextureCache(this);
 }
 
 void
@@ -521,6 +531,21 @@ canvasProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv)
         return TCL_ERROR;
     }
   }
+  else if (args[0] == "exec") {
+    if (args.size() >= 2) {
+      auto op = args[1];
+
+      QStringList args1;
+      for (int i = 2; i < args.length(); ++i)
+        args1.push_back(args[i]);
+
+      QVariant res;
+      if (! th->exec(op, args1, res))
+        return TCL_ERROR;
+
+      tcl->setResult(res);
+    }
+  }
   else if (args[0] == "delete") {
     if (args.size() >= 2) {
       if (args[1] == "all") {
@@ -717,173 +742,312 @@ customFormProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv)
   return TCL_OK;
 }
 
+const PropertyTable<Canvas3D> &
+Canvas3D::
+properties()
+{
+  using Table = PropertyTable<Canvas3D>;
+
+  static Table table({
+    { "bg",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = Util::colorToString(canvas->bgColor()); return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        canvas->setBgColor(Util::stringToColor(canvas->app()->tcl(), value)); return true;
+      } },
+    { "mode",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        if      (canvas->type_ == Type::CAMERA)
+          value = "camera";
+        else if (canvas->type_ == Type::LIGHT)
+          value = "light";
+        else if (canvas->type_ == Type::MODEL)
+          value = "model";
+        else if (canvas->type_ == Type::GAME)
+          value = "game";
+
+        return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        if      (value == "camera")
+          canvas->setType(Type::CAMERA);
+        else if (value == "light")
+          canvas->setType(Type::LIGHT);
+        else if (value == "model")
+          canvas->setType(Type::MODEL);
+        else if (value == "game")
+          canvas->setType(Type::GAME);
+
+        return true;
+      } },
+    { "loop.enabled",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->isLooping()); return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        canvas->setLooping(Util::stringToBool(value)); return true;
+      } },
+    { "loop.timeout",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->redrawTimeOut()); return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        canvas->setRedrawTimeOut(Util::stringToInt(value)); return true;
+      } },
+    { "xmap",
+      [](Canvas3D *canvas, const QStringList &args, QVariant &value) {
+        if (args.size() < 1)
+          return canvas->app()->errorMsg("Missing value for 'xmap'");
+
+        auto v = Util::stringToReal(args[0]);
+
+        value = QVariant(canvas->xrange_.map(v, -0.5, 0.5));
+
+        return true;
+      }, nullptr },
+    { "ymap",
+      [](Canvas3D *canvas, const QStringList &args, QVariant &value) {
+        if (args.size() < 1)
+          return canvas->app()->errorMsg("Missing value for 'ymap'");
+
+        auto v = Util::stringToReal(args[0]);
+
+        value = QVariant(canvas->yrange_.map(v, -0.5, 0.5));
+
+        return true;
+      }, nullptr },
+    { "zmap",
+      [](Canvas3D *canvas, const QStringList &args, QVariant &value) {
+        if (args.size() < 1)
+          return canvas->app()->errorMsg("Missing value for 'zmap'");
+
+        auto v = Util::stringToReal(args[0]);
+
+        value = QVariant(canvas->zrange_.map(v, -0.5, 0.5));
+
+        return true;
+      }, nullptr },
+    { "xrange", nullptr,
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        QStringList strs;
+        (void) canvas->app()->tcl()->splitList(value, strs);
+
+        if (strs.size() != 2)
+          return canvas->app()->errorMsg("Invalid values for range");
+
+        double xmin = Util::stringToReal(strs[0]);
+        double xmax = Util::stringToReal(strs[1]);
+
+        canvas->xrange_ = CRMinMax(xmin, xmax);
+
+        return true;
+      } },
+    { "yrange", nullptr,
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        QStringList strs;
+        (void) canvas->app()->tcl()->splitList(value, strs);
+
+        if (strs.size() != 2)
+          return canvas->app()->errorMsg("Invalid values for range");
+
+        double xmin = Util::stringToReal(strs[0]);
+        double xmax = Util::stringToReal(strs[1]);
+
+        canvas->yrange_ = CRMinMax(xmin, xmax);
+
+        return true;
+      } },
+    { "zrange", nullptr,
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        QStringList strs;
+        (void) canvas->app()->tcl()->splitList(value, strs);
+
+        if (strs.size() != 2)
+          return canvas->app()->errorMsg("Invalid values for range");
+
+        double xmin = Util::stringToReal(strs[0]);
+        double xmax = Util::stringToReal(strs[1]);
+
+        canvas->zrange_ = CRMinMax(xmin, xmax);
+
+        return true;
+      } },
+    { "lights.simple",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->isSimpleLights()); return true;
+      },
+      [](Canvas3D *canvas, const QString &, const QStringList &) {
+        canvas->setSimpleLights(true); return true;
+      } },
+    { "depth_test",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->isDepthTest()); return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        canvas->setDepthTest(Util::stringToBool(value)); return true;
+      } },
+    { "cull_face",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->isCullFace()); return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        canvas->setCullFace(Util::stringToBool(value)); return true;
+      } },
+    { "lighting",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->isLighting()); return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        canvas->setLighting(Util::stringToBool(value)); return true;
+      } },
+    { "front_face",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->isFrontFace()); return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        canvas->setFrontFace(Util::stringToBool(value)); return true;
+      } },
+    { "smooth_shade",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->isSmoothShade()); return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        canvas->setSmoothShade(Util::stringToBool(value)); return true;
+      } },
+    { "model_dir", nullptr,
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        canvas->modelDirs_.push_back(value); return true;
+      } },
+    { "instancing",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->isInstancing()); return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        canvas->setInstancing(Util::stringToBool(value));
+
+        canvas->update();
+
+        return true;
+      } },
+    { "render_sort",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->isRenderSort()); return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        canvas->setRenderSort(Util::stringToBool(value));
+
+        canvas->update();
+
+        return true;
+      } },
+    { "stats.draw_calls",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->numDrawCalls()); return true;
+      }, nullptr },
+    { "stats.program_switches",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->numProgramSwitches()); return true;
+      }, nullptr },
+    { "stats.buffer_binds",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->numBufferBinds()); return true;
+      }, nullptr },
+    { "stats.texture_binds",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->numTextureBinds()); return true;
+      }, nullptr },
+    { "stats.script_time",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->tickScriptTime()); return true;
+      }, nullptr },
+    { "stats.native_time",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->tickNativeTime()); return true;
+      }, nullptr },
+    { "stats.textures",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->textureCache_->numTextures()); return true;
+      }, nullptr },
+    { "stats.textures_pending",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->textureCache_->numPending()); return true;
+      }, nullptr },
+    { "stats.texture_memory",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(double(canvas->textureCache_->memoryUsed())/(1024.0*1024.0));
+
+        return true;
+      }, nullptr },
+    { "texture_cache.async",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->textureCache_->isAsync()); return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        canvas->textureCache_->setAsync(Util::stringToBool(value)); return true;
+      } },
+    { "texture_cache.budget",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(double(canvas->textureCache_->memoryBudget())/(1024.0*1024.0));
+
+        return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        // budget in MB
+        auto r = Util::stringToReal(value);
+        if (r < 0.0) return canvas->app()->errorMsg("Invalid texture cache budget");
+
+        canvas->textureCache_->setMemoryBudget(size_t(r*1024.0*1024.0));
+
+        canvas->update();
+
+        return true;
+      } },
+    { "anim.clip_cache",
+      [](Canvas3D *canvas, const QStringList &, QVariant &value) {
+        value = QVariant(canvas->isAnimClipCache()); return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        canvas->setAnimClipCache(Util::stringToBool(value)); return true;
+      } },
+    { "anim.sample_rate",
+      [](Canvas3D *, const QStringList &, QVariant &value) {
+        value = QVariant(AnimClipCache::instance()->sampleRate()); return true;
+      },
+      [](Canvas3D *canvas, const QString &value, const QStringList &) {
+        AnimClipCache::instance()->setSampleRate(Util::stringToReal(value));
+
+        canvas->invalidateNodeMatrices();
+
+        return true;
+      } },
+  });
+
+  return table;
+}
+
 bool
 Canvas3D::
 getValue(const QString &name, const QStringList &args, QVariant &value)
 {
-//auto *tcl = app_->tcl();
+  auto *property = properties().find(name);
 
-  if      (name == "bg")
-    value = Util::colorToString(bgColor());
-  else if (name == "mode") {
-    if      (type_ == Type::CAMERA)
-      value = "camera";
-    else if (type_ == Type::LIGHT)
-      value = "light";
-    else if (type_ == Type::MODEL)
-      value = "model";
-    else if (type_ == Type::GAME)
-      value = "game";
-  }
-  else if (name == "loop.enabled") {
-    value = QVariant(isLooping());
-  }
-  else if (name == "loop.timeout") {
-    value = QVariant(redrawTimeOut());
-  }
-  else if (name == "xmap") {
-    if (args.size() >= 1) {
-      auto x = Util::stringToReal(args[0]);
-
-      auto x1 = xrange_.map(x, -0.5, 0.5);
-
-      value = QVariant(x1);
-    }
-    else
-      return app_->errorMsg(QString("Missing value for '%1'").arg(name));
-  }
-  else if (name == "ymap") {
-    if (args.size() >= 1) {
-      auto y = Util::stringToReal(args[0]);
+  if (property && property->get)
+    return property->get(this, args, value);
 
-      auto y1 = yrange_.map(y, -0.5, 0.5);
-
-      value = QVariant(y1);
-    }
-    else
-      return app_->errorMsg(QString("Missing value for '%1'").arg(name));
-  }
-  else if (name == "zmap") {
-    if (args.size() >= 1) {
-      auto z = Util::stringToReal(args[0]);
-
-      auto z1 = zrange_.map(z, -0.5, 0.5);
-
-      value = QVariant(z1);
-    }
-    else
-      return app_->errorMsg(QString("Missing value for '%1'").arg(name));
-  }
-  else if (name == "lights.simple") {
-    value = QVariant(isSimpleLights());
-  }
-  else if (name == "depth_test") {
-    value = QVariant(isDepthTest());
-  }
-  else if (name == "cull_face") {
-    value = QVariant(isCullFace());
-  }
-  else if (name == "lighting") {
-    value = QVariant(isLighting());
-  }
-  else if (name == "front_face") {
-    value = QVariant(isFrontFace());
-  }
-  else if (name == "smooth_shade") {
-    value = QVariant(isSmoothShade());
-  }
-  else
-    return app_->errorMsg(QString("Invalid value name '%1'").arg(name));
-
-  return true;
+  return app_->errorMsg(QString("Invalid value name '%1'").arg(name));
 }
 
 bool
 Canvas3D::
-setValue(const QString &name, const QString &value, const QStringList &)
+setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  auto *tcl = app_->tcl();
-
-  if      (name == "bg") {
-    setBgColor(Util::stringToColor(tcl, value));
-  }
-  else if (name == "mode") {
-    if      (value == "camera")
-      setType(Type::CAMERA);
-    else if (value == "light")
-      setType(Type::LIGHT);
-    else if (value == "model")
-      setType(Type::MODEL);
-    else if (value == "game")
-      setType(Type::GAME);
-  }
-  else if (name == "loop.enabled") {
-    setLooping(Util::stringToBool(value));
-  }
-  else if (name == "loop.timeout") {
-    setRedrawTimeOut(Util::stringToInt(value));
-  }
-  else if (name == "xrange") {
-    QStringList strs;
-    (void) tcl->splitList(value, strs);
-
-    if (strs.size() != 2)
-      return app_->errorMsg("Invalid values for range");
-
-    double xmin = Util::stringToReal(strs[0]);
-    double xmax = Util::stringToReal(strs[1]);
-
-    xrange_ = CRMinMax(xmin, xmax);
-  }
-  else if (name == "yrange") {
-    QStringList strs;
-    (void) tcl->splitList(value, strs);
-
-    if (strs.size() != 2)
-      return app_->errorMsg("Invalid values for range");
+  auto *property = properties().find(name);
 
-    double xmin = Util::stringToReal(strs[0]);
-    double xmax = Util::stringToReal(strs[1]);
-
-    yrange_ = CRMinMax(xmin, xmax);
-  }
-  else if (name == "zrange") {
-    QStringList strs;
-    (void) tcl->splitList(value, strs);
-
-    if (strs.size() != 2)
-      return app_->errorMsg("Invalid values for range");
-
-    double xmin = Util::stringToReal(strs[0]);
-    double xmax = Util::stringToReal(strs[1]);
-
-    zrange_ = CRMinMax(xmin, xmax);
-  }
-  else if (name == "lights.simple") {
-    setSimpleLights(true);
-  }
-  else if (name == "depth_test") {
-    setDepthTest(Util::stringToBool(value));
-  }
-  else if (name == "cull_face") {
-    setCullFace(Util::stringToBool(value));
-  }
-  else if (name == "lighting") {
-    setLighting(Util::stringToBool(value));
-  }
-  else if (name == "front_face") {
-    setFrontFace(Util::stringToBool(value));
-  }
-  else if (name == "smooth_shade") {
-    setSmoothShade(Util::stringToBool(value));
-  }
-  else if (name == "model_dir") {
-    modelDirs_.push_back(value);
-  }
-  else
-    return app_->errorMsg(QString("Invalid value name '%1'").arg(name));
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return app_->errorMsg(QString("Invalid value name '%1'").arg(name));
 }
 
 bool
@@ -959,6 +1123,260 @@ setCameraValue(const QString &name, const QString &value, const QStringList &)
   return true;
 }
 
+bool
+Canvas3D::
+exec(const QString &op, const QStringList &args, QVariant &res)
+{
+  res = QVariant();
+
+  if (op == "benchmark.instancing") {
+    // args: [numObjects] [numFrames]
+    auto n         = (args.size() > 0 ? Util::stringToInt(args[0]) : 10000);
+    auto numFrames = (args.size() > 1 ? Util::stringToInt(args[1]) : 10);
+
+    if (n <= 0 || numFrames <= 0)
+      return app_->errorMsg("Invalid count for benchmark.instancing");
+
+    res = instancingBenchmark(n, numFrames);
+  }
+  else if (op == "benchmark.render_sort") {
+    // args: [numFrames]
+    auto numFrames = (args.size() > 0 ? Util::stringToInt(args[0]) : 10);
+
+    if (numFrames <= 0)
+      return app_->errorMsg("Invalid count for benchmark.render_sort");
+
+    res = renderSortBenchmark(numFrames);
+  }
+  else if (op == "benchmark.texture_load") {
+    // args: [size ...] (default 4096 8192)
+    std::vector<int> sizes;
+
+    for (const auto &arg : args) {
+      auto size = Util::stringToInt(arg);
+
+      if (size <= 0)
+        return app_->errorMsg("Invalid size for benchmark.texture_load");
+
+      sizes.push_back(size);
+    }
+
+    if (sizes.empty())
+      sizes = { 4096, 8192 };
+
+    res = textureLoadBenchmark(sizes);
+  }
+  else if (op == "texture_cache.wait") {
+    // wait for pending texture images to be loaded
+    makeCurrent();
+
+    textureCache_->waitForDone();
+
+    doneCurrent();
+  }
+  else
+    return app_->errorMsg(QString("Invalid exec op '%1'").arg(op));
+
+  return true;
+}
+
+QString
+Canvas3D::
+instancingBenchmark(int n, int numFrames)
+{
+  // render grid of n cubes (random colors) with and without instancing and report
+  // draw calls and frame time (glFinish after each frame). Cubes are temporary.
+  makeCurrent();
+
+  Objects cubes;
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> rand01(0.0, 1.0);
+
+  auto nx = std::max(int(std::ceil(std::sqrt(double(n)))), 1);
+
+  for (int i = 0; i < n; ++i) {
+    auto *cube = new Cube3DObj(this);
+
+    addObject(cube);
+
+    cube->init();
+
+    auto x = CMathUtil::map(i % nx, 0, nx, -1.0, 1.0);
+    auto z = CMathUtil::map(i / nx, 0, nx, -1.0, 1.0);
+
+    cube->setPosition(CPoint3D(x, 0.0, z));
+    cube->setScales(0.5/nx, 0.5/nx, 0.5/nx);
+
+    cube->setColor(CGLColor(rand01(rng), rand01(rng), rand01(rng)));
+
+    cubes.push_back(cube);
+  }
+
+  using Clock = std::chrono::steady_clock;
+
+  auto saveInstancing = isInstancing();
+
+  auto frameTime = [&](bool instancing, int &drawCalls) {
+    setInstancing(instancing);
+
+    // first frame builds buffers
+    paintGL();
+
+    glFinish();
+
+    auto t1 = Clock::now();
+
+    for (int i = 0; i < numFrames; ++i) {
+      paintGL();
+
+      glFinish();
+    }
+
+    auto t2 = Clock::now();
+
+    drawCalls = numDrawCalls();
+
+    return std::chrono::duration<double, std::milli>(t2 - t1).count()/numFrames;
+  };
+
+  int drawCalls1 = 0, drawCalls2 = 0;
+
+  auto t1 = frameTime(false, drawCalls1);
+  auto t2 = frameTime(true , drawCalls2);
+
+  setInstancing(saveInstancing);
+
+  for (auto *cube : cubes) {
+    removeObject(cube);
+
+    delete cube;
+  }
+
+  doneCurrent();
+
+  update();
+
+  return QString("%1 cubes: no instancing %2 draw calls %3ms/frame, "
+                 "instancing %4 draw calls %5ms/frame (%6x)").
+           arg(n).arg(drawCalls1).arg(t1).arg(drawCalls2).arg(t2).
+           arg(t2 > 0.0 ? t1/t2 : 0.0);
+}
+
+QString
+Canvas3D::
+renderSortBenchmark(int numFrames)
+{
+  // render current scene in add order and in render state order and report state
+  // changes and frame time (glFinish after each frame)
+  makeCurrent();
+
+  using Clock = std::chrono::steady_clock;
+
+  auto saveRenderSort = isRenderSort();
+
+  struct FrameStats {
+    double time            { 0.0 };
+    int    programSwitches { 0 };
+    int    bufferBinds     { 0 };
+    int    textureBinds    { 0 };
+    int    drawCalls       { 0 };
+  };
+
+  auto frameStats = [&](bool renderSort) {
+    setRenderSort(renderSort);
+
+    paintGL();
+
+    glFinish();
+
+    auto t1 = Clock::now();
+
+    for (int i = 0; i < numFrames; ++i) {
+      paintGL();
+
+      glFinish();
+    }
+
+    auto t2 = Clock::now();
+
+    FrameStats stats;
+
+    stats.time            = std::chrono::duration<double, std::milli>(t2 - t1).count()/numFrames;
+    stats.programSwitches = numProgramSwitches();
+    stats.bufferBinds     = numBufferBinds();
+    stats.textureBinds    = numTextureBinds();
+    stats.drawCalls       = numDrawCalls();
+
+    return stats;
+  };
+
+  auto statsStr = [](const FrameStats &stats) {
+    return QString("%1 programs %2 buffers %3 textures %4 draws %5ms/frame").
+             arg(stats.programSwitches).arg(stats.bufferBinds).arg(stats.textureBinds).
+             arg(stats.drawCalls).arg(stats.time);
+  };
+
+  auto stats1 = frameStats(false);
+  auto stats2 = frameStats(true);
+
+  setRenderSort(saveRenderSort);
+
+  doneCurrent();
+
+  update();
+
+  return QString("unsorted: %1, sorted: %2").arg(statsStr(stats1)).arg(statsStr(stats2));
+}
+
+QString
+Canvas3D::
+textureLoadBenchmark(const std::vector<int> &sizes)
+{
+  // time CQGLTexture load (conversion, upload and mipmaps, glFinish after each) of
+  // generated square images unflipped and flipped
+  makeCurrent();
+
+  using Clock = std::chrono::steady_clock;
+
+  auto loadTime = [&](const QImage &image, bool flip) {
+    CQGLTexture texture;
+
+    auto t1 = Clock::now();
+
+    (void) texture.load(image, flip);
+
+    glFinish();
+
+    auto t2 = Clock::now();
+
+    return std::chrono::duration<double, std::milli>(t2 - t1).count();
+  };
+
+  QStringList strs;
+
+  for (auto size : sizes) {
+    // file decoded images are ARGB32 (converted to upload format in load)
+    QImage image(size, size, QImage::Format_ARGB32);
+
+    for (int y = 0; y < size; ++y) {
+      auto *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+
+      for (int x = 0; x < size; ++x)
+        line[x] = qRgba(x & 0xff, y & 0xff, (x ^ y) & 0xff, 255);
+    }
+
+    auto t1 = loadTime(image, /*flip*/false);
+    auto t2 = loadTime(image, /*flip*/true);
+
+    strs.push_back(QString("%1x%1: %2ms (flipped %3ms)").arg(size).arg(t1).arg(t2));
+  }
+
+  doneCurrent();
+
+  return strs.join(", ");
+}
+
 bool
 Canvas3D::
 execCamera(const QString &op, const QStringList &, QVariant &res)
@@ -1089,7 +1507,7 @@ execLight(const QString &op, const QStringList &, QVariant &)
 
 int
 Canvas3D::
-objectCommandProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv)
+objectCommandProc(void *clientData, Tcl_Interp *interp, int objc, const Tcl_Obj **objv)
 {
   auto *obj = static_cast<Object3D *>(clientData);
   assert(obj);
@@ -1099,43 +1517,69 @@ objectCommandProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv
 
   auto *tcl = app->tcl();
 
-  auto args = app->getArgs(objc, objv);
+  // bulk data values are converted directly from/to Tcl objects
+  if (objc > 1) {
+    std::string op = Tcl_GetString(const_cast<Tcl_Obj *>(objv[1]));
 
-  if      (args[0] == "get") {
-    if (args.size() > 1) {
-      auto name = args[1];
+    if      (op == "get_data") {
+      App::DataArgs dataArgs;
+      if (! app->getDataArgs(interp, objc, objv, /*hasValues*/false, dataArgs))
+        return TCL_ERROR;
 
-      QStringList args1;
-      for (int i = 2; i < args.length(); ++i)
-        args1.push_back(args[i]);
+      std::vector<float> values;
+      if (! obj->getData(dataArgs.name, dataArgs.start, dataArgs.stride, values))
+        return TCL_ERROR;
+
+      app->setDataResult(interp, values, dataArgs.binary);
+
+      return TCL_OK;
+    }
+    else if (op == "set_data") {
+      App::DataArgs dataArgs;
+      if (! app->getDataArgs(interp, objc, objv, /*hasValues*/true, dataArgs))
+        return TCL_ERROR;
+
+      if (! obj->setData(dataArgs.name, dataArgs.values, dataArgs.start, dataArgs.stride))
+        return TCL_ERROR;
+
+      return TCL_OK;
+    }
+    // property name is not converted to a string (interned property id is cached in
+    // Tcl object) and only the args after it are converted
+    else if (op == "get" && objc > 2) {
+      auto name  = app->getPropertyName(objv[2]);
+      auto args1 = app->getArgs(objc - 2, objv + 2);
 
       QVariant res;
       if (! obj->getValue(name, args1, res))
         return TCL_ERROR;
 
       tcl->setResult(res);
+
+      return TCL_OK;
     }
-    else {
-      (void) app->errorMsg("Missing args for get");
-      return TCL_ERROR;
+    else if (op == "set" && objc > 3) {
+      auto name  = app->getPropertyName(objv[2]);
+      auto args1 = app->getArgs(objc - 2, objv + 2);
+      auto value = args1.takeFirst();
+
+      if (! obj->setValue(name, value, args1))
+        return TCL_ERROR;
+
+      return TCL_OK;
     }
   }
-  else if (args[0] == "set") {
-    if (args.size() > 2) {
-      auto name  = args[1];
-      auto value = args[2];
 
-      QStringList args1;
-      for (int i = 3; i < args.length(); ++i)
-        args1.push_back(args[i]);
+  auto args = app->getArgs(objc, objv);
 
-      if (! obj->setValue(args[1], args[2], args1))
-        return TCL_ERROR;
-    }
-    else {
-      (void) app->errorMsg("Missing args for set");
-      return TCL_ERROR;
-    }
+  // get/set with name (and value) handled above
+  if      (args[0] == "get") {
+    (void) app->errorMsg("Missing args for get");
+    return TCL_ERROR;
+  }
+  else if (args[0] == "set") {
+    (void) app->errorMsg("Missing args for set");
+    return TCL_ERROR;
   }
   else if (args[0] == "exec") {
     if (args.size() > 1) {
@@ -1488,6 +1932,14 @@ void
 Canvas3D::
 timerSlot()
 {
+  QElapsedTimer timer;
+
+  timer.start();
+
+  auto scriptTime = app_->scriptTime();
+
+  //---
+
   for (auto *animObject : getAnimObjects())
     animObject->stepAnimTime();
 
@@ -1500,7 +1952,10 @@ timerSlot()
   for (auto *obj : objects)
     obj->tick();
 
-  app_->runTclCmd("update");
+  app_->runTclCallback(updateProc_);
+
+  tickTime_       = timer.nsecsElapsed()/1e6;
+  tickScriptTime_ = app_->scriptTime() - scriptTime;
 
   //---
 
@@ -1545,6 +2000,11 @@ render()
 
   //---
 
+  // upload decoded textures
+  textureCache_->update();
+
+  //---
+
   if (! objectsValid_) {
     objectsValid_ = true;
 
@@ -1564,8 +2024,7 @@ render()
 
   glPopAttrib();
 
-  currentBuffer_  = nullptr;
-  currentProgram_ = nullptr;
+  resetBindState();
 
   //---
 
@@ -1605,8 +2064,15 @@ render()
 
   bbox_ = CBBox3D();
 
+  numDrawCalls_       = 0;
+  numProgramSwitches_ = 0;
+  numBufferBinds_     = 0;
+  numTextureBinds_    = 0;
+
   glPushAttrib(GL_ALL_ATTRIB_BITS);
 
+  Objects renderObjs;
+
   for (auto *obj : objects_) {
     if (! obj || ! obj->isVisible())
       continue;
@@ -1614,10 +2080,13 @@ render()
     if (obj->group())
       continue;
 
-    obj->render();
+    renderObjs.push_back(obj);
+  }
+
+  renderObjects(renderObjs);
 
+  for (auto *obj : renderObjs)
     bbox_ += obj->bbox();
-  }
 
   glPopAttrib();
 
@@ -1636,6 +2105,109 @@ render()
   bindProgram(nullptr);
 }
 
+void
+Canvas3D::
+renderObjects(const Objects &objects)
+{
+  // render queue item (single object or batch of instanced objects)
+  struct RenderItem {
+    Objects               objects;
+    Object3D::RenderState state;
+    double                depth { 0.0 };
+  };
+
+  using RenderItems = std::vector<RenderItem>;
+
+  RenderItems items;
+
+  // objects with the same instance key are drawn in one instanced draw by the first
+  // object of the batch (single objects use normal render)
+  std::map<size_t, size_t> batchItem;
+
+  for (auto *obj : objects) {
+    if (! obj || ! obj->isVisible())
+      continue;
+
+    auto key = (isInstancing() ? obj->instanceKey() : 0);
+
+    if (key) {
+      auto pb = batchItem.find(key);
+
+      if (pb != batchItem.end()) {
+        items[(*pb).second].objects.push_back(obj);
+        continue;
+      }
+
+      batchItem[key] = items.size();
+    }
+
+    RenderItem item;
+
+    item.objects.push_back(obj);
+
+    item.state = obj->renderState();
+
+    const auto &bbox = obj->bbox();
+
+    if (bbox.isSet()) {
+      auto c = bbox.getCenter();
+
+      item.depth = (CVector3D(c.x, c.y, c.z) - viewPos_).length();
+    }
+
+    items.push_back(std::move(item));
+  }
+
+  //---
+
+  // untracked objects first (in add order), then opaque objects grouped by program,
+  // texture and buffer (front to back), then transparent objects back to front
+  if (isRenderSort()) {
+    auto itemCmp = [](const RenderItem &item1, const RenderItem &item2) {
+      const auto &state1 = item1.state;
+      const auto &state2 = item2.state;
+
+      bool tracked1 = !!state1.program;
+      bool tracked2 = !!state2.program;
+
+      if (tracked1 != tracked2) return tracked2;
+      if (! tracked1) return false;
+
+      if (state1.transparent != state2.transparent) return state2.transparent;
+
+      if (state1.transparent)
+        return (item1.depth > item2.depth);
+
+      std::less<const void *> ptrLess;
+
+      if (state1.program != state2.program) return ptrLess(state1.program, state2.program);
+      if (state1.texture != state2.texture) return ptrLess(state1.texture, state2.texture);
+      if (state1.buffer  != state2.buffer ) return ptrLess(state1.buffer , state2.buffer );
+
+      return (item1.depth < item2.depth);
+    };
+
+    std::stable_sort(items.begin(), items.end(), itemCmp);
+  }
+
+  //---
+
+  for (const auto &item : items) {
+    const auto &objs = item.objects;
+
+    if (objs.size() > 1)
+      objs[0]->renderInstances(objs);
+    else
+      objs[0]->render();
+
+    ++numDrawCalls_;
+
+    // untracked objects may change bound state behind our back
+    if (! item.state.program)
+      resetBindState();
+  }
+}
+
 //---
 
 void
@@ -1701,11 +2273,15 @@ bindBuffer(CQGLBuffer *buffer)
       buffer->bind();
 
       currentBuffer_ = buffer;
+
+      ++numBufferBinds_;
     }
   }
   else {
     if (currentBuffer_)
       currentBuffer_->unbind();
+
+    currentBuffer_ = nullptr;
   }
 }
 
@@ -1721,14 +2297,57 @@ bindProgram(ShaderProgram *program)
       program->bind();
 
       currentProgram_ = program;
+
+      ++numProgramSwitches_;
     }
   }
   else {
     if (currentProgram_)
       currentProgram_->release();
+
+    currentProgram_ = nullptr;
   }
 }
 
+void
+Canvas3D::
+bindTexture(CQGLTexture *texture, int unit)
+{
+  // skip rebind of texture already bound to unit
+  if (unit < 0 || unit >= NUM_TEXTURE_UNITS) {
+    glActiveTexture(GLenum(GL_TEXTURE0 + unit));
+
+    texture->bind();
+
+    ++numTextureBinds_;
+
+    return;
+  }
+
+  if (texture == currentTextures_[unit])
+    return;
+
+  glActiveTexture(GLenum(GL_TEXTURE0 + unit));
+
+  texture->bind();
+
+  currentTextures_[unit] = texture;
+
+  ++numTextureBinds_;
+}
+
+void
+Canvas3D::
+resetBindState()
+{
+  // forget bound state (after state changed outside bind methods)
+  currentBuffer_  = nullptr;
+  currentProgram_ = nullptr;
+
+  for (int i = 0; i < NUM_TEXTURE_UNITS; ++i)
+    currentTextures_[i] = nullptr;
+}
+
 void
 Canvas3D::
 updateNodeMatrices(CGeomObject3D *object)
@@ -1800,7 +2419,7 @@ getNodeMatrices() const
   auto *th = const_cast<Canvas3D *>(this);
 
   if (! th->objectNodeMatricesValid_) {
-    th->objectNodeMatrices_ = calcNodeMatrices();
+    th->updateObjectNodeMatrices();
 
     th->objectNodeMatricesValid_ = true;
   }
@@ -1808,6 +2427,110 @@ getNodeMatrices() const
   return objectNodeMatrices_;
 }
 
+void
+Canvas3D::
+updateObjectNodeMatrices()
+{
+  // set bone palette from node matrices (palette allocations are reused across ticks)
+  auto updatePalette = [&](uint ind, const NodeMatrices &nodeMatrices) {
+    auto &palette = objectPalettes_[ind];
+
+    auto numNodes = (! nodeMatrices.empty() ? nodeMatrices.rbegin()->first + 1 : 0);
+
+    palette.resize(numNodes);
+
+    for (const auto &pn : nodeMatrices)
+      palette.setNodeMatrix(pn.first, pn.second.getData());
+  };
+
+  if (! animClipCache_) {
+    objectNodeMatrices_ = calcNodeMatrices();
+
+    for (const auto &po : objectNodeMatrices_)
+      updatePalette(po.first, po.second);
+
+    return;
+  }
+
+  //---
+
+  // interpolate pre-sampled clips (lerp per node), node matrix maps are updated in place
+  auto *clipCache = AnimClipCache::instance();
+
+  std::set<uint> inds;
+
+  for (auto *animObject : getAnimObjects()) {
+    if (! animObject->getVisible())
+      continue;
+
+    auto animName = animObject->animName();
+    if (animName == "") continue;
+
+    auto ind = animObject->getInd();
+
+    inds.insert(ind);
+
+    auto &nodeMatrices = objectNodeMatrices_[ind];
+
+    const auto *clip = clipCache->getClip(animClipKey(animObject), animObject, animName);
+
+    if (! clip) {
+      nodeMatrices.clear();
+
+      calcObjectNodeMatrices(animObject, nodeMatrices);
+
+      updatePalette(ind, nodeMatrices);
+
+      continue;
+    }
+
+    const auto &nodeIds = clip->nodeIds;
+
+    if (nodeMatrices.size() != nodeIds.size())
+      nodeMatrices.clear();
+
+    clipMatrices_.resize(nodeIds.size()*AnimClipCache::MATRIX_SIZE);
+
+    clip->interp(animObject->animTime(), clipMatrices_.data());
+
+    auto &palette = objectPalettes_[ind];
+
+    palette.resize(! nodeIds.empty() ? nodeIds.back() + 1 : 0);
+
+    const auto *m = clipMatrices_.data();
+
+    for (auto nodeId : nodeIds) {
+      palette.setNodeMatrix(nodeId, m);
+
+      nodeMatrices[nodeId] = CMatrix3D(m[0], m[1], m[ 2], m[ 3],
+                                       m[4], m[5], m[ 6], m[ 7],
+                                       m[8], m[9], m[10], m[11]);
+
+      m += AnimClipCache::MATRIX_SIZE;
+    }
+  }
+
+  // remove objects no longer animated
+  for (auto po = objectNodeMatrices_.begin(); po != objectNodeMatrices_.end(); ) {
+    if (inds.find(po->first) == inds.end())
+      po = objectNodeMatrices_.erase(po);
+    else
+      ++po;
+  }
+}
+
+const CSkinning3D::Palette &
+Canvas3D::
+getObjectPalette(CGeomObject3D *object) const
+{
+  (void) getNodeMatrices();
+
+  auto po = objectPalettes_.find(object->getInd());
+  assert(po != objectPalettes_.end());
+
+  return (*po).second;
+}
+
 Canvas3D::ObjectNodeMatrices
 Canvas3D::
 calcNodeMatrices() const
@@ -1823,29 +2546,57 @@ calcNodeMatrices() const
     auto animName = animObject->animName();
     if (animName == "") continue;
 
-    auto animTime = animObject->animTime();
-
     auto &nodeMatrices = objectNodeMatrices[animObject->getInd()];
 
-    animObject->updateNodesAnimationData(animName, animTime);
+    calcObjectNodeMatrices(animObject, nodeMatrices);
+  }
 
-    auto meshMatrix        = animObject->getMeshGlobalTransform();
-    auto inverseMeshMatrix = meshMatrix.inverse();
+  return objectNodeMatrices;
+}
 
-    //---
+void
+Canvas3D::
+calcObjectNodeMatrices(CGeomObject3D *animObject, NodeMatrices &nodeMatrices) const
+{
+  auto animName = animObject->animName();
+  auto animTime = animObject->animTime();
 
-    for (const auto &pn : animObject->getNodes()) {
-      auto &node = const_cast<CGeomNodeData &>(pn.second);
-      //if (! node.isJoint()) continue;
+  animObject->updateNodesAnimationData(animName, animTime);
 
-      if (node.index() < 0)
-        continue;
+  auto meshMatrix        = animObject->getMeshGlobalTransform();
+  auto inverseMeshMatrix = meshMatrix.inverse();
 
-      nodeMatrices[node.index()] = node.calcNodeAnimMatrix(inverseMeshMatrix);
-    }
+  //---
+
+  for (const auto &pn : animObject->getNodes()) {
+    auto &node = const_cast<CGeomNodeData &>(pn.second);
+    //if (! node.isJoint()) continue;
+
+    if (node.index() < 0)
+      continue;
+
+    nodeMatrices[node.index()] = node.calcNodeAnimMatrix(inverseMeshMatrix);
   }
+}
 
-  return objectNodeMatrices;
+void
+Canvas3D::
+setAnimClipKey(CGeomObject3D *object, const std::string &key)
+{
+  animClipKeys_[object->getInd()] = key;
+}
+
+std::string
+Canvas3D::
+animClipKey(CGeomObject3D *object) const
+{
+  auto pk = animClipKeys_.find(object->getInd());
+
+  if (pk != animClipKeys_.end())
+    return (*pk).second;
+
+  // object ids are never reused so unkeyed objects get their own clips
+  return "object." + std::to_string(object->getInd());
 }
 
 QMatrix4x4 *
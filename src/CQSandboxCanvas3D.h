@@ -2,7 +2,9 @@
 #define CQSandboxCanvas3D_H
 
 #include <CQSandboxObject3D.h>
+#include <CQSandboxTclCallback.h>
 
+#include <CSkinning3D.h>
 #include <CTclUtil.h>
 #include <CGLMatrix3D.h>
 #include <CGLPath3D.h>
@@ -22,6 +24,7 @@ class CGeomObject3D;
 class CGeomFace3D;
 class CGeomVertex3D;
 class CQGLBuffer;
+class CQGLTexture;
 
 class QTimer;
 
@@ -37,6 +40,7 @@ class Light3D;
 class Path3DObj;
 class ParticleList3DObj;
 class Camera;
+class TextureCache;
 
 //---
 
@@ -131,6 +135,7 @@ class Canvas3D : public OpenGLWindow {
 
   using NodeMatrices       = std::map<int, CMatrix3D>;
   using ObjectNodeMatrices = std::map<uint, NodeMatrices>;
+  using ObjectPalettes     = std::map<uint, CSkinning3D::Palette>;
 
   using FrameMatrix = std::map<int, CMatrix3DH>;
 
@@ -207,6 +212,30 @@ class Canvas3D : public OpenGLWindow {
   bool isAnimEnabled() const { return animEnabled_; }
   void setAnimEnabled(bool b) { animEnabled_ = b; }
 
+  // batch objects with same instance key into instanced draws
+  bool isInstancing() const { return instancing_; }
+  void setInstancing(bool b) { instancing_ = b; }
+
+  // sort render queue by render state (opaque by program/texture/buffer, then
+  // transparent back to front)
+  bool isRenderSort() const { return renderSort_; }
+  void setRenderSort(bool b) { renderSort_ = b; }
+
+  // shared image file textures
+  TextureCache *textureCache() const { return textureCache_; }
+
+  // object draw calls in last render
+  int numDrawCalls() const { return numDrawCalls_; }
+
+  // state changes in last render
+  int numProgramSwitches() const { return numProgramSwitches_; }
+  int numBufferBinds    () const { return numBufferBinds_; }
+  int numTextureBinds   () const { return numTextureBinds_; }
+
+  // time (ms) in script procs and native code of last update tick
+  double tickScriptTime() const { return tickScriptTime_; }
+  double tickNativeTime() const { return tickTime_ - tickScriptTime_; }
+
   //---
 
   CGeomScene3D *scene() const { return scene_; }
@@ -309,8 +338,13 @@ class Canvas3D : public OpenGLWindow {
 
   void render() override;
 
+  void renderObjects(const Objects &objects);
+
   void bindBuffer (CQGLBuffer *buffer);
   void bindProgram(ShaderProgram *program);
+  void bindTexture(CQGLTexture *texture, int unit=0);
+
+  void resetBindState();
 
   //---
 
@@ -368,13 +402,28 @@ class Canvas3D : public OpenGLWindow {
 
   const ObjectNodeMatrices &getNodeMatrices() const;
 
+  // calc node matrices of visible anim objects from keyframes (no clip cache)
   ObjectNodeMatrices calcNodeMatrices() const;
 
+  void calcObjectNodeMatrices(CGeomObject3D *animObject, NodeMatrices &nodeMatrices) const;
+
+  // use pre-sampled animation clips for node matrices
+  bool isAnimClipCache() const { return animClipCache_; }
+  void setAnimClipCache(bool b) { animClipCache_ = b; invalidateNodeMatrices(); }
+
+  // model source key of object for shared animation clips (default is per object)
+  void setAnimClipKey(CGeomObject3D *object, const std::string &key);
+  std::string animClipKey(CGeomObject3D *object) const;
+
+  // flat bone palette of object node matrices (for CPU skinning)
+  const CSkinning3D::Palette &getObjectPalette(CGeomObject3D *object) const;
+
   void invalidateNodeMatrices() { objectNodeMatricesValid_ = false; }
 
   QMatrix4x4 *nodeQMatrices() const;
   int numNodeQMatrices() const { return NUM_NODE_MATRICES; }
 
+  // per vertex skinning (reference for CSkinning3D)
   CPoint3D adjustAnimPoint(const CGeomVertex3D &vertex, const CPoint3D &p,
                            const NodeMatrices &nodeMatrices) const;
 
@@ -385,6 +434,8 @@ class Canvas3D : public OpenGLWindow {
   std::vector<CGeomObject3D *> getAnimObjects() const;
 
  private:
+  void updateObjectNodeMatrices();
+
   static int objectCommandProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv);
 
   static int canvasProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv);
@@ -397,11 +448,19 @@ class Canvas3D : public OpenGLWindow {
   static int loadModelProc(void *clientData, Tcl_Interp *, int objc, const Tcl_Obj **objv);
 #endif
 
+  static const PropertyTable<Canvas3D> &properties();
+
   bool getValue(const QString &name, const QStringList &args, QVariant &value);
   bool setValue(const QString &name, const QString &value, const QStringList &args);
 
   bool getCameraValue(const QString &name, const QStringList &args, QVariant &value);
   bool setCameraValue(const QString &name, const QString &value, const QStringList &args);
+  bool exec(const QString &op, const QStringList &args, QVariant &res);
+
+  QString instancingBenchmark(int n, int numFrames);
+  QString renderSortBenchmark(int numFrames);
+  QString textureLoadBenchmark(const std::vector<int> &sizes);
+
   bool execCamera(const QString &op, const QStringList &args, QVariant &res);
 
   bool getLightValue(const QString &name, const QStringList &args, QVariant &value);
@@ -482,6 +541,20 @@ class Canvas3D : public OpenGLWindow {
   bool showBBox_       { false };
   bool eyeLineVisible_ { false };
   bool animEnabled_    { true };
+  bool instancing_     { true };
+  bool renderSort_     { true };
+
+  int numDrawCalls_       { 0 };
+  int numProgramSwitches_ { 0 };
+  int numBufferBinds_     { 0 };
+  int numTextureBinds_    { 0 };
+
+  TextureCache* textureCache_ { nullptr };
+
+  TclCallback updateProc_ { "update" };
+
+  double tickTime_       { 0.0 };
+  double tickScriptTime_ { 0.0 };
 
   Type type_ { Type::CAMERA };
 
@@ -508,6 +581,10 @@ class Canvas3D : public OpenGLWindow {
   CQGLBuffer*    currentBuffer_  { nullptr };
   ShaderProgram* currentProgram_ { nullptr };
 
+  static constexpr int NUM_TEXTURE_UNITS = 4;
+
+  CQGLTexture* currentTextures_[NUM_TEXTURE_UNITS] { };
+
   //---
 
   CGeomScene3D* scene_ { nullptr };
@@ -548,6 +625,13 @@ class Canvas3D : public OpenGLWindow {
 
   ObjectNodeMatrices objectNodeMatrices_;
   bool               objectNodeMatricesValid_ { false };
+  ObjectPalettes     objectPalettes_;
+
+  using AnimClipKeys = std::map<uint, std::string>;
+
+  bool               animClipCache_ { true };
+  AnimClipKeys       animClipKeys_;
+  std::vector<float> clipMatrices_;
 
   //---
 
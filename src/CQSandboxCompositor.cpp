@@ -0,0 +1,228 @@
+#include <CQSandboxCompositor.h>
+#include <CThreadPool.h>
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace CQSandbox {
+
+Compositor::
+Compositor()
+{
+  pool_ = new CThreadPool;
+}
+
+Compositor::
+~Compositor()
+{
+  delete pool_;
+}
+
+size_t
+Compositor::
+numThreads() const
+{
+  return pool_->numThreads();
+}
+
+void
+Compositor::
+setNumThreads(size_t n)
+{
+  pool_->setNumThreads(n);
+}
+
+void
+Compositor::
+fadeImage(QImage &image1, const QImage &image2, double f)
+{
+  QElapsedTimer timer;
+  timer.start();
+
+  if (image1.format() != QImage::Format_ARGB32 || image2.format() != QImage::Format_ARGB32) {
+    fadeImageRef(image1, image2, f);
+
+    lastTime_ = timer.nsecsElapsed()/1e6;
+
+    return;
+  }
+
+  int w = std::min(image1.width (), image2.width ());
+  int h = std::min(image1.height(), image2.height());
+
+  // fade factor as 8.8 fixed point
+  auto f1 = uint32_t(std::round(std::min(std::max(f, 0.0), 1.0)*256.0));
+
+  // detach before splitting rows so workers don't race on copy on write
+  (void) image1.bits();
+
+  auto *bits1 = image1.bits();
+  auto *bits2 = image2.constBits();
+
+  auto bpl1 = image1.bytesPerLine();
+  auto bpl2 = image2.bytesPerLine();
+
+  bool simd = simd_;
+
+  pool_->parallelFor(size_t(h), [&](size_t, size_t y1, size_t y2) {
+    for (auto y = y1; y < y2; ++y) {
+      auto *row1 = reinterpret_cast<uint32_t *>(bits1 + y*bpl1);
+      auto *row2 = reinterpret_cast<const uint32_t *>(bits2 + y*bpl2);
+
+      if (simd)
+        fadeRowSimd(row1, row2, w, f1);
+      else
+        fadeRow(row1, row2, w, f1);
+    }
+  }, /*minChunk*/32);
+
+  lastTime_ = timer.nsecsElapsed()/1e6;
+}
+
+void
+Compositor::
+fadeRow(uint32_t *row1, const uint32_t *row2, int w, uint32_t f)
+{
+  for (int x = 0; x < w; ++x) {
+    auto pixel1 = row1[x];
+    auto pixel2 = row2[x];
+
+    if (! (pixel1 & 0xff000000)) {
+      row1[x] = pixel2;
+      continue;
+    }
+
+    auto blend = [&](int shift) {
+      auto c1 = (pixel1 >> shift) & 0xff;
+      auto c2 = (pixel2 >> shift) & 0xff;
+
+      return std::min((c1*f >> 8) + c2, 255u) << shift;
+    };
+
+    row1[x] = 0xff000000 | blend(16) | blend(8) | blend(0);
+  }
+}
+
+void
+Compositor::
+fadeRowSimd(uint32_t *row1, const uint32_t *row2, int w, uint32_t f)
+{
+  int x = 0;
+
+#ifdef __SSE2__
+  auto zero  = _mm_setzero_si128();
+  auto alpha = _mm_set1_epi32(int(0xff000000));
+  auto fv    = _mm_set1_epi16(short(f));
+
+  for ( ; x + 4 <= w; x += 4) {
+    auto p1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + x));
+    auto p2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row2 + x));
+
+    // fade image1 channels in 16 bit lanes
+    auto lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(p1, zero), fv), 8);
+    auto hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(p1, zero), fv), 8);
+
+    // add image2 with saturation and force opaque
+    auto res = _mm_or_si128(_mm_adds_epu8(_mm_packus_epi16(lo, hi), p2), alpha);
+
+    // transparent image1 pixels take image2 pixel unchanged
+    auto mask = _mm_cmpeq_epi32(_mm_and_si128(p1, alpha), zero);
+
+    res = _mm_or_si128(_mm_and_si128(mask, p2), _mm_andnot_si128(mask, res));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(row1 + x), res);
+  }
+#endif
+
+  if (x < w)
+    fadeRow(row1 + x, row2 + x, w - x, f);
+}
+
+void
+Compositor::
+fadeImageRef(QImage &image1, const QImage &image2, double f)
+{
+  int w = std::min(image1.width (), image2.width ());
+  int h = std::min(image1.height(), image2.height());
+
+  // blend image2 into faded image1
+  for (int y = 0; y < h; ++y) {
+    for (int x = 0; x < w; ++x) {
+      QRgb pixel1 = image1.pixel(x, y);
+      QRgb pixel2 = image2.pixel(x, y);
+
+      auto a1 = qAlpha(pixel1)/255.0;
+
+      QRgb pixel3;
+
+      if (a1 > 0) {
+        auto r1 = qRed  (pixel1)/255.0;
+        auto g1 = qGreen(pixel1)/255.0;
+        auto b1 = qBlue (pixel1)/255.0;
+
+        auto r2 = qRed  (pixel2)/255.0;
+        auto g2 = qGreen(pixel2)/255.0;
+        auto b2 = qBlue (pixel2)/255.0;
+
+        pixel3 = qRgb(int(255*std::min(r1*f + r2, 1.0)),
+                      int(255*std::min(g1*f + g2, 1.0)),
+                      int(255*std::min(b1*f + b2, 1.0)));
+      }
+      else
+        pixel3 = pixel2;
+
+      if (pixel3 != pixel1)
+        image1.setPixel(x, y, pixel3);
+    }
+  }
+}
+
+QString
+Compositor::
+benchmark(int w, int h, int n)
+{
+  auto makeImage = [&](int seed) {
+    QImage image(w, h, QImage::Format_ARGB32);
+
+    for (int y = 0; y < h; ++y) {
+      auto *row = reinterpret_cast<uint32_t *>(image.scanLine(y));
+
+      for (int x = 0; x < w; ++x)
+        row[x] = 0xff000000 | uint32_t((x*31 + y*17 + seed) & 0xffffff);
+    }
+
+    return image;
+  };
+
+  auto image1 = makeImage(0);
+  auto image2 = makeImage(1);
+
+  n = std::max(n, 1);
+
+  QElapsedTimer timer;
+
+  timer.start();
+
+  for (int i = 0; i < n; ++i)
+    fadeImageRef(image1, image2, 0.95);
+
+  auto refTime = timer.nsecsElapsed()/1e6/n;
+
+  timer.restart();
+
+  for (int i = 0; i < n; ++i)
+    fadeImage(image1, image2, 0.95);
+
+  auto fastTime = timer.nsecsElapsed()/1e6/n;
+
+  return QString("%1x%2 ref %3ms fast %4ms threads %5").
+           arg(w).arg(h).arg(refTime).arg(fastTime).arg(numThreads());
+}
+
+}
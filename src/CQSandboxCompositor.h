@@ -0,0 +1,55 @@
+#ifndef CQSandboxCompositor_H
+#define CQSandboxCompositor_H
+
+#include <QImage>
+#include <QString>
+
+#include <cstdint>
+
+class CThreadPool;
+
+namespace CQSandbox {
+
+// blends the buffered canvas draw image into the faded previous frame
+//
+// works on raw ARGB32 scanlines with 8.8 fixed point arithmetic (SSE2 when
+// available) and splits rows across a thread pool
+class Compositor {
+ public:
+  Compositor();
+ ~Compositor();
+
+  //! get/set number of threads (0 is hardware concurrency)
+  size_t numThreads() const;
+  void setNumThreads(size_t n);
+
+  //! get/set use SIMD kernel
+  bool isSimd() const { return simd_; }
+  void setSimd(bool b) { simd_ = b; }
+
+  //! time (ms) of last fade
+  double lastTime() const { return lastTime_; }
+
+  //! blend image2 into image1 faded by f
+  void fadeImage(QImage &image1, const QImage &image2, double f);
+
+  //! original per pixel fade (reference for benchmark)
+  static void fadeImageRef(QImage &image1, const QImage &image2, double f);
+
+  //! time (ms/frame) of reference and fast fade for image of specified size
+  QString benchmark(int w, int h, int n);
+
+  //---
+
+  static void fadeRow(uint32_t *row1, const uint32_t *row2, int w, uint32_t f);
+  static void fadeRowSimd(uint32_t *row1, const uint32_t *row2, int w, uint32_t f);
+
+ private:
+  CThreadPool* pool_     { nullptr };
+  bool         simd_     { true };
+  double       lastTime_ { 0.0 };
+};
+
+}
+
+#endif
@@ -44,58 +44,97 @@ init()
   Object3D::init();
 }
 
+const PropertyTable<Object3D> &
+Csv3DObj::
+properties()
+{
+  using Table = PropertyTable<Object3D>;
+
+  auto numColumns = [](Object3D *obj, const QStringList &, QVariant &value) {
+    value = static_cast<Csv3DObj *>(obj)->csv_->columnCount(); return true;
+  };
+
+  static Table table({
+    { "filename",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = static_cast<Csv3DObj *>(obj)->filename_; return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<Csv3DObj *>(obj)->filename_ = value; return true;
+      } },
+    { "comment_header",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = static_cast<Csv3DObj *>(obj)->csv_->isCommentHeader(); return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<Csv3DObj *>(obj)->csv_->setCommentHeader(Util::stringToBool(value));
+        return true;
+      } },
+    { "first_line_header",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = static_cast<Csv3DObj *>(obj)->csv_->isFirstLineHeader(); return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<Csv3DObj *>(obj)->csv_->setFirstLineHeader(Util::stringToBool(value));
+        return true;
+      } },
+    { "first_column_header",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = static_cast<Csv3DObj *>(obj)->csv_->isFirstColumnHeader(); return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<Csv3DObj *>(obj)->csv_->setFirstColumnHeader(Util::stringToBool(value));
+        return true;
+      } },
+    { "num_rows",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = static_cast<Csv3DObj *>(obj)->csv_->rowCount(); return true;
+      }, nullptr },
+    { "num_columns", numColumns, nullptr },
+    { "num_cols"   , numColumns, nullptr },
+    { "data",
+      [](Object3D *obj, const QStringList &args, QVariant &value) {
+        auto *csvObj = static_cast<Csv3DObj *>(obj);
+
+        if (args.size() != 2)
+          return csvObj->canvas()->app()->errorMsg("missing row/col for data");
+
+        auto row = Util::stringToInt(args[0]);
+        auto col = Util::stringToInt(args[1]);
+
+        auto ind = csvObj->csv_->index(row, col, QModelIndex());
+
+        value = csvObj->csv_->data(ind);
+
+        return true;
+      }, nullptr },
+  }, &Object3D::properties());
+
+  return table;
+}
+
 bool
 Csv3DObj::
 getValue(const QString &name, const QStringList &args, QVariant &value)
 {
-  auto *app = canvas_->app();
-
-  if      (name == "filename")
-    value = filename_;
-  else if (name == "comment_header")
-    value = csv_->isCommentHeader();
-  else if (name == "first_line_header")
-    value = csv_->isFirstLineHeader();
-  else if (name == "first_column_header")
-    value = csv_->isFirstColumnHeader();
-  else if (name == "num_rows")
-    value = csv_->rowCount();
-  else if (name == "num_columns" || name == "num_cols")
-    value = csv_->columnCount();
-  else if (name == "data") {
-    if (args.size() == 2) {
-      auto row = Util::stringToInt(args[0]);
-      auto col = Util::stringToInt(args[1]);
-
-      auto ind = csv_->index(row, col, QModelIndex());
-
-      value = csv_->data(ind);
-    }
-    else
-      return app->errorMsg("missing row/col for data");
-  }
-  else
-    return Object3D::getValue(name, args, value);
+  auto *property = properties().find(name);
 
-  return true;
+  if (property && property->get)
+    return property->get(this, args, value);
+
+  return Object3D::getValue(name, args, value);
 }
 
 bool
 Csv3DObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  if      (name == "filename")
-    filename_ = value;
-  else if (name == "comment_header")
-    csv_->setCommentHeader(Util::stringToBool(value));
-  else if (name == "first_line_header")
-    csv_->setFirstLineHeader(Util::stringToBool(value));
-  else if (name == "first_column_header")
-    csv_->setFirstColumnHeader(Util::stringToBool(value));
-  else
-    return Object3D::setValue(name, value, args);
+  auto *property = properties().find(name);
 
-  return true;
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object3D::setValue(name, value, args);
 }
 
 bool
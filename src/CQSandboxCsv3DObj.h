@@ -17,6 +17,8 @@ class Csv3DObj : public Object3D {
 
   const char *typeName() const override { return "Csv"; }
 
+  static const PropertyTable<Object3D> &properties();
+
   bool getValue(const QString &name, const QStringList &args, QVariant &value) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
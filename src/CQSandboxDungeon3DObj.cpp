@@ -4,12 +4,14 @@
 #include <CQSandboxShape3DObj.h>
 #include <CQSandboxCamera.h>
 #include <CQSandboxApp.h>
+#include <CQSandboxTextureCache.h>
 #include <CQSandboxUtil.h>
 
 #include <CQGLTexture.h>
 
 #ifdef CQSANDBOX_DUNGEON
 #include <CDungeon.h>
+#include <CAStarGrid.h>
 #endif
 
 namespace CQSandbox {
@@ -60,10 +62,115 @@ tick()
 {
 }
 
+const PropertyTable<Object3D> &
+Dungeon3DObj::
+properties()
+{
+  using Table = PropertyTable<Object3D>;
+
+  static Table table({
+    { "path",
+      [](Object3D *obj, const QStringList &args, QVariant &value) {
+        auto *dungeonObj = static_cast<Dungeon3DObj *>(obj);
+
+        auto *app = dungeonObj->canvas()->app();
+        auto *tcl = app->tcl();
+
+        auto *dungeon = dungeonObj->dungeon_;
+
+        // args: "<x> <y>" of start and end room, returns list of "<x> <y>" rooms
+        int pos[4];
+
+        for (int i = 0; i < 2; ++i) {
+          if (args.size() <= i)
+            return app->errorMsg("Missing room for path");
+
+          QStringList strs;
+          (void) tcl->splitList(args[i], strs);
+
+          if (strs.size() != 2)
+            return app->errorMsg("Missing room for path");
+
+          pos[2*i    ] = Util::stringToInt(strs[0]);
+          pos[2*i + 1] = Util::stringToInt(strs[1]);
+        }
+
+        // rooms are cells (missing rooms blocked), visible walls block moves between rooms
+        auto nr = int(dungeon->getNumRows());
+        auto nc = int(dungeon->getNumCols());
+
+        CAStarGrid grid(nc, nr);
+
+        for (int y = 0; y < nr; ++y)
+          for (int x = 0; x < nc; ++x)
+            grid.setBlocked(x, y, true);
+
+        for (auto *room : dungeon->getRooms()) {
+          auto rpos = room->getPos();
+
+          if (! grid.isValid(rpos.x, rpos.y))
+            continue;
+
+          grid.setBlocked(rpos.x, rpos.y, false);
+
+          auto setWall = [&](const CCompassType &type, CAStarGrid::Wall wall) {
+            if (room->getWall(type)->getVisible())
+              grid.setWall(rpos.x, rpos.y, wall, true);
+          };
+
+          setWall(CCompassType::NORTH, CAStarGrid::WALL_NORTH);
+          setWall(CCompassType::SOUTH, CAStarGrid::WALL_SOUTH);
+          setWall(CCompassType::WEST , CAStarGrid::WALL_WEST );
+          setWall(CCompassType::EAST , CAStarGrid::WALL_EAST );
+        }
+
+        CAStarGrid::Cells cells;
+
+        QStringList strs;
+
+        if (grid.search(pos[0], pos[1], pos[2], pos[3], cells)) {
+          for (auto i : cells)
+            strs << QString("%1 %2").arg(grid.cellX(i)).arg(grid.cellY(i));
+        }
+
+        value = tcl->mergeList(strs);
+
+        return true;
+      }, nullptr },
+    { "filename", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *dungeonObj = static_cast<Dungeon3DObj *>(obj);
+
+        dungeonObj->dungeon_->load(value.toStdString());
+
+        dungeonObj->updateObjs();
+
+        return true;
+      } },
+    { "player_camera", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *dungeonObj = static_cast<Dungeon3DObj *>(obj);
+
+        bool isGame = Util::stringToBool(value);
+
+        dungeonObj->updatePlayerCamera(isGame);
+
+        return true;
+      } },
+  }, &Object3D::properties());
+
+  return table;
+}
+
 bool
 Dungeon3DObj::
 getValue(const QString &name, const QStringList &args, QVariant &value)
 {
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
+
   return Object3D::getValue(name, args, value);
 }
 
@@ -71,12 +178,12 @@ bool
 Dungeon3DObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  if      (name == "filename") {
-    dungeon_->load(value.toStdString());
+  auto *property = properties().find(name);
 
-    updateObjs();
-  }
-  else if (name.left(8) == "texture.") {
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  if      (name.left(8) == "texture.") {
     auto id = name.mid(8);
 
     setTexture(id, value);
@@ -97,11 +204,6 @@ setValue(const QString &name, const QString &value, const QStringList &args)
 
     updatePlayerCamera(true);
   }
-  else if (name == "player_camera") {
-    bool isGame = Util::stringToBool(value);
-
-    updatePlayerCamera(isGame);
-  }
   else
     return Object3D::setValue(name, value, args);
 
@@ -161,17 +263,13 @@ setTexture(const QString &id, const QString &filename)
   auto p = textures_.find(id);
 
   if (p != textures_.end()) {
-    delete (*p).second;
+    canvas_->textureCache()->release((*p).second);
 
     textures_.erase(p);
   }
 
-  auto *texture = new CQGLTexture;
-
-  if (! texture->load(filename, /*flip*/false)) {
-    delete texture;
-    return;
-  }
+  auto *texture = canvas_->textureCache()->acquire(filename, /*flip*/false);
+  if (! texture) return;
 
   textures_[id] = texture;
 }
@@ -5,6 +5,8 @@
 
 #ifdef CQSANDBOX_FIELD_RUNNERS
 #include <CFieldRunners.h>
+#include <CAStarGrid.h>
+#include <CFlowField.h>
 #endif
 
 namespace CQSandbox {
@@ -48,35 +50,80 @@ init()
   Object3D::init();
 }
 
+FieldRunners3DObj::
+~FieldRunners3DObj()
+{
+  delete flowField_;
+}
+
 void
 FieldRunners3DObj::
 tick()
 {
   runners_->update();
+
+  if (flowField_)
+    updateFlowField();
 }
 
 bool
 FieldRunners3DObj::
-getValue(const QString &name, const QStringList &args, QVariant &value)
+isCellBlocked(int r, int c) const
 {
-  auto *app = canvas()->app();
-  auto *tcl = app->tcl();
+  CFieldRunners::FieldCell *cell;
+  runners_->getCell(CFieldRunners::CellPos(r, c), &cell);
 
-  struct Index {
-    int ix { -1 };
-    int iy { -1 };
+  if (! cell)
+    return false;
 
-    bool isValid() { return (ix >= 0 && iy >= 0); }
-  };
+  auto cellType = cell->type();
+
+  return (cellType == CFieldRunners::CellType::BORDER ||
+          cellType == CFieldRunners::CellType::BLOCK ||
+          cellType == CFieldRunners::CellType::GUN);
+}
+
+void
+FieldRunners3DObj::
+updateFlowField()
+{
+  auto nr = runners_->getNumRows();
+  auto nc = runners_->getNumCols();
+
+  // new map so re-add goals (field recalculated on update)
+  if (flowField_->nx() != nc || flowField_->ny() != nr) {
+    flowField_->resize(nc, nr);
+
+    for (const auto &goal : flowGoals_) {
+      if (flowField_->isValid(goal.ix, goal.iy))
+        flowField_->addGoal(goal.ix, goal.iy);
+    }
+  }
+
+  // only changed cells update the field
+  for (int r = 0; r < nr; ++r)
+    for (int c = 0; c < nc; ++c)
+      flowField_->setBlocked(c, r, isCellBlocked(r, c));
+
+  flowField_->update();
+}
+
+const PropertyTable<Object3D> &
+FieldRunners3DObj::
+properties()
+{
+  using Table = PropertyTable<Object3D>;
 
-  auto argsToIndex = [&]() {
-    Index ind;
+  // get cell index from "<col> <row>" arg
+  static auto argToIndex = [](FieldRunners3DObj *runners, const QStringList &args, int i,
+                              const QString &name, Index &ind) {
+    auto *app = runners->canvas()->app();
 
-    if (args.size() < 1)
+    if (args.size() <= i)
       return app->errorMsg("Missing index for " + name);
 
     QStringList strs;
-    (void) tcl->splitList(args[0], strs);
+    (void) app->tcl()->splitList(args[i], strs);
 
     if (strs.size() != 2)
       return app->errorMsg("Missing index for " + name);
@@ -84,20 +131,159 @@ getValue(const QString &name, const QStringList &args, QVariant &value)
     ind.ix = Util::stringToInt(strs[0]);
     ind.iy = Util::stringToInt(strs[1]);
 
-    return ind;
+    return true;
   };
 
-  if (name == "cell_bg") {
-    (void) argsToIndex();
-  }
-  else
-    return Object3D::getValue(name, args, value);
+  static Table table({
+    { "cell_bg",
+      [](Object3D *obj, const QStringList &args, QVariant &) {
+        Index ind;
+
+        (void) argToIndex(static_cast<FieldRunners3DObj *>(obj), args, 0, "cell_bg", ind);
+
+        return true;
+      }, nullptr },
+    { "path",
+      [](Object3D *obj, const QStringList &args, QVariant &value) {
+        auto *runnersObj = static_cast<FieldRunners3DObj *>(obj);
+
+        // args: "<col> <row>" of start and end cell, returns list of "<col> <row>" cells
+        Index ind1, ind2;
+
+        if (! argToIndex(runnersObj, args, 0, "path", ind1) ||
+            ! argToIndex(runnersObj, args, 1, "path", ind2))
+          return false;
+
+        auto nr = runnersObj->runners_->getNumRows();
+        auto nc = runnersObj->runners_->getNumCols();
+
+        CAStarGrid grid(nc, nr);
+
+        for (int r = 0; r < nr; ++r)
+          for (int c = 0; c < nc; ++c)
+            grid.setBlocked(c, r, runnersObj->isCellBlocked(r, c));
+
+        CAStarGrid::Cells cells;
+
+        QStringList strs;
+
+        if (grid.search(ind1.ix, ind1.iy, ind2.ix, ind2.iy, cells)) {
+          for (auto i : cells)
+            strs << QString("%1 %2").arg(grid.cellX(i)).arg(grid.cellY(i));
+        }
+
+        value = runnersObj->canvas()->app()->tcl()->mergeList(strs);
+
+        return true;
+      }, nullptr },
+    { "flow_field.next",
+      [](Object3D *obj, const QStringList &args, QVariant &value) {
+        auto *runnersObj = static_cast<FieldRunners3DObj *>(obj);
+
+        // args: "<col> <row>" of cell, returns next "<col> <row>" cell
+        Index ind;
+
+        if (! argToIndex(runnersObj, args, 0, "flow_field.next", ind))
+          return false;
+
+        if (! runnersObj->flowField_)
+          return runnersObj->canvas()->app()->errorMsg("No flow field goals for flow_field.next");
+
+        int c1, r1;
+
+        if (runnersObj->flowField_->nextCell(ind.ix, ind.iy, c1, r1))
+          value = QString("%1 %2").arg(c1).arg(r1);
+        else
+          value = QString();
+
+        return true;
+      }, nullptr },
+    { "flow_field.distance",
+      [](Object3D *obj, const QStringList &args, QVariant &value) {
+        auto *runnersObj = static_cast<FieldRunners3DObj *>(obj);
+
+        // args: "<col> <row>" of cell, returns distance to goal
+        Index ind;
+
+        if (! argToIndex(runnersObj, args, 0, "flow_field.distance", ind))
+          return false;
+
+        if (! runnersObj->flowField_)
+          return runnersObj->canvas()->app()->errorMsg(
+                   "No flow field goals for flow_field.distance");
+
+        value = QVariant(runnersObj->flowField_->distance(ind.ix, ind.iy));
+
+        return true;
+      }, nullptr },
+    { "map", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<FieldRunners3DObj *>(obj)->runners_->loadMap(value.toStdString());
+        return true;
+      } },
+    { "flow_field.goals", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *runnersObj = static_cast<FieldRunners3DObj *>(obj);
+
+        auto *app = runnersObj->canvas()->app();
+        auto *tcl = app->tcl();
+
+        // list of "<col> <row>" goal cells for shared flow field
+        QStringList strs;
+        (void) tcl->splitList(value, strs);
+
+        runnersObj->flowGoals_.clear();
+
+        for (const auto &str : strs) {
+          QStringList strs1;
+          (void) tcl->splitList(str, strs1);
+
+          if (strs1.size() != 2)
+            return app->errorMsg("Invalid goal cell '" + str + "'");
+
+          Index ind;
+
+          ind.ix = Util::stringToInt(strs1[0]);
+          ind.iy = Util::stringToInt(strs1[1]);
+
+          runnersObj->flowGoals_.push_back(ind);
+        }
+
+        if (! runnersObj->flowField_)
+          runnersObj->flowField_ = new CFlowField;
+
+        runnersObj->flowField_->resize(0, 0);
+
+        runnersObj->updateFlowField();
+
+        return true;
+      } },
+  }, &Object3D::properties());
+
+  return table;
+}
+
+bool
+FieldRunners3DObj::
+getValue(const QString &name, const QStringList &args, QVariant &value)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
+
+  return Object3D::getValue(name, args, value);
 }
 
 bool
 FieldRunners3DObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
+
   auto setTexture = [&](const QString &id, const QString &filename) {
     auto p = textures_.find(id);
 
@@ -117,10 +303,7 @@ setValue(const QString &name, const QString &value, const QStringList &args)
     textures_[id] = texture;
   };
 
-  if      (name == "map") {
-    runners_->loadMap(value.toStdString());
-  }
-  else if (name.left(8) == "texture.") {
+  if (name.left(8) == "texture.") {
     auto id = name.mid(8);
 
     setTexture(id, value);
@@ -131,6 +314,42 @@ setValue(const QString &name, const QString &value, const QStringList &args)
   return true;
 }
 
+bool
+FieldRunners3DObj::
+exec(const QString &op, const QStringList &args, QVariant &res)
+{
+  if (op == "benchmark.astar") {
+    auto *app = canvas_->app();
+
+    // args: [gridSize] [numQueries]
+    auto size       = (args.size() > 0 ? Util::stringToInt(args[0]) : 1024);
+    auto numQueries = (args.size() > 1 ? Util::stringToInt(args[1]) : 10);
+
+    if (size <= 1 || numQueries <= 0)
+      return app->errorMsg("Invalid size for benchmark.astar");
+
+    res = QString::fromStdString(CAStarGrid::benchmark(int(size), int(numQueries)));
+
+    return true;
+  }
+  else if (op == "benchmark.flow_field") {
+    auto *app = canvas_->app();
+
+    // args: [maxGridSize] [numChanges]
+    auto size       = (args.size() > 0 ? Util::stringToInt(args[0]) : 1024);
+    auto numChanges = (args.size() > 1 ? Util::stringToInt(args[1]) : 100);
+
+    if (size < 16 || numChanges <= 0)
+      return app->errorMsg("Invalid size for benchmark.flow_field");
+
+    res = QString::fromStdString(CFlowField::benchmark(int(size), int(numChanges)));
+
+    return true;
+  }
+
+  return Object3D::exec(op, args, res);
+}
+
 void
 FieldRunners3DObj::
 render()
@@ -6,6 +6,7 @@
 
 class CQGLTexture;
 class CFieldRunners;
+class CFlowField;
 
 namespace CQSandbox {
 
@@ -16,12 +17,17 @@ class FieldRunners3DObj : public Object3D {
   static Object3D *create(Canvas3D *canvas, const QStringList &args);
 
   FieldRunners3DObj(Canvas3D *canvas);
+ ~FieldRunners3DObj();
 
   const char *typeName() const override { return "FieldRunners"; }
 
+  static const PropertyTable<Object3D> &properties();
+
   bool getValue(const QString &name, const QStringList &args, QVariant &value) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
+  bool exec(const QString &op, const QStringList &args, QVariant &res) override;
+
   void init() override;
 
   void tick() override;
@@ -29,10 +35,25 @@ class FieldRunners3DObj : public Object3D {
   void render() override;
 
  private:
+  bool isCellBlocked(int r, int c) const;
+
+  void updateFlowField();
+
+ private:
+  struct Index {
+    int ix { -1 };
+    int iy { -1 };
+
+    bool isValid() { return (ix >= 0 && iy >= 0); }
+  };
+
   using Sprites  = std::vector<Sprite3DObj *>;
   using Textures = std::map<QString, CQGLTexture *>;
+  using Indices  = std::vector<Index>;
 
-  CFieldRunners* runners_ { nullptr };
+  CFieldRunners* runners_   { nullptr };
+  CFlowField*    flowField_ { nullptr };
+  Indices        flowGoals_;
 
   Sprites  bgSprites_;
   Sprites  runnerSprites_;
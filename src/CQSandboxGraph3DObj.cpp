@@ -8,7 +8,16 @@
 #include <CQGLUtil.h>
 
 #include <CForceDirected3D.h>
+#include <CForceDirectedThread3D.h>
+#include <CMultilevelLayout3D.h>
 #include <CDotParse.h>
+#include <CDotParseCSR.h>
+#include <CDotParseStream.h>
+
+#include <QFileInfo>
+
+#include <chrono>
+#include <sstream>
 
 namespace CQSandbox {
 
@@ -38,25 +47,33 @@ Graph3DObj(Canvas3D *canvas) :
 {
 }
 
-void
 Graph3DObj::
-addDemoNodes()
+~Graph3DObj()
 {
+  // stop worker before graph is deleted
+  delete layoutThread_;
+
   delete forceDirected_;
+  delete multilevel_;
+}
 
-  forceDirected_ = new CForceDirected3D;
+void
+Graph3DObj::
+addDemoNodes()
+{
+  auto *forceDirected = new CForceDirected3D;
 
   //---
 
-  auto node1 = forceDirected_->newNode();
-  auto node2 = forceDirected_->newNode();
-  auto node3 = forceDirected_->newNode();
-  auto node4 = forceDirected_->newNode();
+  auto node1 = forceDirected->newNode();
+  auto node2 = forceDirected->newNode();
+  auto node3 = forceDirected->newNode();
+  auto node4 = forceDirected->newNode();
 
-  auto node5 = forceDirected_->newNode();
-  auto node6 = forceDirected_->newNode();
-  auto node7 = forceDirected_->newNode();
-  auto node8 = forceDirected_->newNode();
+  auto node5 = forceDirected->newNode();
+  auto node6 = forceDirected->newNode();
+  auto node7 = forceDirected->newNode();
+  auto node8 = forceDirected->newNode();
 
   node1->setLabel("Node 1");
   node2->setLabel("Node 2");
@@ -67,17 +84,19 @@ addDemoNodes()
   node7->setLabel("Node 7");
   node8->setLabel("Node 8");
 
-  auto edge1 = forceDirected_->newEdge(node1, node2);
-  auto edge2 = forceDirected_->newEdge(node2, node3);
-  auto edge3 = forceDirected_->newEdge(node3, node1);
-  auto edge4 = forceDirected_->newEdge(node1, node4);
-  auto edge5 = forceDirected_->newEdge(node2, node4);
-  auto edge6 = forceDirected_->newEdge(node3, node4);
-
-  auto edge7  = forceDirected_->newEdge(node1, node5);
-  auto edge8  = forceDirected_->newEdge(node2, node6);
-  auto edge9  = forceDirected_->newEdge(node3, node7);
-  auto edge10 = forceDirected_->newEdge(node4, node8);
+  auto edge1 = forceDirected->newEdge(node1, node2);
+  auto edge2 = forceDirected->newEdge(node2, node3);
+  auto edge3 = forceDirected->newEdge(node3, node1);
+  auto edge4 = forceDirected->newEdge(node1, node4);
+  auto edge5 = forceDirected->newEdge(node2, node4);
+  auto edge6 = forceDirected->newEdge(node3, node4);
+
+  auto edge7  = forceDirected->newEdge(node1, node5);
+  auto edge8  = forceDirected->newEdge(node2, node6);
+  auto edge9  = forceDirected->newEdge(node3, node7);
+  auto edge10 = forceDirected->newEdge(node4, node8);
+
+  setForceDirected(forceDirected);
 }
 
 void
@@ -198,10 +217,156 @@ init()
   canvas_->glGenBuffers(1, &linesBufferId_);
 }
 
+const PropertyTable<Object3D> &
+Graph3DObj::
+properties()
+{
+  using Table = PropertyTable<Object3D>;
+
+  static Table table({
+    { "dot_file", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        (void) static_cast<Graph3DObj *>(obj)->loadDotFile(value); return true;
+      } },
+    { "barnes_hut",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = static_cast<Graph3DObj *>(obj)->forceDirected_->isBarnesHut(); return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *graph = static_cast<Graph3DObj *>(obj);
+
+        CForceDirectedThread3D::Pause pause(graph->layoutThread_);
+
+        graph->forceDirected_->setBarnesHut(Util::stringToBool(value));
+
+        return true;
+      } },
+    { "barnes_hut.theta",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = static_cast<Graph3DObj *>(obj)->forceDirected_->theta(); return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *graph = static_cast<Graph3DObj *>(obj);
+
+        CForceDirectedThread3D::Pause pause(graph->layoutThread_);
+
+        graph->forceDirected_->setTheta(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "barnes_hut.error",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        auto *graph = static_cast<Graph3DObj *>(obj);
+
+        CForceDirectedThread3D::Pause pause(graph->layoutThread_);
+
+        value = graph->forceDirected_->barnesHutError();
+
+        return true;
+      }, nullptr },
+    { "layout",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        auto *graph = static_cast<Graph3DObj *>(obj);
+
+        value = QString(graph->isMultilevel_ ? "multilevel" : "spring");
+
+        return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *graph = static_cast<Graph3DObj *>(obj);
+
+        if      (value == "multilevel")
+          graph->setMultilevel(true);
+        else if (value == "spring")
+          graph->setMultilevel(false);
+        else
+          return graph->canvas()->app()->errorMsg("Invalid layout '" + value + "'");
+
+        return true;
+      } },
+    { "layout.time",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        auto *graph = static_cast<Graph3DObj *>(obj);
+
+        value = (graph->multilevel_ ? graph->multilevel_->time() : 0.0);
+
+        return true;
+      }, nullptr },
+    { "layout.levels",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        auto *graph = static_cast<Graph3DObj *>(obj);
+
+        value = (graph->multilevel_ ? graph->multilevel_->numLevels() : 0);
+
+        return true;
+      }, nullptr },
+    { "layout.iterations",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        auto *graph = static_cast<Graph3DObj *>(obj);
+
+        value = (graph->multilevel_ ? graph->multilevel_->numIterations() : 0);
+
+        return true;
+      }, nullptr },
+    { "stress",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        auto *graph = static_cast<Graph3DObj *>(obj);
+
+        CForceDirectedThread3D::Pause pause(graph->layoutThread_);
+
+        value = graph->forceDirected_->stress();
+
+        return true;
+      }, nullptr },
+    { "threaded",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = static_cast<Graph3DObj *>(obj)->isThreaded_; return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<Graph3DObj *>(obj)->setThreaded(Util::stringToBool(value)); return true;
+      } },
+    { "layout.steps",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        auto *graph = static_cast<Graph3DObj *>(obj);
+
+        value = qulonglong(graph->layoutThread_ ? graph->layoutThread_->numSteps() : 0);
+
+        return true;
+      }, nullptr },
+    { "layout.steps_per_second",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        auto *graph = static_cast<Graph3DObj *>(obj);
+
+        value = (graph->layoutThread_ ? graph->layoutThread_->stepsPerSecond() : 0.0);
+
+        return true;
+      }, nullptr },
+    { "layout.converged",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        auto *graph = static_cast<Graph3DObj *>(obj);
+
+        value = (graph->layoutThread_ ? graph->layoutThread_->isConverged() : false);
+
+        return true;
+      }, nullptr },
+    { "render.fps",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = static_cast<Graph3DObj *>(obj)->renderFps_; return true;
+      }, nullptr },
+  }, &Object3D::properties());
+
+  return table;
+}
+
 bool
 Graph3DObj::
 getValue(const QString &name, const QStringList &args, QVariant &value)
 {
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
+
   return Object3D::getValue(name, args, value);
 }
 
@@ -209,159 +374,343 @@ bool
 Graph3DObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  if (name == "dot_file") {
-    (void) loadDotFile(value);
-  }
-  else
-    return Object3D::setValue(name, value, args);
+  auto *property = properties().find(name);
 
-  return true;
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object3D::setValue(name, value, args);
 }
 
 bool
 Graph3DObj::
-loadDotFile(const QString &filename)
+exec(const QString &op, const QStringList &args, QVariant &res)
 {
-  delete parse_;
+  if (op == "benchmark.algorithms") {
+    auto *app = canvas_->app();
 
-  parse_ = new CDotParse::Parse(filename.toStdString());
+    // args: [dotFile] [numEdges] (random graph written to file if missing)
+    auto filename = (args.size() > 0 ? args[0] : QString("graph_algorithms.dot"));
+    auto numEdges = (args.size() > 1 ? Util::stringToInt(args[1]) : 1000000);
 
-  if (! parse_->parse())
-    return false;
+    if (numEdges <= 0)
+      return app->errorMsg("Invalid edges for benchmark.algorithms");
 
-  //---
+    if (! QFileInfo(filename).exists()) {
+      if (! CDotParse::writeRandomDot(filename.toStdString(), uint(numEdges/4), uint(numEdges)))
+        return app->errorMsg("Failed to write '" + filename + "'");
+    }
 
-  delete forceDirected_;
+    res = QString::fromStdString(CDotParse::benchmark(filename.toStdString()));
 
-  forceDirected_ = new CForceDirected3D;
+    return true;
+  }
+  else if (op == "benchmark.parse") {
+    auto *app = canvas_->app();
 
-  //---
+    // args: [dotFile] [numEdges] (random graph written to file if missing)
+    auto filename = (args.size() > 0 ? args[0] : QString("graph_parse.dot"));
+    auto numEdges = (args.size() > 1 ? Util::stringToInt(args[1]) : 1000000);
 
-  using NodeMap = std::map<uint, CForceDirected3D::NodeP>;
+    if (numEdges <= 0)
+      return app->errorMsg("Invalid edges for benchmark.parse");
 
-  NodeMap nodeMap;
+    if (! QFileInfo(filename).exists()) {
+      if (! CDotParse::writeRandomDot(filename.toStdString(), uint(numEdges/4), uint(numEdges)))
+        return app->errorMsg("Failed to write '" + filename + "'");
+    }
 
-  for (const auto &pg : parse_->graphs()) {
-    const auto &graph = pg.second;
+    res = QString::fromStdString(CDotParse::parseBenchmark(filename.toStdString()));
 
-    for (const auto &pn : graph->nodes()) {
-      const auto &node = pn.second;
+    return true;
+  }
+  else if (op == "benchmark.layout") {
+    auto *app = canvas_->app();
 
-      auto node1 = forceDirected_->newNode();
+    if (! forceDirected_)
+      return app->errorMsg("No graph for benchmark.layout");
+
+    // args: [maxSteps] [tolerance] (spring loop stops when average move below tolerance)
+    auto maxSteps  = (args.size() > 0 ? Util::stringToInt (args[0]) : 10000);
+    auto tolerance = (args.size() > 1 ? Util::stringToReal(args[1]) : 0.001);
+
+    if (maxSteps <= 0)
+      return app->errorMsg("Invalid steps for benchmark.layout");
+
+    CForceDirectedThread3D::Pause pause(layoutThread_);
+
+    using Clock = std::chrono::steady_clock;
 
-      node1->setLabel(node->name());
+    auto nn = std::max(forceDirected_->nodes().size(), size_t(1));
 
-      nodeMap[node->id()] = node1;
+    forceDirected_->resetPlacement();
+
+    auto t = Clock::now();
+
+    int steps = 0;
+
+    while (steps < maxSteps) {
+      auto delta = forceDirected_->step(stepSize_);
+
+      ++steps;
+
+      if (delta/double(nn) < tolerance)
+        break;
+    }
+
+    auto springTime = std::chrono::duration<double, std::milli>(Clock::now() - t).count();
+
+    auto springStress = forceDirected_->stress();
+
+    //---
+
+    if (! multilevel_)
+      multilevel_ = new CMultilevelLayout3D;
+
+    // spring loop continues from multilevel positions if not in multilevel mode
+    forceDirected_->multilevelLayout(*multilevel_);
+
+    auto multilevelStress = forceDirected_->stress();
+
+    std::stringstream ss;
+
+    ss << "nodes " << forceDirected_->nodes().size() <<
+          " edges " << forceDirected_->edges().size() << "\n";
+    ss << "spring " << springTime << "ms " << steps << " steps" <<
+          " stress " << springStress << "\n";
+    ss << "multilevel " << multilevel_->time() << "ms " << multilevel_->numLevels() <<
+          " levels " << multilevel_->numIterations() << " iterations" <<
+          " stress " << multilevelStress;
+
+    layoutThread_->update();
+
+    res = QString::fromStdString(ss.str());
+
+    return true;
+  }
+
+  return Object3D::exec(op, args, res);
+}
+
+bool
+Graph3DObj::
+loadDotFile(const QString &filename)
+{
+  // stream nodes and edges directly into force directed graph
+  using Nodes = std::vector<CForceDirected3D::NodeP>;
+
+  class LoadHandler : public CDotParse::StreamParse::Handler {
+   public:
+    LoadHandler(CDotParse::StreamParse &parse, CForceDirected3D *forceDirected) :
+     parse_(parse), forceDirected_(forceDirected) {
     }
 
-    for (const auto &edge : graph->edges()) {
-      auto *fromNode = edge->fromNode();
-      auto *toNode   = edge->toNode  ();
+    void node(uint node, bool created, const CDotParse::StreamParse::Attrs &) override {
+      if (! created)
+        return;
+
+      auto node1 = forceDirected_->newNode();
 
-      const auto &node1 = nodeMap[fromNode->id()];
-      const auto &node2 = nodeMap[toNode  ->id()];
+      node1->setLabel(std::string(parse_.nodeName(node)));
 
-      (void) forceDirected_->newEdge(node1, node2);
+      nodes_.push_back(node1);
     }
+
+    void edge(uint, uint fromNode, uint toNode, bool,
+              const CDotParse::StreamParse::Attrs &) override {
+      (void) forceDirected_->newEdge(nodes_[fromNode], nodes_[toNode]);
+    }
+
+   private:
+    CDotParse::StreamParse& parse_;
+    CForceDirected3D*       forceDirected_ { nullptr };
+    Nodes                   nodes_;
+  };
+
+  //---
+
+  auto *forceDirected = new CForceDirected3D;
+
+  CDotParse::StreamParse parse(filename.toStdString());
+
+  LoadHandler handler(parse, forceDirected);
+
+  parse.setStore  (false);
+  parse.setHandler(&handler);
+
+  if (! parse.parse()) {
+    delete forceDirected;
+
+    return canvas_->app()->errorMsg(QString::fromStdString(parse.errorMsg()));
   }
 
+  setForceDirected(forceDirected);
+
   return true;
 }
 
 void
 Graph3DObj::
-tick()
+setForceDirected(CForceDirected3D *forceDirected)
 {
-  forceDirected_->step(stepSize_);
+  if (! layoutThread_) {
+    layoutThread_ = new CForceDirectedThread3D;
 
-  updatePoints();
+    layoutThread_->setStepSize(stepSize_);
+  }
 
-  updateTextObjs();
+  // stop worker before old graph is deleted
+  layoutThread_->stop();
 
-  Object3D::tick();
+  layoutThread_->setForceDirected(forceDirected);
+
+  delete forceDirected_;
+
+  forceDirected_ = forceDirected;
+
+  if (isMultilevel_)
+    multilevelLayout();
+
+  layoutThread_->update();
+
+  updateLayoutThread();
 }
 
 void
 Graph3DObj::
-updatePoints()
+setMultilevel(bool b)
 {
-  double xmin, ymin, zmin, xmax, ymax, zmax;
-  forceDirected_->calcRange(xmin, ymin, zmin, xmax, ymax, zmax);
+  isMultilevel_ = b;
 
-  auto mapPoint = [&](const Springy3D::Point &p) {
-    auto x = CMathUtil::map(p.p().x(), xmin, xmax, -0.45, 0.45);
-    auto y = CMathUtil::map(p.p().y(), ymin, ymax, -0.45, 0.45);
-    auto z = CMathUtil::map(p.p().z(), zmin, zmax, -0.45, 0.45);
+  if (isMultilevel_)
+    multilevelLayout();
 
-    return CGLVector3D(x, y, z);
-  };
+  updateLayoutThread();
+}
+
+void
+Graph3DObj::
+multilevelLayout()
+{
+  if (! forceDirected_)
+    return;
 
-  if (xmax == xmin) xmax = xmin + 0.01;
-  if (ymax == ymin) ymax = ymin + 0.01;
-  if (zmax == zmin) zmax = zmin + 0.01;
+  CForceDirectedThread3D::Pause pause(layoutThread_);
 
-  auto nodes = forceDirected_->nodes();
+  if (! multilevel_)
+    multilevel_ = new CMultilevelLayout3D;
 
-  auto nn = nodes.size();
+  forceDirected_->multilevelLayout(*multilevel_);
 
-  if (nn != points_.size())
-    points_.resize(nn);
+  layoutThread_->update();
+}
 
-  for (size_t i = 0; i < nn; ++i) {
-    auto point = forceDirected_->point(nodes[i]);
+void
+Graph3DObj::
+setThreaded(bool b)
+{
+  isThreaded_ = b;
 
-    points_[i] = mapPoint(point->p());
+  updateLayoutThread();
+}
+
+void
+Graph3DObj::
+updateLayoutThread()
+{
+  if (! layoutThread_)
+    return;
+
+  // multilevel layout is already converged
+  if (isThreaded_ && ! isMultilevel_)
+    layoutThread_->start();
+  else
+    layoutThread_->stop();
+}
+
+void
+Graph3DObj::
+tick()
+{
+  if (! layoutThread_) {
+    Object3D::tick();
+    return;
   }
 
-  auto edges = forceDirected_->edges();
+  // step on GUI thread if not threaded (positions published to same snapshots)
+  if (! isThreaded_ && ! isMultilevel_)
+    layoutThread_->step();
 
-  auto ne = edges.size();
+  // pick up newest positions for render
+  if (layoutThread_->acquire())
+    pointsChanged_ = true;
 
-  if (2*ne != linePoints_.size())
-    linePoints_.resize(2*ne);
+  updateModelMatrix();
 
-  for (size_t i = 0; i < ne; ++i) {
-    auto point1 = forceDirected_->point(edges[i]->source());
-    auto point2 = forceDirected_->point(edges[i]->target());
+  updateTextObjs();
 
-    linePoints_[2*i    ] = mapPoint(point1->p());
-    linePoints_[2*i + 1] = mapPoint(point2->p());
-  }
+  Object3D::tick();
+}
 
-  //---
+void
+Graph3DObj::
+uploadPoints()
+{
+  pointsChanged_ = false;
+
+  const auto &snapshot = layoutThread_->snapshot();
+
+  auto np = snapshot.points    .size();
+  auto nl = snapshot.linePoints.size();
 
   // bind the Vertex Array Object
   canvas_->glBindVertexArray(pointsArrayId_);
 
   //---
 
-  // store point data in array buffer
-  uint aPos = 0;
-  canvas_->glBindBuffer(GL_ARRAY_BUFFER, pointsBufferId_);
-  canvas_->glBufferData(GL_ARRAY_BUFFER, nn*sizeof(CGLVector3D), &points_[0], GL_STATIC_DRAW);
+  // grow buffers (attrib format only needs setting when buffer reallocated)
+  if (np > pointsCapacity_) {
+    pointsCapacity_ = std::max(np, 2*pointsCapacity_);
 
-  // set points attrib data and format (for current buffer)
-  canvas_->glVertexAttribPointer(aPos, 3, GL_FLOAT, GL_FALSE, sizeof(CGLVector3D), nullptr);
-  canvas_->glEnableVertexAttribArray(aPos);
+    uint aPos = 0;
+    canvas_->glBindBuffer(GL_ARRAY_BUFFER, pointsBufferId_);
+    canvas_->glBufferData(GL_ARRAY_BUFFER, pointsCapacity_*sizeof(float),
+                          nullptr, GL_STREAM_DRAW);
 
-  //---
+    // set points attrib data and format (for current buffer)
+    canvas_->glVertexAttribPointer(aPos, 3, GL_FLOAT, GL_FALSE, 3*sizeof(float), nullptr);
+    canvas_->glEnableVertexAttribArray(aPos);
+  }
 
-  // store point data in array buffer
-  canvas_->glBindBuffer(GL_ARRAY_BUFFER, linesBufferId_);
-  canvas_->glBufferData(GL_ARRAY_BUFFER, 2*ne*sizeof(CGLVector3D), &linePoints_[0], GL_STATIC_DRAW);
+  if (nl > linesCapacity_) {
+    linesCapacity_ = std::max(nl, 2*linesCapacity_);
 
-  // set points attrib data and format (for current buffer)
-  canvas_->glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(CGLVector3D), nullptr);
-  canvas_->glEnableVertexAttribArray(1);
+    canvas_->glBindBuffer(GL_ARRAY_BUFFER, linesBufferId_);
+    canvas_->glBufferData(GL_ARRAY_BUFFER, linesCapacity_*sizeof(float),
+                          nullptr, GL_STREAM_DRAW);
+
+    // set lines attrib data and format (for current buffer)
+    canvas_->glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 3*sizeof(float), nullptr);
+    canvas_->glEnableVertexAttribArray(1);
+  }
 
   //---
 
-  canvas_->glBindBuffer(GL_ARRAY_BUFFER, 0);
-  canvas_->glBindVertexArray(0);
+  // stream point data into buffers
+  if (np > 0) {
+    canvas_->glBindBuffer(GL_ARRAY_BUFFER, pointsBufferId_);
+    canvas_->glBufferSubData(GL_ARRAY_BUFFER, 0, np*sizeof(float), snapshot.points.data());
+  }
+
+  if (nl > 0) {
+    canvas_->glBindBuffer(GL_ARRAY_BUFFER, linesBufferId_);
+    canvas_->glBufferSubData(GL_ARRAY_BUFFER, 0, nl*sizeof(float), snapshot.linePoints.data());
+  }
 
   //---
 
-  updateModelMatrix();
+  canvas_->glBindBuffer(GL_ARRAY_BUFFER, 0);
+  canvas_->glBindVertexArray(0);
 }
 
 void
@@ -370,7 +719,9 @@ updateTextObjs()
 {
   auto nodes = forceDirected_->nodes();
 
-  auto nn = nodes.size();
+  const auto &points = layoutThread_->snapshot().points;
+
+  auto nn = std::min(nodes.size(), points.size()/3);
 
   while (textObjs_.size() > nn) {
     auto *obj = textObjs_.back();
@@ -392,23 +743,19 @@ updateTextObjs()
     textObjs_.push_back(obj);
   }
 
-  int i = 0;
-
-  for (auto &node : nodes) {
+  for (size_t i = 0; i < nn; ++i) {
     auto *textObj = textObjs_[i];
 
-    textObj->setText(QString::fromStdString(node->label()));
+    textObj->setText(QString::fromStdString(nodes[i]->label()));
 
-    const auto &p = points_[i];
+    const auto *p = &points[3*i];
 
     double x, y, z;
-    modelMatrix_.multiplyPoint(p.x(), p.y(), p.z(), &x, &y, &z);
+    modelMatrix_.multiplyPoint(p[0], p[1], p[2], &x, &y, &z);
 
     auto p1 = CPoint3D(x, y, z);
 
     textObj->setPosition(p1);
-
-    ++i;
   }
 }
 
@@ -416,6 +763,31 @@ void
 Graph3DObj::
 render()
 {
+  if (! layoutThread_)
+    return;
+
+  // render rate (independent of layout steps when threaded)
+  using Clock = std::chrono::steady_clock;
+
+  auto t = std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+
+  ++renderCount_;
+
+  if      (renderTime_ == 0.0)
+    renderTime_ = t;
+  else if (t - renderTime_ >= 0.5) {
+    renderFps_   = renderCount_/(t - renderTime_);
+    renderTime_  = t;
+    renderCount_ = 0;
+  }
+
+  if (pointsChanged_)
+    uploadPoints();
+
+  const auto &snapshot = layoutThread_->snapshot();
+
+  //---
+
   //s_program1->bind();
   canvas_->bindProgram(s_program1);
 
@@ -426,7 +798,7 @@ render()
 
   canvas_->glBindVertexArray(pointsArrayId_);
 
-  int np = points_.size();
+  int np = int(snapshot.points.size()/3);
 
   glDrawArrays(GL_POINTS, 0, np);
 //glDrawArrays(GL_TRIANGLES, 0, np);
@@ -447,7 +819,7 @@ render()
 
   canvas_->glBindVertexArray(pointsArrayId_);
 
-  int nl = linePoints_.size();
+  int nl = int(snapshot.linePoints.size()/3);
 
   glDrawArrays(GL_LINES, 0, nl);
 
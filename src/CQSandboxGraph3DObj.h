@@ -7,10 +7,8 @@
 #include <CGLColor.h>
 
 class CForceDirected3D;
-
-namespace CDotParse {
-class Parse;
-}
+class CForceDirectedThread3D;
+class CMultilevelLayout3D;
 
 namespace CQSandbox {
 
@@ -24,12 +22,17 @@ class Graph3DObj : public Object3D {
   static Object3D *create(Canvas3D *canvas, const QStringList &args);
 
   Graph3DObj(Canvas3D *canvas);
+ ~Graph3DObj();
 
   const char *typeName() const override { return "Graph"; }
 
+  static const PropertyTable<Object3D> &properties();
+
   bool getValue(const QString &name, const QStringList &args, QVariant &value) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
+  bool exec(const QString &op, const QStringList &args, QVariant &res) override;
+
   void init() override;
 
   void tick() override;
@@ -43,12 +46,21 @@ class Graph3DObj : public Object3D {
 
   bool loadDotFile(const QString &name);
 
-  void updatePoints();
+  void setForceDirected(CForceDirected3D *forceDirected);
+
+  void setMultilevel(bool b);
+
+  void multilevelLayout();
+
+  void setThreaded(bool b);
+
+  void updateLayoutThread();
+
+  void uploadPoints();
 
   void updateTextObjs();
 
  private:
-  using Points   = std::vector<CGLVector3D>;
   using TextObjs = std::vector<Text3DObj *>;
 
   static ShaderProgram* s_program1;
@@ -56,14 +68,25 @@ class Graph3DObj : public Object3D {
 
   CForceDirected3D *forceDirected_ { nullptr };
 
-  CDotParse::Parse *parse_ { nullptr };
+  // multilevel layout (when enabled replaces step() in tick)
+  CMultilevelLayout3D *multilevel_   { nullptr };
+  bool                 isMultilevel_ { false };
+
+  // layout steps (on worker thread when threaded) publish position snapshots
+  CForceDirectedThread3D *layoutThread_ { nullptr };
+  bool                    isThreaded_   { false };
 
   double stepSize_ { 0.01 };
 
   CGLColor lineColor_ { 1.0, 0.0, 0.0 };
 
-  Points points_;
-  Points linePoints_;
+  bool   pointsChanged_  { false };
+  size_t pointsCapacity_ { 0 }; // floats
+  size_t linesCapacity_  { 0 }; // floats
+
+  int    renderCount_ { 0 };
+  double renderTime_  { 0.0 };
+  double renderFps_   { 0.0 };
 
   TextObjs textObjs_;
 
@@ -146,12 +146,7 @@ render()
 
   //---
 
-  for (auto *obj : objects_) {
-    if (! obj || ! obj->isVisible())
-      continue;
-
-    obj->render();
-  }
+  canvas_->renderObjects(objects_);
 
   //---
 
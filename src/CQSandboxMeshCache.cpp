@@ -0,0 +1,344 @@
+#include <CQSandboxMeshCache.h>
+
+#include <QSaveFile>
+
+#include <cstring>
+
+namespace CQSandbox {
+
+namespace {
+
+const char MAGIC[8] = { 'C', 'Q', 'S', 'B', 'M', 'E', 'S', 'H' };
+
+struct Header {
+  char     magic[8];
+  uint32_t version     { 0 };
+  uint32_t numTextures { 0 };
+  uint32_t numMeshes   { 0 };
+  uint32_t faceSize    { 0 };
+  uint64_t sourceSize  { 0 };
+  uint64_t sourceHash  { 0 };
+  float    bbox[6];
+};
+
+struct MeshHeader {
+  float    meshMatrix [16];
+  float    modelMatrix[16];
+  uint32_t types    { 0 };
+  uint32_t numData  { 0 };
+  uint32_t numFaces { 0 };
+  uint32_t pad      { 0 };
+};
+
+size_t align4(size_t n) { return (n + 3) & ~size_t(3); }
+
+}
+
+//---
+
+MeshCache::
+~MeshCache()
+{
+  close();
+}
+
+QString
+MeshCache::
+cacheFileName(const QString &filename)
+{
+  return filename + ".sbmesh";
+}
+
+bool
+MeshCache::
+sourceKey(const QString &filename, Key &key)
+{
+  QFile file(filename);
+
+  if (! file.open(QIODevice::ReadOnly))
+    return false;
+
+  key.size = uint64_t(file.size());
+
+  // FNV-1a of contents
+  uint64_t hash = 14695981039346656037ULL;
+
+  auto hashData = [&](const uchar *data, qint64 n) {
+    for (qint64 i = 0; i < n; ++i) {
+      hash ^= data[i];
+      hash *= 1099511628211ULL;
+    }
+  };
+
+  auto *data = (key.size > 0 ? file.map(0, file.size()) : nullptr);
+
+  if (data) {
+    hashData(data, file.size());
+
+    file.unmap(data);
+  }
+  else {
+    std::vector<char> buffer(1<<16);
+
+    qint64 n;
+
+    while ((n = file.read(buffer.data(), qint64(buffer.size()))) > 0)
+      hashData(reinterpret_cast<const uchar *>(buffer.data()), n);
+  }
+
+  key.hash = hash;
+
+  return true;
+}
+
+//---
+
+void
+MeshCache::
+setBBox(const float bbox[6])
+{
+  memcpy(bbox_, bbox, sizeof(bbox_));
+}
+
+int
+MeshCache::
+addTexture(const std::string &name, bool flipped)
+{
+  for (size_t i = 0; i < textures_.size(); ++i) {
+    if (textures_[i].name == name && textures_[i].flipped == flipped)
+      return int(i);
+  }
+
+  Texture texture;
+
+  texture.name    = name;
+  texture.flipped = flipped;
+
+  textures_.push_back(texture);
+
+  return int(textures_.size() - 1);
+}
+
+void
+MeshCache::
+addMesh(const float meshMatrix[16], const float modelMatrix[16], uint32_t types,
+        const float *data, uint32_t numData, const std::vector<Face> &faces)
+{
+  meshData_ .emplace_back(data, data + numData);
+  meshFaces_.push_back(faces);
+
+  Mesh mesh;
+
+  memcpy(mesh.meshMatrix , meshMatrix , sizeof(mesh.meshMatrix));
+  memcpy(mesh.modelMatrix, modelMatrix, sizeof(mesh.modelMatrix));
+
+  mesh.types    = types;
+  mesh.numData  = numData;
+  mesh.data     = meshData_.back().data();
+  mesh.numFaces = uint32_t(faces.size());
+  mesh.faces    = meshFaces_.back().data();
+
+  meshes_.push_back(mesh);
+}
+
+//---
+
+bool
+MeshCache::
+write(const QString &cacheFile, const Key &key) const
+{
+  // header, textures (flipped, name length, name padded to 4), then meshes
+  // (header, interleaved data, faces)
+  QSaveFile file(cacheFile);
+
+  if (! file.open(QIODevice::WriteOnly))
+    return false;
+
+  auto writeData = [&](const void *data, size_t n) {
+    return (n == 0 || file.write(static_cast<const char *>(data), qint64(n)) == qint64(n));
+  };
+
+  Header header;
+
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+
+  header.version     = VERSION;
+  header.numTextures = uint32_t(textures_.size());
+  header.numMeshes   = uint32_t(meshes_.size());
+  header.faceSize    = uint32_t(sizeof(Face));
+  header.sourceSize  = key.size;
+  header.sourceHash  = key.hash;
+
+  memcpy(header.bbox, bbox_, sizeof(header.bbox));
+
+  if (! writeData(&header, sizeof(header)))
+    return false;
+
+  for (const auto &texture : textures_) {
+    uint32_t info[2] = { uint32_t(texture.flipped), uint32_t(texture.name.size()) };
+
+    const char pad[4] = { 0, 0, 0, 0 };
+
+    auto len = texture.name.size();
+
+    if (! writeData(info, sizeof(info)) ||
+        ! writeData(texture.name.c_str(), len) ||
+        ! writeData(pad, align4(len) - len))
+      return false;
+  }
+
+  for (const auto &mesh : meshes_) {
+    MeshHeader meshHeader;
+
+    memcpy(meshHeader.meshMatrix , mesh.meshMatrix , sizeof(meshHeader.meshMatrix));
+    memcpy(meshHeader.modelMatrix, mesh.modelMatrix, sizeof(meshHeader.modelMatrix));
+
+    meshHeader.types    = mesh.types;
+    meshHeader.numData  = mesh.numData;
+    meshHeader.numFaces = mesh.numFaces;
+
+    if (! writeData(&meshHeader, sizeof(meshHeader)) ||
+        ! writeData(mesh.data , mesh.numData *sizeof(float)) ||
+        ! writeData(mesh.faces, mesh.numFaces*sizeof(Face)))
+      return false;
+  }
+
+  return file.commit();
+}
+
+bool
+MeshCache::
+read(const QString &cacheFile, const Key &key)
+{
+  close();
+
+  file_.setFileName(cacheFile);
+
+  if (! file_.open(QIODevice::ReadOnly))
+    return false;
+
+  auto size = size_t(file_.size());
+
+  if (size < sizeof(Header)) {
+    close();
+    return false;
+  }
+
+  map_ = file_.map(0, file_.size());
+
+  if (! map_) {
+    close();
+    return false;
+  }
+
+  // bounds checked cursor into mapping
+  size_t pos = 0;
+
+  auto take = [&](size_t n) -> const uchar * {
+    if (n > size - pos)
+      return nullptr;
+
+    auto *p = map_ + pos;
+
+    pos += n;
+
+    return p;
+  };
+
+  auto fail = [&]() {
+    close();
+    return false;
+  };
+
+  Header header;
+
+  memcpy(&header, take(sizeof(header)), sizeof(header));
+
+  if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+      header.faceSize != sizeof(Face) ||
+      header.sourceSize != key.size || header.sourceHash != key.hash)
+    return fail();
+
+  memcpy(bbox_, header.bbox, sizeof(bbox_));
+
+  for (uint32_t i = 0; i < header.numTextures; ++i) {
+    uint32_t info[2];
+
+    auto *p = take(sizeof(info));
+    if (! p) return fail();
+
+    memcpy(info, p, sizeof(info));
+
+    auto *name = take(align4(info[1]));
+    if (! name) return fail();
+
+    Texture texture;
+
+    texture.flipped = (info[0] != 0);
+    texture.name    = std::string(reinterpret_cast<const char *>(name), info[1]);
+
+    textures_.push_back(texture);
+  }
+
+  for (uint32_t i = 0; i < header.numMeshes; ++i) {
+    MeshHeader meshHeader;
+
+    auto *p = take(sizeof(meshHeader));
+    if (! p) return fail();
+
+    memcpy(&meshHeader, p, sizeof(meshHeader));
+
+    Mesh mesh;
+
+    memcpy(mesh.meshMatrix , meshHeader.meshMatrix , sizeof(mesh.meshMatrix));
+    memcpy(mesh.modelMatrix, meshHeader.modelMatrix, sizeof(mesh.modelMatrix));
+
+    mesh.types    = meshHeader.types;
+    mesh.numData  = meshHeader.numData;
+    mesh.numFaces = meshHeader.numFaces;
+
+    // all sections are 4 byte aligned so data can be used in place
+    auto *data  = take(size_t(mesh.numData )*sizeof(float));
+    auto *faces = (data ? take(size_t(mesh.numFaces)*sizeof(Face)) : nullptr);
+
+    if (! data || ! faces)
+      return fail();
+
+    mesh.data  = reinterpret_cast<const float *>(data);
+    mesh.faces = reinterpret_cast<const Face  *>(faces);
+
+    for (uint32_t j = 0; j < mesh.numFaces; ++j) {
+      const auto &face = mesh.faces[j];
+
+      for (int k = 0; k < NUM_TEXTURES; ++k) {
+        if (face.textures[k] >= int32_t(header.numTextures))
+          return fail();
+      }
+    }
+
+    meshes_.push_back(mesh);
+  }
+
+  return true;
+}
+
+void
+MeshCache::
+close()
+{
+  if (map_) {
+    file_.unmap(map_);
+
+    map_ = nullptr;
+  }
+
+  if (file_.isOpen())
+    file_.close();
+
+  textures_ .clear();
+  meshes_   .clear();
+  meshData_ .clear();
+  meshFaces_.clear();
+}
+
+}
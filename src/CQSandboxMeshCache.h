@@ -0,0 +1,118 @@
+#ifndef CQSandboxMeshCache_H
+#define CQSandboxMeshCache_H
+
+#include <QFile>
+#include <QString>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace CQSandbox {
+
+// compiled mesh cache file for models
+//
+// stores the final interleaved vertex buffer, face draw ranges, colors and texture
+// references of each drawn mesh (in draw order) with its mesh and model matrices, so a
+// model can be uploaded to the GPU without importing the source file. The file is keyed
+// by the size and hash of the source file and a format version.
+//
+// a read cache maps the file and mesh data/faces point into the mapping.
+class MeshCache {
+ public:
+  static constexpr uint32_t VERSION = 1;
+
+  static constexpr int NUM_TEXTURES = 4; // diffuse, normal, specular, emissive
+
+  struct Key {
+    uint64_t size { 0 };
+    uint64_t hash { 0 };
+  };
+
+  struct Face {
+    int32_t pos      { 0 };
+    int32_t len      { 0 };
+    float   color[4] { 0.0f, 0.0f, 0.0f, 1.0f };
+    int32_t textures[NUM_TEXTURES] { -1, -1, -1, -1 }; // texture index or -1
+  };
+
+  struct Texture {
+    std::string name;
+    bool        flipped { false };
+  };
+
+  struct Mesh {
+    float        meshMatrix [16]; // row major
+    float        modelMatrix[16]; // row major
+    uint32_t     types    { 0 };  // CQGLBuffer parts
+    uint32_t     numData  { 0 };
+    const float* data     { nullptr };
+    uint32_t     numFaces { 0 };
+    const Face*  faces    { nullptr };
+  };
+
+  using Textures = std::vector<Texture>;
+  using Meshes   = std::vector<Mesh>;
+
+ public:
+  MeshCache() { }
+
+ ~MeshCache();
+
+  MeshCache(const MeshCache &) = delete;
+  MeshCache &operator=(const MeshCache &) = delete;
+
+  // cache file name for source file
+  static QString cacheFileName(const QString &filename);
+
+  // size and hash of source file
+  static bool sourceKey(const QString &filename, Key &key);
+
+  //---
+
+  const float *bbox() const { return bbox_; } // xmin, ymin, zmin, xmax, ymax, zmax
+  void setBBox(const float bbox[6]);
+
+  const Textures &textures() const { return textures_; }
+  const Meshes   &meshes  () const { return meshes_; }
+
+  // add texture reference (returns index, existing if same)
+  int addTexture(const std::string &name, bool flipped);
+
+  // add mesh (data and faces copied)
+  void addMesh(const float meshMatrix[16], const float modelMatrix[16], uint32_t types,
+               const float *data, uint32_t numData, const std::vector<Face> &faces);
+
+  //---
+
+  // write cache file for source key (atomic replace)
+  bool write(const QString &cacheFile, const Key &key) const;
+
+  // map cache file, fails if missing, invalid or for different source key
+  bool read(const QString &cacheFile, const Key &key);
+
+  // release mapping (mesh data no longer valid)
+  void close();
+
+ private:
+  using Floats    = std::vector<float>;
+  using Faces     = std::vector<Face>;
+  using FloatsArr = std::vector<Floats>;
+  using FacesArr  = std::vector<Faces>;
+
+  float    bbox_[6] { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+  Textures textures_;
+  Meshes   meshes_;
+
+  // storage of added meshes
+  FloatsArr meshData_;
+  FacesArr  meshFaces_;
+
+  // read mapping
+  QFile  file_;
+  uchar* map_ { nullptr };
+};
+
+}
+
+#endif
@@ -5,6 +5,8 @@
 #include <CQSandboxGeomObject.h>
 #include <CQSandboxTexture.h>
 #include <CQSandboxUtil.h>
+#include <CQSandboxMeshCache.h>
+#include <CQSandboxAnimClipCache.h>
 
 #include <CQGLTexture.h>
 #include <CQGLBuffer.h>
@@ -17,12 +19,20 @@
 #include <CQTclUtil.h>
 #include <CImageLib.h>
 #include <CFile.h>
+#include <CThreadPool.h>
 
 #include <QFileInfo>
+#include <QDir>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
 
 namespace CQSandbox {
 
 ShaderProgram* Model3DObj::s_program;
+bool           Model3DObj::s_meshCache { true };
+CThreadPool*   Model3DObj::s_updatePool;
 
 Object3D *
 Model3DObj::
@@ -59,6 +69,12 @@ Model3DObj(Canvas3D *canvas) :
   fragShaderFile_ = app->buildDir() + "/shaders/model.fs";
 }
 
+Model3DObj::
+~Model3DObj()
+{
+  clearCacheMeshes();
+}
+
 void
 Model3DObj::
 initShader()
@@ -74,55 +90,13 @@ initShader()
   s_program->link();
 }
 
-bool
+const PropertyTable<Object3D> &
 Model3DObj::
-getValue(const QString &name, const QStringList &args, QVariant &value)
+properties()
 {
-  if      (name == "ref_object") {
-    if (! object_)
-      return false;
-
-    auto *object1 = object_->createRef();
-
-    object1->setInd(CGeometry3DInst->nextObjectId());
-
-    auto *scene = canvas_->scene();
-
-    scene->addObject(object1);
-
-    auto children = object1->hierChildren();
-
-    for (auto *child : children) {
-      child->setInd(CGeometry3DInst->nextObjectId());
-
-      scene->addObject(child);
-    }
+  using Table = PropertyTable<Object3D>;
 
-    scene->addObject(object1);
-
-    QStringList args;
-    auto *obj = dynamic_cast<Model3DObj *>(create(canvas_, args));
-    if (! obj) return false;
-
-    obj->object_ = object1;
-  }
-  else if (name == "transformed_model_bbox") {
-    CBBox3D bbox;
-    object_->getTransformedModelBBox(bbox);
-
-    value = Util::bbox3DToString(bbox);
-  }
-  else
-    return Object3D::getValue(name, args, value);
-
-  return true;
-}
-
-bool
-Model3DObj::
-setValue(const QString &name, const QString &value, const QStringList &args)
-{
-  auto fileToTexture = [&](const QString filename, bool flipY=true) {
+  static auto fileToTexture = [](Model3DObj *model, const QString filename, bool flipY=true) {
     CFile imageFile(filename.toStdString());
 
     if (! imageFile.exists())
@@ -137,10 +111,10 @@ setValue(const QString &name, const QString &value, const QStringList &args)
 
     auto *texture = dynamic_cast<Texture *>(CGeometry3DInst->createTexture(image));
 
-    return texture->glTexture(canvas_);
+    return texture->glTexture(model->canvas());
   };
 
-  auto resetShader = [&]() {
+  static auto resetShader = []() {
     if (s_program) {
       delete s_program;
 
@@ -148,92 +122,205 @@ setValue(const QString &name, const QString &value, const QStringList &args)
     }
   };
 
-  //---
+  // geometry object holding animation data (referenced object for ref model)
+  static auto animObject = [](Model3DObj *model) {
+    auto *geomObject = dynamic_cast<GeomObject *>(model->object());
 
-  if      (name == "diffuse_texture") {
-    diffuseTexture_ = fileToTexture(value);
+    auto *geomObject1 = geomObject;
 
-    needsUpdate_ = true;
-  }
-  else if (name == "specular_texture") {
-    specularTexture_ = fileToTexture(value);
+    if (geomObject->refObject()) {
+      geomObject1 = dynamic_cast<GeomObject *>(geomObject->refObject());
+      assert(geomObject1);
+    }
 
-    needsUpdate_ = true;
-  }
-  else if (name == "normal_texture") {
-    normalTexture_ = fileToTexture(value);
+    return geomObject1;
+  };
 
-    needsUpdate_ = true;
-  }
-  else if (name == "emissive_texture") {
-    emissiveTexture_ = fileToTexture(value);
+  static Table table({
+    { "ref_object",
+      [](Object3D *obj, const QStringList &, QVariant &) {
+        auto *model = static_cast<Model3DObj *>(obj);
 
-    needsUpdate_ = true;
-  }
-  else if (name == "vert_shader") {
-    vertShaderFile_ = value;
+        if (! model->object())
+          return false;
 
-    resetShader();
-  }
-  else if (name == "frag_shader") {
-    fragShaderFile_ = value;
+        auto *object1 = model->object_->createRef();
 
-    resetShader();
-  }
-  else if (name == "anim.name") {
-    auto *geomObject = dynamic_cast<GeomObject *>(object_);
+        object1->setInd(CGeometry3DInst->nextObjectId());
 
-    auto *geomObject1 = geomObject;
+        auto *scene = model->canvas()->scene();
 
-    if (geomObject->refObject()) {
-      geomObject1 = dynamic_cast<GeomObject *>(geomObject->refObject());
-      assert(geomObject1);
-    }
+        scene->addObject(object1);
 
-    geomObject1->setAnimName(value.toStdString());
+        auto children = object1->hierChildren();
 
-    needsUpdate_ = true;
+        for (auto *child : children) {
+          child->setInd(CGeometry3DInst->nextObjectId());
 
-    canvas_->invalidateNodeMatrices();
-  }
-  else if (name == "anim.repeat") {
-    auto *geomObject = dynamic_cast<GeomObject *>(object_);
+          scene->addObject(child);
+        }
 
-    auto *geomObject1 = geomObject;
+        scene->addObject(object1);
 
-    if (geomObject->refObject()) {
-      geomObject1 = dynamic_cast<GeomObject *>(geomObject->refObject());
-      assert(geomObject1);
-    }
+        QStringList args;
+        auto *refModel = dynamic_cast<Model3DObj *>(create(model->canvas(), args));
+        if (! refModel) return false;
 
-    geomObject1->setAnimRepeat(Util::stringToBool(value));
-  }
-  else if (name == "anim.step") {
-    auto *geomObject = dynamic_cast<GeomObject *>(object_);
+        refModel->object_ = object1;
+
+        return true;
+      }, nullptr },
+    { "transformed_model_bbox",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        CBBox3D bbox;
+        static_cast<Model3DObj *>(obj)->object()->getTransformedModelBBox(bbox);
+
+        value = Util::bbox3DToString(bbox);
 
-    auto *geomObject1 = geomObject;
+        return true;
+      }, nullptr },
+    { "mesh_cache",
+      [](Object3D *, const QStringList &, QVariant &value) {
+        value = isMeshCache(); return true;
+      },
+      [](Object3D *, const QString &value, const QStringList &) {
+        setMeshCache(Util::stringToBool(value)); return true;
+      } },
+    { "update.threads",
+      [](Object3D *, const QStringList &, QVariant &value) {
+        value = int(numUpdateThreads()); return true;
+      },
+      [](Object3D *, const QString &value, const QStringList &) {
+        setNumUpdateThreads(size_t(std::max(Util::stringToInt(value), 0))); return true;
+      } },
+    { "cached",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = static_cast<Model3DObj *>(obj)->isCached(); return true;
+      }, nullptr },
+    { "diffuse_texture", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *model = static_cast<Model3DObj *>(obj);
 
-    if (geomObject->refObject()) {
-      geomObject1 = dynamic_cast<GeomObject *>(geomObject->refObject());
-      assert(geomObject1);
-    }
+        model->diffuseTexture_ = fileToTexture(model, value);
 
-    geomObject1->setAnimTimeStep(Util::stringToReal(value));
-  }
-  else if (name == "child.visible") {
-    if (args.size() < 1)
-      return false;
+        model->needsUpdate_ = true;
 
-    auto *child = object_->getChildOfName(value.toStdString());
-    if (! child) return false;
+        return true;
+      } },
+    { "specular_texture", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *model = static_cast<Model3DObj *>(obj);
 
-    child->setVisible(Util::stringToBool(args[0]));
+        model->specularTexture_ = fileToTexture(model, value);
 
-  }
-  else
-    return Object3D::setValue(name, value, args);
+        model->needsUpdate_ = true;
 
-  return true;
+        return true;
+      } },
+    { "normal_texture", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *model = static_cast<Model3DObj *>(obj);
+
+        model->normalTexture_ = fileToTexture(model, value);
+
+        model->needsUpdate_ = true;
+
+        return true;
+      } },
+    { "emissive_texture", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *model = static_cast<Model3DObj *>(obj);
+
+        model->emissiveTexture_ = fileToTexture(model, value);
+
+        model->needsUpdate_ = true;
+
+        return true;
+      } },
+    { "vert_shader", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<Model3DObj *>(obj)->vertShaderFile_ = value;
+
+        resetShader();
+
+        return true;
+      } },
+    { "frag_shader", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<Model3DObj *>(obj)->fragShaderFile_ = value;
+
+        resetShader();
+
+        return true;
+      } },
+    { "anim.name", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *model = static_cast<Model3DObj *>(obj);
+
+        animObject(model)->setAnimName(value.toStdString());
+
+        model->needsUpdate_ = true;
+
+        model->canvas()->invalidateNodeMatrices();
+
+        return true;
+      } },
+    { "anim.repeat", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *model = static_cast<Model3DObj *>(obj);
+
+        animObject(model)->setAnimRepeat(Util::stringToBool(value));
+
+        return true;
+      } },
+    { "anim.step", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *model = static_cast<Model3DObj *>(obj);
+
+        animObject(model)->setAnimTimeStep(Util::stringToReal(value));
+
+        return true;
+      } },
+    { "child.visible", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &args) {
+        if (args.size() < 1)
+          return false;
+
+        auto *child = static_cast<Model3DObj *>(obj)->object()->
+                        getChildOfName(value.toStdString());
+        if (! child) return false;
+
+        child->setVisible(Util::stringToBool(args[0]));
+
+        return true;
+      } },
+  }, &Object3D::properties());
+
+  return table;
+}
+
+bool
+Model3DObj::
+getValue(const QString &name, const QStringList &args, QVariant &value)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
+
+  return Object3D::getValue(name, args, value);
+}
+
+bool
+Model3DObj::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object3D::setValue(name, value, args);
 }
 
 bool
@@ -251,7 +338,7 @@ exec(const QString &op, const QStringList &args, QVariant &res)
     if (! Util::stringToPoint3D(tcl, args[0], p))
       return false;
 
-    object_->setTranslate(p.x, p.y, p.z);
+    object()->setTranslate(p.x, p.y, p.z);
 
     transformed_ = true;
 
@@ -265,7 +352,7 @@ exec(const QString &op, const QStringList &args, QVariant &res)
     if (! Util::stringToPoint3D(tcl, args[0], p))
       return false;
 
-    object_->setScale(p.x, p.y, p.z);
+    object()->setScale(p.x, p.y, p.z);
 
     transformed_ = true;
 
@@ -283,12 +370,33 @@ exec(const QString &op, const QStringList &args, QVariant &res)
     if (! Util::stringToReal(args[1], a))
       return false;
 
-    object_->setRotate(Util::degToRad(a), CVector3D(p.x, p.y, p.z));
+    object()->setRotate(Util::degToRad(a), CVector3D(p.x, p.y, p.z));
 
     transformed_ = true;
 
     setNeedsUpdate();
   }
+  else if (op == "benchmark.load") {
+    // args: model files (default data models)
+    auto filenames = args;
+
+    if (filenames.empty())
+      filenames << "data/gear.stl" << "data/robocop2.3ds";
+
+    res = loadBenchmark(filenames);
+  }
+  else if (op == "benchmark.update") {
+    // args: [threads]
+    res = updateBenchmark(args);
+  }
+  else if (op == "benchmark.anim") {
+    // args: [steps]
+    res = animBenchmark(args);
+  }
+  else if (op == "benchmark.skinning") {
+    // args: [steps]
+    res = skinningBenchmark(args);
+  }
   else
     return Object3D::exec(op, args, res);
 
@@ -300,15 +408,29 @@ Model3DObj::
 load(const QString &filename)
 {
   // TODO: reuse object to add nore objects ?
-  assert(! object_);
+  assert(! object_ && ! isCached_);
 
-  //---
+  filename_ = filename;
 
-  auto *app = canvas_->app();
+  // use compiled mesh cache if valid for file
+  if (s_meshCache && loadMeshCache())
+    return true;
 
-  filename_ = filename;
+  if (! importModel())
+    return false;
+
+  writeMeshCache_ = s_meshCache;
+
+  return true;
+}
+
+bool
+Model3DObj::
+importModel()
+{
+  auto *app = canvas_->app();
 
-  QFileInfo fi(filename);
+  QFileInfo fi(filename_);
 
   auto suffix = fi.suffix().toLower();
   auto type   = CImportBase::suffixToType(suffix.toStdString());
@@ -378,11 +500,43 @@ load(const QString &filename)
     scene1->addTexture(texture);
   }
 
+  //---
+
+  // key objects by source file so instances of the model share animation clips
+  auto fileKey = QFileInfo(filename_).absoluteFilePath().toStdString();
+
+  std::function<void (CGeomObject3D *)> setClipKey = [&](CGeomObject3D *object) {
+    canvas_->setAnimClipKey(object, fileKey + ":" + object->getName());
+
+    for (auto *child : object->children())
+      setClipKey(child);
+  };
+
+  setClipKey(object_);
+
+  //---
+
+  clearCacheMeshes();
+
   needsUpdate_ = true;
 
   return true;
 }
 
+CGeomObject3D *
+Model3DObj::
+object() const
+{
+  // scene objects are only needed for edits so import on demand
+  if (isCached_ && ! object_) {
+    auto *th = const_cast<Model3DObj *>(this);
+
+    (void) th->importModel();
+  }
+
+  return object_;
+}
+
 void
 Model3DObj::
 tick()
@@ -452,7 +606,10 @@ render()
   else if (dt_ < 0 && t <= 0.0)
     dt_ = -dt_;
 
-  drawObject(object_, elapsed_);
+  if (isCached_)
+    drawCacheMeshes(elapsed_);
+  else if (object_)
+    drawObject(object_, elapsed_);
 }
 
 void
@@ -492,6 +649,19 @@ initDraw(double t)
   canvas_->setProgramLights(s_program);
 }
 
+Model3DObj::RenderState
+Model3DObj::
+renderState()
+{
+  // face textures vary per mesh so only object texture is used for sort
+  RenderState state;
+
+  state.program = s_program;
+  state.texture = diffuseTexture_;
+
+  return state;
+}
+
 void
 Model3DObj::
 drawObject(CGeomObject3D *object, double t)
@@ -564,12 +734,28 @@ drawObject(CGeomObject3D *object, double t)
 
   //---
 
-  bool textured = canvas_->isTextured();
+  // render model
+  drawFaces(geomObject1->faceDatas());
+
+  //buffer->unbind();
 
   //---
 
-  // render model
-  for (const auto &faceData : geomObject1->faceDatas()) {
+  for (auto *child : geomObject->children()) {
+    if (! child->getVisible())
+      continue;
+
+    drawObject(child, t);
+  }
+}
+
+void
+Model3DObj::
+drawFaces(const std::vector<FaceData> &faceDatas)
+{
+  bool textured = canvas_->isTextured();
+
+  for (const auto &faceData : faceDatas) {
     // diffuse (texture 0)
     auto *diffuseTexture = faceData.diffuseTexture;
 
@@ -581,8 +767,7 @@ drawObject(CGeomObject3D *object, double t)
     s_program->setUniformValue("diffuseTexture.enabled", textured && useDiffuseTexture);
 
     if (useDiffuseTexture) {
-      glActiveTexture(GL_TEXTURE0);
-      diffuseTexture->bind();
+      canvas_->bindTexture(diffuseTexture, 0);
 
       s_program->setUniformValue("diffuseTexture.texture", 0);
     }
@@ -600,8 +785,7 @@ drawObject(CGeomObject3D *object, double t)
     s_program->setUniformValue("normalTexture.enabled", textured && useNormalTexture);
 
     if (useNormalTexture) {
-      glActiveTexture(GL_TEXTURE1);
-      normalTexture->bind();
+      canvas_->bindTexture(normalTexture, 1);
 
       s_program->setUniformValue("normalTexture.texture", 1);
     }
@@ -619,8 +803,7 @@ drawObject(CGeomObject3D *object, double t)
     s_program->setUniformValue("specularTexture.enabled", textured && useSpecularTexture);
 
     if (useSpecularTexture) {
-      glActiveTexture(GL_TEXTURE2);
-      specularTexture->bind();
+      canvas_->bindTexture(specularTexture, 2);
 
       s_program->setUniformValue("specularTexture.texture", 2);
     }
@@ -638,8 +821,7 @@ drawObject(CGeomObject3D *object, double t)
     s_program->setUniformValue("emissiveTexture.enabled", textured && useEmissiveTexture);
 
     if (useEmissiveTexture) {
-      glActiveTexture(GL_TEXTURE3);
-      emissiveTexture->bind();
+      canvas_->bindTexture(emissiveTexture, 3);
 
       s_program->setUniformValue("emissiveTexture.texture", 3);
     }
@@ -671,17 +853,6 @@ drawObject(CGeomObject3D *object, double t)
     //glDrawArrays(GL_TRIANGLES, faceData.pos, faceData.len);
     }
   }
-
-  //buffer->unbind();
-
-  //---
-
-  for (auto *child : geomObject->children()) {
-    if (! child->getVisible())
-      continue;
-
-    drawObject(child, t);
-  }
 }
 
 void
@@ -706,7 +877,24 @@ updateObjectData()
     //std::cerr << "Scene Center : " << sceneCenter_.getX() << " " <<
     //             sceneCenter_.getY() << " " << sceneCenter_.getZ() << "\n";
 
+    sceneBBox_ = bbox_;
+
     updateObject(object_);
+
+    if (writeMeshCache_) {
+      writeMeshCache_ = false;
+
+      writeMeshCache();
+    }
+  }
+  else if (isCached_) {
+    if (meshCache_)
+      updateCacheMeshes();
+
+    bbox_ = sceneBBox_;
+
+    sceneSize    = bbox_.getSize();
+    sceneCenter_ = bbox_.getCenter();
   }
 
   //---
@@ -725,194 +913,342 @@ updateObjectData()
   }
 }
 
+// vertex data build of one object: prepared (matrices, buffer, face colors and GL textures)
+// on the GUI thread, vertices filled by a worker thread and uploaded on the GUI thread
+struct Model3DObj::ObjectUpdate {
+  using FaceColors = std::vector<CRGBA>;
+
+  GeomObject* object      { nullptr };
+  CQGLBuffer* buffer      { nullptr };
+  CMatrix3DH  modelMatrix;
+  CMatrix3DH  meshMatrix;
+  bool        isAnim      { false };
+  FaceDatas   faceDatas;
+  FaceColors  faceColors;
+  uint        numVertices { 0 };
+  bool        hasBones    { false };
+  CBBox3D     bbox;
+};
+
+size_t
+Model3DObj::
+numUpdateThreads()
+{
+  return updatePool()->numThreads();
+}
+
 void
 Model3DObj::
-updateObject(CGeomObject3D *object)
+setNumUpdateThreads(size_t n)
 {
-  auto *geomObject = dynamic_cast<GeomObject *>(object);
+  updatePool()->setNumThreads(n);
+}
 
-  //---
+CThreadPool *
+Model3DObj::
+updatePool()
+{
+  if (! s_updatePool)
+    s_updatePool = new CThreadPool;
 
-  if (geomObject->refObject()) {
-    auto *geomObject1 = dynamic_cast<GeomObject *>(geomObject->refObject());
+  return s_updatePool;
+}
 
-    updateObject(geomObject1);
-  }
+void
+Model3DObj::
+updateObject(CGeomObject3D *object)
+{
+  // prepare each object (and its ref object) once in hierarchy order
+  ObjectUpdates updates;
+  ObjectSet     done;
+
+  prepareObjectUpdates(object, updates, done);
 
   //---
 
-  int    boneNodeIds[4];
-  double boneWeights[4];
+  // build vertex data of objects in parallel, largest first, each object is
+  // claimed by a single thread so object vertex state is not shared
+  std::vector<size_t> order(updates.size());
 
-  //---
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
 
-  auto modelMatrix = CMatrix3DH(object->getHierTransform());
-  auto meshMatrix  = CMatrix3DH(object->getMeshGlobalTransform());
+  std::stable_sort(order.begin(), order.end(), [&](size_t i1, size_t i2) {
+    return (updates[i1].numVertices > updates[i2].numVertices);
+  });
 
-  //---
+  auto *pool = updatePool();
 
-  auto *animObject = object->getAnimObject();
+  std::atomic<size_t> next { 0 };
 
-  auto animName = (animObject ? animObject->animName() : "");
+  pool->parallelFor(pool->numChunks(order.size()), [&](size_t, size_t, size_t) {
+    size_t i;
 
-  bool isAnim = false;
+    while ((i = next.fetch_add(1)) < order.size())
+      buildObjectVertices(updates[order[i]]);
+  });
 
-  if (canvas_->isAnimEnabled())
-    isAnim = (animObject && animName != "");
+  //---
 
-  //double animTime { 0.0 };
+  // upload
+  for (auto &update : updates) {
+    if (update.isAnim && ! update.hasBones)
+      update.buffer->disableBonesPart();
 
-  if (isAnim) {
-    //animTime = animObject->animTime();
+    update.object->setBBox(update.bbox);
 
-    auto meshNodeId = object->getMeshNode();
+    for (const auto &faceData : update.faceDatas)
+      update.object->addFaceData(faceData);
 
-    CGeomNodeData *node = nullptr;
+    update.buffer->load();
 
-    if (meshNodeId >= 0)
-      node = const_cast<CGeomNodeData *>(&animObject->getNode(meshNodeId));
+    bbox_ = update.bbox;
+  }
+}
 
-    auto isJointed = (node && object->isJointed());
+void
+Model3DObj::
+prepareObjectUpdates(CGeomObject3D *object, ObjectUpdates &updates, ObjectSet &done)
+{
+  auto *geomObject = dynamic_cast<GeomObject *>(object);
 
-    if (node && ! isJointed) {
-      auto &objectMeshData = canvas_->getObjectMeshData(object);
+  //---
 
-      objectMeshData.nt = object->animTimeFrames();
+  if (geomObject->refObject())
+    prepareObjectUpdates(geomObject->refObject(), updates, done);
 
-      (void) animObject->getAnimationTranslationRange(animName,
-               objectMeshData.tmin, objectMeshData.tmax);
+  //---
 
-      if (objectMeshData.nt > 1)
-        objectMeshData.dt = (objectMeshData.tmax - objectMeshData.tmin)/(objectMeshData.nt - 1);
-      else
-        objectMeshData.dt = (objectMeshData.tmax - objectMeshData.tmin);
+  if (done.find(object) == done.end()) {
+    done.insert(object);
 
-      for (int i = 0; i < objectMeshData.nt; ++i) {
-        auto animTime1 = objectMeshData.tmin + i*objectMeshData.dt;
+    ObjectUpdate update;
 
-        auto meshMatrix1 =
-          CMatrix3DH(object->getNodeAnimHierTransform(*node, animName, animTime1));
+    update.object = geomObject;
 
-        objectMeshData.frameMatrix[i] = meshMatrix1;
-      }
-    }
-  }
+    //---
 
-  //---
+    update.modelMatrix = CMatrix3DH(object->getHierTransform());
+    update.meshMatrix  = CMatrix3DH(object->getMeshGlobalTransform());
 
-  auto *buffer = geomObject->initBuffer(canvas_);
+    //---
 
-  //---
+    auto *animObject = object->getAnimObject();
 
-  auto *objectMaterial = object->getMaterialP();
+    auto animName = (animObject ? animObject->animName() : "");
 
-  auto *diffuseTexture  = object->getDiffuseTexture();
-  auto *specularTexture = object->getSpecularTexture();
-  auto *normalTexture   = object->getNormalTexture();
-  auto *emissiveTexture = object->getEmissiveTexture();
+    if (canvas_->isAnimEnabled())
+      update.isAnim = (animObject && animName != "");
 
-  //---
+    if (update.isAnim) {
+      auto meshNodeId = object->getMeshNode();
 
-  bbox_ = CBBox3D();
+      CGeomNodeData *node = nullptr;
 
-  int pos = 0;
+      if (meshNodeId >= 0)
+        node = const_cast<CGeomNodeData *>(&animObject->getNode(meshNodeId));
 
-  const auto &faces = geomObject->getFaces();
+      auto isJointed = (node && object->isJointed());
 
-  for (const auto *face : faces) {
-    FaceData faceData;
+      if (node && ! isJointed) {
+        auto &objectMeshData = canvas_->getObjectMeshData(object);
 
-    faceData.face = const_cast<CGeomFace3D *>(face);
+        objectMeshData.nt = object->animTimeFrames();
 
-    //---
+        // mesh frames are sampled once per model source
+        const auto &meshFrames = AnimClipCache::instance()->getMeshFrames(
+          canvas_->animClipKey(object), object, meshNodeId, animName, objectMeshData.nt);
 
-    auto *faceMaterial = faceData.face->getMaterialP();
+        objectMeshData.tmin = meshFrames.tmin;
+        objectMeshData.tmax = meshFrames.tmax;
+        objectMeshData.dt   = meshFrames.dt;
 
-    if (! faceMaterial && objectMaterial)
-      faceMaterial = objectMaterial;
+        for (int i = 0; i < objectMeshData.nt; ++i)
+          objectMeshData.frameMatrix[i] = meshFrames.matrices[size_t(i)];
+      }
+    }
 
     //---
 
-    auto color = face->color().value_or(CRGBA(1, 1, 1));
+    // GL objects must be created on GUI thread
+    update.buffer = geomObject->initBuffer(canvas_);
+
+    //---
 
-    if (faceMaterial && faceMaterial->diffuse())
-      color = faceMaterial->diffuse().value();
+    auto *objectMaterial = object->getMaterialP();
 
-    faceData.color = Util::RGBAToQColor(color);
+    auto *diffuseTexture  = object->getDiffuseTexture();
+    auto *specularTexture = object->getSpecularTexture();
+    auto *normalTexture   = object->getNormalTexture();
+    auto *emissiveTexture = object->getEmissiveTexture();
 
     //---
 
-    // set face textures
-    auto *diffuseTexture1  = face->getDiffuseTexture();
-    auto *normalTexture1   = face->getNormalTexture();
-    auto *specularTexture1 = face->getSpecularTexture();
-    auto *emissiveTexture1 = face->getEmissiveTexture();
-
-    if (! diffuseTexture1 ) diffuseTexture1  = diffuseTexture;
-    if (! normalTexture1  ) normalTexture1   = normalTexture;
-    if (! specularTexture1) specularTexture1 = specularTexture;
-    if (! emissiveTexture1) emissiveTexture1 = emissiveTexture;
-
-    if (faceMaterial) {
-      if (faceMaterial->diffuseTexture ()) diffuseTexture1  = faceMaterial->diffuseTexture ();
-      if (faceMaterial->normalTexture  ()) normalTexture1   = faceMaterial->normalTexture  ();
-      if (faceMaterial->specularTexture()) specularTexture1 = faceMaterial->specularTexture();
-      if (faceMaterial->emissiveTexture()) emissiveTexture1 = faceMaterial->emissiveTexture();
-    }
+    int pos = 0;
 
-    if (diffuseTexture1)
-      faceData.diffuseTexture = getGLTexture(diffuseTexture1, /*add*/true);
+    const auto &faces = geomObject->getFaces();
 
-    if (normalTexture1)
-      faceData.normalTexture = getGLTexture(normalTexture1, /*add*/true);
+    update.faceDatas .reserve(faces.size());
+    update.faceColors.reserve(faces.size());
 
-    if (specularTexture1)
-      faceData.specularTexture = getGLTexture(specularTexture1, /*add*/true);
+    for (const auto *face : faces) {
+      FaceData faceData;
 
-    if (emissiveTexture1)
-      faceData.emissiveTexture = getGLTexture(emissiveTexture1, /*add*/true);
+      faceData.face = const_cast<CGeomFace3D *>(face);
 
-    //---
+      //---
 
-    const auto &vertices = face->getVertices();
+      auto *faceMaterial = faceData.face->getMaterialP();
 
-    //---
+      if (! faceMaterial && objectMaterial)
+        faceMaterial = objectMaterial;
 
-    // get face normal
-    CVector3D normal;
+      //---
 
-    if (face->getNormalSet())
-      normal = face->getNormal();
-    else {
-      for (const auto &v : vertices) {
-        auto &vertex = object->getVertex(v);
+      auto color = face->color().value_or(CRGBA(1, 1, 1));
 
-        vertex.setViewed(vertex.getModel());
-      }
+      if (faceMaterial && faceMaterial->diffuse())
+        color = faceMaterial->diffuse().value();
 
-      face->calcModelNormal(normal);
-    }
+      faceData.color = Util::RGBAToQColor(color);
 
-    //---
+      //---
 
-    faceData.pos = pos;
-    faceData.len = int(vertices.size());
+      // set face textures
+      auto *diffuseTexture1  = face->getDiffuseTexture();
+      auto *normalTexture1   = face->getNormalTexture();
+      auto *specularTexture1 = face->getSpecularTexture();
+      auto *emissiveTexture1 = face->getEmissiveTexture();
+
+      if (! diffuseTexture1 ) diffuseTexture1  = diffuseTexture;
+      if (! normalTexture1  ) normalTexture1   = normalTexture;
+      if (! specularTexture1) specularTexture1 = specularTexture;
+      if (! emissiveTexture1) emissiveTexture1 = emissiveTexture;
+
+      if (faceMaterial) {
+        if (faceMaterial->diffuseTexture ()) diffuseTexture1  = faceMaterial->diffuseTexture ();
+        if (faceMaterial->normalTexture  ()) normalTexture1   = faceMaterial->normalTexture  ();
+        if (faceMaterial->specularTexture()) specularTexture1 = faceMaterial->specularTexture();
+        if (faceMaterial->emissiveTexture()) emissiveTexture1 = faceMaterial->emissiveTexture();
+      }
 
-    int iv = 0;
+      if (diffuseTexture1)
+        faceData.diffuseTexture = getGLTexture(diffuseTexture1, /*add*/true);
 
-    for (const auto &v : vertices) {
-      const auto &vertex = geomObject->getVertex(v);
-      const auto &model  = vertex.getModel();
+      if (normalTexture1)
+        faceData.normalTexture = getGLTexture(normalTexture1, /*add*/true);
 
-      auto model1 = meshMatrix *model;
-      auto model2 = modelMatrix*model1;
+      if (specularTexture1)
+        faceData.specularTexture = getGLTexture(specularTexture1, /*add*/true);
+
+      if (emissiveTexture1)
+        faceData.emissiveTexture = getGLTexture(emissiveTexture1, /*add*/true);
 
       //---
 
-      // update color, normal for custom vertex value
+      faceData.pos = pos;
+      faceData.len = int(face->getVertices().size());
 
-      auto normal1 = normal;
-      auto color1  = color;
+      pos += faceData.len;
+
+      update.faceDatas .push_back(faceData);
+      update.faceColors.push_back(color);
+    }
+
+    update.numVertices = uint(pos);
+
+    updates.push_back(std::move(update));
+  }
+
+  //---
+
+  for (auto *child : geomObject->children()) {
+    if (! child->getVisible())
+      continue;
+
+    prepareObjectUpdates(child, updates, done);
+  }
+}
+
+void
+Model3DObj::
+buildObjectVertices(ObjectUpdate &update)
+{
+  // called from worker thread: only reads shared state and writes object's own
+  // vertices, buffer arrays and update data
+  auto *object = update.object;
+  auto *buffer = update.buffer;
+
+  uint types = CQGLBuffer::IND | CQGLBuffer::POINT | CQGLBuffer::NORMAL |
+               CQGLBuffer::COLOR | CQGLBuffer::TEXTURE;
+
+  if (update.isAnim)
+    types |= CQGLBuffer::BONE;
+
+  buffer->resizeVertices(types, update.numVertices);
+
+  //---
+
+  update.bbox = CBBox3D();
+
+  const auto &faces = object->getFaces();
+
+  for (size_t i = 0; i < faces.size(); ++i) {
+    const auto *face     = faces[i];
+    const auto &faceData = update.faceDatas[i];
+    const auto &color    = update.faceColors[i];
+
+    const auto &vertices = face->getVertices();
+
+    //---
+
+    // get face normal
+    CVector3D normal;
+
+    if (face->getNormalSet())
+      normal = face->getNormal();
+    else {
+      for (const auto &v : vertices) {
+        auto &vertex = object->getVertex(v);
+
+        vertex.setViewed(vertex.getModel());
+      }
+
+      face->calcModelNormal(normal);
+    }
+
+    //---
+
+    // normal map image (read only)
+    const QImage *normalImage = nullptr;
+    int           tw = 0, th = 0;
+
+    if (faceData.normalTexture) {
+      normalImage = &faceData.normalTexture->getImage();
+
+      tw = faceData.normalTexture->getWidth ();
+      th = faceData.normalTexture->getHeight();
+    }
+
+    //---
+
+    auto ip = uint(faceData.pos);
+
+    int iv = 0;
+
+    for (const auto &v : vertices) {
+      const auto &vertex = object->getVertex(v);
+      const auto &model  = vertex.getModel();
+
+      auto model1 = update.meshMatrix *model;
+      auto model2 = update.modelMatrix*model1;
+
+      //---
+
+      // update color, normal for custom vertex value
+
+      auto normal1 = normal;
+      auto color1  = color;
 
       if      (face->hasVertexNormals())
         normal1 = face->getVertexNormal(iv);
@@ -924,7 +1260,7 @@ updateObject(CGeomObject3D *object)
 
       //---
 
-      if (faceData.normalTexture) {
+      if (normalImage) {
         CPoint2D tpoint;
 
         if (vertex.hasTextureMap())
@@ -932,14 +1268,11 @@ updateObject(CGeomObject3D *object)
         else
           tpoint = face->getTexturePoint(vertex, iv);
 
-        int tw = faceData.normalTexture->getWidth ();
-        int th = faceData.normalTexture->getHeight();
-
         auto tx = CMathUtil::clamp(tpoint.x, 0.0, 1.0);
         auto ty = CMathUtil::clamp(tpoint.y, 0.0, 1.0);
 
         // get normal value from texture
-        auto rgba = faceData.normalTexture->getImage().pixel(tx*(tw - 1), ty*(th - 1));
+        auto rgba = normalImage->pixel(int(tx*(tw - 1)), int(ty*(th - 1)));
         auto tnormal = CVector3D(qRed(rgba)/255.0, qGreen(rgba)/255.0, qBlue(rgba)/255.0);
 
         // this normal is in tangent space
@@ -948,27 +1281,36 @@ updateObject(CGeomObject3D *object)
 
       //---
 
-      buffer->addInd(vertex.getInd());
+      buffer->setInd(ip, int(vertex.getInd()));
 
-      buffer->addPoint(float(model.x), float(model.y), float(model.z));
+      buffer->setPoint(ip, CQGLBuffer::Point(float(model.x), float(model.y), float(model.z)));
 
-      buffer->addNormal(float(normal1.getX()), float(normal1.getY()), float(normal1.getZ()));
+      buffer->setNormal(ip, CQGLBuffer::Point(float(normal1.getX()), float(normal1.getY()),
+                                              float(normal1.getZ())));
 
-      buffer->addColor(color1);
+      buffer->setColor(ip, CQGLBuffer::Color(float(color1.getRedF()), float(color1.getGreenF()),
+                                             float(color1.getBlueF())));
 
       //---
 
-      if (isAnim) {
+      if (update.isAnim) {
         if (vertex.hasJointData()) {
           const auto &jointData = vertex.getJointData();
 
-          for (int i = 0; i < 4; ++i) {
-            boneNodeIds[i] = jointData.nodeDatas[i].node;
-            boneWeights[i] = jointData.nodeDatas[i].weight;
+          int   boneNodeIds[4];
+          float boneWeights[4];
+
+          for (int j = 0; j < 4; ++j) {
+            boneNodeIds[j] = jointData.nodeDatas[j].node;
+            boneWeights[j] = float(jointData.nodeDatas[j].weight);
           }
 
-          buffer->addBoneIds    (boneNodeIds[0], boneNodeIds[1], boneNodeIds[2], boneNodeIds[3]);
-          buffer->addBoneWeights(boneWeights[0], boneWeights[1], boneWeights[2], boneWeights[3]);
+          buffer->setBoneIds(ip,
+            CQGLBuffer::IVector(boneNodeIds[0], boneNodeIds[1], boneNodeIds[2], boneNodeIds[3]));
+          buffer->setBoneWeights(ip,
+            CQGLBuffer::Vector(boneWeights[0], boneWeights[1], boneWeights[2], boneWeights[3]));
+
+          update.hasBones = true;
         }
       }
 
@@ -977,43 +1319,23 @@ updateObject(CGeomObject3D *object)
       if (faceData.diffuseTexture) {
         const auto &tpoint = face->getTexturePoint(vertex, iv);
 
-        buffer->addTexturePoint(float(tpoint.x), float(tpoint.y));
+        buffer->setTexturePoint(ip, CQGLBuffer::TexturePoint(float(tpoint.x), float(tpoint.y)));
       }
-      else
-        buffer->addTexturePoint(0.0f, 0.0f);
 
       //---
 
+      ++ip;
       ++iv;
 
-      bbox_ += model2;
+      update.bbox += model2;
     }
-
-    pos += faceData.len;
-
-    geomObject->addFaceData(faceData);
   }
 
   //---
 
-  if (! bbox_.isSet()) {
-    bbox_.add(CPoint3D(-1, -1, -1));
-    bbox_.add(CPoint3D( 1,  1,  1));
-  }
-
-  geomObject->setBBox(bbox_);
-
-  //---
-
-  buffer->load();
-
-  //---
-
-  for (auto *child : geomObject->children()) {
-    if (! child->getVisible())
-      continue;
-
-    updateObject(child);
+  if (! update.bbox.isSet()) {
+    update.bbox.add(CPoint3D(-1, -1, -1));
+    update.bbox.add(CPoint3D( 1,  1,  1));
   }
 }
 
@@ -1065,11 +1387,730 @@ makeTexture(const CImagePtr &image) const
 
 //---
 
+bool
+Model3DObj::
+loadMeshCache()
+{
+  MeshCache::Key key;
+
+  if (! MeshCache::sourceKey(filename_, key))
+    return false;
+
+  auto *cache = new MeshCache;
+
+  if (! cache->read(MeshCache::cacheFileName(filename_), key)) {
+    delete cache;
+    return false;
+  }
+
+  // textures are referenced by name (import if any are missing)
+  CacheTextures textures;
+
+  for (const auto &cacheTexture : cache->textures()) {
+    auto textureFile = findTextureFile(cacheTexture.name);
+
+    if (textureFile == "") {
+      delete cache;
+      return false;
+    }
+
+    CFile imageFile(textureFile.toStdString());
+
+    CImageFileSrc src(imageFile);
+
+    auto image = CImageMgrInst->createImage(src);
+
+    if (! image) {
+      delete cache;
+      return false;
+    }
+
+    auto *texture = dynamic_cast<Texture *>(CGeometry3DInst->createTexture(image));
+    assert(texture);
+
+    texture->setFlipped(cacheTexture.flipped);
+
+    textures.push_back(texture);
+  }
+
+  const auto *bbox = cache->bbox();
+
+  sceneBBox_ = CBBox3D();
+
+  sceneBBox_.add(CPoint3D(bbox[0], bbox[1], bbox[2]));
+  sceneBBox_.add(CPoint3D(bbox[3], bbox[4], bbox[5]));
+
+  meshCache_     = cache;
+  cacheTextures_ = textures;
+  isCached_      = true;
+  needsUpdate_   = true;
+
+  return true;
+}
+
+void
+Model3DObj::
+updateCacheMeshes()
+{
+  // upload mapped vertex data, then release mapping (cache textures are kept)
+  for (auto &cacheMesh : cacheMeshes_)
+    delete cacheMesh.buffer;
+
+  cacheMeshes_.clear();
+
+  auto rowMajorMatrix = [](const float *m) {
+    return QMatrix4x4(m);
+  };
+
+  for (const auto &mesh : meshCache_->meshes()) {
+    auto span = CQGLBuffer::typesSpan(mesh.types);
+    if (span == 0) continue;
+
+    auto numVertices = int(mesh.numData/span);
+
+    CacheMesh cacheMesh;
+
+    cacheMesh.meshMatrix  = rowMajorMatrix(mesh.meshMatrix);
+    cacheMesh.modelMatrix = rowMajorMatrix(mesh.modelMatrix);
+
+    for (uint32_t i = 0; i < mesh.numFaces; ++i) {
+      const auto &face = mesh.faces[i];
+
+      if (face.pos < 0 || face.len < 0 || face.pos + face.len > numVertices)
+        continue;
+
+      FaceData faceData;
+
+      faceData.pos   = face.pos;
+      faceData.len   = face.len;
+      faceData.color = QColor::fromRgbF(face.color[0], face.color[1], face.color[2],
+                                        face.color[3]);
+
+      auto faceTexture = [&](int j) {
+        auto ind = face.textures[j];
+
+        return (ind >= 0 ? getGLTexture(cacheTextures_[size_t(ind)], /*add*/true) : nullptr);
+      };
+
+      faceData.diffuseTexture  = faceTexture(0);
+      faceData.normalTexture   = faceTexture(1);
+      faceData.specularTexture = faceTexture(2);
+      faceData.emissiveTexture = faceTexture(3);
+
+      cacheMesh.faceDatas.push_back(faceData);
+    }
+
+    cacheMesh.buffer = s_program->createBuffer();
+
+    cacheMesh.buffer->setInterleavedData(mesh.types, mesh.data, mesh.numData);
+
+    cacheMesh.buffer->load();
+
+    cacheMeshes_.push_back(cacheMesh);
+  }
+
+  delete meshCache_;
+
+  meshCache_ = nullptr;
+}
+
+void
+Model3DObj::
+drawCacheMeshes(double t)
+{
+  updateObjectData();
+
+  //---
+
+  initDraw(t);
+
+  s_program->setUniformValue("useBonePoints", false);
+
+  for (const auto &cacheMesh : cacheMeshes_) {
+    s_program->setUniformValue("meshMatrix", cacheMesh.meshMatrix);
+    s_program->setUniformValue("model"     , cacheMesh.modelMatrix);
+
+    canvas_->bindBuffer(cacheMesh.buffer);
+
+    drawFaces(cacheMesh.faceDatas);
+  }
+}
+
+void
+Model3DObj::
+clearCacheMeshes()
+{
+  for (auto &cacheMesh : cacheMeshes_)
+    delete cacheMesh.buffer;
+
+  cacheMeshes_.clear();
+
+  // cache textures (and their GL textures) are only used by the cache meshes
+  for (auto *texture : cacheTextures_)
+    delete texture;
+
+  cacheTextures_.clear();
+
+  delete meshCache_;
+
+  meshCache_ = nullptr;
+  isCached_  = false;
+}
+
+void
+Model3DObj::
+writeMeshCache()
+{
+  MeshCache::Key key;
+
+  if (! MeshCache::sourceKey(filename_, key))
+    return;
+
+  MeshCache cache;
+
+  float bbox[6] = {
+    float(sceneBBox_.getXMin()), float(sceneBBox_.getYMin()), float(sceneBBox_.getZMin()),
+    float(sceneBBox_.getXMax()), float(sceneBBox_.getYMax()), float(sceneBBox_.getZMax()) };
+
+  cache.setBBox(bbox);
+
+  // skip models which can't be drawn from cache
+  if (! addCacheMesh(object_, cache))
+    return;
+
+  (void) cache.write(MeshCache::cacheFileName(filename_), key);
+}
+
+bool
+Model3DObj::
+addCacheMesh(CGeomObject3D *object, MeshCache &cache) const
+{
+  // add meshes in draw order (see drawObject)
+  auto *geomObject  = dynamic_cast<GeomObject *>(object);
+  auto *geomObject1 = geomObject;
+
+  if (geomObject->refObject()) {
+    geomObject1 = dynamic_cast<GeomObject *>(geomObject->refObject());
+    assert(geomObject1);
+  }
+
+  auto *buffer = geomObject1->buffer();
+
+  // bone weights need scene nodes
+  if (! buffer || buffer->hasBonesPart())
+    return false;
+
+  float meshMatrix[16], modelMatrix[16];
+
+  CQGLUtil::toQMatrix(CMatrix3DH(object->getMeshGlobalTransform())).copyDataTo(meshMatrix);
+  CQGLUtil::toQMatrix(CMatrix3DH(object->getHierTransform     ())).copyDataTo(modelMatrix);
+
+  std::vector<MeshCache::Face> faces;
+
+  for (const auto &faceData : geomObject1->faceDatas()) {
+    MeshCache::Face face;
+
+    face.pos = faceData.pos;
+    face.len = faceData.len;
+
+    face.color[0] = float(faceData.color.redF  ());
+    face.color[1] = float(faceData.color.greenF());
+    face.color[2] = float(faceData.color.blueF ());
+    face.color[3] = float(faceData.color.alphaF());
+
+    CQGLTexture *textures[MeshCache::NUM_TEXTURES] = {
+      faceData.diffuseTexture, faceData.normalTexture,
+      faceData.specularTexture, faceData.emissiveTexture };
+
+    for (int i = 0; i < MeshCache::NUM_TEXTURES; ++i) {
+      if (! textures[i])
+        continue;
+
+      // name of flipped texture has ".flip" suffix (see initGLTexture)
+      auto name    = textures[i]->getName();
+      bool flipped = false;
+
+      if (name.size() > 5 && name.substr(name.size() - 5) == ".flip") {
+        name    = name.substr(0, name.size() - 5);
+        flipped = true;
+      }
+
+      if (findTextureFile(name) == "")
+        return false;
+
+      face.textures[i] = cache.addTexture(name, flipped);
+    }
+
+    faces.push_back(face);
+  }
+
+  cache.addMesh(meshMatrix, modelMatrix, buffer->types(), buffer->interleavedData(),
+                buffer->numInterleavedData(), faces);
+
+  for (auto *child : geomObject->children()) {
+    if (! child->getVisible())
+      continue;
+
+    if (! addCacheMesh(child, cache))
+      return false;
+  }
+
+  return true;
+}
+
+QString
+Model3DObj::
+findTextureFile(const std::string &name) const
+{
+  if (name == "")
+    return "";
+
+  auto name1 = QString::fromStdString(name);
+
+  if (QFileInfo(name1).isFile())
+    return name1;
+
+  // model file directory then model dirs
+  QStringList dirs;
+
+  dirs << QFileInfo(filename_).path();
+
+  for (const auto &dir : canvas_->modelDirs())
+    dirs << dir;
+
+  for (const auto &dir : dirs) {
+    auto filename = QDir(dir).filePath(name1);
+
+    if (QFileInfo(filename).isFile())
+      return filename;
+  }
+
+  return "";
+}
+
+QString
+Model3DObj::
+loadBenchmark(const QStringList &filenames)
+{
+  // time import and buffer build against mesh cache read and upload for each file,
+  // then draw the cached object (benchmark objects are added to the scene)
+  using Clock = std::chrono::steady_clock;
+
+  auto msecs = [](const Clock::time_point &t1, const Clock::time_point &t2) {
+    return std::chrono::duration<double, std::milli>(t2 - t1).count();
+  };
+
+  canvas_->makeCurrent();
+
+  initShader();
+
+  auto saveMeshCache = s_meshCache;
+
+  s_meshCache = true;
+
+  QStringList lines;
+
+  for (const auto &filename : filenames) {
+    auto cacheFile = MeshCache::cacheFileName(filename);
+
+    QFile::remove(cacheFile);
+
+    // cold: import, build buffers and write cache
+    auto t1 = Clock::now();
+
+    auto *coldObj = new Model3DObj(canvas_);
+
+    if (! coldObj->load(filename)) {
+      delete coldObj;
+      lines << QString("%1: load failed").arg(filename);
+      continue;
+    }
+
+    auto t2 = Clock::now();
+
+    coldObj->updateObjectData();
+
+    auto t3 = Clock::now();
+
+    delete coldObj;
+
+    if (! QFileInfo(cacheFile).isFile()) {
+      lines << QString("%1: cold %2ms (import %3ms), not cacheable").
+                 arg(filename).arg(msecs(t1, t3)).arg(msecs(t1, t2));
+      continue;
+    }
+
+    // cached: map cache and upload
+    auto t4 = Clock::now();
+
+    auto *cachedObj = new Model3DObj(canvas_);
+
+    (void) cachedObj->load(filename);
+
+    auto t5 = Clock::now();
+
+    cachedObj->updateObjectData();
+
+    auto t6 = Clock::now();
+
+    bool isCached = cachedObj->isCached();
+
+    // draw from cache meshes (replaced by next canvas paint)
+    cachedObj->render();
+
+    canvas_->glFinish();
+
+    auto t7 = Clock::now();
+
+    delete cachedObj;
+
+    auto cold   = msecs(t1, t3);
+    auto cached = msecs(t4, t6);
+
+    lines << QString("%1: cold %2ms (import %3ms) cached %4ms (read %5ms) %6x%7, "
+                     "draw %8ms, cache %9KB").
+               arg(filename).arg(cold).arg(msecs(t1, t2)).arg(cached).arg(msecs(t4, t5)).
+               arg(cached > 0.0 ? cold/cached : 0.0).arg(isCached ? "" : " (cache not used)").
+               arg(msecs(t6, t7)).arg(QFileInfo(cacheFile).size()/1024);
+  }
+
+  s_meshCache = saveMeshCache;
+
+  canvas_->doneCurrent();
+
+  return lines.join("\n");
+}
+
+QString
+Model3DObj::
+updateBenchmark(const QStringList &args)
+{
+  // time vertex data build and upload of model with one thread and with n threads
+  // (default hardware concurrency), best of three runs each
+  if (! object())
+    return "no model";
+
+  auto numThreads = CThreadPool::hardwareThreads();
+
+  if (args.size() > 0)
+    numThreads = size_t(std::max(Util::stringToInt(args[0]), 1));
+
+  using Clock = std::chrono::steady_clock;
+
+  auto msecs = [](const Clock::time_point &t1, const Clock::time_point &t2) {
+    return std::chrono::duration<double, std::milli>(t2 - t1).count();
+  };
+
+  canvas_->makeCurrent();
+
+  initShader();
+
+  auto saveThreads = numUpdateThreads();
+
+  auto updateTime = [&](size_t n) {
+    setNumUpdateThreads(n);
+
+    double t = 1e100;
+
+    for (int i = 0; i < 3; ++i) {
+      auto t1 = Clock::now();
+
+      updateObject(object_);
+
+      auto t2 = Clock::now();
+
+      t = std::min(t, msecs(t1, t2));
+    }
+
+    return t;
+  };
+
+  auto serialTime   = updateTime(1);
+  auto parallelTime = updateTime(numThreads);
+
+  setNumUpdateThreads(saveThreads);
+
+  canvas_->doneCurrent();
+
+  //---
+
+  // count built objects and vertices
+  int  numObjects  = 0;
+  uint numVertices = 0;
+
+  std::function<void (CGeomObject3D *)> countObject = [&](CGeomObject3D *object) {
+    auto *geomObject = dynamic_cast<GeomObject *>(object);
+
+    if (geomObject->buffer()) {
+      ++numObjects;
+
+      numVertices += geomObject->buffer()->numPoints();
+    }
+
+    for (auto *child : geomObject->children()) {
+      if (child->getVisible())
+        countObject(child);
+    }
+  };
+
+  countObject(object_);
+
+  return QString("%1 objects, %2 vertices: 1 thread %3ms, %4 threads %5ms (%6x)").
+           arg(numObjects).arg(numVertices).arg(serialTime).arg(numThreads).arg(parallelTime).
+           arg(parallelTime > 0.0 ? serialTime/parallelTime : 0.0);
+}
+
+QString
+Model3DObj::
+skinningBenchmark(const QStringList &args)
+{
+  // time CPU skinning of model vertices for current anim name and time using per vertex
+  // Canvas3D::adjustAnimPoint against CSkinning3D (scalar, SIMD and SIMD with threads)
+  if (! object())
+    return "no model";
+
+  int numSteps = 10;
+
+  if (args.size() > 0)
+    numSteps = std::max(Util::stringToInt(args[0]), 1);
+
+  using Clock = std::chrono::steady_clock;
+
+  auto msecs = [](const Clock::time_point &t1, const Clock::time_point &t2) {
+    return std::chrono::duration<double, std::milli>(t2 - t1).count();
+  };
+
+  //---
+
+  // collect meshes of animated objects (skin meshes built once, weights are static)
+  struct SkinObject {
+    CGeomObject3D*      object     { nullptr };
+    CGeomObject3D*      animObject { nullptr };
+    CSkinning3D::Mesh   mesh;
+    CSkinning3D::Points points;
+  };
+
+  std::vector<SkinObject> skinObjects;
+
+  std::function<void (CGeomObject3D *)> addObject = [&](CGeomObject3D *object) {
+    auto *animObject = object->getAnimObject();
+
+    auto nv = object->getNumVertices();
+
+    if (animObject && animObject->getVisible() && animObject->animName() != "" && nv > 0) {
+      SkinObject skinObject;
+
+      skinObject.object     = object;
+      skinObject.animObject = animObject;
+
+      skinObject.mesh.resize(nv);
+
+      for (uint i = 0; i < nv; ++i) {
+        const auto &vertex = object->getVertex(i);
+        const auto &model  = vertex.getModel();
+
+        auto x = float(model.x), y = float(model.y), z = float(model.z);
+
+        const auto &jointData = vertex.getJointData();
+
+        if (vertex.hasJointData() && jointData.set) {
+          int    nodeIds[CSkinning3D::NUM_INFLUENCES];
+          double weights[CSkinning3D::NUM_INFLUENCES];
+
+          for (int j = 0; j < CSkinning3D::NUM_INFLUENCES; ++j) {
+            nodeIds[j] = jointData.nodeDatas[j].node;
+            weights[j] = jointData.nodeDatas[j].weight;
+          }
+
+          skinObject.mesh.setVertex(i, x, y, z, nodeIds, weights);
+        }
+        else
+          skinObject.mesh.setVertex(i, x, y, z);
+      }
+
+      skinObjects.push_back(std::move(skinObject));
+    }
+
+    for (auto *child : object->children()) {
+      if (child->getVisible())
+        addObject(child);
+    }
+  };
+
+  addObject(object_);
+
+  if (skinObjects.empty())
+    return "no animated objects";
+
+  //---
+
+  canvas_->invalidateNodeMatrices();
+
+  size_t numVertices = 0;
+
+  CSkinning3D::Jobs jobs;
+
+  for (auto &skinObject : skinObjects) {
+    CSkinning3D::Job job;
+
+    job.palette = &canvas_->getObjectPalette(skinObject.animObject);
+    job.mesh    = &skinObject.mesh;
+    job.points  = &skinObject.points;
+
+    jobs.push_back(job);
+
+    numVertices += skinObject.mesh.size();
+  }
+
+  //---
+
+  // reference per vertex path
+  std::vector<CPoint3D> refPoints(numVertices);
+
+  auto t1 = Clock::now();
+
+  for (int step = 0; step < numSteps; ++step) {
+    size_t ip = 0;
+
+    for (const auto &skinObject : skinObjects) {
+      const auto &nodeMatrices = canvas_->getObjectNodeMatrices(skinObject.animObject);
+
+      auto nv = skinObject.object->getNumVertices();
+
+      for (uint i = 0; i < nv; ++i) {
+        const auto &vertex = skinObject.object->getVertex(i);
+
+        refPoints[ip++] = canvas_->adjustAnimPoint(vertex, vertex.getModel(), nodeMatrices);
+      }
+    }
+  }
+
+  auto refTime = msecs(t1, Clock::now())/numSteps;
+
+  //---
+
+  auto skinTime = [&](CThreadPool *pool, bool simd) {
+    auto t2 = Clock::now();
+
+    for (int step = 0; step < numSteps; ++step)
+      CSkinning3D::skinMeshes(pool, jobs, simd);
+
+    return msecs(t2, Clock::now())/numSteps;
+  };
+
+  auto scalarTime   = skinTime(nullptr, false);
+  auto simdTime     = skinTime(nullptr, true);
+  auto parallelTime = skinTime(CThreadPool::instance(), true);
+
+  //---
+
+  // max difference from reference
+  double maxErr = 0.0;
+
+  size_t ip = 0;
+
+  for (const auto &skinObject : skinObjects) {
+    const auto &points = skinObject.points;
+
+    for (size_t i = 0; i < points.size(); ++i, ++ip) {
+      const auto &p = refPoints[ip];
+
+      maxErr = std::max(maxErr, std::abs(points.x[i] - p.x));
+      maxErr = std::max(maxErr, std::abs(points.y[i] - p.y));
+      maxErr = std::max(maxErr, std::abs(points.z[i] - p.z));
+    }
+  }
+
+  auto speedup = [&](double t) { return (t > 0.0 ? refTime/t : 0.0); };
+
+  return QString("%1 objects, %2 vertices: per vertex %3ms, scalar %4ms (%5x), "
+                 "simd %6ms (%7x), %8 threads %9ms (%10x), max error %11").
+           arg(skinObjects.size()).arg(numVertices).arg(refTime).
+           arg(scalarTime).arg(speedup(scalarTime)).
+           arg(simdTime).arg(speedup(simdTime)).
+           arg(CThreadPool::instance()->numThreads()).arg(parallelTime).
+           arg(speedup(parallelTime)).arg(maxErr);
+}
+
+QString
+Model3DObj::
+animBenchmark(const QStringList &args)
+{
+  // time node matrix update for current anim name using keyframes (hierarchy walk per
+  // node) against the pre-sampled clip cache (lerp per node)
+  if (! object())
+    return "no model";
+
+  int numSteps = 100;
+
+  if (args.size() > 0)
+    numSteps = std::max(Util::stringToInt(args[0]), 1);
+
+  // all animated objects on canvas (e.g. crowd of model instances)
+  auto animObjects = canvas_->getAnimObjects();
+
+  size_t numNodes = 0;
+
+  for (const auto &po : canvas_->calcNodeMatrices())
+    numNodes += po.second.size();
+
+  if (numNodes == 0)
+    return "no animated objects";
+
+  using Clock = std::chrono::steady_clock;
+
+  auto msecs = [](const Clock::time_point &t1, const Clock::time_point &t2) {
+    return std::chrono::duration<double, std::milli>(t2 - t1).count();
+  };
+
+  auto saveClipCache = canvas_->isAnimClipCache();
+
+  // step anim time as timer does. Anim time is not restored (CGeomObject3D only steps
+  // it) so each run advances the animations by 2*numSteps steps
+  auto updateTime = [&](bool clipCache) {
+    canvas_->setAnimClipCache(clipCache);
+
+    // sample clips before timing
+    (void) canvas_->getNodeMatrices();
+
+    auto t1 = Clock::now();
+
+    for (int step = 0; step < numSteps; ++step) {
+      for (auto *animObject : animObjects)
+        animObject->stepAnimTime();
+
+      canvas_->invalidateNodeMatrices();
+
+      (void) canvas_->getNodeMatrices();
+    }
+
+    return msecs(t1, Clock::now())/numSteps;
+  };
+
+  auto keyTime  = updateTime(false);
+  auto clipTime = updateTime(true);
+
+  canvas_->setAnimClipCache(saveClipCache);
+
+  // recalc node matrices for current anim time with restored mode
+  canvas_->invalidateNodeMatrices();
+
+  canvas_->update();
+
+  return QString("%1 anim objects, %2 nodes: keyframes %3ms, clip cache %4ms (%5x), "
+                 "%6 clips").
+           arg(animObjects.size()).arg(numNodes).arg(keyTime).arg(clipTime).
+           arg(clipTime > 0.0 ? keyTime/clipTime : 0.0).
+           arg(AnimClipCache::instance()->numClips());
+}
+
+//---
+
 void
 Model3DObj::
 calcTangents()
 {
-  if (! object_)
+  if (! object())
     return;
 
   calcTangents1(object_);
@@ -6,15 +6,21 @@
 
 #include <CImagePtr.h>
 
+#include <QMatrix4x4>
+
+#include <set>
+
 class CQGLBuffer;
 class CQGLTexture;
 class CGeomObject3D;
 class CGeomTexture;
+class CThreadPool;
 
 namespace CQSandbox {
 
 class Texture;
 class ShaderProgram;
+class MeshCache;
 
 class Model3DObj : public Object3D {
   Q_OBJECT
@@ -24,16 +30,30 @@ class Model3DObj : public Object3D {
 
   static ShaderProgram* shaderProgram() { return s_program; }
 
+  //! get/set load from (and write) compiled mesh cache file
+  static bool isMeshCache() { return s_meshCache; }
+  static void setMeshCache(bool b) { s_meshCache = b; }
+
+  //! get/set number of threads used to build model vertex data (0 is hardware concurrency)
+  static size_t numUpdateThreads();
+  static void setNumUpdateThreads(size_t n);
+
   //---
 
   Model3DObj(Canvas3D *canvas);
+ ~Model3DObj();
 
   const char *typeName() const override { return "Model"; }
 
   bool isAutoScale() const { return autoScale_; }
   void setAutoScale(bool b) { autoScale_ = b; }
 
-  CGeomObject3D *object() const { return object_; }
+  // model object (imported from source file if loaded from mesh cache)
+  CGeomObject3D *object() const;
+
+  bool isCached() const { return isCached_; }
+
+  static const PropertyTable<Object3D> &properties();
 
   bool getValue(const QString &name, const QStringList &args, QVariant &value) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
@@ -46,6 +66,8 @@ class Model3DObj : public Object3D {
 
   void render() override;
 
+  RenderState renderState() override;
+
   void initShader();
 
   void calcTangents();
@@ -53,16 +75,55 @@ class Model3DObj : public Object3D {
   void setModelMatrix(uint flags=ModelMatrixFlags::ALL) override;
 
  private:
+  struct ObjectUpdate;
+
+  using ObjectUpdates = std::vector<ObjectUpdate>;
+  using ObjectSet     = std::set<CGeomObject3D *>;
+
+  bool importModel();
+
   void updateObject(CGeomObject3D *object);
 
+  void prepareObjectUpdates(CGeomObject3D *object, ObjectUpdates &updates, ObjectSet &done);
+
+  static void buildObjectVertices(ObjectUpdate &update);
+
+  static CThreadPool *updatePool();
+
   void initDraw(double t);
 
   void drawObject(CGeomObject3D *object, double t);
 
+  void drawFaces(const std::vector<FaceData> &faceDatas);
+
   void updateObjectData();
 
   //---
 
+  bool loadMeshCache();
+
+  void updateCacheMeshes();
+
+  void drawCacheMeshes(double t);
+
+  void clearCacheMeshes();
+
+  void writeMeshCache();
+
+  bool addCacheMesh(CGeomObject3D *object, MeshCache &cache) const;
+
+  QString findTextureFile(const std::string &name) const;
+
+  QString loadBenchmark(const QStringList &filenames);
+
+  QString updateBenchmark(const QStringList &args);
+
+  QString skinningBenchmark(const QStringList &args);
+
+  QString animBenchmark(const QStringList &args);
+
+  //---
+
   CQGLTexture *getGLTexture(CGeomTexture *texture, bool /*add*/);
 
   void initGLTexture(Texture *texture);
@@ -78,6 +139,19 @@ class Model3DObj : public Object3D {
 
   //---
 
+  // mesh drawn from cache (no scene object)
+  struct CacheMesh {
+    CQGLBuffer* buffer { nullptr };
+    QMatrix4x4  meshMatrix;
+    QMatrix4x4  modelMatrix;
+    FaceDatas   faceDatas;
+  };
+
+  using CacheMeshes   = std::vector<CacheMesh>;
+  using CacheTextures = std::vector<Texture *>;
+
+  //---
+
   struct TextureBuffer {
     CQGLTexture*   texture       { nullptr };
     ShaderProgram* shaderProgram { nullptr };
@@ -88,6 +162,8 @@ class Model3DObj : public Object3D {
   //---
 
   static ShaderProgram* s_program;
+  static bool           s_meshCache;
+  static CThreadPool*   s_updatePool;
 
   QString vertShaderFile_;
   QString fragShaderFile_;
@@ -98,6 +174,14 @@ class Model3DObj : public Object3D {
 
   CGeomObject3D* object_ { nullptr };
 
+  // mesh cache (read cache kept until uploaded)
+  bool          isCached_       { false };
+  bool          writeMeshCache_ { false };
+  MeshCache*    meshCache_      { nullptr };
+  CacheMeshes   cacheMeshes_;
+  CacheTextures cacheTextures_;
+  CBBox3D       sceneBBox_;
+
   CQGLTexture* diffuseTexture_  { nullptr };
   CQGLTexture* specularTexture_ { nullptr };
   CQGLTexture* normalTexture_   { nullptr };
@@ -191,117 +191,185 @@ setModelMatrix(uint matrixFlags)
     modelMatrix_.scaled(xscale(), yscale(), zscale());
 }
 
-bool
+const PropertyTable<Object3D> &
 Object3D::
-getValue(const QString &name, const QStringList &, QVariant &value)
+properties()
 {
-  auto *app = canvas()->app();
-
-  if      (name == "id")
-    value = id();
-  else if (name == "visible")
-    value = QString(isVisible() ? "1" : "0");
-  else if (name == "position")
-    value = Util::point3DToString(position());
-  else if (name == "x_angle")
-    value = Util::realToString(Util::radToDeg(xAngle()));
-  else if (name == "y_angle")
-    value = Util::realToString(Util::radToDeg(yAngle()));
-  else if (name == "z_angle")
-    value = Util::realToString(Util::radToDeg(zAngle()));
-  else if (name == "group")
-    value = (group() ? group()->calcId() : "");
-  else
-    return app->errorMsg(QString("Invalid get name '%1'").arg(name));
-
-  return true;
+  using Table = PropertyTable<Object3D>;
+
+  static Table table({
+    { "id",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = obj->id(); return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        obj->setId(value); return true;
+      } },
+    { "visible",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = QString(obj->isVisible() ? "1" : "0"); return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        obj->setVisible(Util::stringToBool(value));
+
+        obj->setNeedsUpdate();
+
+        return true;
+      } },
+    { "position",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = Util::point3DToString(obj->position()); return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        CPoint3D p;
+        if (! Util::stringToPoint3D(obj->canvas()->app()->tcl(), value, p))
+          return false;
+
+        obj->setPosition(p);
+
+        obj->setNeedsUpdate();
+
+        return true;
+      } },
+    { "x_angle",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = Util::realToString(Util::radToDeg(obj->xAngle())); return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        double a;
+        if (! Util::stringToReal(value, a))
+          return false;
+
+        obj->setXAngle(Util::degToRad(a));
+
+        obj->setNeedsUpdate();
+
+        return true;
+      } },
+    { "y_angle",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = Util::realToString(Util::radToDeg(obj->yAngle())); return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        double a;
+        if (! Util::stringToReal(value, a))
+          return false;
+
+        obj->setYAngle(Util::degToRad(a));
+
+        obj->setNeedsUpdate();
+
+        return true;
+      } },
+    { "z_angle",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = Util::realToString(Util::radToDeg(obj->zAngle())); return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        double a;
+        if (! Util::stringToReal(value, a))
+          return false;
+
+        obj->setZAngle(Util::degToRad(a));
+
+        obj->setNeedsUpdate();
+
+        return true;
+      } },
+    { "scale", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        double s;
+        if (! Util::stringToReal(value, s))
+          return false;
+
+        obj->setScale(s);
+
+        obj->setNeedsUpdate();
+
+        return true;
+      } },
+    { "group",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = (obj->group() ? obj->group()->calcId() : ""); return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        obj->setGroupName(value); return true;
+      } },
+  });
+
+  return table;
 }
 
 bool
 Object3D::
-setValue(const QString &name, const QString &value, const QStringList &)
+getValue(const QString &name, const QStringList &args, QVariant &value)
 {
-  auto *app = canvas()->app();
-  auto *tcl = app->tcl();
-
-  if      (name == "id")
-    setId(value);
-  else if (name == "visible") {
-    setVisible(Util::stringToBool(value));
+  auto *property = properties().find(name);
 
-    setNeedsUpdate();
-  }
-  else if (name == "position") {
-    CPoint3D p;
-    if (! Util::stringToPoint3D(tcl, value, p))
-      return false;
-
-    setPosition(p);
+  if (property && property->get)
+    return property->get(this, args, value);
 
-    setNeedsUpdate();
-  }
-  else if (name == "x_angle") {
-    double a;
-    if (! Util::stringToReal(value, a))
-      return false;
+  auto *app = canvas()->app();
 
-    setXAngle(Util::degToRad(a));
+  return app->errorMsg(QString("Invalid get name '%1'").arg(name));
+}
 
-    setNeedsUpdate();
-  }
-  else if (name == "y_angle") {
-    double a;
-    if (! Util::stringToReal(value, a))
-      return false;
+bool
+Object3D::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
 
-    setYAngle(Util::degToRad(a));
+  if (property && property->set)
+    return property->set(this, value, args);
 
-    setNeedsUpdate();
-  }
-  else if (name == "z_angle") {
-    double a;
-    if (! Util::stringToReal(value, a))
-      return false;
+  auto *app = canvas()->app();
 
-    setZAngle(Util::degToRad(a));
+  return app->errorMsg(QString("Invalid set name '%1'").arg(name));
+}
 
-    setNeedsUpdate();
+void
+Object3D::
+setGroupName(const QString &name)
+{
+  auto *group = dynamic_cast<Group3DObj *>(canvas()->getObjectByName(name));
+
+  if (group != group_) {
+    if (group_)
+      group_->removeObject(this);
+    else
+      canvas()->removeObject(this);
+
+    if (group)
+      group->addObject(this);
+    else
+      canvas()->addObject(this);
   }
-  else if (name == "scale") {
-    double s;
-    if (! Util::stringToReal(value, s))
-      return false;
+}
 
-    setScale(s);
+bool
+Object3D::
+exec(const QString &, const QStringList &, QVariant &)
+{
+  return false;
+}
 
-    setNeedsUpdate();
-  }
-  else if (name == "group") {
-    auto *group = dynamic_cast<Group3DObj *>(canvas()->getObjectByName(value));
-
-    if (group != group_) {
-      if (group_)
-        group_->removeObject(this);
-      else
-        canvas()->removeObject(this);
-
-      if (group)
-        group->addObject(this);
-      else
-        canvas()->addObject(this);
-    }
-  }
-  else
-    return app->errorMsg(QString("Invalid set name '%1'").arg(name));
+bool
+Object3D::
+getData(const QString &name, int, int, std::vector<float> &)
+{
+  auto *app = canvas()->app();
 
-  return true;
+  return app->errorMsg(QString("Invalid data name '%1'").arg(name));
 }
 
 bool
 Object3D::
-exec(const QString &, const QStringList &, QVariant &)
+setData(const QString &name, const std::vector<float> &, int, int)
 {
-  return false;
+  auto *app = canvas()->app();
+
+  return app->errorMsg(QString("Invalid data name '%1'").arg(name));
 }
 
 void
@@ -1,6 +1,8 @@
 #ifndef CQSandboxObject3D_H
 #define CQSandboxObject3D_H
 
+#include <CQSandboxProperty.h>
+
 #include <CVector3D.h>
 #include <CMatrix3DH.h>
 #include <CBBox3D.h>
@@ -11,6 +13,7 @@
 #include <QStringList>
 
 #include <optional>
+#include <vector>
 
 namespace CQSandbox {
 
@@ -164,6 +167,9 @@ class Object3D : public QObject {
   Group3DObj *group() const { return group_; }
   void setGroup(Group3DObj *group) { group_ = group; }
 
+  // move to named group (or canvas if not a group)
+  void setGroupName(const QString &name);
+
   //---
 
   void setNeedsUpdate();
@@ -174,11 +180,19 @@ class Object3D : public QObject {
 
   virtual void setModelMatrix(uint flags=ModelMatrixFlags::ALL);
 
+  // properties handled by getValue/setValue (derived classes extend)
+  static const PropertyTable<Object3D> &properties();
+
   virtual bool getValue(const QString &name, const QStringList &args, QVariant &value);
   virtual bool setValue(const QString &name, const QString &value, const QStringList &args);
 
   virtual bool exec(const QString &name, const QStringList &args, QVariant &res);
 
+  // bulk float data (e.g. all positions) for elements start, start + stride, ...
+  virtual bool getData(const QString &name, int start, int stride, std::vector<float> &values);
+  virtual bool setData(const QString &name, const std::vector<float> &values,
+                       int start, int stride);
+
   //---
 
   virtual void updateModelMatrix();
@@ -189,6 +203,23 @@ class Object3D : public QObject {
 
   virtual void render();
 
+  // instanced rendering: visible objects with the same non-zero instance key share geometry
+  // and shader state and are drawn in one call by renderInstances on the first object
+  virtual size_t instanceKey() { return 0; }
+
+  virtual void renderInstances(const std::vector<Object3D *> &) { }
+
+  // GL state used by render (for render queue sort). Objects with no program are
+  // untracked: they keep their relative order and may bind state outside the canvas
+  struct RenderState {
+    const void* program     { nullptr };
+    const void* texture     { nullptr };
+    const void* buffer      { nullptr };
+    bool        transparent { false };
+  };
+
+  virtual RenderState renderState() { return RenderState(); }
+
   virtual bool intersect(const CVector3D &, const CVector3D &, CPoint3D &, CPoint3D &) const {
     return false;
   }
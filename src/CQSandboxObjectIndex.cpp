@@ -0,0 +1,403 @@
+#include <CQSandboxObjectIndex.h>
+
+#include <algorithm>
+
+namespace CQSandbox {
+
+ObjectIndex::
+ObjectIndex(Canvas *canvas) :
+ canvas_(canvas)
+{
+}
+
+ObjectIndex::
+~ObjectIndex()
+{
+  quadTree_.reset();
+
+  for (auto &pe : entries_)
+    delete pe.second;
+}
+
+//---
+
+void
+ObjectIndex::
+addName(Object *obj)
+{
+  commandNames_[obj->getCommandName()] = obj;
+
+  auto id = obj->id();
+
+  if (id != "" && ! ids_.contains(id))
+    ids_[id] = obj;
+}
+
+void
+ObjectIndex::
+removeName(Object *obj)
+{
+  commandNames_.remove(obj->getCommandName());
+
+  idChanged(obj, obj->id());
+}
+
+void
+ObjectIndex::
+idChanged(Object *obj, const QString &oldId)
+{
+  // if object was found by old id then find next object with that id (in create order)
+  if (oldId != "" && ids_.value(oldId) == obj) {
+    ids_.remove(oldId);
+
+    for (auto *obj1 : canvas_->allObjects()) {
+      if (obj1 != obj && obj1->id() == oldId) {
+        ids_[oldId] = obj1;
+        break;
+      }
+    }
+  }
+
+  auto id = obj->id();
+
+  if (id == "" || id == oldId)
+    return;
+
+  // new id only replaces existing object if created earlier
+  auto *obj1 = ids_.value(id);
+
+  if (! obj1 || obj->ind() < obj1->ind())
+    ids_[id] = obj;
+}
+
+Object *
+ObjectIndex::
+objectByName(const QString &name) const
+{
+  auto *obj = commandNames_.value(name);
+
+  if (! obj)
+    obj = ids_.value(name);
+
+  return obj;
+}
+
+//---
+
+void
+ObjectIndex::
+addObject(Object *obj, Viewport *viewport, int viewportInd)
+{
+  auto *&entry = entries_[obj];
+
+  if (entry)
+    removeObject(obj);
+
+  entry = new Entry;
+
+  entry->obj         = obj;
+  entry->viewport    = viewport;
+  entry->viewportInd = viewportInd;
+  entry->order       = ++order_;
+
+  dirty_.push_back(entry);
+}
+
+void
+ObjectIndex::
+removeObject(Object *obj)
+{
+  auto pe = entries_.find(obj);
+
+  if (pe == entries_.end())
+    return;
+
+  auto *entry = (*pe).second;
+
+  if (entry->inTree) {
+    addDamage(entry);
+
+    quadTree_.remove(entry);
+  }
+
+  if (entry->dirty) {
+    auto pd = std::find(dirty_.begin(), dirty_.end(), entry);
+
+    if (pd != dirty_.end())
+      dirty_.erase(pd);
+  }
+
+  entries_.erase(pe);
+
+  delete entry;
+}
+
+void
+ObjectIndex::
+objectChanged(const Object *obj, bool damage)
+{
+  auto pe = entries_.find(obj);
+
+  if (pe == entries_.end())
+    return;
+
+  auto *entry = (*pe).second;
+
+  if (damage)
+    entry->damaged = true;
+
+  if (! entry->dirty) {
+    entry->dirty = true;
+
+    dirty_.push_back(entry);
+  }
+}
+
+void
+ObjectIndex::
+invalidate()
+{
+  allDirty_   = true;
+  allDamaged_ = true;
+}
+
+//---
+
+Object *
+ObjectIndex::
+objectAtPos(const QPointF &p) const
+{
+  Objects objs;
+
+  objectsAtPos(p, objs);
+
+  return (! objs.empty() ? objs[0] : nullptr);
+}
+
+void
+ObjectIndex::
+objectsAtPos(const QPointF &p, Objects &objs) const
+{
+  updateRects();
+
+  EntryList entries;
+
+  quadTree_.getDataAtPoint(p.x(), p.y(), entries);
+
+  // same test as rect scan (empty rects never contain point)
+  entries.remove_if([&](const Entry *entry) { return ! entry->prect.contains(p); });
+
+  sortEntries(entries, objs);
+}
+
+void
+ObjectIndex::
+objectsTouchingRect(const QRectF &r, Objects &objs) const
+{
+  updateRects();
+
+  EntryList entries;
+
+  auto r1 = r.normalized();
+
+  quadTree_.getDataTouchingBBox(Rect(r1.left(), r1.top(), r1.right(), r1.bottom()), entries);
+
+  sortEntries(entries, objs);
+}
+
+bool
+ObjectIndex::
+objectRect(const Object *obj, QRectF &r) const
+{
+  auto pe = entries_.find(obj);
+
+  if (pe == entries_.end())
+    return false;
+
+  updateRects();
+
+  r = (*pe).second->prect;
+
+  return true;
+}
+
+//---
+
+void
+ObjectIndex::
+updateRects() const
+{
+  if (allDirty_) {
+    // rebuild tree (removing one by one would need old rects)
+    quadTree_.reset();
+
+    dirty_.clear();
+
+    maxMargin_ = 0.0;
+
+    for (auto &pe : entries_) {
+      auto *entry = pe.second;
+
+      entry->inTree = false;
+
+      updateEntry(entry);
+    }
+
+    allDirty_ = false;
+  }
+  else {
+    for (auto *entry : dirty_) {
+      if (entry->inTree) {
+        // old rect
+        if (entry->damaged)
+          addDamage(entry);
+
+        quadTree_.remove(entry);
+
+        entry->inTree = false;
+      }
+
+      updateEntry(entry);
+    }
+
+    dirty_.clear();
+  }
+}
+
+void
+ObjectIndex::
+updateEntry(Entry *entry) const
+{
+  auto rect = entry->obj->calcRect();
+
+  entry->prect = canvas_->rectToPixel(entry->viewport, rect).qrect();
+  entry->bbox  = Rect(entry->prect.left (), entry->prect.top   (),
+                      entry->prect.right(), entry->prect.bottom());
+  entry->dirty = false;
+
+  entry->margin = drawMargin(entry->obj);
+
+  maxMargin_ = std::max(maxMargin_, entry->margin);
+
+  quadTree_.add(entry);
+
+  entry->inTree = true;
+
+  // new rect
+  if (entry->damaged) {
+    addDamage(entry);
+
+    entry->damaged = false;
+  }
+}
+
+void
+ObjectIndex::
+sortEntries(EntryList &entries, Objects &objs) const
+{
+  // viewport then add order (matches drawing order)
+  entries.sort([](const Entry *entry1, const Entry *entry2) {
+    if (entry1->viewportInd != entry2->viewportInd)
+      return (entry1->viewportInd < entry2->viewportInd);
+
+    return (entry1->order < entry2->order);
+  });
+
+  objs.clear();
+
+  for (auto *entry : entries)
+    objs.push_back(entry->obj);
+}
+
+//---
+
+void
+ObjectIndex::
+takeDamage(QRegion &region, bool &all)
+{
+  updateRects();
+
+  all = allDamaged_;
+
+  region = QRegion();
+
+  if (! all) {
+    for (const auto &r : damage_)
+      region += r.toAlignedRect();
+  }
+
+  damage_.clear();
+
+  allDamaged_ = false;
+}
+
+void
+ObjectIndex::
+objectsTouchingRegion(const QRegion &region, const Viewport *viewport, Objects &objs) const
+{
+  updateRects();
+
+  EntryList entries;
+
+  // tree has undrawn rects so query is expanded by largest margin and entries are
+  // checked against their own drawn rect
+  auto m = maxMargin_;
+
+  for (const auto &r : region) {
+    EntryList entries1;
+
+    auto r1 = QRectF(r);
+    auto r2 = r1.adjusted(-m, -m, m, m);
+
+    quadTree_.getDataTouchingBBox(Rect(r2.left(), r2.top(), r2.right(), r2.bottom()), entries1);
+
+    for (auto *entry : entries1) {
+      if (entry->viewport != viewport)
+        continue;
+
+      auto m1 = entry->margin;
+
+      if (entry->prect.adjusted(-m1, -m1, m1, m1).intersects(r1))
+        entries.push_back(entry);
+    }
+  }
+
+  // object may touch more than one rect
+  entries.sort();
+  entries.unique();
+
+  sortEntries(entries, objs);
+}
+
+double
+ObjectIndex::
+drawMargin(const Object *obj)
+{
+  return obj->pen().widthF()/2.0 + 2.0;
+}
+
+void
+ObjectIndex::
+addDamage(const Entry *entry) const
+{
+  if (allDamaged_)
+    return;
+
+  auto m = entry->margin;
+
+  damage_.push_back(entry->prect.adjusted(-m, -m, m, m));
+
+  // merge into single rect if too many (keeps region calc cheap)
+  if (damage_.size() > 256) {
+    QRectF r;
+
+    for (const auto &r1 : damage_)
+      r = r.united(r1);
+
+    damage_.clear();
+
+    damage_.push_back(r);
+  }
+}
+
+}
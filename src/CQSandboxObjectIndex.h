@@ -0,0 +1,127 @@
+#ifndef CQSandboxObjectIndex_H
+#define CQSandboxObjectIndex_H
+
+#include <CQSandboxCanvas.h>
+
+#include <QHash>
+#include <QRectF>
+#include <QRegion>
+
+#include <unordered_map>
+#include <vector>
+
+namespace CQSandbox {
+
+// index of canvas objects
+//
+// viewport objects are stored in a quad tree on their pixel rect so picking and overlap
+// queries only test nearby objects. Rects are recalculated lazily: changed objects are
+// marked and re-inserted before the next query, and all rects are recalculated when the
+// pixel mapping changes (resize or range change).
+//
+// command names and ids are hashed for name lookup (first created object wins for
+// duplicate ids).
+//
+// the old and new pixel rects of changed, added and removed objects are recorded as
+// damage for partial (retained) redraw.
+class ObjectIndex {
+ public:
+  ObjectIndex(Canvas *canvas);
+ ~ObjectIndex();
+
+  //--- names
+
+  void addName   (Object *obj);
+  void removeName(Object *obj);
+
+  void idChanged(Object *obj, const QString &oldId);
+
+  Object *objectByName(const QString &name) const;
+
+  //--- spatial
+
+  // add/remove object in viewport
+  void addObject   (Object *obj, Viewport *viewport, int viewportInd);
+  void removeObject(Object *obj);
+
+  // object rect may have changed (damage is false for changes made while drawing)
+  void objectChanged(const Object *obj, bool damage=true);
+
+  // all object rects may have changed
+  void invalidate();
+
+  // first object (viewport then add order) whose pixel rect contains point
+  Object *objectAtPos(const QPointF &p) const;
+
+  // objects whose pixel rect contains point (viewport then add order)
+  void objectsAtPos(const QPointF &p, Objects &objs) const;
+
+  // objects whose pixel rect touches rect (viewport then add order)
+  void objectsTouchingRect(const QRectF &r, Objects &objs) const;
+
+  // pixel rect of object
+  bool objectRect(const Object *obj, QRectF &r) const;
+
+  uint numObjects() const { return uint(entries_.size()); }
+
+  //--- damage
+
+  // get and clear pixel region needing redraw (all is set if everything changed)
+  void takeDamage(QRegion &region, bool &all);
+
+  // objects in viewport whose drawn pixel rect (rect plus draw margin) touches region
+  // (add order)
+  void objectsTouchingRegion(const QRegion &region, const Viewport *viewport,
+                             Objects &objs) const;
+
+  // extra pixels drawn outside object rect (pen and antialiasing)
+  static double drawMargin(const Object *obj);
+
+ private:
+  struct Entry {
+    Object*   obj         { nullptr };
+    Viewport* viewport    { nullptr };
+    int       viewportInd { 0 };
+    size_t    order       { 0 };
+    QRectF    prect;                   // pixel rect
+    double    margin      { 0.0 };     // draw margin of prect
+    Rect      bbox;                    // quad tree rect (bottom <= top)
+    bool      inTree      { false };
+    bool      dirty       { true };
+    bool      damaged     { true };
+
+    const Rect &getBBox() const { return bbox; }
+  };
+
+  using QuadTree  = CQuadTree<Entry, Rect>;
+  using Entries   = std::unordered_map<const Object *, Entry *>;
+  using Dirty     = std::vector<Entry *>;
+  using NameMap   = QHash<QString, Object *>;
+  using EntryList = QuadTree::DataList;
+  using Rects     = std::vector<QRectF>;
+
+  void updateRects() const;
+
+  void updateEntry(Entry *entry) const;
+
+  void sortEntries(EntryList &entries, Objects &objs) const;
+
+  void addDamage(const Entry *entry) const;
+
+ private:
+  Canvas*          canvas_   { nullptr };
+  mutable QuadTree quadTree_;
+  Entries          entries_;
+  mutable Dirty    dirty_;
+  mutable bool     allDirty_ { false };
+  mutable double   maxMargin_ { 0.0 }; // max draw margin of entries (since rebuild)
+  size_t           order_    { 0 };
+  NameMap          commandNames_;
+  NameMap          ids_;
+  mutable Rects    damage_;
+  mutable bool     allDamaged_ { true };
+};
+
+}
+
+#endif
@@ -41,12 +41,11 @@ init()
   Object3D::init();
 }
 
-bool
+const PropertyTable<Object3D> &
 Othello3DObj::
-getValue(const QString &name, const QStringList &args, QVariant &value)
+properties()
 {
-  auto *app = canvas()->app();
-  auto *tcl = app->tcl();
+  using Table = PropertyTable<Object3D>;
 
   struct Index {
     int ix { -1 };
@@ -55,12 +54,16 @@ getValue(const QString &name, const QStringList &args, QVariant &value)
     bool isValid() { return (ix >= 0 && iy >= 0); }
   };
 
-  auto argsToIndex = [&](Index &ind) {
+  // get board index from "<x> <y>" first arg
+  static auto argsToIndex = [](Othello3DObj *othello, const QStringList &args,
+                               const QString &name, Index &ind) {
+    auto *app = othello->canvas()->app();
+
     if (args.size() < 1)
       return app->errorMsg("Missing index for " + name);
 
     QStringList strs;
-    (void) tcl->splitList(args[0], strs);
+    (void) app->tcl()->splitList(args[0], strs);
 
     if (strs.size() != 2)
       return app->errorMsg("Missing index for " + name);
@@ -71,7 +74,7 @@ getValue(const QString &name, const QStringList &args, QVariant &value)
     return true;
   };
 
-  auto stringToPiece = [](const QString &str) {
+  static auto stringToPiece = [](const QString &str) {
     if      (str.toLower() == "white")
       return COTHELLO_PIECE_WHITE;
     else if (str.toLower() == "black")
@@ -80,83 +83,126 @@ getValue(const QString &name, const QStringList &args, QVariant &value)
       return COTHELLO_PIECE_NONE;
   };
 
-  if      (name == "init_board") {
-  }
-  else if (name == "board_piece") {
-  }
-  else if (name == "can_move_anywhere") {
-  }
-  else if (name == "can_move") {
-    if (args.size() != 2)
-      return app->errorMsg("Invalid args for " + name);
-
-    Index ind;
-    if (! argsToIndex(ind) || ! ind.isValid())
-      return false;
-
-    auto b = board_->canMove(ind.ix, ind.iy, stringToPiece(args[1]));
-
-    value = QVariant(b);
-  }
-  else if (name == "do_move") {
-    if (args.size() != 2)
-      return app->errorMsg("Invalid args for " + name);
-
-    Index ind;
-    if (! argsToIndex(ind) || ! ind.isValid())
-      return false;
-
-    board_->doMove(ind.ix, ind.iy, stringToPiece(args[1]));
-  }
-  else if (name == "is_white_piece") {
-    Index ind;
-    if (! argsToIndex(ind) || ! ind.isValid())
-      return false;
-
-    value = QVariant(board_->getPiece(ind.ix, ind.iy) == COTHELLO_PIECE_WHITE ? 1 : 0);
-  }
-  else if (name == "is_black_piece") {
-    Index ind;
-    if (! argsToIndex(ind) || ! ind.isValid())
-      return false;
-
-    value = QVariant(board_->getPiece(ind.ix, ind.iy) == COTHELLO_PIECE_BLACK ? 1 : 0);
-  }
-  else if (name == "num_white") {
-  }
-  else if (name == "num_black") {
-  }
-  else if (name == "num") {
-  }
-  else if (name == "best_move") {
-    if (args.size() != 1)
-      return app->errorMsg("Invalid args for " + name);
-
-    int depth = 1;
-
-    int ix, iy;
-
-    auto b = board_->getBestMove(stringToPiece(args[0]), depth, &ix, &iy);
-
-    QString res;
-
-    if (b)
-      res = QString("%1 %2").arg(ix).arg(iy);
-    else
-      res = QString("-1 -1");
+  // not implemented (no value)
+  auto noValue = [](Object3D *, const QStringList &, QVariant &) { return true; };
+
+  static Table table({
+    { "init_board"       , noValue, nullptr },
+    { "board_piece"      , noValue, nullptr },
+    { "can_move_anywhere", noValue, nullptr },
+    { "can_move",
+      [](Object3D *obj, const QStringList &args, QVariant &value) {
+        auto *othello = static_cast<Othello3DObj *>(obj);
+
+        if (args.size() != 2)
+          return othello->canvas()->app()->errorMsg("Invalid args for can_move");
+
+        Index ind;
+        if (! argsToIndex(othello, args, "can_move", ind) || ! ind.isValid())
+          return false;
+
+        auto b = othello->board_->canMove(ind.ix, ind.iy, stringToPiece(args[1]));
+
+        value = QVariant(b);
+
+        return true;
+      }, nullptr },
+    { "do_move",
+      [](Object3D *obj, const QStringList &args, QVariant &) {
+        auto *othello = static_cast<Othello3DObj *>(obj);
+
+        if (args.size() != 2)
+          return othello->canvas()->app()->errorMsg("Invalid args for do_move");
+
+        Index ind;
+        if (! argsToIndex(othello, args, "do_move", ind) || ! ind.isValid())
+          return false;
+
+        othello->board_->doMove(ind.ix, ind.iy, stringToPiece(args[1]));
+
+        return true;
+      }, nullptr },
+    { "is_white_piece",
+      [](Object3D *obj, const QStringList &args, QVariant &value) {
+        auto *othello = static_cast<Othello3DObj *>(obj);
+
+        Index ind;
+        if (! argsToIndex(othello, args, "is_white_piece", ind) || ! ind.isValid())
+          return false;
+
+        auto piece = othello->board_->getPiece(ind.ix, ind.iy);
+
+        value = QVariant(piece == COTHELLO_PIECE_WHITE ? 1 : 0);
+
+        return true;
+      }, nullptr },
+    { "is_black_piece",
+      [](Object3D *obj, const QStringList &args, QVariant &value) {
+        auto *othello = static_cast<Othello3DObj *>(obj);
+
+        Index ind;
+        if (! argsToIndex(othello, args, "is_black_piece", ind) || ! ind.isValid())
+          return false;
+
+        auto piece = othello->board_->getPiece(ind.ix, ind.iy);
 
-    value = QVariant(res);
-  }
-  else
-    return Object3D::getValue(name, args, value);
+        value = QVariant(piece == COTHELLO_PIECE_BLACK ? 1 : 0);
 
-  return true;
+        return true;
+      }, nullptr },
+    { "num_white", noValue, nullptr },
+    { "num_black", noValue, nullptr },
+    { "num"      , noValue, nullptr },
+    { "best_move",
+      [](Object3D *obj, const QStringList &args, QVariant &value) {
+        auto *othello = static_cast<Othello3DObj *>(obj);
+
+        if (args.size() != 1)
+          return othello->canvas()->app()->errorMsg("Invalid args for best_move");
+
+        int depth = 1;
+
+        int ix, iy;
+
+        auto b = othello->board_->getBestMove(stringToPiece(args[0]), depth, &ix, &iy);
+
+        QString res;
+
+        if (b)
+          res = QString("%1 %2").arg(ix).arg(iy);
+        else
+          res = QString("-1 -1");
+
+        value = QVariant(res);
+
+        return true;
+      }, nullptr },
+  }, &Object3D::properties());
+
+  return table;
+}
+
+bool
+Othello3DObj::
+getValue(const QString &name, const QStringList &args, QVariant &value)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
+
+  return Object3D::getValue(name, args, value);
 }
 
 bool
 Othello3DObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
+
   return Object3D::setValue(name, value, args);
 }
 
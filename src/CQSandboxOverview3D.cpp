@@ -18,6 +18,7 @@
 #include <CQRubberBand.h>
 #include <CQGLBuffer.h>
 #include <CQGLTexture.h>
+#include <CThreadPool.h>
 
 #include <CGeomScene3D.h>
 #include <CGeomObject3D.h>
@@ -300,6 +301,8 @@ updateObjects()
 
   drawData_.bbox = CBBox3D();
 
+  numSkinDatas_ = 0;
+
   auto *canvas = app_->canvas3D();
 
   for (auto *object : canvas->objects()) {
@@ -329,6 +332,8 @@ updateObjects()
     else if (textObj)
       updateText(textObj);
   }
+
+  updateSkinObjects();
 }
 
 void
@@ -526,10 +531,6 @@ updateObject(CGeomObject3D *object)
 
   //---
 
-  auto *nodeMatrices = (useAnim ? &canvas->getObjectNodeMatrices(animObject) : nullptr);
-
-  //---
-
   auto &faces = drawData_.objFaces[object];
 
   faces.clear();
@@ -537,6 +538,31 @@ updateObject(CGeomObject3D *object)
   const auto &faceDatas = geomObject1->faceDatas();
   auto       *buffer    = geomObject1->buffer();
 
+  //---
+
+  // animated points are added to skin mesh and transformed in updateSkinObjects
+  SkinData *skinData = nullptr;
+
+  if (useAnim) {
+    if (numSkinDatas_ >= skinDatas_.size())
+      skinDatas_.resize(numSkinDatas_ + 1);
+
+    skinData = &skinDatas_[numSkinDatas_++];
+
+    skinData->object  = object;
+    skinData->matrix  = modelMatrix*meshMatrix;
+    skinData->palette = &canvas->getObjectPalette(animObject);
+
+    size_t numPoints = 0;
+
+    for (const auto &faceData : faceDatas)
+      numPoints += size_t(faceData.len);
+
+    skinData->mesh.resize(numPoints);
+  }
+
+  size_t ip = 0;
+
   for (const auto &faceData : faceDatas) {
     Face face;
 
@@ -549,11 +575,32 @@ updateObject(CGeomObject3D *object)
 
       auto p = data.point->point();
 
-      if (useAnim) {
+      if (skinData) {
         auto *vertex = geomObject1->getVertexP(*data.ind);
 
-        if (vertex->hasJointData())
-          p = canvas->adjustAnimPoint(*vertex, p, *nodeMatrices);
+        auto x = float(p.x), y = float(p.y), z = float(p.z);
+
+        const auto &jointData = vertex->getJointData();
+
+        if (vertex->hasJointData() && jointData.set) {
+          int    nodeIds[CSkinning3D::NUM_INFLUENCES];
+          double weights[CSkinning3D::NUM_INFLUENCES];
+
+          for (int j = 0; j < CSkinning3D::NUM_INFLUENCES; ++j) {
+            nodeIds[j] = jointData.nodeDatas[j].node;
+            weights[j] = jointData.nodeDatas[j].weight;
+          }
+
+          skinData->mesh.setVertex(ip, x, y, z, nodeIds, weights);
+        }
+        else
+          skinData->mesh.setVertex(ip, x, y, z);
+
+        ++ip;
+
+        face.points.push_back(p);
+
+        continue;
       }
 
       p = modelMatrix*meshMatrix*p;
@@ -573,6 +620,53 @@ updateObject(CGeomObject3D *object)
   }
 }
 
+void
+Overview3D::
+updateSkinObjects()
+{
+  CQPerfTrace trace("Overview3D::updateSkinObjects");
+
+  if (numSkinDatas_ == 0)
+    return;
+
+  // skin all animated meshes in one pass (split across threads)
+  CSkinning3D::Jobs jobs;
+
+  for (size_t i = 0; i < numSkinDatas_; ++i) {
+    auto &skinData = skinDatas_[i];
+
+    CSkinning3D::Job job;
+
+    job.palette = skinData.palette;
+    job.mesh    = &skinData.mesh;
+    job.points  = &skinData.points;
+
+    jobs.push_back(job);
+  }
+
+  CSkinning3D::skinMeshes(CThreadPool::instance(), jobs);
+
+  //---
+
+  // replace face points with transformed skinned points
+  for (size_t i = 0; i < numSkinDatas_; ++i) {
+    const auto &skinData = skinDatas_[i];
+    const auto &points   = skinData.points;
+
+    size_t ip = 0;
+
+    for (auto &face : drawData_.objFaces[skinData.object]) {
+      for (auto &p : face.points) {
+        p = skinData.matrix*CPoint3D(points.x[ip], points.y[ip], points.z[ip]);
+
+        drawData_.bbox += p;
+
+        ++ip;
+      }
+    }
+  }
+}
+
 void
 Overview3D::
 updateBBox()
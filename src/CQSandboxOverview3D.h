@@ -3,6 +3,7 @@
 
 #include <CWindowRange2D.h>
 //#include <CDisplayRange2D.h>
+#include <CSkinning3D.h>
 #include <CMatrix3DH.h>
 #include <CBBox3D.h>
 #include <CPoint3D.h>
@@ -120,6 +121,7 @@ class Overview3D : public QFrame {
 
   void updateObjects();
   void updateObject(CGeomObject3D *object);
+  void updateSkinObjects();
   void updateModel(Model3DObj *obj);
   void updateParticleList(ParticleList3DObj *obj);
   void updatePath(Path3DObj *obj);
@@ -285,6 +287,17 @@ class Overview3D : public QFrame {
 
   using ObjFaces = std::map<CGeomObject3D *, Faces>;
 
+  // animated object face points skinned after all objects are updated
+  struct SkinData {
+    CGeomObject3D*              object  { nullptr };
+    CMatrix3DH                  matrix;
+    const CSkinning3D::Palette* palette { nullptr };
+    CSkinning3D::Mesh           mesh;
+    CSkinning3D::Points         points;
+  };
+
+  using SkinDatas = std::vector<SkinData>;
+
   //---
 
   struct DrawData {
@@ -362,6 +375,9 @@ class Overview3D : public QFrame {
 
   DrawData drawData_;
 
+  SkinDatas skinDatas_;
+  size_t    numSkinDatas_ { 0 };
+
   int w_ { 100 };
   int h_ { 100 };
 
@@ -3,6 +3,7 @@
 #include <CQSandboxBBox3DObj.h>
 #include <CQSandboxCamera.h>
 #include <CQSandboxApp.h>
+#include <CQSandboxTextureCache.h>
 #include <CQSandboxUtil.h>
 
 #include <CQGLTexture.h>
@@ -47,214 +48,423 @@ ParticleList3DObj(Canvas3D *canvas) :
 {
 }
 
-bool
 ParticleList3DObj::
-getValue(const QString &name, const QStringList &args, QVariant &value)
+~ParticleList3DObj()
 {
-  if      (name == "size") {
-    value = Util::intToString(int(points_.size()));
-  }
-  else if (name == "position") {
-    if (args.size() > 0) {
-      auto i = Util::stringToInt(args[0]);
+  canvas_->textureCache()->release(texture_);
+}
 
-      if (i < 0 || i >= int(points_.size()))
-        return false;
+const PropertyTable<Object3D> &
+ParticleList3DObj::
+properties()
+{
+  // per particle properties are indexed by first arg
+  using Table = PropertyTable<Object3D>;
 
-      value = Util::vector3DToString(points_[i]);
-    }
-    else
-      return false;
-  }
-  else if (name == "color") {
-    if (args.size() > 0) {
-      auto i = Util::stringToInt(args[0]);
+  static Table table({
+    { "size",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        auto *particles = static_cast<ParticleList3DObj *>(obj);
 
-      if (i < 0 || i >= int(colors_.size()))
-        return false;
+        value = Util::intToString(int(particles->points_.size()));
 
-      value = Util::colorToString(colors_[i]);
-    }
-    else
-      return false;
-  }
-  else if (name == "range") {
-    calcBBox();
+        return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<ParticleList3DObj *>(obj)->setNumPoints(Util::stringToInt(value));
+        return true;
+      } },
+    { "position",
+      [](Object3D *obj, const QStringList &args, QVariant &value) {
+        auto *particles = static_cast<ParticleList3DObj *>(obj);
 
-    QStringList strs;
+        if (args.size() == 0)
+          return false;
 
-    strs << QString::number(bbox_.getXMin());
-    strs << QString::number(bbox_.getYMin());
-    strs << QString::number(bbox_.getZMin());
-    strs << QString::number(bbox_.getXMax());
-    strs << QString::number(bbox_.getYMax());
-    strs << QString::number(bbox_.getZMax());
+        auto i = Util::stringToInt(args[0]);
 
-    value = strs.join(" ");
-  }
-  else if (name == "particleSize") {
-    value = QVariant(particleSize());
-  }
-  else
-    return Object3D::getValue(name, args, value);
+        if (i < 0 || i >= int(particles->points_.size()))
+          return false;
 
-  return true;
-}
+        value = Util::vector3DToString(particles->points_[i]);
 
-bool
-ParticleList3DObj::
-setValue(const QString &name, const QString &value, const QStringList &args)
-{
-  auto *app = canvas_->app();
-  auto *tcl = app->tcl();
+        return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &args) {
+        auto *particles = static_cast<ParticleList3DObj *>(obj);
+        auto *app       = particles->canvas()->app();
 
-  if      (name == "size") {
-    auto n = Util::stringToInt(value);
+        // get index from args
+        if (args.size() == 0)
+          return app->errorMsg("Missing index for position");
 
-    setNumPoints(n);
-  }
-  else if (name == "position") {
-    // get index from args
-    if (args.size() > 0) {
-      auto i = Util::stringToInt(args[0]);
+        auto i = Util::stringToInt(args[0]);
 
-      if (i < 0 || i >= int(points_.size()))
-        return false;
+        if (i < 0 || i >= int(particles->points_.size()))
+          return false;
 
-      CPoint3D p;
-      if (! Util::stringToPoint3D(tcl, value, p))
-        return false;
+        CPoint3D p;
+        if (! Util::stringToPoint3D(app->tcl(), value, p))
+          return false;
 
-      points_[i] = p;
-    }
-    else
-      return app->errorMsg("Missing index for position");
+        particles->points_[i] = p;
 
-    bboxValid_ = false;
-  }
-  else if (name == "color") {
-    // get index from args
-    if (args.size() > 0) {
-      auto i = Util::stringToInt(args[0]);
+        particles->bboxValid_ = false;
 
-      if (i < 0 || i >= int(colors_.size()))
-        return app->errorMsg("Invalid index for color");
+        return true;
+      } },
+    { "color",
+      [](Object3D *obj, const QStringList &args, QVariant &value) {
+        auto *particles = static_cast<ParticleList3DObj *>(obj);
 
-      colors_[i] = Util::stringToGLColor(tcl, value);
-    }
-    else
-      return app->errorMsg("Missing index for color");
-  }
-  else if (name == "generator") {
-    int n = 10000;
+        if (args.size() == 0)
+          return false;
 
-    if (args.size() > 0)
-      n = Util::stringToInt(args[0]);
+        auto i = Util::stringToInt(args[0]);
 
-    if (value == "lorenz") {
-      CRMinMax xrange, yrange, zrange;
+        if (i < 0 || i >= int(particles->colors_.size()))
+          return false;
 
-      setNumPoints(n);
+        value = Util::colorToString(particles->colors_[i]);
 
-      CLorenzCalc calc(0, n);
+        return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &args) {
+        auto *particles = static_cast<ParticleList3DObj *>(obj);
+        auto *app       = particles->canvas()->app();
 
-      int j = 0;
+        // get index from args
+        if (args.size() == 0)
+          return app->errorMsg("Missing index for color");
 
-      for (int i = 0; i < calc.getIterationEnd(); i++) {
-        double x, y, z;
+        auto i = Util::stringToInt(args[0]);
 
-        calc.nextValue(x, y, z);
+        if (i < 0 || i >= int(particles->colors_.size()))
+          return app->errorMsg("Invalid index for color");
 
-        if (i >= calc.getIterationStart()) {
-          points_[j] = CGLVector3D(x, y, z);
+        particles->colors_[i] = Util::stringToGLColor(app->tcl(), value);
 
-#if 0
-          int i1 = int(j  - 1000*(j /1000));
-          int i2 =     i1 -  100*(i1/ 100);
-          int i3 =     i2 -   10*(i2/  10);
+        return true;
+      } },
+    { "range",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        auto *particles = static_cast<ParticleList3DObj *>(obj);
 
-          i1 -= i2 + i3;
-          i2 -= i3;
+        particles->calcBBox();
 
-          float b = i1/1000.0;
-          float g = i2/100.0;
-          float r = i3/10.0;
+        const auto &bbox = particles->bbox_;
 
-          colors_[j] = CGLColor(r, g, b);
-#endif
+        QStringList strs;
 
-          xrange.add(x);
-          yrange.add(y);
-          zrange.add(z);
+        strs << QString::number(bbox.getXMin());
+        strs << QString::number(bbox.getYMin());
+        strs << QString::number(bbox.getZMin());
+        strs << QString::number(bbox.getXMax());
+        strs << QString::number(bbox.getYMax());
+        strs << QString::number(bbox.getZMax());
 
-          ++j;
-        }
-      }
+        value = strs.join(" ");
 
-      //std::cerr << "X: " << xrange.min() << " " << xrange.max() << "\n";
-      //std::cerr << "Y: " << yrange.min() << " " << yrange.max() << "\n";
-      //std::cerr << "Z: " << zrange.min() << " " << zrange.max() << "\n";
+        return true;
+      }, nullptr },
+    { "particleSize",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = QVariant(static_cast<ParticleList3DObj *>(obj)->particleSize()); return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        double r;
+        if (! Util::stringToReal(value, r))
+           return false;
 
-      for (int i = 0; i < j; ++i) {
-        auto x1 = CMathUtil::map(points_[i].x(), xrange.min(), xrange.max(), -1, 1);
-        auto y1 = CMathUtil::map(points_[i].y(), yrange.min(), yrange.max(), -1, 1);
-        auto z1 = CMathUtil::map(points_[i].z(), zrange.min(), zrange.max(), -1, -2);
+        static_cast<ParticleList3DObj *>(obj)->setParticleSize(r);
 
-        auto r = CMathUtil::map(points_[i].x(), xrange.min(), xrange.max(), 0, 1);
-        auto g = CMathUtil::map(points_[i].y(), yrange.min(), yrange.max(), 0, 1);
-        auto b = CMathUtil::map(points_[i].z(), zrange.min(), zrange.max(), 0, 1);
+        return true;
+      } },
+    { "texture", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<ParticleList3DObj *>(obj)->setTextureFile(value); return true;
+      } },
+    { "generator", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &args) {
+        auto *particles = static_cast<ParticleList3DObj *>(obj);
 
-        colors_[i] = CGLColor(r, g, b);
-        points_[i] = CGLVector3D(x1, y1, z1);
-      }
-    }
+        int n = 10000;
 
-    bboxValid_ = false;
-  }
+        if (args.size() > 0)
+          n = Util::stringToInt(args[0]);
+
+        if (value == "lorenz")
+          particles->generateLorenz(n);
+
+        particles->bboxValid_ = false;
+
+        return true;
+      } },
 #ifdef CQSANDBOX_FLOCKING
-  else if (name == "flocking") {
-    delete flocking_;
+    { "flocking", nullptr,
+      [](Object3D *obj, const QString &, const QStringList &args) {
+        auto *particles = static_cast<ParticleList3DObj *>(obj);
+
+        delete particles->flocking_;
 #ifdef CQSANDBOX_FIREWORKS
-    delete fireworks_;
+        delete particles->fireworks_;
 #endif
 
-    flocking_ = new CFlocking;
+        particles->flocking_ = new CFlocking;
 
-    auto n = flocking_->numBoids();
+        // optional boid count
+        if (args.size() > 0) {
+          auto n = Util::stringToInt(args[0]);
 
-    setNumPoints(n);
+          if (n <= 0)
+            return particles->canvas()->app()->errorMsg("Invalid boid count for flocking");
 
-    updateFlocking();
-  }
+          particles->flocking_->setNumBoids(uint(n));
+        }
+
+        particles->flocking_->setNumThreads(size_t(particles->flockingThreads_));
+
+        auto n = particles->flocking_->numBoids();
+
+        particles->setNumPoints(n);
+
+        particles->updateFlocking();
+
+        return true;
+      } },
+    { "flocking.threads",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        auto *particles = static_cast<ParticleList3DObj *>(obj);
+
+        value = (particles->flocking_ ? int(particles->flocking_->numThreads()) :
+                                        particles->flockingThreads_);
+
+        return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *particles = static_cast<ParticleList3DObj *>(obj);
+
+        particles->flockingThreads_ = std::max(Util::stringToInt(value), 0);
+
+        if (particles->flocking_)
+          particles->flocking_->setNumThreads(size_t(particles->flockingThreads_));
+
+        return true;
+      } },
+    { "flocking.time",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        auto *particles = static_cast<ParticleList3DObj *>(obj);
+
+        value = (particles->flocking_ ? particles->flocking_->lastTime() : 0.0);
+
+        return true;
+      }, nullptr },
 #endif
 #ifdef CQSANDBOX_FIREWORKS
-  else if (name == "fireworks") {
+    { "fireworks", nullptr,
+      [](Object3D *obj, const QString &, const QStringList &) {
+        auto *particles = static_cast<ParticleList3DObj *>(obj);
+
 #ifdef CQSANDBOX_FLOCKING
-    delete flocking_;
+        delete particles->flocking_;
 #endif
-    delete fireworks_;
+        delete particles->fireworks_;
 
-    fireworks_ = new CFireworks;
+        particles->fireworks_ = new CFireworks;
 
-    auto n = 100;
+        auto n = 100;
 
-    setNumPoints(n);
+        particles->setNumPoints(n);
 
-    updateFireworks();
+        particles->updateFireworks();
+
+        return true;
+      } },
+#endif
+  }, &Object3D::properties());
+
+  return table;
+}
+
+bool
+ParticleList3DObj::
+getValue(const QString &name, const QStringList &args, QVariant &value)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
+
+  return Object3D::getValue(name, args, value);
+}
+
+bool
+ParticleList3DObj::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object3D::setValue(name, value, args);
+}
+
+void
+ParticleList3DObj::
+generateLorenz(int n)
+{
+  CRMinMax xrange, yrange, zrange;
+
+  setNumPoints(n);
+
+  CLorenzCalc calc(0, n);
+
+  int j = 0;
+
+  for (int i = 0; i < calc.getIterationEnd(); i++) {
+    double x, y, z;
+
+    calc.nextValue(x, y, z);
+
+    if (i >= calc.getIterationStart()) {
+      points_[j] = CGLVector3D(x, y, z);
+
+#if 0
+      int i1 = int(j  - 1000*(j /1000));
+      int i2 =     i1 -  100*(i1/ 100);
+      int i3 =     i2 -   10*(i2/  10);
+
+      i1 -= i2 + i3;
+      i2 -= i3;
+
+      float b = i1/1000.0;
+      float g = i2/100.0;
+      float r = i3/10.0;
+
+      colors_[j] = CGLColor(r, g, b);
+#endif
+
+      xrange.add(x);
+      yrange.add(y);
+      zrange.add(z);
+
+      ++j;
+    }
+  }
+
+  //std::cerr << "X: " << xrange.min() << " " << xrange.max() << "\n";
+  //std::cerr << "Y: " << yrange.min() << " " << yrange.max() << "\n";
+  //std::cerr << "Z: " << zrange.min() << " " << zrange.max() << "\n";
+
+  for (int i = 0; i < j; ++i) {
+    auto x1 = CMathUtil::map(points_[i].x(), xrange.min(), xrange.max(), -1, 1);
+    auto y1 = CMathUtil::map(points_[i].y(), yrange.min(), yrange.max(), -1, 1);
+    auto z1 = CMathUtil::map(points_[i].z(), zrange.min(), zrange.max(), -1, -2);
+
+    auto r = CMathUtil::map(points_[i].x(), xrange.min(), xrange.max(), 0, 1);
+    auto g = CMathUtil::map(points_[i].y(), yrange.min(), yrange.max(), 0, 1);
+    auto b = CMathUtil::map(points_[i].z(), zrange.min(), zrange.max(), 0, 1);
+
+    colors_[i] = CGLColor(r, g, b);
+    points_[i] = CGLVector3D(x1, y1, z1);
+  }
+}
+
+bool
+ParticleList3DObj::
+exec(const QString &op, const QStringList &args, QVariant &res)
+{
+#ifdef CQSANDBOX_FLOCKING
+  if (op == "benchmark.flocking") {
+    auto *app = canvas_->app();
+
+    // args: [numBoids] [numSteps]
+    auto numBoids = (args.size() > 0 ? Util::stringToInt(args[0]) : 50000);
+    auto numSteps = (args.size() > 1 ? Util::stringToInt(args[1]) : 10);
+
+    if (numBoids <= 0 || numSteps <= 0)
+      return app->errorMsg("Invalid count for benchmark.flocking");
+
+    res = QString::fromStdString(CFlocking::benchmark(uint(numBoids), uint(numSteps)));
+
+    return true;
   }
 #endif
-  else if (name == "texture") {
-    setTextureFile(value);
+
+  return Object3D::exec(op, args, res);
+}
+
+bool
+ParticleList3DObj::
+getData(const QString &name, int start, int stride, std::vector<float> &values)
+{
+  if      (name == "position") {
+    auto n = Util::dataRangeCount(int(points_.size()), start, stride);
+
+    values.resize(size_t(3*n));
+
+    auto *v = values.data();
+
+    for (int i = 0, j = start; i < n; ++i, j += stride) {
+      const auto &p = points_[size_t(j)];
+
+      *v++ = float(p.x()); *v++ = float(p.y()); *v++ = float(p.z());
+    }
   }
-  else if (name == "particleSize") {
-    double r;
-    if (! Util::stringToReal(value, r))
-       return false;
+  else if (name == "color") {
+    auto n = Util::dataRangeCount(int(colors_.size()), start, stride);
+
+    values.resize(size_t(3*n));
+
+    auto *v = values.data();
+
+    for (int i = 0, j = start; i < n; ++i, j += stride) {
+      const auto &c = colors_[size_t(j)];
 
-    setParticleSize(r);
+      *v++ = float(c.r); *v++ = float(c.g); *v++ = float(c.b);
+    }
   }
   else
-    return Object3D::setValue(name, value, args);
+    return Object3D::getData(name, start, stride, values);
+
+  return true;
+}
+
+bool
+ParticleList3DObj::
+setData(const QString &name, const std::vector<float> &values, int start, int stride)
+{
+  auto *app = canvas_->app();
+
+  if (name != "position" && name != "color")
+    return Object3D::setData(name, values, start, stride);
+
+  // x y z or r g b per element
+  if (values.size() % 3 != 0)
+    return app->errorMsg(QString("Invalid number of values for '%1' data").arg(name));
+
+  auto n = int(values.size()/3);
+
+  // all positions (resize)
+  if (name == "position" && start == 0 && stride == 1 && n != int(points_.size()))
+    setNumPoints(n);
+
+  if (! Util::isDataRangeValid(int(points_.size()), n, start, stride))
+    return app->errorMsg(QString("Invalid range for '%1' data").arg(name));
+
+  const auto *v = values.data();
+
+  if (name == "position") {
+    for (int i = 0, j = start; i < n; ++i, j += stride, v += 3)
+      points_[size_t(j)] = CGLVector3D(v[0], v[1], v[2]);
+
+    bboxValid_ = false;
+  }
+  else {
+    for (int i = 0, j = start; i < n; ++i, j += stride, v += 3)
+      colors_[size_t(j)] = CGLColor(v[0], v[1], v[2]);
+  }
 
   return true;
 }
@@ -324,18 +534,12 @@ setTextureFile(const QString &filename)
 {
   textureFile_ = filename;
 
-  if (textureFile_ != "") {
-    texture_ = new CQGLTexture;
+  canvas_->textureCache()->release(texture_);
 
-    if (! texture_->load(textureFile_, /*flip*/true)) {
-      delete texture_;
-      texture_ = nullptr;
-    }
-  }
-  else {
-    delete texture_;
+  if (textureFile_ != "")
+    texture_ = canvas_->textureCache()->acquire(textureFile_, /*flip*/true);
+  else
     texture_ = nullptr;
-  }
 }
 
 void
@@ -586,19 +790,21 @@ render()
 
   auto n = points_.size();
 
+  auto maxPoints = std::max(s_maxPoints, n);
+
   // Update the buffers that OpenGL uses for rendering.
   // There are much more sophisticated means to stream data from the CPU to the GPU,
   // but this is outside the scope of this tutorial.
   // http://www.opengl.org/wiki/Buffer_Object_Streaming
   canvas_->glBindBuffer(GL_ARRAY_BUFFER, particlesPositionBuffer_);
   // Buffer orphaning, a common way to improve streaming perf. See above link for details.
-  canvas_->glBufferData(GL_ARRAY_BUFFER, s_maxPoints*sizeof(CGLVector3D),
+  canvas_->glBufferData(GL_ARRAY_BUFFER, maxPoints*sizeof(CGLVector3D),
                         nullptr, GL_STREAM_DRAW);
   canvas_->glBufferSubData(GL_ARRAY_BUFFER, 0, n*sizeof(CGLVector3D), &points_[0]);
 
   canvas_->glBindBuffer(GL_ARRAY_BUFFER, particlesColorBuffer_);
   // Buffer orphaning, a common way to improve streaming perf. See above link for details.
-  canvas_->glBufferData(GL_ARRAY_BUFFER, s_maxPoints*sizeof(CGLColor),
+  canvas_->glBufferData(GL_ARRAY_BUFFER, maxPoints*sizeof(CGLColor),
                         nullptr, GL_STREAM_DRAW);
   canvas_->glBufferSubData(GL_ARRAY_BUFFER, 0, n*sizeof(CGLColor), &colors_[0]);
 
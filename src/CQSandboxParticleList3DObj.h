@@ -32,15 +32,24 @@ class ParticleList3DObj : public Object3D {
   static Object3D *create(Canvas3D *canvas, const QStringList &args);
 
   ParticleList3DObj(Canvas3D *canvas);
+ ~ParticleList3DObj() override;
 
   const char *typeName() const override { return "ParticleList"; }
 
   double particleSize() const { return particleSize_; }
   void setParticleSize(double r) { particleSize_ = r; }
 
+  static const PropertyTable<Object3D> &properties();
+
   bool getValue(const QString &name, const QStringList &args, QVariant &value) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
+  bool exec(const QString &op, const QStringList &args, QVariant &res) override;
+
+  bool getData(const QString &name, int start, int stride, std::vector<float> &values) override;
+  bool setData(const QString &name, const std::vector<float> &values,
+               int start, int stride) override;
+
   const Points &points() const { return points_; }
   void setPoints(const Points &points);
 
@@ -60,6 +69,8 @@ class ParticleList3DObj : public Object3D {
  protected:
   void setNumPoints(int n);
 
+  void generateLorenz(int n);
+
 #ifdef CQSANDBOX_FLOCKING
   void updateFlocking();
 #endif
@@ -95,7 +106,8 @@ class ParticleList3DObj : public Object3D {
   CQGLTexture *texture_ { nullptr };
 
 #ifdef CQSANDBOX_FLOCKING
-  CFlocking* flocking_ { nullptr };
+  CFlocking* flocking_        { nullptr };
+  int        flockingThreads_ { 0 };
 #endif
 
 #ifdef CQSANDBOX_FIREWORKS
@@ -106,52 +106,75 @@ setLine(const CVector3D &p1, const CVector3D &p2)
   setNeedsUpdate();
 }
 
-bool
+const PropertyTable<Object3D> &
 Path3DObj::
-getValue(const QString &name, const QStringList &args, QVariant &value)
+properties()
 {
-  return Object3D::getValue(name, args, value);
-}
+  using Table = PropertyTable<Object3D>;
 
-bool
-Path3DObj::
-setValue(const QString &name, const QString &value, const QStringList &args)
-{
-  auto *app = canvas_->app();
-  auto *tcl = app->tcl();
+  static Table table({
+    { "path", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *pathObj = static_cast<Path3DObj *>(obj);
 
-  if (name == "path") {
-    path_.clear();
+        auto *tcl = pathObj->canvas()->app()->tcl();
 
-    QStringList strs;
-    (void) tcl->splitList(value, strs);
+        pathObj->path_.clear();
 
-    for (const auto &str : strs) {
-      QStringList strs1;
-      (void) tcl->splitList(str, strs1);
+        QStringList strs;
+        (void) tcl->splitList(value, strs);
 
-      if (strs1.size() < 2) continue;
+        for (const auto &str : strs) {
+          QStringList strs1;
+          (void) tcl->splitList(str, strs1);
 
-      if      (strs1[0] == "M") {
-        auto p = Util::stringToVector3D(tcl, strs1[1]);
+          if (strs1.size() < 2) continue;
 
-        path_.moveTo(p);
-      }
-      else if (strs1[0] == "L") {
-        auto p = Util::stringToVector3D(tcl, strs1[1]);
+          if      (strs1[0] == "M") {
+            auto p = Util::stringToVector3D(tcl, strs1[1]);
 
-        path_.lineTo(p);
-      }
-    }
+            pathObj->path_.moveTo(p);
+          }
+          else if (strs1[0] == "L") {
+            auto p = Util::stringToVector3D(tcl, strs1[1]);
 
-    updatePoints();
+            pathObj->path_.lineTo(p);
+          }
+        }
 
-    setNeedsUpdate();
-  }
-  else
-    return Object3D::setValue(name, value, args);
+        pathObj->updatePoints();
+
+        pathObj->setNeedsUpdate();
+
+        return true;
+      } },
+  }, &Object3D::properties());
+
+  return table;
+}
+
+bool
+Path3DObj::
+getValue(const QString &name, const QStringList &args, QVariant &value)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
+
+  return Object3D::getValue(name, args, value);
+}
+
+bool
+Path3DObj::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object3D::setValue(name, value, args);
 }
 
 void
@@ -31,6 +31,8 @@ class Path3DObj : public Object3D {
 
   void setLine(const CVector3D &p1, const CVector3D &p2);
 
+  static const PropertyTable<Object3D> &properties();
+
   bool getValue(const QString &name, const QStringList &args, QVariant &value) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -1,6 +1,7 @@
 #include <CQSandboxPlane3DObj.h>
 #include <CQSandboxCanvas3D.h>
 #include <CQSandboxApp.h>
+#include <CQSandboxTextureCache.h>
 #include <CQSandboxUtil.h>
 
 #include <CQTclUtil.h>
@@ -34,6 +35,12 @@ Plane3DObj(Canvas3D *canvas) :
 {
 }
 
+Plane3DObj::
+~Plane3DObj()
+{
+  canvas_->textureCache()->release(texture_);
+}
+
 void
 Plane3DObj::
 init()
@@ -78,21 +85,40 @@ init()
   texCoords_ = texCoords;
 }
 
+const PropertyTable<Object3D> &
+Plane3DObj::
+properties()
+{
+  using Table = PropertyTable<Object3D>;
+
+  static Table table({
+    { "color", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *plane = static_cast<Plane3DObj *>(obj);
+
+        plane->setColor(Util::stringToQColor(plane->canvas()->app()->tcl(), value));
+
+        return true;
+      } },
+    { "texture", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<Plane3DObj *>(obj)->setTextureFile(value); return true;
+      } },
+  }, &Object3D::properties());
+
+  return table;
+}
+
 bool
 Plane3DObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  auto *app = canvas_->app();
-  auto *tcl = app->tcl();
+  auto *property = properties().find(name);
 
-  if      (name == "color")
-    setColor(Util::stringToQColor(tcl, value));
-  else if (name == "texture")
-    setTextureFile(value);
-  else
-    return Object3D::setValue(name, value, args);
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object3D::setValue(name, value, args);
 }
 
 void
@@ -104,24 +130,28 @@ setColor(const QColor &c)
   setNeedsUpdate();
 }
 
+void
+Plane3DObj::
+setTexture(CQGLTexture *texture)
+{
+  canvas_->textureCache()->addRef(texture);
+  canvas_->textureCache()->release(texture_);
+
+  texture_ = texture;
+}
+
 void
 Plane3DObj::
 setTextureFile(const QString &filename)
 {
   textureFile_ = filename;
 
-  if (textureFile_ != "") {
-    texture_ = new CQGLTexture;
+  canvas_->textureCache()->release(texture_);
 
-    if (! texture_->load(textureFile_, /*flip*/true)) {
-      delete texture_;
-      texture_ = nullptr;
-    }
-  }
-  else {
-    delete texture_;
+  if (textureFile_ != "")
+    texture_ = canvas_->textureCache()->acquire(textureFile_, /*flip*/true);
+  else
     texture_ = nullptr;
-  }
 
   setNeedsUpdate();
 }
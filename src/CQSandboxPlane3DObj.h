@@ -25,6 +25,7 @@ class Plane3DObj : public Object3D {
   static Object3D *create(Canvas3D *canvas, const QStringList &args);
 
   Plane3DObj(Canvas3D *canvas);
+ ~Plane3DObj() override;
 
   const char *typeName() const override { return "Plane"; }
 
@@ -34,10 +35,13 @@ class Plane3DObj : public Object3D {
   const QString &textureFile() const { return textureFile_; }
   void setTextureFile(const QString &filename);
 
-  void setTexture(CQGLTexture *texture) { texture_ = texture; }
+  // shared texture (cache reference added)
+  void setTexture(CQGLTexture *texture);
 
   void init() override;
 
+  static const PropertyTable<Object3D> &properties();
+
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
   void initShader();
@@ -0,0 +1,156 @@
+#ifndef CQSandboxProperty_H
+#define CQSandboxProperty_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include <initializer_list>
+#include <vector>
+
+namespace CQSandbox {
+
+// interned property names
+//
+// each distinct name gets a small stable id. The last looked up name is remembered by
+// string data pointer so repeated lookups of the same interned string (e.g. the name
+// cached in a Tcl_Obj and passed down a getValue/setValue chain) are a pointer compare.
+class PropertyId {
+ public:
+  // id of name (name is added if new)
+  static int lookup(const QString &name) {
+    auto id = find(name);
+
+    if (id < 0) {
+      auto &data = getData();
+
+      id = data.names.size();
+
+      data.ids.insert(name, id);
+      data.names.push_back(name);
+
+      setLast(id);
+    }
+
+    return id;
+  }
+
+  // id of name or -1 if not interned (unknown names are not added)
+  static int find(const QString &name) {
+    auto &data = getData();
+
+    if (name.constData() == data.lastStr)
+      return data.lastId;
+
+    auto p = data.ids.find(name);
+
+    if (p == data.ids.end())
+      return -1;
+
+    auto id = p.value();
+
+    setLast(id);
+
+    return id;
+  }
+
+  // interned name for id (shares data with intern table)
+  static const QString &name(int id) {
+    return getData().names[id];
+  }
+
+ private:
+  struct Data {
+    QHash<QString, int> ids;
+    QStringList         names;
+    const QChar*        lastStr { nullptr };
+    int                 lastId  { -1 };
+  };
+
+  static void setLast(int id) {
+    auto &data = getData();
+
+    data.lastStr = data.names[id].constData();
+    data.lastId  = id;
+  }
+
+  static Data &getData() {
+    static Data data;
+
+    return data;
+  }
+};
+
+//---
+
+// table of object properties (name -> getter/setter) indexed by interned name id
+//
+// tables are function local statics built from the class's entry list on first use (the
+// entries are fixed at compile time, the name id index is built at run time).
+//
+// tables include the properties of the parent class table so the whole class hierarchy
+// is dispatched by one lookup. A derived class entry replaces the parent's getter and/or
+// setter for the name (a null getter or setter keeps the parent's).
+template<typename OBJ>
+class PropertyTable {
+ public:
+  using Getter = bool (*)(OBJ *obj, const QStringList &args, QVariant &value);
+  using Setter = bool (*)(OBJ *obj, const QString &value, const QStringList &args);
+
+  struct Property {
+    const char* name { nullptr };
+    Getter      get  { nullptr };
+    Setter      set  { nullptr };
+  };
+
+ public:
+  PropertyTable(std::initializer_list<Property> properties,
+                const PropertyTable *parent=nullptr) {
+    if (parent) {
+      for (const auto &property : parent->properties_)
+        add(property);
+    }
+
+    for (const auto &property : properties)
+      add(property);
+  }
+
+  const Property *find(const QString &name) const {
+    auto id = PropertyId::find(name);
+
+    if (id < 0 || id >= int(index_.size()) || index_[id] < 0)
+      return nullptr;
+
+    return &properties_[index_[id]];
+  }
+
+ private:
+  void add(const Property &property) {
+    auto id = PropertyId::lookup(property.name);
+
+    if (id >= int(index_.size()))
+      index_.resize(id + 1, -1);
+
+    // later (derived) definition replaces earlier
+    if (index_[id] >= 0) {
+      auto &property1 = properties_[index_[id]];
+
+      if (property.get) property1.get = property.get;
+      if (property.set) property1.set = property.set;
+    }
+    else {
+      index_[id] = int(properties_.size());
+
+      properties_.push_back(property);
+    }
+  }
+
+ private:
+  std::vector<Property> properties_;
+  std::vector<int>      index_;
+};
+
+}
+
+#endif
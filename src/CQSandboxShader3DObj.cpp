@@ -41,10 +41,35 @@ init()
   shaderToyProgram_ = new ShaderToyProgram(this);
 }
 
+const PropertyTable<Object3D> &
+Shader3DObj::
+properties()
+{
+  using Table = PropertyTable<Object3D>;
+
+  static Table table({
+    { "vertex_shader", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<Shader3DObj *>(obj)->shaderToyProgram_->setVertexShader(value); return true;
+      } },
+    { "fragment_shader", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<Shader3DObj *>(obj)->shaderToyProgram_->setFragmentShader(value); return true;
+      } },
+  }, &Object3D::properties());
+
+  return table;
+}
+
 bool
 Shader3DObj::
 getValue(const QString &name, const QStringList &args, QVariant &value)
 {
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
+
   return Object3D::getValue(name, args, value);
 }
 
@@ -52,14 +77,12 @@ bool
 Shader3DObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  if      (name == "vertex_shader")
-    shaderToyProgram_->setVertexShader(value);
-  else if (name == "fragment_shader")
-    shaderToyProgram_->setFragmentShader(value);
-  else
-    return Object3D::setValue(name, value, args);
-
-  return true;
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object3D::setValue(name, value, args);
 }
 
 void
@@ -69,138 +69,228 @@ init()
   canvas_->glGenBuffers(1, &indBufferId_);
 }
 
-bool
+const PropertyTable<Object3D> &
 ShaderShape3DObj::
-getValue(const QString &name, const QStringList &args, QVariant &value)
+properties()
 {
-  return Object3D::getValue(name, args, value);
-}
+  using Table = PropertyTable<Object3D>;
 
-bool
-ShaderShape3DObj::
-setValue(const QString &name, const QString &value, const QStringList &args)
-{
-  auto *app = canvas_->app();
-  auto *tcl = app->tcl();
+  static Table table({
+    { "points", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<ShaderShape3DObj *>(obj);
 
-  if      (name == "points") {
-    shapeData_.setPoints(Util::stringToVectors3D(tcl, value));
+        auto *tcl = shape->canvas()->app()->tcl();
 
-    setNeedsUpdate();
-  }
-  else if (name == "indices") {
-    shapeData_.setIndices(Util::stringToUIntArray(tcl, value));
+        shape->shapeData_.setPoints(Util::stringToVectors3D(tcl, value));
 
-    setNeedsUpdate();
-  }
-  else if (name == "colors") {
-    colors_ = Util::stringToColors(tcl, value);
+        shape->setNeedsUpdate();
 
-    setNeedsUpdate();
-  }
-  else if (name == "tex_coords") {
-    shapeData_.setTexCoords(Util::stringToVectors2D(tcl, value));
+        return true;
+      } },
+    { "indices", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<ShaderShape3DObj *>(obj);
 
-    setNeedsUpdate();
-  }
-  else if (name == "color") {
-    setColor(Util::stringToGLColor(tcl, value));
+        auto *tcl = shape->canvas()->app()->tcl();
 
-    setNeedsUpdate();
-  }
-  else if (name == "shader_texture") {
-    QStringList strs;
-    (void) tcl->splitList(value, strs);
+        shape->shapeData_.setIndices(Util::stringToUIntArray(tcl, value));
 
-    if (strs.length() != 2)
-      return app->errorMsg("Invalid number of values shader_texture <id> <file>");
+        shape->setNeedsUpdate();
 
-    setShaderToyTexture(strs[1]);
+        return true;
+      } },
+    { "colors", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<ShaderShape3DObj *>(obj);
 
-    setNeedsUpdate();
-  }
-  else if (name == "angle") {
-    CPoint3D p;
-    if (! Util::stringToPoint3D(tcl, value, p))
-      return false;
+        auto *tcl = shape->canvas()->app()->tcl();
 
-    xAngle_ = p.getX();
-    yAngle_ = p.getY();
-    zAngle_ = p.getZ();
+        shape->colors_ = Util::stringToColors(tcl, value);
 
-    setNeedsUpdate();
-  }
-  else if (name == "wireframe") {
-    wireframe_ = Util::stringToBool(value);
+        shape->setNeedsUpdate();
 
-    setNeedsUpdate();
-  }
-  // cone <r> <h>
-  else if (name == "cone") {
-    QStringList strs;
-    (void) tcl->splitList(value, strs);
+        return true;
+      } },
+    { "tex_coords", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<ShaderShape3DObj *>(obj);
 
-    if (strs.size() != 2)
-      return app->errorMsg("Invalid dimensions for cone");
+        auto *tcl = shape->canvas()->app()->tcl();
 
-    double r = Util::stringToReal(strs[0]);
-    double h = Util::stringToReal(strs[1]);
+        shape->shapeData_.setTexCoords(Util::stringToVectors2D(tcl, value));
 
-    shapeData_.addCone(r, h);
+        shape->setNeedsUpdate();
 
-    setNeedsUpdate();
-  }
-  // cylinder <r> <h>
-  else if (name == "cylinder") {
-    QStringList strs;
-    (void) tcl->splitList(value, strs);
+        return true;
+      } },
+    { "color", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<ShaderShape3DObj *>(obj);
 
-    if (strs.size() != 2)
-      return app->errorMsg("Invalid dimensions for cylinder");
+        shape->setColor(Util::stringToGLColor(shape->canvas()->app()->tcl(), value));
 
-    double r = Util::stringToReal(strs[0]);
-    double h = Util::stringToReal(strs[1]);
+        shape->setNeedsUpdate();
 
-    shapeData_.addCylinder(r, h);
+        return true;
+      } },
+    { "shader_texture", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<ShaderShape3DObj *>(obj);
 
-    setNeedsUpdate();
-  }
-  // sphere <r>
-  else if (name == "sphere") {
-    double r = Util::stringToReal(value);
+        auto *app = shape->canvas()->app();
 
-    shapeData_.addSphere(r);
+        QStringList strs;
+        (void) app->tcl()->splitList(value, strs);
 
-    setNeedsUpdate();
-  }
-  // cube <sx> <sy> >sz>
-  else if (name == "cube") {
-    QStringList strs;
-    (void) tcl->splitList(value, strs);
+        if (strs.length() != 2)
+          return app->errorMsg("Invalid number of values shader_texture <id> <file>");
 
-    double sx = 1.0, sy = 1.0, sz = 1.0;
+        shape->setShaderToyTexture(strs[1]);
 
-    if      (strs.size() == 1) {
-      sx = Util::stringToReal(value);
-      sy = sx;
-      sz = sx;
-    }
-    else if (strs.size() == 3) {
-      sx = Util::stringToReal(strs[0]);
-      sy = Util::stringToReal(strs[1]);
-      sz = Util::stringToReal(strs[2]);
-    }
-    else
-      return app->errorMsg("bad sizes for cube");
+        shape->setNeedsUpdate();
 
-    shapeData_.addCube(sx, sy, sz);
+        return true;
+      } },
+    { "angle", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<ShaderShape3DObj *>(obj);
 
-    setNeedsUpdate();
-  }
-  else
-    return Object3D::setValue(name, value, args);
+        CPoint3D p;
+        if (! Util::stringToPoint3D(shape->canvas()->app()->tcl(), value, p))
+          return false;
 
-  return true;
+        shape->xAngle_ = p.getX();
+        shape->yAngle_ = p.getY();
+        shape->zAngle_ = p.getZ();
+
+        shape->setNeedsUpdate();
+
+        return true;
+      } },
+    { "wireframe", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<ShaderShape3DObj *>(obj);
+
+        shape->wireframe_ = Util::stringToBool(value);
+
+        shape->setNeedsUpdate();
+
+        return true;
+      } },
+    // cone <r> <h>
+    { "cone", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<ShaderShape3DObj *>(obj);
+
+        auto *app = shape->canvas()->app();
+
+        QStringList strs;
+        (void) app->tcl()->splitList(value, strs);
+
+        if (strs.size() != 2)
+          return app->errorMsg("Invalid dimensions for cone");
+
+        double r = Util::stringToReal(strs[0]);
+        double h = Util::stringToReal(strs[1]);
+
+        shape->shapeData_.addCone(r, h);
+
+        shape->setNeedsUpdate();
+
+        return true;
+      } },
+    // cylinder <r> <h>
+    { "cylinder", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<ShaderShape3DObj *>(obj);
+
+        auto *app = shape->canvas()->app();
+
+        QStringList strs;
+        (void) app->tcl()->splitList(value, strs);
+
+        if (strs.size() != 2)
+          return app->errorMsg("Invalid dimensions for cylinder");
+
+        double r = Util::stringToReal(strs[0]);
+        double h = Util::stringToReal(strs[1]);
+
+        shape->shapeData_.addCylinder(r, h);
+
+        shape->setNeedsUpdate();
+
+        return true;
+      } },
+    // sphere <r>
+    { "sphere", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<ShaderShape3DObj *>(obj);
+
+        double r = Util::stringToReal(value);
+
+        shape->shapeData_.addSphere(r);
+
+        shape->setNeedsUpdate();
+
+        return true;
+      } },
+    // cube <sx> <sy> >sz>
+    { "cube", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<ShaderShape3DObj *>(obj);
+
+        QStringList strs;
+        (void) shape->canvas()->app()->tcl()->splitList(value, strs);
+
+        double sx = 1.0, sy = 1.0, sz = 1.0;
+
+        if      (strs.size() == 1) {
+          sx = Util::stringToReal(value);
+          sy = sx;
+          sz = sx;
+        }
+        else if (strs.size() == 3) {
+          sx = Util::stringToReal(strs[0]);
+          sy = Util::stringToReal(strs[1]);
+          sz = Util::stringToReal(strs[2]);
+        }
+        else
+          return shape->canvas()->app()->errorMsg("bad sizes for cube");
+
+        shape->shapeData_.addCube(sx, sy, sz);
+
+        shape->setNeedsUpdate();
+
+        return true;
+      } },
+  }, &Object3D::properties());
+
+  return table;
+}
+
+bool
+ShaderShape3DObj::
+getValue(const QString &name, const QStringList &args, QVariant &value)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
+
+  return Object3D::getValue(name, args, value);
+}
+
+bool
+ShaderShape3DObj::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object3D::setValue(name, value, args);
 }
 
 void
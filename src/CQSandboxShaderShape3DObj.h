@@ -36,6 +36,8 @@ class ShaderShape3DObj : public Object3D {
 
   const char *typeName() const override { return "ShaderShape"; }
 
+  static const PropertyTable<Object3D> &properties();
+
   bool getValue(const QString &name, const QStringList &args, QVariant &value) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
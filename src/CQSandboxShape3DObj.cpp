@@ -3,6 +3,7 @@
 #include <CQSandboxBBox3DObj.h>
 #include <CQSandboxLight3D.h>
 #include <CQSandboxApp.h>
+#include <CQSandboxTextureCache.h>
 #include <CQSandboxUtil.h>
 
 #include <CQGLTexture.h>
@@ -13,7 +14,35 @@
 
 namespace CQSandbox {
 
-ShaderProgram *Shape3DObj::s_program = nullptr;
+ShaderProgram *Shape3DObj::s_program          = nullptr;
+ShaderProgram *Shape3DObj::s_instanceProgram  = nullptr;
+unsigned int   Shape3DObj::s_instanceBufferId = 0;
+
+namespace {
+
+// per instance model matrix (column major) and color
+const int INSTANCE_SIZE = 20;
+
+// instance attributes (mat4 model uses locations 4-7 and vec4 color location 8)
+const int INSTANCE_LOC       = 4;
+const int NUM_INSTANCE_ATTRS = 5;
+
+// FNV-1a hash of data
+void hashData(size_t &hash, const void *data, size_t n) {
+  auto *p = reinterpret_cast<const unsigned char *>(data);
+
+  for (size_t i = 0; i < n; ++i) {
+    hash ^= p[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+template<typename T>
+void hashValue(size_t &hash, const T &value) {
+  hashData(hash, &value, sizeof(T));
+}
+
+}
 
 Object3D *
 Shape3DObj::
@@ -38,6 +67,15 @@ Shape3DObj(Canvas3D *canvas) :
 {
 }
 
+Shape3DObj::
+~Shape3DObj()
+{
+  delete buffer_;
+
+  canvas_->textureCache()->release(diffuseTexture_);
+  canvas_->textureCache()->release(normalTexture_);
+}
+
 void
 Shape3DObj::
 init()
@@ -149,137 +187,249 @@ initShader()
   }
 }
 
-bool
+void
 Shape3DObj::
-getValue(const QString &name, const QStringList &args, QVariant &value)
+initInstanceShader()
 {
-  return Object3D::getValue(name, args, value);
+  // same lighting as shape shader with per instance model matrix and color
+  if (! s_instanceProgram) {
+    auto *app = canvas_->app();
+
+    s_instanceProgram = new ShaderProgram(this);
+
+    s_instanceProgram->addVertexFile  (app->buildDir() + "/shaders/shape_instanced.vs");
+    s_instanceProgram->addFragmentFile(app->buildDir() + "/shaders/shape.fs");
+
+    s_instanceProgram->link();
+  }
 }
 
-bool
+const PropertyTable<Object3D> &
 Shape3DObj::
-setValue(const QString &name, const QString &value, const QStringList &args)
+properties()
 {
-  auto *app = canvas_->app();
-  auto *tcl = app->tcl();
+  using Table = PropertyTable<Object3D>;
 
-  if      (name == "points") {
-    shapeData_.setPoints(Util::stringToVectors3D(tcl, value));
+  static Table table({
+    { "color", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<Shape3DObj *>(obj);
 
-    setNeedsUpdate();
-  }
-  else if (name == "indices") {
-    shapeData_.setIndices(Util::stringToUIntArray(tcl, value));
+        shape->setColor(Util::stringToGLColor(shape->canvas()->app()->tcl(), value));
 
-    setNeedsUpdate();
-  }
-  else if (name == "colors") {
-    colors_ = Util::stringToColors(tcl, value);
+        shape->setNeedsUpdate();
 
-    setNeedsUpdate();
-  }
-  else if (name == "tex_coords") {
-    shapeData_.setTexCoords(Util::stringToVectors2D(tcl, value));
+        return true;
+      } },
+    { "angle", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<Shape3DObj *>(obj);
 
-    setNeedsUpdate();
-  }
-  else if (name == "color") {
-    setColor(Util::stringToGLColor(tcl, value));
+        CPoint3D p;
+        if (! Util::stringToPoint3D(shape->canvas()->app()->tcl(), value, p))
+          return false;
 
-    setNeedsUpdate();
-  }
-  else if (name == "texture") {
-    setTextureFile(value);
+        shape->xAngle_ = p.getX();
+        shape->yAngle_ = p.getY();
+        shape->zAngle_ = p.getZ();
 
-    setNeedsUpdate();
-  }
-  else if (name == "normal_texture") {
-    setNormalTexture(value);
+        shape->setNeedsUpdate();
 
-    setNeedsUpdate();
-  }
-  else if (name == "angle") {
-    CPoint3D p;
-    if (! Util::stringToPoint3D(tcl, value, p))
-      return false;
+        return true;
+      } },
+    { "wireframe", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<Shape3DObj *>(obj);
 
-    xAngle_ = p.getX();
-    yAngle_ = p.getY();
-    zAngle_ = p.getZ();
+        shape->wireframe_ = Util::stringToBool(value);
 
-    setNeedsUpdate();
-  }
-  else if (name == "wireframe") {
-    wireframe_ = Util::stringToBool(value);
+        shape->setNeedsUpdate();
 
-    setNeedsUpdate();
-  }
-  // cone <r> <h>
-  else if (name == "cone") {
-    QStringList strs;
-    (void) tcl->splitList(value, strs);
+        return true;
+      } },
+    { "points", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<Shape3DObj *>(obj);
 
-    if (strs.size() != 2)
-      return app->errorMsg("Invalid dimensions for cone");
+        auto *tcl = shape->canvas()->app()->tcl();
 
-    double r = Util::stringToReal(strs[0]);
-    double h = Util::stringToReal(strs[1]);
+        shape->shapeData_.setPoints(Util::stringToVectors3D(tcl, value));
 
-    shapeData_.addCone(r, h);
+        shape->setNeedsUpdate();
 
-    setNeedsUpdate();
-  }
-  // cylinder <r> <h>
-  else if (name == "cylinder") {
-    QStringList strs;
-    (void) tcl->splitList(value, strs);
+        return true;
+      } },
+    { "indices", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<Shape3DObj *>(obj);
 
-    if (strs.size() != 2)
-      return app->errorMsg("Invalid dimensions for cylinder");
+        auto *tcl = shape->canvas()->app()->tcl();
 
-    double r = Util::stringToReal(strs[0]);
-    double h = Util::stringToReal(strs[1]);
+        shape->shapeData_.setIndices(Util::stringToUIntArray(tcl, value));
 
-    shapeData_.addCylinder(r, h);
+        shape->setNeedsUpdate();
 
-    setNeedsUpdate();
-  }
-  // sphere <r>
-  else if (name == "sphere") {
-    double r = Util::stringToReal(value);
+        return true;
+      } },
+    { "colors", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<Shape3DObj *>(obj);
 
-    shapeData_.addSphere(r);
+        auto *tcl = shape->canvas()->app()->tcl();
 
-    setNeedsUpdate();
-  }
-  // cube <sx> <sy> >sz>
-  else if (name == "cube") {
-    QStringList strs;
-    (void) tcl->splitList(value, strs);
+        shape->colors_ = Util::stringToColors(tcl, value);
 
-    double sx = 1.0, sy = 1.0, sz = 1.0;
+        shape->setNeedsUpdate();
 
-    if      (strs.size() == 1) {
-      sx = Util::stringToReal(value);
-      sy = sx;
-      sz = sx;
-    }
-    else if (strs.size() == 3) {
-      sx = Util::stringToReal(strs[0]);
-      sy = Util::stringToReal(strs[1]);
-      sz = Util::stringToReal(strs[2]);
-    }
-    else
-      return app->errorMsg("bad sizes for cube");
+        return true;
+      } },
+    { "tex_coords", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<Shape3DObj *>(obj);
 
-    shapeData_.addCube(sx, sy, sz);
+        auto *tcl = shape->canvas()->app()->tcl();
 
-    setNeedsUpdate();
-  }
-  else
-    return Object3D::setValue(name, value, args);
+        shape->shapeData_.setTexCoords(Util::stringToVectors2D(tcl, value));
 
-  return true;
+        shape->setNeedsUpdate();
+
+        return true;
+      } },
+
+    { "texture", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<Shape3DObj *>(obj);
+
+        shape->setTextureFile(value);
+
+        shape->setNeedsUpdate();
+
+        return true;
+      } },
+    { "normal_texture", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<Shape3DObj *>(obj);
+
+        shape->setNormalTexture(value);
+
+        shape->setNeedsUpdate();
+
+        return true;
+      } },
+
+    // cone <r> <h>
+    { "cone", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<Shape3DObj *>(obj);
+
+        auto *app = shape->canvas()->app();
+
+        QStringList strs;
+        (void) app->tcl()->splitList(value, strs);
+
+        if (strs.size() != 2)
+          return app->errorMsg("Invalid dimensions for cone");
+
+        double r = Util::stringToReal(strs[0]);
+        double h = Util::stringToReal(strs[1]);
+
+        shape->shapeData_.addCone(r, h);
+
+        shape->setNeedsUpdate();
+
+        return true;
+      } },
+    // cylinder <r> <h>
+    { "cylinder", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<Shape3DObj *>(obj);
+
+        auto *app = shape->canvas()->app();
+
+        QStringList strs;
+        (void) app->tcl()->splitList(value, strs);
+
+        if (strs.size() != 2)
+          return app->errorMsg("Invalid dimensions for cylinder");
+
+        double r = Util::stringToReal(strs[0]);
+        double h = Util::stringToReal(strs[1]);
+
+        shape->shapeData_.addCylinder(r, h);
+
+        shape->setNeedsUpdate();
+
+        return true;
+      } },
+    // sphere <r>
+    { "sphere", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<Shape3DObj *>(obj);
+
+        double r = Util::stringToReal(value);
+
+        shape->shapeData_.addSphere(r);
+
+        shape->setNeedsUpdate();
+
+        return true;
+      } },
+    // cube <sx> <sy> >sz>
+    { "cube", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *shape = static_cast<Shape3DObj *>(obj);
+
+        QStringList strs;
+        (void) shape->canvas()->app()->tcl()->splitList(value, strs);
+
+        double sx = 1.0, sy = 1.0, sz = 1.0;
+
+        if      (strs.size() == 1) {
+          sx = Util::stringToReal(value);
+          sy = sx;
+          sz = sx;
+        }
+        else if (strs.size() == 3) {
+          sx = Util::stringToReal(strs[0]);
+          sy = Util::stringToReal(strs[1]);
+          sz = Util::stringToReal(strs[2]);
+        }
+        else
+          return shape->canvas()->app()->errorMsg("bad sizes for cube");
+
+        shape->shapeData_.addCube(sx, sy, sz);
+
+        shape->setNeedsUpdate();
+
+        return true;
+      } },
+  }, &Object3D::properties());
+
+  return table;
+}
+
+bool
+Shape3DObj::
+getValue(const QString &name, const QStringList &args, QVariant &value)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
+
+  return Object3D::getValue(name, args, value);
+}
+
+bool
+Shape3DObj::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object3D::setValue(name, value, args);
 }
 
 void
@@ -297,30 +447,41 @@ setTextureFile(const QString &filename)
 {
   textureFile_ = filename;
 
-  if (textureFile_ != "") {
-    diffuseTexture_ = new CQGLTexture;
+  canvas_->textureCache()->release(diffuseTexture_);
 
-    if (! diffuseTexture_->load(textureFile_, /*flip*/true)) {
-      delete diffuseTexture_;
-      diffuseTexture_ = nullptr;
-    }
-  }
-  else {
-    delete diffuseTexture_;
+  if (textureFile_ != "")
+    diffuseTexture_ = canvas_->textureCache()->acquire(textureFile_, /*flip*/true);
+  else
     diffuseTexture_ = nullptr;
-  }
+}
+
+void
+Shape3DObj::
+setTexture(CQGLTexture *texture)
+{
+  canvas_->textureCache()->addRef(texture);
+  canvas_->textureCache()->release(diffuseTexture_);
+
+  diffuseTexture_ = texture;
+}
+
+void
+Shape3DObj::
+setNormalTexture(CQGLTexture *texture)
+{
+  canvas_->textureCache()->addRef(texture);
+  canvas_->textureCache()->release(normalTexture_);
+
+  normalTexture_ = texture;
 }
 
 void
 Shape3DObj::
 setNormalTexture(const QString &filename)
 {
-  normalTexture_ = new CQGLTexture;
+  canvas_->textureCache()->release(normalTexture_);
 
-  if (! normalTexture_->load(filename, /*flip*/true)) {
-    delete normalTexture_;
-    normalTexture_ = nullptr;
-  }
+  normalTexture_ = canvas_->textureCache()->acquire(filename, /*flip*/true);
 }
 
 bool
@@ -520,6 +681,30 @@ updateGL()
 
   buffer_->load();
 #endif
+
+  //---
+
+  // geometry key for instancing (colors are per instance)
+  geometryKey_ = 14695981039346656037ULL;
+
+  for (uint i = 0; i < np; ++i) {
+    hashValue(geometryKey_, points [i].x()); hashValue(geometryKey_, points [i].y());
+    hashValue(geometryKey_, points [i].z());
+    hashValue(geometryKey_, normals[i].x()); hashValue(geometryKey_, normals[i].y());
+    hashValue(geometryKey_, normals[i].z());
+  }
+
+  if (nt == np) {
+    for (uint i = 0; i < np; ++i) {
+      hashValue(geometryKey_, texCoords[i].x()); hashValue(geometryKey_, texCoords[i].y());
+    }
+  }
+
+  if (ni > 0)
+    hashData(geometryKey_, &indices[0], ni*sizeof(indices[0]));
+
+  hashValue(geometryKey_, shapeData_.isUseTriangleStrip());
+  hashValue(geometryKey_, shapeData_.isUseTriangleFan());
 }
 
 CBBox3D
@@ -591,26 +776,10 @@ render()
 
   //---
 
-  auto *light = canvas_->currentLight();
-
-  auto lightPos   = light->getPosition();
-  auto lightColor = light->getDiffuse();
-
   //s_program->bind();
   canvas_->bindProgram(s_program);
 
-  s_program->setUniformValue("viewPos", CQGLUtil::toVector(canvas_->viewPos()));
-
-  s_program->setUniformValue("lightPos"  , CQGLUtil::toVector(lightPos));
-  s_program->setUniformValue("lightColor", CQGLUtil::toVector(lightColor));
-
-  s_program->setUniformValue("ambientStrength" , float(canvas_->ambientStrength()));
-  s_program->setUniformValue("diffuseStrength" , float(canvas_->diffuseStrength()));
-  s_program->setUniformValue("specularStrength", float(canvas_->specularStrength()));
-  s_program->setUniformValue("shininess"       , float(canvas_->shininess()));
-
-  s_program->setUniformValue("projection", CQGLUtil::toQMatrix(canvas_->projectionMatrix()));
-  s_program->setUniformValue("view", CQGLUtil::toQMatrix(canvas_->viewMatrix()));
+  setShaderUniforms(s_program);
 
   setModelMatrix();
   s_program->setUniformValue("model", CQGLUtil::toQMatrix(modelMatrix()));
@@ -626,50 +795,232 @@ render()
 
   //---
 
-  s_program->setUniformValue("useDiffuseTexture", useDiffuseTexture_);
-  s_program->setUniformValue("useNormalTexture", useNormalTexture_);
-  s_program->setUniformValue("textureId", 0);
+  bindTextures();
 
-  if (useDiffuseTexture_ || useNormalTexture_)
-    glEnable(GL_TEXTURE_2D);
+  drawShape(0);
+
+  unbindTextures();
 
-  if (useDiffuseTexture_) {
-    glActiveTexture(GL_TEXTURE0);
+  //---
+
+#if 0
+  //canvas_->glBindVertexArray(0);
+#else
+  //buffer_->unbind();
+#endif
+}
 
-    if (useDiffuseTexture_)
-      diffuseTexture_->bind();
+size_t
+Shape3DObj::
+instanceKey()
+{
+  // bbox, inside (highlight color) and per vertex colors need normal render
+  if (canvas_->isShowBBox() || isSelected() || isInside())
+    return 0;
+
+  updateGL();
+
+  if (! colors_.empty() && colors_.size() == shapeData_.points().size())
+    return 0;
+
+  auto key = geometryKey_;
+
+  hashValue(key, diffuseTexture_);
+  hashValue(key, normalTexture_);
+  hashValue(key, useDiffuseTexture_);
+  hashValue(key, useNormalTexture_);
+  hashValue(key, wireframe_);
+
+  return (key ? key : 1);
+}
+
+void
+Shape3DObj::
+renderInstances(const std::vector<Object3D *> &objects)
+{
+  updateGL();
+
+  if (wireframe_ || canvas_->isWireframe())
+    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+  else
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+  //---
+
+  initInstanceShader();
+
+  canvas_->bindProgram(s_instanceProgram);
+
+  setShaderUniforms(s_instanceProgram);
+
+  //---
+
+  // instance data
+  static std::vector<float> s_instanceData;
+
+  auto n = objects.size();
+
+  s_instanceData.resize(n*INSTANCE_SIZE);
+
+  auto *data = &s_instanceData[0];
+
+  for (auto *obj : objects) {
+    auto *shape = dynamic_cast<Shape3DObj *>(obj);
+    assert(shape);
+
+    shape->setModelMatrix();
+
+    auto m = CQGLUtil::toQMatrix(shape->modelMatrix());
+
+    std::copy(m.constData(), m.constData() + 16, data);
+
+    // vertex colors are rgb (alpha 1)
+    const auto &c = shape->color();
+
+    data[16] = float(c.r);
+    data[17] = float(c.g);
+    data[18] = float(c.b);
+    data[19] = 1.0f;
+
+    data += INSTANCE_SIZE;
   }
 
-  if (useNormalTexture_) {
-    glActiveTexture(GL_TEXTURE1);
+  //---
+
+  // add instance attributes to shared geometry vertex array
+  canvas_->bindBuffer(buffer_);
+
+  if (! s_instanceBufferId)
+    canvas_->glGenBuffers(1, &s_instanceBufferId);
+
+  canvas_->glBindBuffer(GL_ARRAY_BUFFER, s_instanceBufferId);
+  canvas_->glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(n*INSTANCE_SIZE*sizeof(float)),
+                        &s_instanceData[0], GL_STREAM_DRAW);
+
+  auto stride = GLsizei(INSTANCE_SIZE*sizeof(float));
+
+  for (int i = 0; i < NUM_INSTANCE_ATTRS; ++i) {
+    auto loc = GLuint(INSTANCE_LOC + i);
 
-    normalTexture_->bind();
+    canvas_->glEnableVertexAttribArray(loc);
+    canvas_->glVertexAttribPointer(loc, 4, GL_FLOAT, GL_FALSE, stride,
+                                   reinterpret_cast<void *>(4*i*sizeof(float)));
+    canvas_->glVertexAttribDivisor(loc, 1);
   }
 
-  auto np = shapeData_.points ().size();
-  auto ni = shapeData_.indices().size();
+  canvas_->glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-  if (ni > 0)
-    glDrawElements(GL_TRIANGLES, ni, GL_UNSIGNED_INT, nullptr);
-  else {
-    if      (shapeData_.isUseTriangleStrip())
-      glDrawArrays(GL_TRIANGLE_STRIP, 0, np);
-    else if (shapeData_.isUseTriangleFan())
-      glDrawArrays(GL_TRIANGLE_FAN, 0, np);
-    else
-      glDrawArrays(GL_TRIANGLES, 0, np);
+  //---
+
+  bindTextures();
+
+  drawShape(int(n));
+
+  unbindTextures();
+
+  //---
+
+  // remove instance attributes so vertex array can be drawn by render
+  for (int i = 0; i < NUM_INSTANCE_ATTRS; ++i) {
+    auto loc = GLuint(INSTANCE_LOC + i);
+
+    canvas_->glVertexAttribDivisor(loc, 0);
+    canvas_->glDisableVertexAttribArray(loc);
   }
+}
+
+Shape3DObj::RenderState
+Shape3DObj::
+renderState()
+{
+  // vertex colors are rgb so shapes are always opaque
+  RenderState state;
+
+  state.program = s_program;
+  state.texture = (useDiffuseTexture_ ? diffuseTexture_ : nullptr);
+  state.buffer  = buffer_;
+
+  return state;
+}
+
+void
+Shape3DObj::
+setShaderUniforms(ShaderProgram *program)
+{
+  auto *light = canvas_->currentLight();
+
+  auto lightPos   = light->getPosition();
+  auto lightColor = light->getDiffuse();
+
+  program->setUniformValue("viewPos", CQGLUtil::toVector(canvas_->viewPos()));
+
+  program->setUniformValue("lightPos"  , CQGLUtil::toVector(lightPos));
+  program->setUniformValue("lightColor", CQGLUtil::toVector(lightColor));
+
+  program->setUniformValue("ambientStrength" , float(canvas_->ambientStrength()));
+  program->setUniformValue("diffuseStrength" , float(canvas_->diffuseStrength()));
+  program->setUniformValue("specularStrength", float(canvas_->specularStrength()));
+  program->setUniformValue("shininess"       , float(canvas_->shininess()));
+
+  program->setUniformValue("projection", CQGLUtil::toQMatrix(canvas_->projectionMatrix()));
+  program->setUniformValue("view", CQGLUtil::toQMatrix(canvas_->viewMatrix()));
+
+  program->setUniformValue("useDiffuseTexture", useDiffuseTexture_);
+  program->setUniformValue("useNormalTexture", useNormalTexture_);
+  program->setUniformValue("textureId", 0);
+}
+
+void
+Shape3DObj::
+bindTextures()
+{
+  if (useDiffuseTexture_ || useNormalTexture_)
+    glEnable(GL_TEXTURE_2D);
+
+  if (useDiffuseTexture_)
+    canvas_->bindTexture(diffuseTexture_, 0);
+
+  if (useNormalTexture_)
+    canvas_->bindTexture(normalTexture_, 1);
+}
 
+void
+Shape3DObj::
+unbindTextures()
+{
   if (useDiffuseTexture_ || useNormalTexture_)
     glDisable(GL_TEXTURE_2D);
+}
 
-  //---
+void
+Shape3DObj::
+drawShape(int numInstances)
+{
+  // draw shape (numInstances > 0 for instanced draw)
+  auto np = GLsizei(shapeData_.points ().size());
+  auto ni = GLsizei(shapeData_.indices().size());
 
-#if 0
-  //canvas_->glBindVertexArray(0);
-#else
-  //buffer_->unbind();
-#endif
+  GLenum mode = GL_TRIANGLES;
+
+  if (ni == 0) {
+    if      (shapeData_.isUseTriangleStrip())
+      mode = GL_TRIANGLE_STRIP;
+    else if (shapeData_.isUseTriangleFan())
+      mode = GL_TRIANGLE_FAN;
+  }
+
+  if (numInstances > 0) {
+    if (ni > 0)
+      canvas_->glDrawElementsInstanced(mode, ni, GL_UNSIGNED_INT, nullptr, numInstances);
+    else
+      canvas_->glDrawArraysInstanced(mode, 0, np, numInstances);
+  }
+  else {
+    if (ni > 0)
+      glDrawElements(mode, ni, GL_UNSIGNED_INT, nullptr);
+    else
+      glDrawArrays(mode, 0, np);
+  }
 }
 
 }
@@ -24,11 +24,14 @@ class Shape3DObj : public Object3D {
   static Object3D *create(Canvas3D *canvas, const QStringList &args);
 
   Shape3DObj(Canvas3D *canvas);
+ ~Shape3DObj() override;
 
   const char *typeName() const override { return "Shape"; }
 
   const Shape3DData &shapeData() const { return shapeData_; }
 
+  static const PropertyTable<Object3D> &properties();
+
   bool getValue(const QString &name, const QStringList &args, QVariant &value) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -38,10 +41,11 @@ class Shape3DObj : public Object3D {
   const QString &textureFile() const { return textureFile_; }
   void setTextureFile(const QString &filename);
 
-  void setTexture(CQGLTexture *texture) { diffuseTexture_ = texture; }
+  // shared texture (cache reference added)
+  void setTexture(CQGLTexture *texture);
 
   void setNormalTexture(const QString &filename);
-  void setNormalTexture(CQGLTexture *texture) { normalTexture_ = texture; }
+  void setNormalTexture(CQGLTexture *texture);
 
   void init() override;
 
@@ -56,15 +60,31 @@ class Shape3DObj : public Object3D {
 
   void render() override;
 
+  size_t instanceKey() override;
+
+  void renderInstances(const std::vector<Object3D *> &objects) override;
+
+  RenderState renderState() override;
+
   void addCube(double sx, double sy, double sz);
 
  private:
   void initShader();
+  void initInstanceShader();
+
+  void setShaderUniforms(ShaderProgram *program);
+
+  void bindTextures();
+  void unbindTextures();
+
+  void drawShape(int numInstances);
 
  protected:
   using Colors = std::vector<CGLColor>;
 
   static ShaderProgram* s_program;
+  static ShaderProgram* s_instanceProgram;
+  static unsigned int   s_instanceBufferId;
 
   CGLColor color_ { 1.0, 1.0, 1.0, 1.0 };
 
@@ -80,6 +100,8 @@ class Shape3DObj : public Object3D {
   bool useDiffuseTexture_ { false };
   bool useNormalTexture_  { false };
 
+  size_t geometryKey_ { 0 }; // hash of buffer geometry (points, normals, tex coords, indices)
+
 #if 0
   unsigned int pointsBufferId_   { 0 };
   unsigned int normalsBufferId_  { 0 };
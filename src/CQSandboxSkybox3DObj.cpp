@@ -131,57 +131,81 @@ load()
   return true;
 }
 
-bool
+const PropertyTable<Object3D> &
 Skybox3DObj::
-getValue(const QString &name, const QStringList &args, QVariant &value)
+properties()
 {
-  return Object3D::getValue(name, args, value);
-}
+  using Table = PropertyTable<Object3D>;
 
-bool
-Skybox3DObj::
-setValue(const QString &name, const QString &value, const QStringList &args)
-{
-  auto *app = canvas()->app();
-  auto *tcl = app->tcl();
+  static Table table({
+    { "images", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *skybox = static_cast<Skybox3DObj *>(obj);
 
-  if      (name == "images") {
-    QStringList strs;
-    (void) tcl->splitList(value, strs);
+        auto *canvas = skybox->canvas();
 
-    if (strs.length() != 6)
-      return false;
+        QStringList strs;
+        (void) canvas->app()->tcl()->splitList(value, strs);
 
-    images_.resize(6);
+        if (strs.length() != 6)
+          return false;
 
-    for (int i = 0; i < 6; ++i) {
-      images_[i] = QImage(strs[i]);
+        skybox->images_.resize(6);
 
-      if (images_[i].isNull())
-        std::cerr << "Invalid image '" << strs[i].toStdString() << "'\n";
-    }
+        for (int i = 0; i < 6; ++i) {
+          skybox->images_[i] = QImage(strs[i]);
 
-    delete cubemap_;
+          if (skybox->images_[i].isNull())
+            std::cerr << "Invalid image '" << strs[i].toStdString() << "'\n";
+        }
 
-    cubemap_ = new CQGLCubemap;
-    cubemap_->setImages(images_);
+        delete skybox->cubemap_;
 
-    canvas_->glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+        skybox->cubemap_ = new CQGLCubemap;
+        skybox->cubemap_->setImages(skybox->images_);
 
-    delete texture_;
+        canvas->glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 
-    texture_ = new CQGLTexture;
-    texture_->setImage(images_[0]);
+        delete skybox->texture_;
 
-    needsUpdate_ = true;
-  }
-  else if (name == "cubemap") {
-    useCubemap_ = Util::stringToBool(value);
-  }
-  else
-    return Object3D::setValue(name, value, args);
+        skybox->texture_ = new CQGLTexture;
+        skybox->texture_->setImage(skybox->images_[0]);
 
-  return true;
+        skybox->needsUpdate_ = true;
+
+        return true;
+      } },
+    { "cubemap", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<Skybox3DObj *>(obj)->useCubemap_ = Util::stringToBool(value); return true;
+      } },
+  }, &Object3D::properties());
+
+  return table;
+}
+
+bool
+Skybox3DObj::
+getValue(const QString &name, const QStringList &args, QVariant &value)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
+
+  return Object3D::getValue(name, args, value);
+}
+
+bool
+Skybox3DObj::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
+
+  return Object3D::setValue(name, value, args);
 }
 
 void
@@ -28,6 +28,8 @@ class Skybox3DObj : public Object3D {
 
   const char *typeName() const override { return "Skybox"; }
 
+  static const PropertyTable<Object3D> &properties();
+
   bool getValue(const QString &name, const QStringList &args, QVariant &value) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -1,6 +1,7 @@
 #include <CQSandboxSprite3DObj.h>
 #include <CQSandboxCanvas3D.h>
 #include <CQSandboxApp.h>
+#include <CQSandboxTextureCache.h>
 #include <CQSandboxUtil.h>
 
 #include <CQGLBuffer.h>
@@ -34,6 +35,13 @@ Sprite3DObj(Canvas3D *canvas) :
 {
 }
 
+Sprite3DObj::
+~Sprite3DObj()
+{
+  for (auto *texture : textures_)
+    canvas_->textureCache()->release(texture);
+}
+
 void
 Sprite3DObj::
 init()
@@ -127,6 +135,11 @@ void
 Sprite3DObj::
 setTexture(CQGLTexture *texture)
 {
+  canvas_->textureCache()->addRef(texture);
+
+  for (auto *texture1 : textures_)
+    canvas_->textureCache()->release(texture1);
+
   textures_.clear();
 
   textures_.push_back(texture);
@@ -144,10 +157,59 @@ currentTexture() const
   return nullptr;
 }
 
+const PropertyTable<Object3D> &
+Sprite3DObj::
+properties()
+{
+  using Table = PropertyTable<Object3D>;
+
+  static Table table({
+    { "add_image", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *sprite = static_cast<Sprite3DObj *>(obj);
+
+        auto *texture = sprite->canvas_->textureCache()->acquire(value, /*flip*/false);
+
+        if (texture)
+          sprite->textures_.push_back(texture);
+
+        return true;
+      } },
+    { "image_start", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<Sprite3DObj *>(obj)->textureStart_ = Util::stringToInt(value);
+        return true;
+      } },
+    { "image_end", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<Sprite3DObj *>(obj)->textureEnd_ = Util::stringToInt(value);
+        return true;
+      } },
+    { "velocity", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *sprite = static_cast<Sprite3DObj *>(obj);
+
+        auto v = Util::stringToPoint2D(sprite->canvas()->app()->tcl(), value);
+
+        sprite->xv_ = v.x;
+        sprite->yv_ = v.y;
+
+        return true;
+      } },
+  }, &Object3D::properties());
+
+  return table;
+}
+
 bool
 Sprite3DObj::
 getValue(const QString &name, const QStringList &args, QVariant &value)
 {
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
+
   return Object3D::getValue(name, args, value);
 }
 
@@ -155,33 +217,12 @@ bool
 Sprite3DObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  auto *app = canvas_->app();
-  auto *tcl = app->tcl();
+  auto *property = properties().find(name);
 
-  if      (name == "add_image") {
-    auto *texture = new CQGLTexture;
+  if (property && property->set)
+    return property->set(this, value, args);
 
-    if (texture->load(value, /*flip*/false))
-      textures_.push_back(texture);
-    else
-      delete texture;
-  }
-  else if (name == "image_start") {
-    textureStart_ = Util::stringToInt(value);
-  }
-  else if (name == "image_end") {
-    textureEnd_ = Util::stringToInt(value);
-  }
-  else if (name == "velocity") {
-    auto v = Util::stringToPoint2D(tcl, value);
-
-    xv_ = v.x;
-    yv_ = v.y;
-  }
-  else
-    return Object3D::setValue(name, value, args);
-
-  return true;
+  return Object3D::setValue(name, value, args);
 }
 
 void
@@ -254,12 +295,10 @@ render()
 
   s_program->setUniformValue("model", CQGLUtil::toQMatrix(modelMatrix()));
 
-  glActiveTexture(GL_TEXTURE0);
-
   auto *texture = currentTexture();
 
   if (texture)
-    texture->bind();
+    canvas_->bindTexture(texture, 0);
 
   glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
@@ -268,4 +307,19 @@ render()
   //buffer_->unbind();
 }
 
+Sprite3DObj::RenderState
+Sprite3DObj::
+renderState()
+{
+  // sprite images are alpha blended
+  RenderState state;
+
+  state.program     = s_program;
+  state.texture     = currentTexture();
+  state.buffer      = buffer_;
+  state.transparent = true;
+
+  return state;
+}
+
 }
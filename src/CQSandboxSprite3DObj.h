@@ -17,6 +17,7 @@ class Sprite3DObj : public Object3D {
   static Object3D *create(Canvas3D *canvas, const QStringList &args);
 
   Sprite3DObj(Canvas3D *canvas);
+ ~Sprite3DObj() override;
 
   const char *typeName() const override { return "Sprite"; }
 
@@ -25,6 +26,8 @@ class Sprite3DObj : public Object3D {
 
   CQGLTexture *currentTexture() const;
 
+  static const PropertyTable<Object3D> &properties();
+
   bool getValue(const QString &name, const QStringList &args, QVariant &value) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
@@ -36,6 +39,8 @@ class Sprite3DObj : public Object3D {
 
   void render() override;
 
+  RenderState renderState() override;
+
  private:
   void initShader();
 
@@ -42,169 +42,211 @@ Surface3DObj(Canvas3D *canvas) :
 {
 }
 
-bool
-Surface3DObj::
-getValue(const QString &name, const QStringList &args, QVariant &value)
-{
-  return Object3D::getValue(name, args, value);
-}
-
-bool
+const PropertyTable<Object3D> &
 Surface3DObj::
-setValue(const QString &name, const QString &value, const QStringList &args)
+properties()
 {
-  auto *app = canvas_->app();
-  auto *tcl = app->tcl();
+  using Table = PropertyTable<Object3D>;
 
-  if      (name == "size") {
+  // get point index from "<ix> <iy>" arg (-1 if invalid)
+  static auto argToIndex = [](Surface3DObj *surface, const QStringList &args) {
     QStringList strs;
-    (void) tcl->splitList(value, strs);
+    (void) surface->canvas()->app()->tcl()->splitList(args[0], strs);
+
+    int ix = -1, iy = -1;
 
     if (strs.size() >= 2) {
-      bool ok;
-      nx_ = std::max(strs[0].toInt(&ok), 0);
-      ny_ = std::max(strs[1].toInt(&ok), 0);
+      ix = Util::stringToInt(strs[0]);
+      iy = Util::stringToInt(strs[1]);
     }
 
-    resizePoints();
+    if (ix < 0 || ix >= surface->nx_ || iy < 0 || iy >= surface->ny_)
+      return -1;
 
-    setNeedsUpdate();
-  }
+    return iy*surface->nx_ + ix;
+  };
+
+  static Table table({
+    { "size", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *surface = static_cast<Surface3DObj *>(obj);
+
+        QStringList strs;
+        (void) surface->canvas()->app()->tcl()->splitList(value, strs);
+
+        if (strs.size() >= 2) {
+          bool ok;
+          surface->nx_ = std::max(strs[0].toInt(&ok), 0);
+          surface->ny_ = std::max(strs[1].toInt(&ok), 0);
+        }
+
+        surface->resizePoints();
+
+        surface->setNeedsUpdate();
+
+        return true;
+      } },
 #ifdef CQSANDBOX_WATER_SURFACE
-  else if (name == "water_surface") {
-    bool ok;
-    nx_ = std::max(value.toInt(&ok), 1);
-    ny_ = nx_;
+    { "water_surface", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *surface = static_cast<Surface3DObj *>(obj);
+
+        bool ok;
+        auto nx = std::max(value.toInt(&ok), 1);
 
-    resizePoints();
+        surface->nx_ = nx;
+        surface->ny_ = nx;
+
+        surface->resizePoints();
 
 #ifdef CQSANDBOX_FLAG
-    delete flag_;
-    flag_ = nullptr;
+        delete surface->flag_;
+        surface->flag_ = nullptr;
 #endif
 
-    delete waterSurface_;
-    waterSurface_ = new CWaterSurface(nx_);
+        delete surface->waterSurface_;
+        surface->waterSurface_ = new CWaterSurface(nx);
 
-    //---
+        //---
 
-    for (int iy = 1; iy < nx_ - 1; ++iy) {
-      for (int ix = 1; ix < nx_ - 1; ++ix) {
-        waterSurface_->setDampening(ix, iy, 1.0);
+        auto *waterSurface = surface->waterSurface_;
 
-        waterSurface_->setZ(ix, iy, 0.0);
-      }
-    }
+        for (int iy = 1; iy < nx - 1; ++iy) {
+          for (int ix = 1; ix < nx - 1; ++ix) {
+            waterSurface->setDampening(ix, iy, 1.0);
 
-    waterSurface_->setZ(int(    nx_/4.0), int(    nx_/4.0), 1.0);
-    waterSurface_->setZ(int(3.0*nx_/4.0), int(3.0*nx_/4.0), 1.0);
+            waterSurface->setZ(ix, iy, 0.0);
+          }
+        }
 
-    //---
+        waterSurface->setZ(int(    nx/4.0), int(    nx/4.0), 1.0);
+        waterSurface->setZ(int(3.0*nx/4.0), int(3.0*nx/4.0), 1.0);
 
-    updateWaterSurface();
-  }
+        //---
+
+        surface->updateWaterSurface();
+
+        return true;
+      } },
 #endif
 #ifdef CQSANDBOX_FLAG
-  else if (name == "flag") {
-    QStringList strs;
-    (void) tcl->splitList(value, strs);
+    { "flag", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *surface = static_cast<Surface3DObj *>(obj);
 
-    if (strs.size() >= 2) {
-      bool ok;
-      nx_ = std::max(strs[0].toInt(&ok), 0);
-      ny_ = std::max(strs[1].toInt(&ok), 0);
-    }
+        QStringList strs;
+        (void) surface->canvas()->app()->tcl()->splitList(value, strs);
+
+        if (strs.size() >= 2) {
+          bool ok;
+          surface->nx_ = std::max(strs[0].toInt(&ok), 0);
+          surface->ny_ = std::max(strs[1].toInt(&ok), 0);
+        }
 
-    resizePoints();
+        surface->resizePoints();
 
 #ifdef CQSANDBOX_WATER_SURFACE
-    delete waterSurface_;
-    waterSurface_ = nullptr;
+        delete surface->waterSurface_;
+        surface->waterSurface_ = nullptr;
 #endif
 
-    delete flag_;
-    flag_ = new CFlag(-0.5, -0.5, 1, 1, nx_, ny_);
+        delete surface->flag_;
+        surface->flag_ = new CFlag(-0.5, -0.5, 1, 1, surface->nx_, surface->ny_);
 
-    flag_->setWind(true);
-    flag_->setWindForce(3.0);
+        surface->flag_->setWind(true);
+        surface->flag_->setWindForce(3.0);
 
-    //---
+        //---
 
-    updateFlag();
-  }
+        surface->updateFlag();
+
+        return true;
+      } },
 #endif
-  else if (name == "point") {
-    int ix = -1, iy = -1;
+    { "point", nullptr,
+      // get index from args
+      [](Object3D *obj, const QString &value, const QStringList &args) {
+        auto *surface = static_cast<Surface3DObj *>(obj);
 
-    // get index from args
-    if (args.size() > 0) {
-      QStringList strs;
-      (void) tcl->splitList(args[0], strs);
+        if (args.size() == 0)
+          return surface->canvas()->app()->errorMsg("Missing index for point");
 
-      if (strs.size() >= 2) {
-        ix = Util::stringToInt(strs[0]);
-        iy = Util::stringToInt(strs[1]);
-      }
+        auto ixy = argToIndex(surface, args);
+        if (ixy < 0) return false;
 
-      if (ix < 0 || ix >= nx_ || iy < 0 || iy >= ny_)
-        return false;
+        double z;
+        if (! Util::stringToReal(value, z))
+          return false;
 
-      int ixy = iy*nx_ + ix;
+        surface->points_[ixy].setZ(z);
 
-      double z;
-      if (! Util::stringToReal(value, z))
-        return false;
+        surface->setNeedsUpdate();
 
-      points_[ixy].setZ(z);
-    }
-    else
-      return app->errorMsg("Missing index for point");
+        return true;
+      } },
+    { "color", nullptr,
+      // get index from args
+      [](Object3D *obj, const QString &value, const QStringList &args) {
+        auto *surface = static_cast<Surface3DObj *>(obj);
 
-    setNeedsUpdate();
-  }
-  else if (name == "color") {
-    int ix = -1, iy = -1;
+        if (args.size() == 0)
+          return surface->canvas()->app()->errorMsg("Missing index for color");
 
-    // get index from args
-    if (args.size() > 0) {
-      QStringList strs;
-      (void) tcl->splitList(args[0], strs);
+        auto ixy = argToIndex(surface, args);
+        if (ixy < 0) return false;
 
-      if (strs.size() >= 2) {
-        ix = Util::stringToInt(strs[0]);
-        iy = Util::stringToInt(strs[1]);
-      }
+        QStringList cstrs;
+        (void) surface->canvas()->app()->tcl()->splitList(value, cstrs);
 
-      if (ix < 0 || ix >= nx_ || iy < 0 || iy >= ny_)
-        return false;
+        double r, g, b;
+        if (! Util::stringToReal(cstrs[0], r) ||
+            ! Util::stringToReal(cstrs[1], g) ||
+            ! Util::stringToReal(cstrs[2], b))
+          return false;
 
-      int ixy = iy*nx_ + ix;
+        surface->colors_[ixy] = CGLVector3D(r, g, b);
 
-      QStringList cstrs;
-      (void) tcl->splitList(value, cstrs);
+        surface->setNeedsUpdate();
 
-      double r, g, b;
-      if (! Util::stringToReal(cstrs[0], r) ||
-          ! Util::stringToReal(cstrs[1], g) ||
-          ! Util::stringToReal(cstrs[2], b))
-        return false;
+        return true;
+      } },
+    { "wireframe", nullptr,
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        auto *surface = static_cast<Surface3DObj *>(obj);
 
-      colors_[ixy] = CGLVector3D(r, g, b);
-    }
-    else
-      return app->errorMsg("Missing index for color");
+        surface->wireframe_ = Util::stringToBool(value);
 
-    setNeedsUpdate();
-  }
-  else if (name == "wireframe") {
-    wireframe_ = Util::stringToBool(value);
+        surface->setNeedsUpdate();
 
-    setNeedsUpdate();
-  }
-  else
-    return Object3D::setValue(name, value, args);
+        return true;
+      } },
+  }, &Object3D::properties());
+
+  return table;
+}
+
+bool
+Surface3DObj::
+getValue(const QString &name, const QStringList &args, QVariant &value)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
+
+  return Object3D::getValue(name, args, value);
+}
+
+bool
+Surface3DObj::
+setValue(const QString &name, const QString &value, const QStringList &args)
+{
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object3D::setValue(name, value, args);
 }
 
 void
@@ -42,6 +42,8 @@ class Surface3DObj : public Object3D {
   int nx() const { return nx_; }
   int ny() const { return ny_; }
 
+  static const PropertyTable<Object3D> &properties();
+
   bool getValue(const QString &name, const QStringList &args, QVariant &value) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
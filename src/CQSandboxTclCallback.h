@@ -0,0 +1,75 @@
+#ifndef CQSandboxTclCallback_H
+#define CQSandboxTclCallback_H
+
+#include <CTclUtil.h>
+
+namespace CQSandbox {
+
+// script proc (no args) run from per frame hooks (see App::runTclCallback)
+//
+// the command object is built once and evaluated directly so the proc's compiled body is
+// reused. Procs with an empty body (the default procs) are skipped without calling the
+// interpreter. The body is checked once per definition: a command delete/rename trace
+// (also called when the proc is redefined) marks the check as out of date.
+class TclCallback {
+ public:
+  explicit TclCallback(const char *name) :
+   name_(name) {
+  }
+
+ ~TclCallback() {
+    untrace(name_);
+
+    if (cmdObj_)
+      Tcl_DecrRefCount(cmdObj_);
+  }
+
+  TclCallback(const TclCallback &) = delete;
+  TclCallback &operator=(const TclCallback &) = delete;
+
+  const char *name() const { return name_; }
+
+ private:
+  friend class App;
+
+  static constexpr int TRACE_FLAGS = (TCL_TRACE_RENAME | TCL_TRACE_DELETE);
+
+  void trace(Tcl_Interp *interp) {
+    interp_ = interp;
+
+    if (Tcl_TraceCommand(interp_, name_, TRACE_FLAGS, traceProc, this) == TCL_OK)
+      traced_ = true;
+  }
+
+  void untrace(const char *name) {
+    if (traced_)
+      Tcl_UntraceCommand(interp_, name, TRACE_FLAGS, traceProc, this);
+
+    traced_ = false;
+  }
+
+  static void traceProc(ClientData clientData, Tcl_Interp *, const char *,
+                        const char *newName, int flags) {
+    auto *callback = static_cast<TclCallback *>(clientData);
+
+    callback->checked_ = false;
+
+    // renamed command keeps trace (deleted command's traces are freed)
+    if ((flags & TCL_TRACE_RENAME) && newName && *newName)
+      callback->untrace(newName);
+    else
+      callback->traced_ = false;
+  }
+
+ private:
+  const char* name_    { nullptr };
+  Tcl_Obj*    cmdObj_  { nullptr };
+  Tcl_Interp* interp_  { nullptr };
+  bool        traced_  { false }; // delete/rename trace on command
+  bool        checked_ { false }; // body of current definition checked
+  bool        enabled_ { false };
+};
+
+}
+
+#endif
@@ -196,28 +196,47 @@ setText(const QString &text)
   textDataValid_  = false;
 }
 
+const PropertyTable<Object3D> &
+Text3DObj::
+properties()
+{
+  using Table = PropertyTable<Object3D>;
+
+  static Table table({
+    { "text",
+      [](Object3D *obj, const QStringList &, QVariant &value) {
+        value = static_cast<Text3DObj *>(obj)->text(); return true;
+      },
+      [](Object3D *obj, const QString &value, const QStringList &) {
+        static_cast<Text3DObj *>(obj)->setText(value); return true;
+      } },
+  }, &Object3D::properties());
+
+  return table;
+}
+
 bool
 Text3DObj::
 getValue(const QString &name, const QStringList &args, QVariant &value)
 {
-  if (name == "text")
-    value = text();
-  else
-    return Object3D::getValue(name, args, value);
+  auto *property = properties().find(name);
+
+  if (property && property->get)
+    return property->get(this, args, value);
 
-  return true;
+  return Object3D::getValue(name, args, value);
 }
 
 bool
 Text3DObj::
 setValue(const QString &name, const QString &value, const QStringList &args)
 {
-  if (name == "text")
-    setText(value);
-  else
-    return Object3D::setValue(name, value, args);
+  auto *property = properties().find(name);
+
+  if (property && property->set)
+    return property->set(this, value, args);
 
-  return true;
+  return Object3D::setValue(name, value, args);
 }
 
 void
@@ -53,6 +53,8 @@ class Text3DObj : public Object3D {
   bool isRotated() const { return rotated_; }
   void setRotated(bool b) { rotated_ = b; }
 
+  static const PropertyTable<Object3D> &properties();
+
   bool getValue(const QString &name, const QStringList &args, QVariant &value) override;
   bool setValue(const QString &name, const QString &value, const QStringList &args) override;
 
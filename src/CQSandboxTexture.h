@@ -12,6 +12,13 @@ class Texture : public CGeomTexture {
  public:
   Texture() { }
 
+ ~Texture() {
+    for (auto &pt : canvasTextureData_) {
+      delete pt.second.glTexture;
+      delete pt.second.glTextureFlipped;
+    }
+  }
+
   bool isFlipped() const { return flipped_; }
   void setFlipped(bool b) { flipped_ = b; }
 
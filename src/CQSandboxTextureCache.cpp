@@ -0,0 +1,260 @@
+#include <CQSandboxTextureCache.h>
+#include <CQSandboxCanvas3D.h>
+
+#include <CQGLTexture.h>
+
+#include <QFileInfo>
+#include <QImageReader>
+#include <QRunnable>
+#include <QThread>
+
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace CQSandbox {
+
+// decoded images waiting for upload (shared by loaders and cache)
+struct TextureCache::Loaded {
+  using KeyImage = std::pair<QString, QImage>;
+
+  std::mutex            mutex;
+  std::vector<KeyImage> images;
+};
+
+//---
+
+// worker thread image decode
+class TextureCache::Loader : public QRunnable {
+ public:
+  Loader(TextureCache *cache, const LoadedP &loaded, const QString &key,
+         const QString &filename) :
+   cache_(cache), loaded_(loaded), key_(key), filename_(filename) {
+  }
+
+  void run() override {
+    QImageReader imageReader(filename_);
+
+    QImage image;
+
+    // convert to upload format here so only the GL upload is done on the GL thread
+    if (imageReader.read(&image) && ! image.isNull())
+      image = image.convertToFormat(QImage::Format_RGBA8888);
+
+    {
+    std::unique_lock<std::mutex> lock(loaded_->mutex);
+
+    loaded_->images.emplace_back(key_, image);
+    }
+
+    QMetaObject::invokeMethod(cache_, "loadedSlot", Qt::QueuedConnection);
+  }
+
+ private:
+  TextureCache* cache_ { nullptr };
+  LoadedP       loaded_;
+  QString       key_;
+  QString       filename_;
+};
+
+//---
+
+TextureCache::
+TextureCache(Canvas3D *canvas) :
+ QObject(canvas), canvas_(canvas), loaded_(std::make_shared<Loaded>())
+{
+  pool_.setMaxThreadCount(std::max(QThread::idealThreadCount() - 1, 1));
+}
+
+TextureCache::
+~TextureCache()
+{
+  // loaders reference cache. GL textures are released with the canvas context
+  pool_.waitForDone();
+}
+
+QString
+TextureCache::
+entryKey(const QString &filename, bool flip)
+{
+  return filename + (flip ? "|flip" : "");
+}
+
+CQGLTexture *
+TextureCache::
+acquire(const QString &filename, bool flip)
+{
+  auto key = entryKey(filename, flip);
+
+  auto pe = entries_.find(key);
+
+  if (pe == entries_.end()) {
+    QFileInfo fi(filename);
+
+    if (! fi.exists()) {
+      std::cerr << "Error: Invalid texture file '" << filename.toStdString() << "'\n";
+      return nullptr;
+    }
+
+    Entry entry;
+
+    entry.filename = filename;
+    entry.flip     = flip;
+    entry.texture  = new CQGLTexture;
+
+    pe = entries_.emplace(key, entry).first;
+
+    textureKeys_[entry.texture] = key;
+
+    if (isAsync()) {
+      (*pe).second.pending = true;
+
+      ++numPending_;
+
+      pool_.start(new Loader(this, loaded_, key, filename));
+    }
+    else {
+      QImageReader imageReader(filename);
+
+      QImage image;
+
+      (void) imageReader.read(&image);
+
+      loadEntry((*pe).second, image);
+    }
+  }
+
+  auto &entry = (*pe).second;
+
+  ++entry.refCount;
+
+  entry.lastUse = ++useCount_;
+
+  return entry.texture;
+}
+
+void
+TextureCache::
+addRef(CQGLTexture *texture)
+{
+  auto pt = textureKeys_.find(texture);
+  if (pt == textureKeys_.end()) return;
+
+  auto &entry = entries_[(*pt).second];
+
+  ++entry.refCount;
+
+  entry.lastUse = ++useCount_;
+}
+
+void
+TextureCache::
+release(CQGLTexture *texture)
+{
+  auto pt = textureKeys_.find(texture);
+  if (pt == textureKeys_.end()) return;
+
+  auto &entry = entries_[(*pt).second];
+
+  // unused textures are kept until evicted by update (may be reused)
+  if (entry.refCount > 0)
+    --entry.refCount;
+}
+
+void
+TextureCache::
+loadedSlot()
+{
+  // redraw to upload in render
+  canvas_->update();
+}
+
+void
+TextureCache::
+update()
+{
+  std::vector<Loaded::KeyImage> images;
+
+  {
+  std::unique_lock<std::mutex> lock(loaded_->mutex);
+
+  std::swap(images, loaded_->images);
+  }
+
+  for (auto &keyImage : images) {
+    auto pe = entries_.find(keyImage.first);
+    if (pe == entries_.end()) continue;
+
+    auto &entry = (*pe).second;
+
+    entry.pending = false;
+
+    --numPending_;
+
+    loadEntry(entry, keyImage.second);
+  }
+
+  evict();
+}
+
+void
+TextureCache::
+waitForDone()
+{
+  pool_.waitForDone();
+
+  update();
+}
+
+void
+TextureCache::
+loadEntry(Entry &entry, const QImage &image)
+{
+  if (image.isNull()) {
+    std::cerr << "Error: Failed to read image from '" << entry.filename.toStdString() << "'\n";
+    return;
+  }
+
+  if (! entry.texture->load(image, entry.flip))
+    return;
+
+  entry.memory = size_t(entry.texture->getWidth())*size_t(entry.texture->getHeight())*4;
+
+  memoryUsed_ += entry.memory;
+}
+
+void
+TextureCache::
+evict()
+{
+  // delete least recently used unused textures until under budget
+  while (memoryUsed_ > memoryBudget_) {
+    auto pe = entries_.end();
+
+    for (auto pe1 = entries_.begin(); pe1 != entries_.end(); ++pe1) {
+      const auto &entry = (*pe1).second;
+
+      if (entry.refCount > 0 || entry.pending)
+        continue;
+
+      if (pe == entries_.end() || entry.lastUse < (*pe).second.lastUse)
+        pe = pe1;
+    }
+
+    if (pe == entries_.end())
+      break;
+
+    auto &entry = (*pe).second;
+
+    memoryUsed_ -= entry.memory;
+
+    textureKeys_.erase(entry.texture);
+
+    delete entry.texture;
+
+    entries_.erase(pe);
+  }
+}
+
+}
@@ -0,0 +1,114 @@
+#ifndef CQSandboxTextureCache_H
+#define CQSandboxTextureCache_H
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+#include <map>
+#include <memory>
+#include <cstddef>
+
+class CQGLTexture;
+
+namespace CQSandbox {
+
+class Canvas3D;
+
+// shared image file textures of a canvas
+//
+// textures are keyed by file name and load options and reference counted: objects
+// acquire a texture for a file and release it when no longer used. Image files are
+// decoded on a worker thread pool and uploaded to GL in update (called from render with
+// the canvas context current), so an acquired texture is empty (id 0) until its image has
+// been loaded. Unused textures stay cached (for reuse) until the memory of all textures
+// exceeds the memory budget, then the least recently used are deleted.
+class TextureCache : public QObject {
+  Q_OBJECT
+
+ public:
+  TextureCache(Canvas3D *canvas);
+ ~TextureCache() override;
+
+  TextureCache(const TextureCache &) = delete;
+  TextureCache &operator=(const TextureCache &) = delete;
+
+  //---
+
+  // decode images on worker threads (else load on acquire)
+  bool isAsync() const { return async_; }
+  void setAsync(bool b) { async_ = b; }
+
+  // memory budget (bytes) of cached textures (unused textures are evicted above this)
+  size_t memoryBudget() const { return memoryBudget_; }
+  void setMemoryBudget(size_t n) { memoryBudget_ = n; }
+
+  // memory (bytes) of loaded textures
+  size_t memoryUsed() const { return memoryUsed_; }
+
+  int numTextures() const { return int(entries_.size()); }
+  int numPending () const { return numPending_; }
+
+  //---
+
+  // get shared texture for image file (nullptr if file does not exist)
+  CQGLTexture *acquire(const QString &filename, bool flip);
+
+  // add reference to texture from acquire (for objects sharing an acquired texture).
+  // Other textures are ignored
+  void addRef(CQGLTexture *texture);
+
+  // release texture reference from acquire or addRef (other textures are ignored)
+  void release(CQGLTexture *texture);
+
+  //---
+
+  // upload decoded images and evict unused textures over budget (GL context current)
+  void update();
+
+  // wait for pending images to be decoded and loaded (GL context current)
+  void waitForDone();
+
+ private Q_SLOTS:
+  void loadedSlot();
+
+ private:
+  struct Entry {
+    QString      filename;
+    bool         flip     { false };
+    CQGLTexture* texture  { nullptr };
+    int          refCount { 0 };
+    bool         pending  { false };
+    size_t       memory   { 0 };
+    size_t       lastUse  { 0 };
+  };
+
+  class Loader;
+  struct Loaded;
+
+  using Entries     = std::map<QString, Entry>;
+  using TextureKeys = std::map<CQGLTexture *, QString>;
+  using LoadedP     = std::shared_ptr<Loaded>;
+
+  static QString entryKey(const QString &filename, bool flip);
+
+  void loadEntry(Entry &entry, const QImage &image);
+
+  void evict();
+
+ private:
+  Canvas3D*   canvas_       { nullptr };
+  bool        async_        { true };
+  size_t      memoryBudget_ { 256*1024*1024 };
+  size_t      memoryUsed_   { 0 };
+  int         numPending_   { 0 };
+  size_t      useCount_     { 0 };
+  Entries     entries_;
+  TextureKeys textureKeys_;
+  LoadedP     loaded_;
+  QThreadPool pool_;
+};
+
+}
+
+#endif
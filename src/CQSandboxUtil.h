@@ -400,6 +400,18 @@ inline double radToDeg(double d) {
 
 //---
 
+// number of elements in strided range (start, start + stride, ...) of n elements
+inline int dataRangeCount(int n, int start, int stride) {
+  return (start < n ? (n - start - 1)/stride + 1 : 0);
+}
+
+// check ne elements of strided range fit in n elements
+inline bool isDataRangeValid(int n, int ne, int start, int stride) {
+  return (ne == 0 || int64_t(start) + int64_t(ne - 1)*stride < n);
+}
+
+//---
+
 }
 
 }
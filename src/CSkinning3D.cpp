@@ -0,0 +1,252 @@
+#include <CSkinning3D.h>
+#include <CThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+namespace {
+
+// vertices per parallel work block
+const size_t SKIN_BLOCK = 16384;
+
+}
+
+//---
+
+void
+CSkinning3D::Palette::
+resize(int numNodes)
+{
+  auto n = size_t(std::max(numNodes, 0) + 1);
+
+  data_.resize(16*n);
+
+  for (size_t i = 0; i < n; ++i) {
+    auto *c = &data_[16*i];
+
+    std::fill(c, c + 16, 0.0f);
+
+    c[0] = 1.0f; c[5] = 1.0f; c[10] = 1.0f;
+  }
+}
+
+//---
+
+void
+CSkinning3D::Mesh::
+resize(size_t n)
+{
+  points_.resize(n);
+
+  for (int k = 0; k < NUM_INFLUENCES; ++k) {
+    bones_  [k].resize(n);
+    weights_[k].resize(n);
+  }
+}
+
+void
+CSkinning3D::Mesh::
+setVertex(size_t i, float x, float y, float z, const int nodeIds[NUM_INFLUENCES],
+          const double weights[NUM_INFLUENCES])
+{
+  points_.x[i] = x;
+  points_.y[i] = y;
+  points_.z[i] = z;
+
+  double total = 0.0;
+
+  for (int k = 0; k < NUM_INFLUENCES; ++k) {
+    if (nodeIds[k] >= 0 && weights[k] > 0.0)
+      total += weights[k];
+  }
+
+  if (total <= 0.0) {
+    setVertex(i, x, y, z);
+    return;
+  }
+
+  for (int k = 0; k < NUM_INFLUENCES; ++k) {
+    if (nodeIds[k] >= 0 && weights[k] > 0.0) {
+      bones_  [k][i] = nodeIds[k] + 1;
+      weights_[k][i] = float(weights[k]/total);
+    }
+    else {
+      bones_  [k][i] = 0;
+      weights_[k][i] = 0.0f;
+    }
+  }
+}
+
+void
+CSkinning3D::Mesh::
+setVertex(size_t i, float x, float y, float z)
+{
+  points_.x[i] = x;
+  points_.y[i] = y;
+  points_.z[i] = z;
+
+  // identity bone
+  for (int k = 0; k < NUM_INFLUENCES; ++k) {
+    bones_  [k][i] = 0;
+    weights_[k][i] = (k == 0 ? 1.0f : 0.0f);
+  }
+}
+
+//---
+
+void
+CSkinning3D::
+skin(const Palette &palette, const Mesh &mesh, Points &points, size_t i1, size_t i2, bool simd)
+{
+  i2 = std::min(i2, mesh.size());
+
+  if (i1 >= i2)
+    return;
+
+#ifdef __SSE__
+  if (simd) {
+    skinSimd(palette, mesh, points, i1, i2);
+    return;
+  }
+#else
+  (void) simd;
+#endif
+
+  skinScalar(palette, mesh, points, i1, i2);
+}
+
+void
+CSkinning3D::
+skinScalar(const Palette &palette, const Mesh &mesh, Points &points, size_t i1, size_t i2)
+{
+  const auto *pd = palette.data();
+  auto        nb = palette.numBones();
+
+  const auto &src = mesh.points();
+
+  for (auto i = i1; i < i2; ++i) {
+    auto x = src.x[i], y = src.y[i], z = src.z[i];
+
+    float rx = 0.0f, ry = 0.0f, rz = 0.0f;
+
+    for (int k = 0; k < NUM_INFLUENCES; ++k) {
+      auto w = mesh.weights(k)[i];
+      if (w == 0.0f) continue;
+
+      auto b = mesh.bones(k)[i];
+      if (b < 0 || b >= nb) b = 0;
+
+      const auto *m = pd + 16*b;
+
+      rx += w*(m[0]*x + m[4]*y + m[ 8]*z + m[12]);
+      ry += w*(m[1]*x + m[5]*y + m[ 9]*z + m[13]);
+      rz += w*(m[2]*x + m[6]*y + m[10]*z + m[14]);
+    }
+
+    points.x[i] = rx;
+    points.y[i] = ry;
+    points.z[i] = rz;
+  }
+}
+
+void
+CSkinning3D::
+skinSimd(const Palette &palette, const Mesh &mesh, Points &points, size_t i1, size_t i2)
+{
+#ifdef __SSE__
+  const auto *pd = palette.data();
+  auto        nb = palette.numBones();
+
+  const auto &src = mesh.points();
+
+  for (auto i = i1; i < i2; ++i) {
+    // result lanes are x, y, z, pad
+    auto vx = _mm_set1_ps(src.x[i]);
+    auto vy = _mm_set1_ps(src.y[i]);
+    auto vz = _mm_set1_ps(src.z[i]);
+
+    auto acc = _mm_setzero_ps();
+
+    for (int k = 0; k < NUM_INFLUENCES; ++k) {
+      auto w = mesh.weights(k)[i];
+      if (w == 0.0f) continue;
+
+      auto b = mesh.bones(k)[i];
+      if (b < 0 || b >= nb) b = 0;
+
+      const auto *m = pd + 16*b;
+
+      auto t = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m    ), vx),
+                                     _mm_mul_ps(_mm_loadu_ps(m + 4), vy)),
+                          _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m + 8), vz),
+                                     _mm_loadu_ps(m + 12)));
+
+      acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(w), t));
+    }
+
+    alignas(16) float r[4];
+
+    _mm_store_ps(r, acc);
+
+    points.x[i] = r[0];
+    points.y[i] = r[1];
+    points.z[i] = r[2];
+  }
+#else
+  skinScalar(palette, mesh, points, i1, i2);
+#endif
+}
+
+void
+CSkinning3D::
+skinMeshes(CThreadPool *pool, const Jobs &jobs, bool simd)
+{
+  // split meshes into blocks so large meshes are also shared across threads
+  struct Block {
+    const Job* job { nullptr };
+    size_t     i1  { 0 };
+    size_t     i2  { 0 };
+  };
+
+  std::vector<Block> blocks;
+
+  for (const auto &job : jobs) {
+    auto n = job.mesh->size();
+
+    job.points->resize(n);
+
+    for (size_t i = 0; i < n; i += SKIN_BLOCK) {
+      Block block;
+
+      block.job = &job;
+      block.i1  = i;
+      block.i2  = std::min(i + SKIN_BLOCK, n);
+
+      blocks.push_back(block);
+    }
+  }
+
+  auto skinBlock = [&](const Block &block) {
+    skin(*block.job->palette, *block.job->mesh, *block.job->points, block.i1, block.i2, simd);
+  };
+
+  if (! pool || blocks.size() <= 1) {
+    for (const auto &block : blocks)
+      skinBlock(block);
+
+    return;
+  }
+
+  std::atomic<size_t> next { 0 };
+
+  pool->parallelFor(pool->numChunks(blocks.size()), [&](size_t, size_t, size_t) {
+    size_t i;
+
+    while ((i = next.fetch_add(1)) < blocks.size())
+      skinBlock(blocks[i]);
+  });
+}
@@ -0,0 +1,120 @@
+#ifndef CSkinning3D_H
+#define CSkinning3D_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class CThreadPool;
+
+// CPU linear blend skinning
+//
+// bone matrices are stored in a flat palette indexed by node id + 1 (index 0 is the
+// identity used for unset bones and unweighted vertices). Each bone is an affine matrix
+// stored as four float columns (x, y, z, pad) so a transform is four vector multiply adds.
+//
+// mesh vertices are stored as SoA arrays with four fixed influences per vertex (weights
+// normalized, unused influences have zero weight). skin() transforms a range of vertices
+// in one pass (SSE when available) and skinMeshes() splits meshes into blocks across a
+// thread pool.
+class CSkinning3D {
+ public:
+  static constexpr int NUM_INFLUENCES = 4;
+
+  // bone matrix palette
+  class Palette {
+   public:
+    Palette() { }
+
+    int numBones() const { return int(data_.size()/16); }
+
+    // set number of nodes (all bones reset to identity, keeps allocation)
+    void resize(int numNodes);
+
+    // set bone matrix for node from 4x4 row major values (e.g. CMatrix3D::getData())
+    template<typename T>
+    void setNodeMatrix(int nodeId, const T *m) {
+      auto i = nodeId + 1;
+      if (i <= 0 || i >= numBones()) return;
+
+      auto *c = &data_[size_t(16*i)];
+
+      for (int col = 0; col < 4; ++col) {
+        c[4*col    ] = float(m[col    ]);
+        c[4*col + 1] = float(m[col + 4]);
+        c[4*col + 2] = float(m[col + 8]);
+        c[4*col + 3] = 0.0f;
+      }
+    }
+
+    const float *data() const { return data_.data(); }
+
+   private:
+    std::vector<float> data_;
+  };
+
+  // SoA vertex coordinates
+  struct Points {
+    std::vector<float> x, y, z;
+
+    size_t size() const { return x.size(); }
+
+    void resize(size_t n) { x.resize(n); y.resize(n); z.resize(n); }
+  };
+
+  // mesh vertices with bone influences
+  class Mesh {
+   public:
+    Mesh() { }
+
+    size_t size() const { return points_.size(); }
+
+    void resize(size_t n);
+
+    // set vertex point and influences (node ids and weights, influences with negative node
+    // or zero weight are ignored and the rest normalized)
+    void setVertex(size_t i, float x, float y, float z, const int nodeIds[NUM_INFLUENCES],
+                   const double weights[NUM_INFLUENCES]);
+
+    // set vertex point with no influences
+    void setVertex(size_t i, float x, float y, float z);
+
+    const Points &points() const { return points_; }
+
+    const int32_t *bones  (int k) const { return bones_  [k].data(); }
+    const float   *weights(int k) const { return weights_[k].data(); }
+
+   private:
+    using Bones   = std::vector<int32_t>;
+    using Weights = std::vector<float>;
+
+    Points  points_;
+    Bones   bones_  [NUM_INFLUENCES];
+    Weights weights_[NUM_INFLUENCES];
+  };
+
+  // skin job for skinMeshes
+  struct Job {
+    const Palette* palette { nullptr };
+    const Mesh*    mesh    { nullptr };
+    Points*        points  { nullptr };
+  };
+
+  using Jobs = std::vector<Job>;
+
+ public:
+  // skin mesh vertices [i1, i2) into points (points must be sized to mesh)
+  static void skin(const Palette &palette, const Mesh &mesh, Points &points,
+                   size_t i1, size_t i2, bool simd=true);
+
+  // skin all meshes (points are resized), pool can be null
+  static void skinMeshes(CThreadPool *pool, const Jobs &jobs, bool simd=true);
+
+ private:
+  static void skinScalar(const Palette &palette, const Mesh &mesh, Points &points,
+                         size_t i1, size_t i2);
+  static void skinSimd  (const Palette &palette, const Mesh &mesh, Points &points,
+                         size_t i1, size_t i2);
+};
+
+#endif
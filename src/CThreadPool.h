@@ -0,0 +1,213 @@
+#ifndef CThreadPool_H
+#define CThreadPool_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+// persistent pool of worker threads used to run data parallel loops
+//
+// parallelFor splits the range [0, n) into one contiguous chunk per thread and
+// blocks until all chunks have completed. The calling thread processes the first
+// chunk so a pool of N threads only needs N - 1 workers.
+//
+// chunk boundaries only depend on n and the thread count so callers which write
+// results to per chunk or per index storage get deterministic results.
+//
+// calls from different threads are serialized (a call waits for the running call to
+// finish) and not reentrant: proc must not call parallelFor on the same pool.
+class CThreadPool {
+ public:
+  using RangeProc = std::function<void (size_t, size_t, size_t)>;
+
+ public:
+  static CThreadPool *instance() {
+    static CThreadPool pool;
+
+    return &pool;
+  }
+
+  static size_t hardwareThreads() {
+    auto n = std::thread::hardware_concurrency();
+
+    return (n > 0 ? size_t(n) : 1);
+  }
+
+  explicit CThreadPool(size_t numThreads=0) {
+    setNumThreads(numThreads);
+  }
+
+ ~CThreadPool() {
+    stopWorkers();
+  }
+
+  CThreadPool(const CThreadPool &) = delete;
+  CThreadPool &operator=(const CThreadPool &) = delete;
+
+  //! get/set number of threads (including calling thread), 0 is hardware concurrency
+  size_t numThreads() const { return numThreads_; }
+
+  void setNumThreads(size_t n) {
+    if (n == 0)
+      n = hardwareThreads();
+
+    std::unique_lock<std::mutex> callLock(callMutex_);
+
+    if (n == numThreads_)
+      return;
+
+    stopWorkers();
+
+    numThreads_ = n;
+
+    startWorkers();
+  }
+
+  //! number of chunks a range of size n is split into
+  size_t numChunks(size_t n, size_t minChunk=1) const {
+    if (n == 0)
+      return 0;
+
+    minChunk = std::max(minChunk, size_t(1));
+
+    return std::max(size_t(1), std::min(numThreads_, (n + minChunk - 1)/minChunk));
+  }
+
+  //! run proc(chunk, begin, end) for each chunk of [0, n)
+  void parallelFor(size_t n, const RangeProc &proc, size_t minChunk=1) {
+    // one call at a time uses the workers and shared loop state
+    std::unique_lock<std::mutex> callLock(callMutex_);
+
+    auto nc = numChunks(n, minChunk);
+
+    if (nc == 0)
+      return;
+
+    if (nc == 1 || workers_.empty()) {
+      callLock.unlock();
+
+      proc(0, 0, n);
+      return;
+    }
+
+    {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    proc_      = &proc;
+    n_         = n;
+    nc_        = nc;
+    nextChunk_ = 1;
+    pending_   = nc - 1;
+    }
+
+    startCond_.notify_all();
+
+    runChunk(0);
+
+    // help with any chunks not yet claimed by a worker
+    for (;;) {
+      size_t chunk;
+
+      {
+      std::unique_lock<std::mutex> lock(mutex_);
+
+      if (nextChunk_ >= nc_)
+        break;
+
+      chunk = nextChunk_++;
+      }
+
+      runChunk(chunk);
+
+      finishChunk();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    doneCond_.wait(lock, [&]() { return pending_ == 0; });
+
+    proc_ = nullptr;
+  }
+
+ private:
+  void runChunk(size_t chunk) {
+    auto begin = (n_*chunk      )/nc_;
+    auto end   = (n_*(chunk + 1))/nc_;
+
+    (*proc_)(chunk, begin, end);
+  }
+
+  void finishChunk() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (--pending_ == 0)
+      doneCond_.notify_all();
+  }
+
+  void startWorkers() {
+    stop_ = false;
+
+    for (size_t i = 1; i < numThreads_; ++i)
+      workers_.emplace_back([this]() { workerLoop(); });
+  }
+
+  void stopWorkers() {
+    {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    stop_ = true;
+    }
+
+    startCond_.notify_all();
+
+    for (auto &worker : workers_)
+      worker.join();
+
+    workers_.clear();
+  }
+
+  void workerLoop() {
+    for (;;) {
+      size_t chunk;
+
+      {
+      std::unique_lock<std::mutex> lock(mutex_);
+
+      startCond_.wait(lock, [&]() { return stop_ || nextChunk_ < nc_; });
+
+      if (stop_)
+        return;
+
+      chunk = nextChunk_++;
+      }
+
+      runChunk(chunk);
+
+      finishChunk();
+    }
+  }
+
+ private:
+  using Workers = std::vector<std::thread>;
+
+  size_t  numThreads_ { 0 };
+  Workers workers_;
+
+  std::mutex              callMutex_;
+  std::mutex              mutex_;
+  std::condition_variable startCond_;
+  std::condition_variable doneCond_;
+
+  const RangeProc* proc_       { nullptr };
+  size_t           n_          { 0 };
+  size_t           nc_         { 0 };
+  size_t           nextChunk_  { 0 };
+  size_t           pending_    { 0 };
+  bool             stop_       { false };
+};
+
+#endif
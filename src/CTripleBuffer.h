@@ -0,0 +1,51 @@
+#ifndef CTripleBuffer_H
+#define CTripleBuffer_H
+
+#include <atomic>
+
+// lock free single producer, single consumer triple buffer
+//
+// the writer fills writeBuffer() and publishes it, the reader acquires the most recently
+// published buffer and reads it with readBuffer(). Neither side ever waits: the writer
+// always has a free buffer and intermediate buffers are dropped if the reader is slower.
+// Buffers are reused so they keep their allocations once warmed up.
+template<typename T>
+class CTripleBuffer {
+ public:
+  CTripleBuffer() { }
+
+  CTripleBuffer(const CTripleBuffer &) = delete;
+  CTripleBuffer &operator=(const CTripleBuffer &) = delete;
+
+  //! buffer being written (writer thread only)
+  T &writeBuffer() { return buffers_[write_]; }
+
+  //! make write buffer newest (writer thread only)
+  void publish() {
+    write_ = middle_.exchange(write_ | FRESH, std::memory_order_acq_rel) & INDEX;
+  }
+
+  //! swap in newest published buffer, returns false if nothing new (reader thread only)
+  bool acquire() {
+    if (! (middle_.load(std::memory_order_relaxed) & FRESH))
+      return false;
+
+    read_ = middle_.exchange(read_, std::memory_order_acq_rel) & INDEX;
+
+    return true;
+  }
+
+  //! buffer being read (reader thread only)
+  const T &readBuffer() const { return buffers_[read_]; }
+
+ private:
+  static constexpr unsigned int INDEX = 3;
+  static constexpr unsigned int FRESH = 4;
+
+  T                         buffers_[3];
+  unsigned int              write_  { 0 };
+  std::atomic<unsigned int> middle_ { 1 }; // index of spare buffer (and fresh flag)
+  unsigned int              read_   { 2 };
+};
+
+#endif
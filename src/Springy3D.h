@@ -2,6 +2,7 @@
 #define Springy_H
 
 #include <CGenRand.h>
+#include <CBarnesHut3D.h>
 
 #include <optional>
 #include <string>
@@ -504,6 +505,14 @@ namespace Springy3D {
     double centerAttract() const { return centerAttract_; }
     void setCenterAttract(double r) { centerAttract_ = r; }
 
+    //! get/set use Barnes-Hut approximation for repulsion
+    bool isBarnesHut() const { return barnesHut_; }
+    void setBarnesHut(bool b) { barnesHut_ = b; }
+
+    //! get/set Barnes-Hut accuracy (cell size/distance threshold)
+    double theta() const { return barnesHutTree_.theta(); }
+    void setTheta(double r) { barnesHutTree_.setTheta(r); }
+
     PointP nodePoint(NodeP node) const {
       auto *th = const_cast<Layout *>(this);
 
@@ -593,6 +602,13 @@ namespace Springy3D {
 
     // Physics stuff
     void applyCoulombsLaw() {
+      if (isBarnesHut())
+        applyCoulombsLawBarnesHut();
+      else
+        applyCoulombsLawExact();
+    }
+
+    void applyCoulombsLawExact() {
       for (auto n1 : graph_->nodes()) {
         auto point1 = nodePoint(n1);
 
@@ -617,6 +633,99 @@ namespace Springy3D {
       }
     }
 
+    // approximate repulsion using octree of node positions (O(N log N))
+    void applyCoulombsLawBarnesHut() {
+      using PointArray = std::vector<Point *>;
+
+      PointArray points;
+
+      for (auto n : graph_->nodes())
+        points.push_back(nodePoint(n).get());
+
+      std::vector<Vector> forces;
+
+      calcCoulombsForces(points, /*barnesHut*/true, forces);
+
+      for (size_t i = 0; i < points.size(); ++i)
+        points[i]->applyForce(forces[i]);
+    }
+
+    // calc repulsion force on each point (both ordered pairs of the exact loop
+    // contribute 2*repulsion/d^2 so each pair gives 4*repulsion/d^2)
+    void calcCoulombsForces(const std::vector<Point *> &points, bool barnesHut,
+                            std::vector<Vector> &forces) {
+      auto n = points.size();
+
+      forces.resize(n);
+
+      auto scale = 4.0*repulsion();
+
+      auto kernel = [&](double dx, double dy, double dz, double w,
+                        double &fx, double &fy, double &fz) {
+        auto r = std::sqrt(dx*dx + dy*dy + dz*dz);
+        if (r == 0.0) return;
+
+        auto r1 = r + 0.1;
+        auto f  = scale*w/(r*r1*r1);
+
+        fx += dx*f; fy += dy*f; fz += dz*f;
+      };
+
+      if (barnesHut) {
+        barnesHutTree_.clear();
+
+        for (auto *point : points)
+          barnesHutTree_.addBody(point->p().x(), point->p().y(), point->p().z());
+
+        barnesHutTree_.build();
+      }
+
+      for (size_t i = 0; i < n; ++i) {
+        const auto &p = points[i]->p();
+
+        double fx = 0.0, fy = 0.0, fz = 0.0;
+
+        if (barnesHut)
+          barnesHutTree_.accumulate(p.x(), p.y(), p.z(), i, kernel, fx, fy, fz);
+        else {
+          for (size_t j = 0; j < n; ++j) {
+            if (j == i) continue;
+
+            const auto &p1 = points[j]->p();
+
+            kernel(p.x() - p1.x(), p.y() - p1.y(), p.z() - p1.z(), 1.0, fx, fy, fz);
+          }
+        }
+
+        forces[i] = Vector(fx, fy, fz);
+      }
+    }
+
+    // relative (RMS) error of Barnes-Hut repulsion compared to exact calculation
+    double barnesHutError() {
+      std::vector<Point *> points;
+
+      for (auto n : graph_->nodes())
+        points.push_back(nodePoint(n).get());
+
+      std::vector<Vector> exactForces, approxForces;
+
+      calcCoulombsForces(points, /*barnesHut*/false, exactForces);
+      calcCoulombsForces(points, /*barnesHut*/true , approxForces);
+
+      double e2 = 0.0, f2 = 0.0;
+
+      for (size_t i = 0; i < points.size(); ++i) {
+        auto d = approxForces[i].subtract(exactForces[i]).magnitude();
+        auto f = exactForces[i].magnitude();
+
+        e2 += d*d;
+        f2 += f*f;
+      }
+
+      return (f2 > 0.0 ? std::sqrt(e2/f2) : 0.0);
+    }
+
     void applyHookesLaw() {
       for (auto edge : graph_->edges()) {
         bool isTemp = false;
@@ -785,6 +894,8 @@ namespace Springy3D {
     double      repulsion_          { 400.0 };   //!< repulsion constant
     double      damping_            { 0.5 };     //!< velocity damping factor
     double      centerAttract_      { 50.0 };    //!< center attraction
+    bool        barnesHut_          { false };   //!< use Barnes-Hut repulsion
+    CBarnesHut3D barnesHutTree_;                 //!< Barnes-Hut octree
 //  double      minEnergyThreshold_ { 0.0 };     //!< min energy threshold
     NodePoints  nodePoints_;                     //!< keep track of points associated with nodes
     EdgeSprings edgeSprings_;                    //!< keep track of springs associated with edges
@@ -0,0 +1,27 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec4 aColor;
+layout (location = 3) in vec2 aTexCoord;
+
+// per instance
+layout (location = 4) in mat4 aModel;
+layout (location = 8) in vec4 aInstanceColor;
+
+uniform highp mat4 projection;
+uniform highp mat4 view;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec4 Color;
+out vec2 TexCoord;
+
+void main() {
+  FragPos  = vec3(aModel * vec4(aPos, 1.0));
+  Normal   = mat3(transpose(inverse(aModel)))*aNormal;
+  Color    = aInstanceColor;
+  TexCoord = vec2(aTexCoord.x, aTexCoord.y);
+
+  gl_Position = projection * view * aModel * vec4(aPos, 1.0);
+}
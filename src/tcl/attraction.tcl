@@ -0,0 +1,26 @@
+# particles attracted to each other (all pairs) using Barnes-Hut approximation
+
+proc randIn { min max } {
+  return [expr {rand()*($max - $min) + $min}]
+}
+
+proc init { } {
+  sb::canvas set range [list -10.0 -10.0 10.0 10.0]
+
+  sb::canvas set gravity 0
+
+  for {set i 0} {$i < 2000} {incr i} {
+    set p [sb::particle [list [randIn -8 8] [randIn -8 8] 0]]
+
+    $p set velocity [list [randIn -0.5 0.5] [randIn -0.5 0.5]]
+  }
+
+  sb::canvas set attraction.all {0.001 0.5}
+
+  sb::canvas set barnes_hut       1
+  sb::canvas set barnes_hut.theta 0.7
+
+  echo "barnes hut error [sb::canvas get barnes_hut.error]"
+
+  sb::canvas set play 1
+}
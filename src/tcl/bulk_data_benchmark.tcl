@@ -0,0 +1,46 @@
+# point updates/second for per element set position and bulk list/binary set_data
+
+proc report { name n t } {
+  echo [format "%-10s %10.0f updates/s" $name [expr {$n/($t/1e6)}]]
+}
+
+proc init { } {
+  sb::canvas set range {0 0 100 100}
+
+  set n 100000
+
+  set points [sb::point_list 1px]
+
+  $points set size $n
+
+  # per element string values
+  set t1 [clock microseconds]
+
+  for {set i 0} {$i < $n} {incr i} {
+    $points set position [list [expr {100*rand()}] [expr {100*rand()}]] $i
+  }
+
+  report "element" $n [expr {[clock microseconds] - $t1}]
+
+  # flat list of numbers
+  set values {}
+
+  for {set i 0} {$i < $n} {incr i} {
+    lappend values [expr {100*rand()}] [expr {100*rand()}]
+  }
+
+  set t1 [clock microseconds]
+
+  $points set_data position $values
+
+  report "list" $n [expr {[clock microseconds] - $t1}]
+
+  # binary floats
+  set bytes [binary format f* $values]
+
+  set t1 [clock microseconds]
+
+  $points set_data position $bytes -binary
+
+  report "binary" $n [expr {[clock microseconds] - $t1}]
+}
@@ -0,0 +1,17 @@
+# compare buffered fade/blend cost of original per pixel loop and compositor
+
+proc init { } {
+  sb::canvas set buffered 1
+
+  sb::canvas set blend.enabled 1
+
+  foreach size {{1920 1080} {3840 2160}} {
+    lassign $size w h
+
+    foreach threads {1 0} {
+      sb::canvas set blend.threads $threads
+
+      echo [sb::canvas exec benchmark.fade $w $h 5]
+    }
+  }
+}
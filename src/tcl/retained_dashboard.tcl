@@ -0,0 +1,38 @@
+# mostly static dashboard drawn in retained mode (only damaged regions are redrawn)
+
+proc init { } {
+  sb::canvas set range {0 0 100 100}
+
+  sb::canvas set retained 1
+
+  for {set r 0} {$r < 20} {incr r} {
+    for {set c 0} {$c < 10} {incr c} {
+      set x [expr {$c*10 + 1}]
+      set y [expr {$r*5 + 1}]
+
+      set rect [sb::rect [list $x $y [expr {$x + 8}] [expr {$y + 4}]]]
+
+      $rect set brush.color [expr {($r + $c) % 2 ? "#c0d0e0" : "#e0d0c0"}]
+
+      sb::text [list [expr {$x + 1}] [expr {$y + 1}]] "$r.$c"
+    }
+  }
+
+  set ::marker [sb::rect {0 0 2 2}]
+
+  $::marker set brush.color red
+
+  set ::ticks 0
+}
+
+proc update { } {
+  incr ::ticks
+
+  set x [expr {($::ticks % 98)}]
+
+  $::marker set rect [list $x 50 [expr {$x + 2}] 52]
+
+  if {$::ticks % 100 == 0} {
+    echo "redraw objects [sb::canvas get redraw.objects] cached [sb::canvas get redraw.cached] full [sb::canvas get redraw.full]"
+  }
+}
@@ -0,0 +1,22 @@
+# time point and rect object queries on large number of rects (uses object index)
+
+proc init { } {
+  sb::canvas set range {0 0 1000 1000}
+
+  set n 100000
+
+  expr srand(1)
+
+  for {set i 0} {$i < $n} {incr i} {
+    set x [expr {rand()*995}]
+    set y [expr {rand()*995}]
+
+    sb::rect [list $x $y [expr {$x + 5}] [expr {$y + 5}]]
+  }
+
+  echo "objects [sb::canvas get objects.count]"
+
+  echo "at_point [time { sb::canvas get objects.at_point [list [expr {rand()*1000}] [expr {rand()*1000}]] } 1000]"
+
+  echo "in_rect [time { sb::canvas get objects.in_rect {100 100 120 120} } 1000]"
+}
@@ -0,0 +1,10 @@
+# time particle system ticks for 100k spring mesh from 1 to all cores
+
+proc init { } {
+  echo [sb::canvas exec benchmark.springs 100000 10]
+
+  # use all cores for canvas particles
+  sb::canvas set particle.threads 0
+
+  echo "particle threads [sb::canvas get particle.threads]"
+}
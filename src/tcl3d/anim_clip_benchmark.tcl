@@ -0,0 +1,15 @@
+# compare keyframe node matrix update with pre-sampled clip cache for a crowd of models
+
+proc init { } {
+  set model_dir "tcl3d/Dungeon_Characters/gltf"
+
+  sb3d::canvas set model_dir $model_dir
+
+  for {set i 0} {$i < 500} {incr i} {
+    set model [sb3d::model "$model_dir/Barbarian.glb"]
+
+    $model set anim.name "Idle"
+  }
+
+  echo [$model exec benchmark.anim 100]
+}
@@ -0,0 +1,11 @@
+# grid/heap A* time per query on random 1024x1024 grid (and previous A* on 256x256 grid)
+
+proc init { } {
+  set ::field_runners [sb3d::field_runners]
+
+  $::field_runners set map field_runners/maps/grasslands.map
+
+  echo [$::field_runners exec benchmark.astar 1024 10]
+
+  echo [$::field_runners get path {1 1} {20 10}]
+}
@@ -0,0 +1,58 @@
+# point updates/second for per element set position, bulk list set_data and bulk binary set_data
+
+proc report { name n t } {
+  echo [format "%-10s %10.0f updates/s" $name [expr {$n/($t/1e6)}]]
+}
+
+proc init { } {
+  set n 100000
+
+  set particles [sb3d::particle_list]
+
+  $particles set size $n
+
+  # per element string values
+  set t1 [clock microseconds]
+
+  for {set i 0} {$i < $n} {incr i} {
+    $particles set position [list [expr {rand()}] [expr {rand()}] [expr {rand()}]] $i
+  }
+
+  report "element" $n [expr {[clock microseconds] - $t1}]
+
+  # flat list of numbers
+  set values {}
+
+  for {set i 0} {$i < $n} {incr i} {
+    lappend values [expr {rand()}] [expr {rand()}] [expr {rand()}]
+  }
+
+  set t1 [clock microseconds]
+
+  $particles set_data position $values
+
+  report "list" $n [expr {[clock microseconds] - $t1}]
+
+  # binary floats
+  set bytes [binary format f* $values]
+
+  set t1 [clock microseconds]
+
+  $particles set_data position $bytes -binary
+
+  report "binary" $n [expr {[clock microseconds] - $t1}]
+
+  # every 10th point (strided range update)
+  set bytes [binary format f* [lrange $values 0 [expr {3*$n/10 - 1}]]]
+
+  set t1 [clock microseconds]
+
+  $particles set_data position $bytes -binary -stride 10
+
+  report "strided" [expr {$n/10}] [expr {[clock microseconds] - $t1}]
+
+  # check round trip
+  binary scan [$particles get_data position -binary -start 1 -stride 10] f3 p
+
+  echo "point 1: $p"
+}
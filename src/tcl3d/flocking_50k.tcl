@@ -0,0 +1,8 @@
+proc init { } {
+  set particles [sb3d::particle_list]
+
+  # boid count (world is scaled to keep default density)
+  $particles set flocking 1 50000
+  $particles set texture  textures/particle.png
+  $particles set particleSize 0.005
+}
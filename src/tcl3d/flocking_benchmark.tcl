@@ -0,0 +1,7 @@
+# boids/second for 1 to all cores (and check results don't depend on thread count)
+
+proc init { } {
+  set particles [sb3d::particle_list]
+
+  echo [$particles exec benchmark.flocking 50000 10]
+}
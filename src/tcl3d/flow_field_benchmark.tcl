@@ -0,0 +1,15 @@
+# flow field full recalculation against incremental block/unblock update for 16x16 to 1024x1024 grids
+
+proc init { } {
+  set ::field_runners [sb3d::field_runners]
+
+  $::field_runners set map field_runners/maps/grasslands.map
+
+  echo [$::field_runners exec benchmark.flow_field 1024 100]
+
+  # shared field to exit cells, each runner reads next cell
+  $::field_runners set flow_field.goals {{25 6} {25 7} {25 8}}
+
+  echo [$::field_runners get flow_field.distance {1 7}]
+  echo [$::field_runners get flow_field.next {1 7}]
+}
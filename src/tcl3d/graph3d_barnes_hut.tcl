@@ -0,0 +1,10 @@
+proc init { } {
+  set ::graph [sb3d::graph]
+
+  $::graph set barnes_hut       1
+  $::graph set barnes_hut.theta 0.7
+
+  $::graph set dot_file "dot/philo.gv"
+
+  echo "barnes hut error [$::graph get barnes_hut.error]"
+}
@@ -0,0 +1,15 @@
+# multilevel (coarsen/refine) layout compared to spring step loop (time and stress)
+
+proc init { } {
+  set ::graph [sb3d::graph]
+
+  $::graph set barnes_hut 1
+
+  $::graph set dot_file "dot/philo.gv"
+
+  echo [$::graph exec benchmark.layout 10000 0.001]
+
+  $::graph set layout multilevel
+
+  echo "multilevel [$::graph get layout.time]ms stress [$::graph get stress]"
+}
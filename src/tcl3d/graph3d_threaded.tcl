@@ -0,0 +1,17 @@
+# layout steps on worker thread, render picks up newest positions
+
+proc init { } {
+  set ::graph [sb3d::graph]
+
+  $::graph set barnes_hut 1
+
+  $::graph set dot_file "dot/philo.gv"
+
+  $::graph set threaded 1
+}
+
+proc tick { args } {
+  if {[incr ::ticks] % 100 == 0} {
+    echo "layout [$::graph get layout.steps_per_second]/s render [$::graph get render.fps] fps"
+  }
+}
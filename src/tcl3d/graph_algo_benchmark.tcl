@@ -0,0 +1,7 @@
+# parse, kruskal, components, topological sort, bfs and dijkstra times on 1M edge DOT file
+
+proc init { } {
+  set ::graph [sb3d::graph]
+
+  echo [$::graph exec benchmark.algorithms "graph_1m.dot" 1000000]
+}
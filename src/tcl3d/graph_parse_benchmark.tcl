@@ -0,0 +1,7 @@
+# streaming (arrays and handler) against object graph parse of 1M edge DOT file (MB/s)
+
+proc init { } {
+  set ::graph [sb3d::graph]
+
+  echo [$::graph exec benchmark.parse "graph_1m.dot" 1000000]
+}
@@ -0,0 +1,7 @@
+# compare draw calls and frame time of cubes with and without instancing
+#
+# software rasterizer: LIBGL_ALWAYS_SOFTWARE=1 CQSandbox -3d tcl3d/instancing_benchmark.tcl
+
+proc init { } {
+  echo [sb3d::canvas exec benchmark.instancing 10000 10]
+}
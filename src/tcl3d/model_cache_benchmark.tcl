@@ -0,0 +1,7 @@
+# compare model import with compiled mesh cache (.sbmesh) load
+
+proc init { } {
+  set ::model [sb3d::model]
+
+  echo [$::model exec benchmark.load data/gear.stl data/robocop2.3ds]
+}
@@ -0,0 +1,13 @@
+# compare per vertex CPU skinning with CSkinning3D (scalar, simd, threaded)
+
+proc init { } {
+  set model_dir "tcl3d/Dungeon_Characters/gltf"
+
+  sb3d::canvas set model_dir $model_dir
+
+  set ::model [sb3d::model "$model_dir/Barbarian.glb"]
+
+  $::model set anim.name "Idle"
+
+  echo [$::model exec benchmark.skinning 10]
+}
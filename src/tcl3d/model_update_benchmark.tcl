@@ -0,0 +1,7 @@
+# compare model vertex data build with one thread and all threads
+
+proc init { } {
+  set ::model [sb3d::model data/robocop2.3ds]
+
+  echo [$::model exec benchmark.update]
+}
@@ -0,0 +1,51 @@
+# property get/set calls/second for base (table), derived (table) and chain properties
+
+proc report { name n t } {
+  echo [format "%-10s %10.0f calls/s" $name [expr {$n/($t/1e6)}]]
+}
+
+proc init { } {
+  set n 100000
+
+  set shape [sb3d::shape]
+
+  # base class property
+  set t1 [clock microseconds]
+
+  for {set i 0} {$i < $n} {incr i} {
+    $shape set visible 1
+  }
+
+  report "visible" $n [expr {[clock microseconds] - $t1}]
+
+  # derived class property
+  set t1 [clock microseconds]
+
+  for {set i 0} {$i < $n} {incr i} {
+    $shape set color red
+  }
+
+  report "color" $n [expr {[clock microseconds] - $t1}]
+
+  # base class get
+  set t1 [clock microseconds]
+
+  for {set i 0} {$i < $n} {incr i} {
+    $shape get position
+  }
+
+  report "position" $n [expr {[clock microseconds] - $t1}]
+
+  # indexed particle property
+  set particles [sb3d::particle_list]
+
+  $particles set size 1000
+
+  set t1 [clock microseconds]
+
+  for {set i 0} {$i < $n} {incr i} {
+    $particles set position {0 0 0} [expr {$i % 1000}]
+  }
+
+  report "particle" $n [expr {[clock microseconds] - $t1}]
+}
@@ -0,0 +1,32 @@
+# compare state changes and frame time of scene drawn in add order and sorted by render state
+#
+# software rasterizer: LIBGL_ALWAYS_SOFTWARE=1 CQSandbox -3d tcl3d/render_sort_benchmark.tcl
+
+proc init { } {
+  set textures [list "textures/container.jpg" "textures/Catwoman.jpg"]
+
+  set n 64
+
+  for {set i 0} {$i < $n} {incr i} {
+    set x [expr {($i % 8)/4.0 - 1.0}]
+    set z [expr {($i / 8)/4.0 - 1.0}]
+
+    # interleave textures and sprites so add order switches state every object
+    set cube [sb3d::cube]
+
+    $cube set scale 0.1
+    $cube set position [list $x 0.0 $z]
+    $cube set texture  [lindex $textures [expr {$i % 2}]]
+
+    set sprite [sb3d::sprite]
+
+    $sprite set scale 0.1
+    $sprite set position [list $x 0.3 $z]
+    $sprite set add_image [lindex $textures [expr {($i + 1) % 2}]]
+  }
+
+  # instanced draws would hide per object state changes
+  sb3d::canvas set instancing 0
+
+  echo [sb3d::canvas exec benchmark.render_sort 10]
+}
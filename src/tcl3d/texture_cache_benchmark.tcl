@@ -0,0 +1,34 @@
+# scene startup time and texture memory for many objects sharing a few texture files
+#
+# run with texture_cache.async 0 for synchronous (GUI thread) image loads
+
+proc init { } {
+  set textures [list "textures/container.jpg" "textures/Catwoman.jpg"]
+
+  set n 200
+
+  set t1 [clock microseconds]
+
+  for {set i 0} {$i < $n} {incr i} {
+    set x [expr {($i % 20)/10.0 - 1.0}]
+    set z [expr {($i / 20)/10.0 - 1.0}]
+
+    set cube [sb3d::cube]
+
+    $cube set scale 0.05
+    $cube set position [list $x 0.0 $z]
+    $cube set texture  [lindex $textures [expr {$i % 2}]]
+  }
+
+  set t2 [clock microseconds]
+
+  sb3d::canvas exec texture_cache.wait
+
+  set t3 [clock microseconds]
+
+  echo [format "create %.1f ms, loaded %.1f ms" \
+    [expr {($t2 - $t1)/1000.0}] [expr {($t3 - $t1)/1000.0}]]
+
+  echo [format "textures %d, memory %.1f MB" \
+    [sb3d::canvas get stats.textures] [sb3d::canvas get stats.texture_memory]]
+}
@@ -0,0 +1,5 @@
+# texture load time (format conversion, upload and mipmap generation) of 4K and 8K images
+
+proc init { } {
+  echo [sb3d::canvas exec benchmark.texture_load 4096 8192]
+}